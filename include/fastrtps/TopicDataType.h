@@ -23,6 +23,8 @@
 #include "rtps/common/SerializedPayload.h"
 #include "rtps/common/InstanceHandle.h"
 #include "utils/md5.h"
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <functional>
 
@@ -80,6 +82,92 @@ class  TopicDataType {
          */
         RTPS_DllAPI virtual bool getKey(void* data, rtps::InstanceHandle_t* ihandle, bool force_md5 = false) = 0;
 
+        /**
+         * Check whether the type is plain: once serialized, a sample is its encapsulation followed by the memory of
+         * the object as is. Samples of plain types are serialized and deserialized with a single copy, and can be
+         * used in place in lent payloads.
+         * @return True if the type is plain.
+         */
+        RTPS_DllAPI virtual bool is_plain() const { return false; }
+
+        /**
+         * Check whether the serialized size of every sample is bounded by m_typeSize, so payloads of that size
+         * can always hold a sample.
+         * @return True if the type is bounded.
+         */
+        RTPS_DllAPI virtual bool is_bounded() const { return m_typeSize != 0; }
+
+        /**
+         * Serialize a sample of a plain type, copying its memory after the encapsulation.
+         * @param[in] data Pointer to the data
+         * @param[in] size Size of the object in memory
+         * @param[out] payload Pointer to the payload
+         * @return True if correct.
+         */
+        static bool serialize_plain(const void* data, uint32_t size, rtps::SerializedPayload_t* payload)
+        {
+            if(payload->max_size < size + 4)
+            {
+                return false;
+            }
+            write_plain_encapsulation(payload);
+            memcpy(payload->data + 4, data, size);
+            payload->length = size + 4;
+            return true;
+        }
+
+        /**
+         * Deserialize a sample of a plain type, copying its memory from after the encapsulation.
+         * @param[in] payload Pointer to the payload
+         * @param[out] data Pointer to the data
+         * @param[in] size Size of the object in memory
+         * @return True if correct. False if the sample was serialized with another endianness, so it has to be
+         * deserialized field by field.
+         */
+        static bool deserialize_plain(rtps::SerializedPayload_t* payload, void* data, uint32_t size)
+        {
+            if(!is_plain_payload(payload, size))
+            {
+                return false;
+            }
+            payload->encapsulation = plain_encapsulation();
+            memcpy(data, payload->data + 4, size);
+            return true;
+        }
+
+        /**
+         * Get the sample of a plain type held in a payload, without copying it.
+         * It is used with the payloads of lent changes, as the ones of Publisher::loan_sample and
+         * Subscriber::takeNextLoan.
+         * @param payload Pointer to the payload
+         * @return Pointer to the sample, or nullptr if it was serialized with another endianness or it is not aligned
+         * for T in the payload.
+         */
+        template<typename T>
+        static T* plain_sample(rtps::SerializedPayload_t* payload)
+        {
+            return plain_sample_at<T>(payload);
+        }
+
+        template<typename T>
+        static const T* plain_sample(const rtps::SerializedPayload_t* payload)
+        {
+            return plain_sample_at<const T>(payload);
+        }
+
+        /**
+         * Write the encapsulation of a plain sample, in the endianness of the host.
+         * @param[out] payload Pointer to the payload
+         */
+        static void write_plain_encapsulation(rtps::SerializedPayload_t* payload)
+        {
+            payload->encapsulation = plain_encapsulation();
+            payload->data[0] = 0;
+            payload->data[1] = static_cast<rtps::octet>(payload->encapsulation);
+            payload->data[2] = 0;
+            payload->data[3] = 0;
+        }
+
         /**
          * Set topic data type name
          * @param nam Topic data type name
@@ -99,6 +187,29 @@ class  TopicDataType {
         //! Indicates whether the method to obtain the key has been implemented.
         bool m_isGetKeyDefined;
     private:
+
+        static uint16_t plain_encapsulation()
+        {
+            return rtps::DEFAULT_ENDIAN == rtps::LITTLEEND ? CDR_LE : CDR_BE;
+        }
+
+        static bool is_plain_payload(const rtps::SerializedPayload_t* payload, size_t size)
+        {
+            return payload->length >= size + 4 && payload->data[0] == 0 &&
+                payload->data[1] == static_cast<rtps::octet>(plain_encapsulation());
+        }
+
+        template<typename T, typename Payload>
+        static T* plain_sample_at(Payload* payload)
+        {
+            if(!is_plain_payload(payload, sizeof(T)) ||
+                    reinterpret_cast<uintptr_t>(payload->data + 4) % alignof(T) != 0)
+            {
+                return nullptr;
+            }
+            return reinterpret_cast<T*>(payload->data + 4);
+        }
+
         //! Data Type Name.
         std::string m_topicDataTypeName;
 
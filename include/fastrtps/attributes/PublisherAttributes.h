@@ -28,6 +28,9 @@
 #include "TopicAttributes.h"
 #include "../qos/WriterQos.h"
 #include "../rtps/attributes/PropertyPolicy.h"
+#include "../rtps/history/PayloadArena.h"
+
+#include <memory>
 
 
 
@@ -60,6 +63,7 @@ public:
                (this->multicastLocatorList == b.multicastLocatorList) &&
                (this->remoteLocatorList == b.remoteLocatorList) &&
                (this->historyMemoryPolicy == b.historyMemoryPolicy) &&
+               (this->historyPayloadArena == b.historyPayloadArena) &&
                (this->properties == b.properties);
     }
 
@@ -79,6 +83,8 @@ public:
     rtps::ThroughputControllerDescriptor throughputController;
     //!Underlying History memory policy
     rtps::MemoryManagementPolicy_t historyMemoryPolicy;
+    //!Arena of the payloads of the underlying History in DYNAMIC_RESERVE_MEMORY_MODE. If not set, the History creates its own.
+    std::shared_ptr<rtps::PayloadArena> historyPayloadArena;
     rtps::PropertyPolicy properties;
 
     /**
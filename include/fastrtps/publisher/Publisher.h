@@ -33,6 +33,7 @@ namespace rtps
 {
 struct GUID_t;
 class WriteParams;
+struct CacheChange_t;
 }
 
 
@@ -71,6 +72,41 @@ class RTPS_DllAPI Publisher
      */
     bool write(void*Data, rtps::WriteParams &wparams);
 
+    /**
+     * Reserve a sample in the history of the Publisher and lend its change, so the application serializes the
+     * sample directly into its payload, without an intermediate copy.
+     * The payload has room for the maximum serialized size of the type, which must be bounded. The application
+     * has to write the serialized sample, including its encapsulation, and set its length.
+     * For plain types the encapsulation and the length are already set, and the object is written in place
+     * through TopicDataType::plain_sample.
+     * For keyed topics, setting the instance handle of the change saves reading the key back from the sample
+     * when it is written.
+     * @return Pointer to the change, or nullptr if no sample could be reserved.
+     */
+    rtps::CacheChange_t* loan_sample();
+
+    /**
+     * Write a sample lent by loan_sample. The change must not be used afterwards.
+     * @param change Pointer to the change.
+     * @return True if correct
+     */
+    bool write_loaned(rtps::CacheChange_t* change);
+
+    /**
+     * Write a sample lent by loan_sample with params. The change must not be used afterwards.
+     * @param change Pointer to the change.
+     * @param wparams Extra write parameters.
+     * @return True if correct
+     */
+    bool write_loaned(rtps::CacheChange_t* change, rtps::WriteParams &wparams);
+
+    /**
+     * Give back a sample lent by loan_sample without writing it.
+     * @param change Pointer to the change.
+     * @return True if the change was lent by this Publisher.
+     */
+    bool discard_loan(rtps::CacheChange_t* change);
+
     /**
      * Dispose of a previously written data.
      * @param Data Pointer to the data.
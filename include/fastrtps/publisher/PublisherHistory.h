@@ -24,8 +24,11 @@
 #include <fastrtps/rtps/resources/ResourceManagement.h>
 
 #include "../rtps/history/WriterHistory.h"
+#include "../rtps/history/InstanceChanges.h"
 #include "../qos/QosPolicies.h"
 
+#include <unordered_map>
+
 
 
 namespace eprosima {
@@ -41,8 +44,8 @@ class PublisherImpl;
 class PublisherHistory:public rtps::WriterHistory
 {
     public:
-        typedef std::pair<rtps::InstanceHandle_t,std::vector<rtps::CacheChange_t*>> t_p_I_Change;
-        typedef std::vector<t_p_I_Change> t_v_Inst_Caches;
+        typedef std::unordered_map<rtps::InstanceHandle_t, rtps::InstanceChanges, rtps::InstanceHandleHash>
+            t_m_Inst_Caches;
         /**
          * Constructor of the PublisherHistory.
          * @param pimpl Pointer to the PublisherImpl.
@@ -50,9 +53,11 @@ class PublisherHistory:public rtps::WriterHistory
          * @param mempolicy Set wether the payloads ccan dynamically resized or not.
          * @param history QOS of the associated History.
          * @param resource ResourceLimits for the History.
+         * @param arena Arena of the payloads in DYNAMIC_RESERVE_MEMORY_MODE. If nullptr, the History creates its own.
          */
         PublisherHistory(PublisherImpl* pimpl,uint32_t payloadMax,
-                HistoryQosPolicy& history,ResourceLimitsQosPolicy& resource, rtps::MemoryManagementPolicy_t mempolicy);
+                HistoryQosPolicy& history,ResourceLimitsQosPolicy& resource, rtps::MemoryManagementPolicy_t mempolicy,
+                std::shared_ptr<rtps::PayloadArena> arena = nullptr);
 
         virtual ~PublisherHistory();
 
@@ -82,16 +87,16 @@ class PublisherHistory:public rtps::WriterHistory
         /**
          * Remove a change by the publisher History.
          * @param change Pointer to the CacheChange_t.
-         * @param vit Pointer to the iterator of the Keyed history vector.
+         * @param vit Pointer to the iterator of the instance of the change.
          * @return True if removed.
          */
-        bool remove_change_pub(rtps::CacheChange_t* change,t_v_Inst_Caches::iterator* vit=nullptr);
+        bool remove_change_pub(rtps::CacheChange_t* change,t_m_Inst_Caches::iterator* vit=nullptr);
 
         virtual bool remove_change_g(rtps::CacheChange_t* a_change);
 
     private:
-        //!Vector of pointer to the CacheChange_t divided by key.
-        t_v_Inst_Caches m_keyedChanges;
+        //!Changes of each instance, indexed by instance handle.
+        t_m_Inst_Caches m_keyedChanges;
         //!HistoryQosPolicy values.
         HistoryQosPolicy m_historyQos;
         //!ResourceLimitsQosPolicy values.
@@ -99,7 +104,13 @@ class PublisherHistory:public rtps::WriterHistory
         //!Publisher Pointer
         PublisherImpl* mp_pubImpl;
 
-        bool find_Key(rtps::CacheChange_t* a_change,t_v_Inst_Caches::iterator* vecPairIterrator);
+        /**
+         * Finds the instance of a change, creating it if the limit of instances is not reached.
+         * @param a_change Pointer to the change.
+         * @param vit_out Returned iterator to the instance.
+         * @return True if the instance exists or was created.
+         */
+        bool find_Key(rtps::CacheChange_t* a_change,t_m_Inst_Caches::iterator* vit_out);
 };
 
 } /* namespace fastrtps */
@@ -22,10 +22,13 @@
 #define RTPSRTPSParticipant_H_
 
 #include "common/Types.h"
+#include "common/Guid.h"
 
 #include "attributes/RTPSParticipantAttributes.h"
 
 #include <atomic>
+#include <condition_variable>
+#include <map>
 #include <mutex>
 #include <set>
 
@@ -147,6 +150,59 @@ class RTPSDomain
 
     static void removeRTPSParticipant_nts(std::vector<t_p_RTPSParticipant>::iterator it);
 
+    /**
+     * Entry of the table of readers that can receive changes directly from writers of this process.
+     */
+    struct LocalReaderEntry
+    {
+        //! Registered reader.
+        RTPSReader* reader;
+        //! Number of writers currently delivering to the reader.
+        uint32_t users;
+    };
+
+    static std::mutex m_local_readers_mutex;
+
+    static std::condition_variable m_local_readers_cv;
+
+    static std::map<GUID_t, LocalReaderEntry> m_local_readers;
+
+    /**
+     * Makes a reader reachable for intraprocess delivery.
+     * @param reader Pointer to the reader.
+     */
+    static void register_local_reader(RTPSReader* reader);
+
+    /**
+     * Makes a reader unreachable for intraprocess delivery.
+     * Blocks until no writer is delivering to it, so the reader can be safely destroyed afterwards. Deliveries made
+     * by the calling thread, which may be running a listener of the reader, are not waited for.
+     * @param reader_guid GUID of the reader.
+     */
+    static void unregister_local_reader(const GUID_t& reader_guid);
+
+    /**
+     * Checks whether a reader is registered for intraprocess delivery.
+     * @param reader_guid GUID of the reader.
+     * @return True if the reader lives in this process and accepts intraprocess delivery.
+     */
+    static bool is_local_reader(const GUID_t& reader_guid);
+
+    /**
+     * Gets a registered reader, preventing its destruction until release_local_reader is called.
+     * @param reader_guid GUID of the reader.
+     * @return Pointer to the reader, or nullptr if it is not registered.
+     */
+    static RTPSReader* acquire_local_reader(const GUID_t& reader_guid);
+
+    /**
+     * Releases a reader obtained with acquire_local_reader.
+     * @param reader_guid GUID of the reader.
+     */
+    static void release_local_reader(const GUID_t& reader_guid);
+
+    friend class RTPSParticipantImpl;
+    friend class RTPSWriter;
 };
 
 
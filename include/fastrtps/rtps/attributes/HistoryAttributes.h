@@ -24,11 +24,14 @@
 #include "../../fastrtps_dll.h"
 
 #include <cstdint>
+#include <memory>
 
 namespace eprosima{
 namespace fastrtps{
 namespace rtps{
 
+class PayloadArena;
+
 /**
  * Class HistoryAttributes, to specify the attributes of a WriterHistory or a ReaderHistory.
  * This class is only intended to be used with the RTPS API.
@@ -52,10 +55,12 @@ class RTPS_DllAPI HistoryAttributes
          * @param initial Initial reserved caches. It is used when memory management policy is
          * PREALLOCATED_MEMORY_MODE or PREALLOCATED_WITH_REALLOC_MEMORY_MODE.
          * @param maxRes Maximum reserved caches.
+         * @param arena Arena payloads are allocated from when memory management policy is DYNAMIC_RESERVE_MEMORY_MODE.
          */
-        HistoryAttributes(MemoryManagementPolicy_t memoryPolicy, uint32_t payload, int32_t initial, int32_t maxRes):
+        HistoryAttributes(MemoryManagementPolicy_t memoryPolicy, uint32_t payload, int32_t initial, int32_t maxRes,
+                std::shared_ptr<PayloadArena> arena = nullptr):
             memoryPolicy(memoryPolicy), payloadMaxSize(payload),initialReservedCaches(initial),
-            maximumReservedCaches(maxRes){}
+            maximumReservedCaches(maxRes), payloadArena(arena){}
 
         virtual ~HistoryAttributes(){}
 
@@ -70,6 +75,13 @@ class RTPS_DllAPI HistoryAttributes
 
         //!Maximum number of reserved caches. Default value is 0 that indicates to keep reserving until something breaks.
         int32_t maximumReservedCaches;
+
+        /**
+         * Arena payloads are allocated from when memory management policy is DYNAMIC_RESERVE_MEMORY_MODE.
+         * It may be shared by several histories, to bound the memory they take together. Default value is nullptr,
+         * that indicates the history to use an arena of its own without limit.
+         */
+        std::shared_ptr<PayloadArena> payloadArena;
 };
 
 }
@@ -192,6 +192,7 @@ class RTPSParticipantAttributes
             listenSocketBufferSize = 0;
             participantID = -1;
             useBuiltinTransports = true;
+            intraprocess_delivery = false;
         }
 
         virtual ~RTPSParticipantAttributes() {}
@@ -209,6 +210,7 @@ class RTPSParticipantAttributes
                    (this->participantID == b.participantID) &&
                    (this->throughputController == b.throughputController) &&
                    (this->useBuiltinTransports == b.useBuiltinTransports) &&
+                   (this->intraprocess_delivery == b.intraprocess_delivery) &&
                    (this->properties == b.properties);
         }
 
@@ -254,6 +256,13 @@ class RTPSParticipantAttributes
         //!Set as false to disable the default UDPv4 implementation.
         bool useBuiltinTransports;
 
+        /*!
+         * @brief Hand changes directly to matched readers living in the same process, bypassing serialization
+         * into transport buffers and the network stack. Both participants must enable it.
+         * Default value: false.
+         */
+        bool intraprocess_delivery;
+
         //! Property policies
         PropertyPolicy properties;
 
@@ -34,6 +34,8 @@ namespace eprosima
     {
         namespace rtps
         {
+            class CacheChangePool;
+
             /**
              * @enum ChangeKind_t, different types of CacheChange_t.
              * @ingroup COMMON_MODULE
@@ -88,7 +90,10 @@ namespace eprosima
                     isRead(false),
                     is_untyped_(true),
                     dataFragments_(new std::vector<uint32_t>()),
-                    fragment_size_(0)
+                    fragment_size_(0),
+                    pool_index_(UINT32_MAX),
+                    loan_count_(0),
+                    removed_while_lent_(false)
                 {
                 }
 
@@ -106,7 +111,10 @@ namespace eprosima
                     isRead(false),
                     is_untyped_(is_untyped),
                     dataFragments_(new std::vector<uint32_t>()),
-                    fragment_size_(0)
+                    fragment_size_(0),
+                    pool_index_(UINT32_MAX),
+                    loan_count_(0),
+                    removed_while_lent_(false)
                 {
                 }
 
@@ -134,6 +142,19 @@ namespace eprosima
                     return ret;
                 }
 
+                /*!
+                 * Copy a different change into this one. When its payload is loaned from a receive buffer, the buffer may
+                 * be shared instead of copying the data. It is kept until the change is released back to its pool.
+                 * @param[in] ch_ptr Pointer to the change.
+                 * @return True if correct.
+                 */
+                bool copy_or_loan(const CacheChange_t* ch_ptr)
+                {
+                    bool ret = serializedPayload.copy_or_loan(&ch_ptr->serializedPayload, (ch_ptr->is_untyped_ ? false : true));
+                    copy_not_memcpy(ch_ptr);
+                    return ret;
+                }
+
                 void copy_not_memcpy(const CacheChange_t* ch_ptr)
                 {
                     kind = ch_ptr->kind;
@@ -186,11 +207,24 @@ namespace eprosima
 
                 private:
 
+                friend class CacheChangePool;
+                friend class ReaderHistory;
+                friend class WriterHistory;
+
                 // Data fragments
                 std::vector<uint32_t>* dataFragments_;
 
                 // Fragment size
                 uint16_t fragment_size_;
+
+                // Slot of the change in the pool it was reserved from
+                uint32_t pool_index_;
+
+                // Loans of the change not returned yet, which keep it out of the pool
+                uint32_t loan_count_;
+
+                // Whether the change was removed from its history while lent
+                bool removed_while_lent_;
             };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
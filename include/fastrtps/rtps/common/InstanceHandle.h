@@ -22,6 +22,8 @@
 #include "Types.h"
 #include "Guid.h"
 
+#include <cstring>
+
 namespace eprosima{
 namespace fastrtps{
 namespace rtps{
@@ -153,6 +155,31 @@ inline bool operator<(const InstanceHandle_t& h1, const InstanceHandle_t& h2)
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 
+/**
+ * Hash of an InstanceHandle_t, to index instances in unordered containers.
+ * Handles are either the MD5 of the key or the key itself padded with zeros, so all the bytes are mixed.
+ */
+struct InstanceHandleHash
+{
+    std::size_t operator()(const InstanceHandle_t& ihandle) const
+    {
+        uint64_t low;
+        uint64_t high;
+        memcpy(&low, ihandle.value, sizeof(low));
+        memcpy(&high, ihandle.value + sizeof(low), sizeof(high));
+
+        uint64_t hash = low ^ (high * 0x9E3779B97F4A7C15ull);
+        hash ^= hash >> 32;
+        hash *= 0xD6E8FEB86659FD93ull;
+        hash ^= hash >> 32;
+        return static_cast<std::size_t>(hash);
+    }
+};
+
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
 /**
 * 
 * @param output 
@@ -40,6 +40,7 @@ namespace rtps {
 #define LOCATOR_KIND_UDPv6 2
 #define LOCATOR_KIND_TCPv4 4
 #define LOCATOR_KIND_TCPv6 8
+#define LOCATOR_KIND_SHM 16
 
 //!@brief Class Locator_t, uniquely identifies a communication channel for a particular transport.
 //For example, an address+port combination in the case of UDP.
@@ -54,6 +55,7 @@ public:
         * LOCATOR_KIND_UDPv6
         * LOCATOR_KIND_TCPv4
         * LOCATOR_KIND_TCPv6
+        * LOCATOR_KIND_SHM
         */
     int32_t kind;
     uint32_t port;
@@ -136,7 +138,7 @@ inline bool IsAddressDefined(const Locator_t& loc)
                 return true;
         }
     }
-    else if (loc.kind == LOCATOR_KIND_UDPv6 || loc.kind == LOCATOR_KIND_TCPv6)
+    else if (loc.kind == LOCATOR_KIND_UDPv6 || loc.kind == LOCATOR_KIND_TCPv6 || loc.kind == LOCATOR_KIND_SHM)
     {
         for (uint8_t i = 0; i < 16; ++i)
         {
@@ -188,6 +190,15 @@ inline std::ostream& operator<<(std::ostream& output, const Locator_t& loc)
         }
         output << ":" << loc.port;
     }
+    else if (loc.kind == LOCATOR_KIND_SHM)
+    {
+        output << "SHM:" << std::hex << std::setfill('0');
+        for (uint8_t i = 0; i < 16; ++i)
+        {
+            output << std::setw(2) << (int)loc.address[i];
+        }
+        output << std::dec << std::setfill(' ') << ":" << loc.port;
+    }
     return output;
 }
 
@@ -0,0 +1,60 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file NetworkBuffer.h
+ */
+
+#ifndef NETWORKBUFFER_H_
+#define NETWORKBUFFER_H_
+
+#include "Types.h"
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+/**
+ * Maximum number of segments a message is split into when handed to a transport.
+ * Transports may prepend framing segments of their own, so this is kept below the usual gather limits.
+ * @ingroup COMMON_MODULE
+ */
+static const uint32_t s_maximumNetworkBuffers = 32;
+
+/**
+ * Struct NetworkBuffer, a non-owning slice of a message to be sent.
+ * A message may be split in several of them, which transports send in order as a single datagram or stream write.
+ * @ingroup COMMON_MODULE
+ */
+struct NetworkBuffer
+{
+    //! Pointer to the first byte of the slice.
+    const octet* buffer;
+    //! Number of bytes in the slice.
+    uint32_t size;
+
+    NetworkBuffer() : buffer(nullptr), size(0)
+    {
+    }
+
+    NetworkBuffer(const octet* ptr, uint32_t length) : buffer(ptr), size(length)
+    {
+    }
+};
+
+}
+}
+}
+
+#endif /* NETWORKBUFFER_H_ */
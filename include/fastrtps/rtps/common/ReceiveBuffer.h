@@ -0,0 +1,242 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ReceiveBuffer.h
+ */
+
+#ifndef RECEIVEBUFFER_H_
+#define RECEIVEBUFFER_H_
+
+#include "Types.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+class ReceiveBufferPool;
+
+/**
+ * Buffer a transport receives messages into, shared through reference counting.
+ * Payloads of the received message may keep a reference to it instead of copying their data, so the
+ * transport takes another buffer for the next message while any reference remains.
+ * @ingroup COMMON_MODULE
+ */
+class ReceiveBuffer
+{
+    friend class ReceiveBufferPool;
+
+public:
+
+    octet* data()
+    {
+        return data_;
+    }
+
+    uint32_t max_size() const
+    {
+        return max_size_;
+    }
+
+    //! Whether the given range lies inside the buffer.
+    bool contains(const octet* ptr, uint32_t length) const
+    {
+        return ptr >= data_ && ptr + length <= data_ + max_size_;
+    }
+
+    //! Whether the caller holds the only reference.
+    bool unique() const
+    {
+        return references_.load(std::memory_order_acquire) == 1;
+    }
+
+    /**
+     * Whether a payload may keep a reference to the buffer instead of copying its data.
+     * False once the buffers of the pool in use exceed its loan budget.
+     */
+    inline bool can_loan() const;
+
+    //! Adds a reference.
+    void acquire()
+    {
+        references_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    //! Removes a reference. The buffer goes back to its pool when the last one is removed.
+    inline void release();
+
+private:
+
+    explicit ReceiveBuffer(uint32_t max_size)
+        : data_(static_cast<octet*>(malloc(max_size)))
+        , max_size_(max_size)
+        , references_(0)
+    {
+        if (data_ == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+    }
+
+    ~ReceiveBuffer()
+    {
+        free(data_);
+    }
+
+    ReceiveBuffer(const ReceiveBuffer&) = delete;
+    ReceiveBuffer& operator=(const ReceiveBuffer&) = delete;
+
+    octet* data_;
+
+    uint32_t max_size_;
+
+    std::atomic<uint32_t> references_;
+
+    //! Pool the buffer returns to. Only set while the buffer is in use, so the pool outlives its channel.
+    std::shared_ptr<ReceiveBufferPool> pool_;
+};
+
+/**
+ * Pool of receive buffers of the same size. Buffers are allocated when none is free, and kept for reuse
+ * when released, so the pool grows up to the number of buffers referenced at the same time.
+ * As each loaned payload keeps a whole buffer alive, loans are refused once the buffers in use take more
+ * memory than the loan budget, and payloads are copied instead. This bounds the pool to the budget plus the
+ * buffers the transport is receiving into.
+ * It must be owned by a shared_ptr, as buffers in use keep it alive.
+ * @ingroup COMMON_MODULE
+ */
+class ReceiveBufferPool : public std::enable_shared_from_this<ReceiveBufferPool>
+{
+    friend class ReceiveBuffer;
+
+public:
+
+    //! Memory the buffers in use may take before loans are refused, unless otherwise given.
+    static const size_t default_loan_budget = 8 * 1024 * 1024;
+
+    /**
+     * @param buffer_size Size of each buffer.
+     * @param loan_budget Memory the buffers in use may take before loans are refused. At least one buffer may
+     * always be loaned.
+     */
+    explicit ReceiveBufferPool(uint32_t buffer_size, size_t loan_budget = default_loan_budget)
+        : buffer_size_(buffer_size)
+        , max_loaned_buffers_(buffer_size == 0 ? 1 : std::max<size_t>(loan_budget / buffer_size, 1))
+        , buffers_in_use_(0)
+    {
+    }
+
+    ~ReceiveBufferPool()
+    {
+        for (ReceiveBuffer* buffer : free_buffers_)
+        {
+            delete buffer;
+        }
+    }
+
+    uint32_t buffer_size() const
+    {
+        return buffer_size_;
+    }
+
+    /**
+     * Takes a buffer from the pool.
+     * @return Buffer of which the caller holds the only reference.
+     */
+    ReceiveBuffer* acquire()
+    {
+        ReceiveBuffer* buffer = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!free_buffers_.empty())
+            {
+                buffer = free_buffers_.back();
+                free_buffers_.pop_back();
+            }
+        }
+
+        if (buffer == nullptr)
+        {
+            buffer = new ReceiveBuffer(buffer_size_);
+        }
+
+        buffers_in_use_.fetch_add(1, std::memory_order_relaxed);
+        buffer->pool_ = shared_from_this();
+        buffer->references_.store(1, std::memory_order_relaxed);
+        return buffer;
+    }
+
+    //! Number of buffers taken and not released yet.
+    size_t buffers_in_use() const
+    {
+        return buffers_in_use_.load(std::memory_order_relaxed);
+    }
+
+private:
+
+    ReceiveBufferPool(const ReceiveBufferPool&) = delete;
+    ReceiveBufferPool& operator=(const ReceiveBufferPool&) = delete;
+
+    void give_back(ReceiveBuffer* buffer)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_buffers_.push_back(buffer);
+        buffers_in_use_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    bool can_loan() const
+    {
+        return buffers_in_use_.load(std::memory_order_relaxed) <= max_loaned_buffers_;
+    }
+
+    uint32_t buffer_size_;
+
+    //! Buffers in use above which loans are refused. Checked without a lock, so concurrent loans may exceed it.
+    size_t max_loaned_buffers_;
+
+    std::atomic<size_t> buffers_in_use_;
+
+    std::mutex mutex_;
+
+    std::vector<ReceiveBuffer*> free_buffers_;
+};
+
+inline bool ReceiveBuffer::can_loan() const
+{
+    return pool_ == nullptr || pool_->can_loan();
+}
+
+inline void ReceiveBuffer::release()
+{
+    if (references_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        // Moved out first, as the pool may be destroyed along with the last buffer in use.
+        std::shared_ptr<ReceiveBufferPool> pool = std::move(pool_);
+        pool->give_back(this);
+    }
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif /* RECEIVEBUFFER_H_ */
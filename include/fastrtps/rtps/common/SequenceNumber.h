@@ -20,7 +20,9 @@
 #define RPTS_ELEM_SEQNUM_H_
 #include "../../fastrtps_dll.h"
 #include "Types.h"
+#include "../../utils/BitmapWord.h"
 
+#include <iterator>
 #include <vector>
 #include <algorithm>
 #include <sstream>
@@ -353,22 +355,78 @@ struct SequenceNumberHash
 #endif
 
 //!Structure SequenceNumberSet_t, contains a group of sequencenumbers.
+//!Sequence numbers are kept as a bitmap relative to the base, as in the wire representation, so the base has to be
+//!set before adding any of them.
 //!@ingroup COMMON_MODULE
 class SequenceNumberSet_t
 {
     public:
-        //!Base sequence number
-        SequenceNumber_t base;
+
+        //!Maximum number of sequence numbers after the base the set can hold.
+        static const uint32_t c_max_bits = 256;
+
+        //!Number of 32 bit words of the bitmap.
+        static const uint32_t c_words = c_max_bits / 32;
 
         /**
-         * Assignment operator
-         * @param set2 SequenceNumberSet_t to copy the data from
+         * Iterator over the sequence numbers in the set, in increasing order.
          */
-        SequenceNumberSet_t& operator=(const SequenceNumberSet_t& set2)
+        class const_iterator
+        {
+            public:
+
+                typedef std::input_iterator_tag iterator_category;
+                typedef SequenceNumber_t value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef const SequenceNumber_t* pointer;
+                typedef SequenceNumber_t reference;
+
+                const_iterator(const SequenceNumberSet_t* set, uint32_t offset)
+                    : set_(set), offset_(offset)
+                {
+                }
+
+                SequenceNumber_t operator*() const
+                {
+                    return set_->base + offset_;
+                }
+
+                const_iterator& operator++()
+                {
+                    offset_ = set_->next_offset(offset_ + 1);
+                    return *this;
+                }
+
+                const_iterator operator++(int)
+                {
+                    const_iterator result(*this);
+                    ++(*this);
+                    return result;
+                }
+
+                bool operator==(const const_iterator& other) const
+                {
+                    return offset_ == other.offset_;
+                }
+
+                bool operator!=(const const_iterator& other) const
+                {
+                    return offset_ != other.offset_;
+                }
+
+            private:
+
+                const SequenceNumberSet_t* set_;
+
+                uint32_t offset_;
+        };
+
+        //!Base sequence number
+        SequenceNumber_t base;
+
+        SequenceNumberSet_t() : num_bits_(0)
         {
-            base = set2.base;
-            set = set2.set;
-            return *this;
+            std::fill(bitmap_, bitmap_ + c_words, 0u);
         }
 
         /**
@@ -378,22 +436,43 @@ class SequenceNumberSet_t
          */
         bool add(const SequenceNumber_t& in)
         {
-            SequenceNumber_t max = base + 255;
-            if(in >= base && in < max)
-                set.push_back(in);
-            else
+            if(in < base)
                 return false;
 
+            SequenceNumber_t delta = in - base;
+            if(delta.high != 0 || delta.low >= c_max_bits)
+                return false;
+
+            bitmap_[delta.low / 32] |= 0x80000000u >> (delta.low % 32);
+            if(delta.low >= num_bits_)
+                num_bits_ = delta.low + 1;
+
             return true;
         }
 
+        /**
+         * Check if a sequence number is in the set
+         * @param in Sequence number to look for
+         * @return True if it is in the set
+         */
+        bool is_set(const SequenceNumber_t& in) const
+        {
+            if(in < base)
+                return false;
+
+            SequenceNumber_t delta = in - base;
+            return delta.high == 0 && delta.low < num_bits_ &&
+                (bitmap_[delta.low / 32] & (0x80000000u >> (delta.low % 32))) != 0;
+        }
+
         /**
          * Get the maximum sequence number in the set
          * @return maximum sequence number in the set
          */
         SequenceNumber_t get_maxSeqNum() const
         {
-            return *std::max_element(set.begin(),set.end(),sort_seqNum);
+            assert(num_bits_ > 0);
+            return base + (num_bits_ - 1);
         }
 
         /**
@@ -402,50 +481,103 @@ class SequenceNumberSet_t
          */
         bool isSetEmpty() const
         {
-            return set.empty();
+            return num_bits_ == 0;
         }
 
         /**
          * Get the begin of the set
-         * @return Vector iterator pointing to the begin of the set
+         * @return Iterator pointing to the lowest sequence number of the set
          */
-        std::vector<SequenceNumber_t>::const_iterator get_begin() const
+        const_iterator get_begin() const
         {
-            return set.begin();
+            return const_iterator(this, next_offset(0));
         }
 
         /**
          * Get the end of the set
-         * @return Vector iterator pointing to the end of the set
+         * @return Iterator pointing past the highest sequence number of the set
          */
-        std::vector<SequenceNumber_t>::const_iterator get_end() const
+        const_iterator get_end() const
         {
-            return set.end();
+            return const_iterator(this, c_max_bits);
         }
 
         /**
          * Get the number of SequenceNumbers in the set
          * @return Size of the set
          */
-        size_t get_size()
+        size_t get_size() const
         {
-            return set.size();
+            size_t size = 0;
+            for(uint32_t word = 0; word < c_words; ++word)
+                size += bitmap_word_count(bitmap_[word]);
+            return size;
         }
 
         /**
-         * Get the set of SequenceNumbers 
+         * Get the set of SequenceNumbers
          * @return Set of SequenceNumbers
          */
         std::vector<SequenceNumber_t> get_set() const
         {
-            return set;
+            return std::vector<SequenceNumber_t>(get_begin(), get_end());
+        }
+
+        /**
+         * Get the number of bits of the bitmap used by the set, as sent on the wire.
+         * @return One more than the offset of the highest sequence number, or zero if the set is empty.
+         */
+        uint32_t get_num_bits() const
+        {
+            return num_bits_;
+        }
+
+        /**
+         * Get the bitmap of the set, with the bit of the base being the most significant one of the first word.
+         * @return Pointer to the c_words words of the bitmap.
+         */
+        const uint32_t* get_bitmap() const
+        {
+            return bitmap_;
+        }
+
+        /**
+         * Replace the sequence numbers of the set with the ones of a bitmap read from the wire.
+         * @param num_bits Number of valid bits in the bitmap.
+         * @param bitmap Pointer to the (num_bits + 31) / 32 words of the bitmap.
+         * @return False if the bitmap is longer than the maximum allowed.
+         */
+        bool set_bitmap(uint32_t num_bits, const uint32_t* bitmap)
+        {
+            if(num_bits > c_max_bits)
+                return false;
+
+            uint32_t n_words = (num_bits + 31) / 32;
+            for(uint32_t word = 0; word < c_words; ++word)
+                bitmap_[word] = word < n_words ? bitmap[word] : 0u;
+
+            // Bits after num_bits are not part of the set.
+            if(num_bits % 32 != 0)
+                bitmap_[n_words - 1] &= ~(0xFFFFFFFFu >> (num_bits % 32));
+
+            num_bits_ = 0;
+            for(uint32_t word = c_words; word > 0; --word)
+            {
+                if(bitmap_[word - 1] != 0)
+                {
+                    uint32_t bits = bitmap_[word - 1];
+                    num_bits_ = 32 * word - bitmap_word_lowest(bits);
+                    break;
+                }
+            }
+            return true;
         }
 
         /**
          * Get a string representation of the set
          * @return string representation of the set
          */
-        std::string print()
+        std::string print() const
         {
             std::stringstream ss;
 
@@ -454,19 +586,36 @@ class SequenceNumberSet_t
 #else
             ss << "{high: " << base.high << ", low: " << base.low << "} :";
 #endif
-            for(std::vector<SequenceNumber_t>::iterator it = set.begin(); it != set.end(); ++it)
+            for(const_iterator it = get_begin(); it != get_end(); ++it)
             {
 #ifdef LLONG_MAX
-                ss << it->to64long() << "-";
+                ss << (*it).to64long() << "-";
 #else
-                ss << "{high: " << it->high << ", low: " << it->low << "} -";
+                ss << "{high: " << (*it).high << ", low: " << (*it).low << "} -";
 #endif
             }
             return ss.str();
         }
 
     private:
-        std::vector<SequenceNumber_t> set;
+
+        //!Offset of the first sequence number in the set from a given one, or c_max_bits if there is none.
+        uint32_t next_offset(uint32_t offset) const
+        {
+            for(uint32_t word = offset / 32; word < c_words && word * 32 < num_bits_; ++word)
+            {
+                uint32_t bits = bitmap_[word];
+                if(word == offset / 32)
+                    bits &= 0xFFFFFFFFu >> (offset % 32);
+                if(bits != 0)
+                    return word * 32 + bitmap_word_leading(bits);
+            }
+            return c_max_bits;
+        }
+
+        uint32_t bitmap_[c_words];
+
+        uint32_t num_bits_;
 };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
@@ -477,7 +626,7 @@ class SequenceNumberSet_t
  * @param sns SequenceNumber set
  * @return OStream.
  */
-inline std::ostream& operator<<(std::ostream& output, SequenceNumberSet_t& sns)
+inline std::ostream& operator<<(std::ostream& output, const SequenceNumberSet_t& sns)
 {
     return output << sns.print();
 }
@@ -20,6 +20,8 @@
 #define SERIALIZEDPAYLOAD_H_
 #include "../../fastrtps_dll.h"
 #include "Types.h"
+#include "ReceiveBuffer.h"
+#include "../history/PayloadArena.h"
 #include <cstring>
 #include <new>
 #include <stdexcept>
@@ -56,11 +58,20 @@ namespace eprosima{
                 uint32_t max_size;
                 //!Position when reading
                 uint32_t pos;
+                //!Receive buffer data points into when the payload is loaned, nullptr when data is owned.
+                ReceiveBuffer* loaned_buffer;
+                //!Owned data, kept aside while the payload is loaned.
+                octet* owned_data;
+                //!Maximum size of the owned data.
+                uint32_t owned_max_size;
+                //!Arena the owned data is allocated from, nullptr when it is allocated from the heap.
+                PayloadArena* arena;
 
                 //!Default constructor
                 SerializedPayload_t() : encapsulation(CDR_BE),
                 length(0), data(nullptr), max_size(0),
-                pos(0)
+                pos(0), loaned_buffer(nullptr), owned_data(nullptr),
+                owned_max_size(0), arena(nullptr)
                 {
                 }
 
@@ -86,6 +97,7 @@ namespace eprosima{
                  */
                 bool copy(const SerializedPayload_t* serData, bool with_limit = true)
                 {
+                    return_loan();
                     length = serData->length;
 
                     if(serData->length > max_size)
@@ -100,6 +112,65 @@ namespace eprosima{
                     return true;
                 }
 
+                /*!
+                 * Share the data of a payload loaned from a receive buffer instead of copying it.
+                 * Payloads taking less than a quarter of the buffer are copied, so they do not keep big buffers alive.
+                 * So are all payloads while the pool of the buffer is over its loan budget.
+                 * @param[in] serData Pointer to the structure to copy
+                 * @param with_limit if true, the function will fail when providing a payload too big
+                 * @return True if correct
+                 */
+                bool copy_or_loan(const SerializedPayload_t* serData, bool with_limit = true)
+                {
+                    ReceiveBuffer* buffer = serData->loaned_buffer;
+                    if(buffer == nullptr || serData->length < buffer->max_size() / 4 || !buffer->can_loan())
+                        return copy(serData, with_limit);
+
+                    return_loan();
+                    if(with_limit && serData->length > max_size)
+                    {
+                        length = serData->length;
+                        return false;
+                    }
+                    loan(buffer, serData->data, serData->length);
+                    encapsulation = serData->encapsulation;
+                    return true;
+                }
+
+                /*!
+                 * Point the payload to data inside a receive buffer, taking a reference to it.
+                 * The owned data is kept aside until the loan is returned.
+                 * @param buffer Receive buffer holding the data.
+                 * @param buffer_data Pointer to the first byte of the payload, inside the buffer.
+                 * @param buffer_length Length of the payload.
+                 */
+                void loan(ReceiveBuffer* buffer, octet* buffer_data, uint32_t buffer_length)
+                {
+                    return_loan();
+                    buffer->acquire();
+                    loaned_buffer = buffer;
+                    owned_data = data;
+                    owned_max_size = max_size;
+                    data = buffer_data;
+                    length = buffer_length;
+                    max_size = buffer_length;
+                }
+
+                //! Release the receive buffer the payload is loaned from, if any, and restore the owned data.
+                void return_loan()
+                {
+                    if(loaned_buffer != nullptr)
+                    {
+                        loaned_buffer->release();
+                        loaned_buffer = nullptr;
+                        data = owned_data;
+                        max_size = owned_max_size;
+                        length = 0;
+                        owned_data = nullptr;
+                        owned_max_size = 0;
+                    }
+                }
+
 
                 /*!
                  * Allocate new space for fragmented data
@@ -108,30 +179,49 @@ namespace eprosima{
                  */
                 bool reserve_fragmented(SerializedPayload_t* serData)
                 {
+                    this->reserve(serData->length);
                     length = serData->length;
-                    max_size = serData->length;
                     encapsulation = serData->encapsulation;
-                    data = (octet*)calloc(length, sizeof(octet));
                     return true;
                 }
 
                 //! Empty the payload
                 void empty()
                 {
+                    return_loan();
                     length= 0;
                     encapsulation = CDR_BE;
                     max_size = 0;
-                    if(data!=nullptr)
+                    if(arena != nullptr)
+                        arena->deallocate(data);
+                    else if(data!=nullptr)
                         free(data);
                     data = nullptr;
                 }
 
                 void reserve(uint32_t new_size)
                 {
+                    return_loan();
                     if (new_size <= this->max_size) {
                         return;
                     }
-                    if(data == nullptr)
+                    if(arena != nullptr)
+                    {
+                        uint32_t capacity = 0;
+                        octet* new_data = arena->allocate(new_size, capacity);
+                        if (!new_data)
+                        {
+                            throw std::bad_alloc();
+                        }
+                        if(data != nullptr)
+                        {
+                            memcpy(new_data, data, max_size);
+                            arena->deallocate(data);
+                        }
+                        data = new_data;
+                        new_size = capacity;
+                    }
+                    else if(data == nullptr)
                     {
                         data = (octet*)calloc(new_size, sizeof(octet));
                         if (!data)
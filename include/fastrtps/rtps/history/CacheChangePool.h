@@ -23,9 +23,12 @@
 #define CACHECHANGEPOOL_H_
 
 #include "../resources/ResourceManagement.h"
+#include "PayloadArena.h"
 
+#include <atomic>
 #include <vector>
 #include <functional>
+#include <memory>
 #include <cstdint>
 #include <cstddef>
 #include <mutex>
@@ -39,6 +42,8 @@ struct CacheChange_t;
 
 /**
  * Class CacheChangePool, used by the HistoryCache to pre-reserve a number of CacheChange_t to avoid dynamically reserving memory in the middle of execution loops.
+ * Free changes are kept in a lock-free stack, so writers and the receiving threads do not serialize on reserve and release.
+ * Only growing the pool takes a lock.
  * @ingroup COMMON_MODULE
  */
 class CacheChangePool {
@@ -50,8 +55,10 @@ class CacheChangePool {
          * @param payload_size The initial payload size associated with the pool.
          * @param max_pool_size Maximum payload size. If set to 0 the pool will keep reserving until something breaks.
          * @param memoryPolicy Memory management policy.
+         * @param arena Arena payloads are allocated from in DYNAMIC_RESERVE_MEMORY_MODE. If nullptr, the pool creates its own.
          */
-        CacheChangePool(int32_t pool_size, uint32_t payload_size, int32_t max_pool_size, MemoryManagementPolicy_t memoryPolicy);
+        CacheChangePool(int32_t pool_size, uint32_t payload_size, int32_t max_pool_size, MemoryManagementPolicy_t memoryPolicy,
+                std::shared_ptr<PayloadArena> arena = nullptr);
 
         /*!
          * @brief Reserves a CacheChange from the pool.
@@ -74,23 +81,60 @@ class CacheChangePool {
 
         //!Release a Cache back to the pool.
         void release_Cache(CacheChange_t*);
+        //!Check whether a change belongs to this pool.
+        bool is_pool_change(const CacheChange_t* ch);
         //!Get the size of the cache vector; all of them (reserved and not reserved).
-        size_t get_allCachesSize(){return m_allCaches.size();}
+        size_t get_allCachesSize(){return m_pool_size.load(std::memory_order_relaxed);}
         //!Get the number of frre caches.
-        size_t get_freeCachesSize(){return m_freeCaches.size();}
+        size_t get_freeCachesSize(){return m_free_count.load(std::memory_order_relaxed);}
         //!Get the initial payload size associated with the Pool.
         inline uint32_t getInitialPayloadSize(){return m_initial_payload_size;};
+        //!Get the arena payloads are allocated from. Only set in DYNAMIC_RESERVE_MEMORY_MODE.
+        inline PayloadArena* getPayloadArena(){return m_arena.get();}
     private:
+
+        /**
+         * Place of a change in the pool.
+         * In the preallocated modes every slot holds a change, and free changes are linked through their slots.
+         * In DYNAMIC_RESERVE_MEMORY_MODE changes are created on reserve, and only empty slots are linked.
+         */
+        struct Slot
+        {
+            Slot() : change(nullptr), next(0) {}
+
+            CacheChange_t* change;
+            std::atomic<uint32_t> next;
+        };
+
+        //!Slots are allocated in chunks that never move, the k-th of them holding s_firstChunkSize << k slots.
+        static const uint32_t s_firstChunkSize = 16;
+        static const uint32_t s_maxChunks = 26;
+        //!Index ending the stack of free slots.
+        static const uint32_t s_noSlot = UINT32_MAX;
+
+        Slot& getSlot(uint32_t index);
+        //!Pops a slot from the free stack, or returns nullptr if it is empty.
+        Slot* popSlot(uint32_t& index);
+        void pushSlot(uint32_t index);
+        //!Appends slots to the pool, which are not pushed to the free stack. m_growth_mutex must be held.
+        bool addSlots(uint32_t count, uint32_t& first);
+
         uint32_t m_initial_payload_size;
         uint32_t m_payload_size;
-        uint32_t m_pool_size;
+        //!Number of changes of the pool. In DYNAMIC_RESERVE_MEMORY_MODE, number of changes in use.
+        std::atomic<uint32_t> m_pool_size;
         uint32_t m_max_pool_size;
-        std::vector<CacheChange_t*> m_freeCaches;
-        std::vector<CacheChange_t*> m_allCaches;
+        std::atomic<uint32_t> m_free_count;
+        //!Top of the free stack: index of the slot in the low half, and a tag changed on every update in the high half.
+        std::atomic<uint64_t> m_free_head;
+        std::atomic<Slot*> m_chunks[s_maxChunks];
+        std::atomic<uint32_t> m_slot_count;
         bool allocateGroup(uint32_t pool_size);
         CacheChange_t* allocateSingle(uint32_t dataSize);
-        std::mutex mp_mutex;
+        //!Serializes the growth of the pool.
+        std::mutex m_growth_mutex;
         MemoryManagementPolicy_t memoryMode;
+        std::shared_ptr<PayloadArena> m_arena;
 };
 }
 } /* namespace rtps */
@@ -78,7 +78,7 @@ class History
          * Get the History size.
          * @return Size of the history.
          */
-        RTPS_DllAPI size_t getHistorySize(){ return m_changes.size(); }
+        RTPS_DllAPI size_t getHistorySize(){ return m_changes.size() - m_firstChange; }
         /**
          * Remove all changes from the History
          * @return True if everything was correctly removed.
@@ -99,7 +99,7 @@ class History
          * Get the beginning of the changes history iterator.
          * @return Iterator to the beginning of the vector.
          */
-        RTPS_DllAPI std::vector<CacheChange_t*>::iterator changesBegin(){ return m_changes.begin(); }
+        RTPS_DllAPI std::vector<CacheChange_t*>::iterator changesBegin(){ return m_changes.begin() + m_firstChange; }
         /**
          * Get the end of the changes history iterator.
          * @return Iterator to the end of the vector.
@@ -131,11 +131,21 @@ class History
          */
         RTPS_DllAPI inline std::recursive_mutex* getMutex() { assert(mp_mutex != nullptr); return mp_mutex; }
 
-        RTPS_DllAPI bool get_change(const SequenceNumber_t& seq, const GUID_t& guid, CacheChange_t** change);
+        /**
+         * Get a change by its sequence number and writer.
+         * @param seq Sequence number of the change.
+         * @param guid GUID of the writer of the change.
+         * @param change Pointer to pointer to the change found.
+         * @return True if found.
+         */
+        RTPS_DllAPI virtual bool get_change(const SequenceNumber_t& seq, const GUID_t& guid, CacheChange_t** change);
 
     protected:
         //!Vector of pointers to the CacheChange_t.
         std::vector<CacheChange_t*> m_changes;
+        //!Position of the first change in m_changes. The positions before it are unused, so the minimum change
+        //!is removed without moving the others.
+        size_t m_firstChange;
         //!Variable to know if the history is full without needing to block the History mutex.
         bool m_isHistoryFull;
         //!Pointer to and invalid cacheChange used to return the maximum and minimum when no changes are stored in the history.
@@ -148,6 +158,8 @@ class History
         CacheChange_t* mp_maxSeqCacheChange;
         //!Print the seqNum of the changes in the History (for debugging purposes).
         void print_changes_seqNum2();
+        //!Remove a change from m_changes, moving the changes on its shorter side.
+        void erase_change(std::vector<CacheChange_t*>::iterator chit);
         //!Mutex for the History.
         std::recursive_mutex* mp_mutex;
 };
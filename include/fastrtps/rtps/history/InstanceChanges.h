@@ -0,0 +1,212 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file InstanceChanges.h
+ */
+
+#ifndef INSTANCECHANGES_H_
+#define INSTANCECHANGES_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include "../common/CacheChange.h"
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Changes of one instance of a keyed topic, or of one writer, ordered by sequence number.
+ * Changes are kept in a ring, so adding the newest change and removing the oldest one take constant time.
+ * The ring is created with the depth of the history when it is KEEP_LAST, so it never grows, and doubles its
+ * capacity when needed otherwise.
+ */
+class InstanceChanges
+{
+    public:
+
+        /**
+         * @param capacity Number of changes the ring holds before it has to grow.
+         */
+        explicit InstanceChanges(size_t capacity = 0)
+            : m_buffer(capacity, nullptr)
+            , m_first(0)
+            , m_size(0)
+        {
+        }
+
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        //! Change at a position, 0 being the oldest one.
+        CacheChange_t* operator[](size_t index) const
+        {
+            assert(index < m_size);
+            return m_buffer[slot(index)];
+        }
+
+        CacheChange_t* front() const
+        {
+            return (*this)[0];
+        }
+
+        CacheChange_t* back() const
+        {
+            return (*this)[m_size - 1];
+        }
+
+        //! Adds a change newer than all the others.
+        void push_back(CacheChange_t* change)
+        {
+            if(m_size == m_buffer.size())
+            {
+                grow();
+            }
+            m_buffer[slot(m_size)] = change;
+            ++m_size;
+        }
+
+        void pop_front()
+        {
+            assert(m_size > 0);
+            m_buffer[m_first] = nullptr;
+            m_first = slot(1);
+            if(--m_size == 0)
+            {
+                m_first = 0;
+            }
+        }
+
+        /**
+         * Adds a change keeping the order by sequence number. Changes with the same sequence number keep the order
+         * they were added in.
+         * Changes are expected to arrive mostly in order, so the position is looked for from the newest change.
+         * @return Position of the change.
+         */
+        size_t insert_ordered(CacheChange_t* change)
+        {
+            push_back(change);
+            size_t index = m_size - 1;
+            while(index > 0 && change->sequenceNumber < (*this)[index - 1]->sequenceNumber)
+            {
+                m_buffer[slot(index)] = m_buffer[slot(index - 1)];
+                --index;
+            }
+            m_buffer[slot(index)] = change;
+            return index;
+        }
+
+        /**
+         * Position of a change, looked for by its sequence number.
+         * @return Position of the change, or size() if it is not in the ring.
+         */
+        size_t find(const CacheChange_t* change) const
+        {
+            size_t low = 0;
+            size_t high = m_size;
+            while(low < high)
+            {
+                size_t middle = low + (high - low) / 2;
+                if(m_buffer[slot(middle)]->sequenceNumber < change->sequenceNumber)
+                {
+                    low = middle + 1;
+                }
+                else
+                {
+                    high = middle;
+                }
+            }
+
+            for(size_t index = low; index < m_size; ++index)
+            {
+                const CacheChange_t* current = m_buffer[slot(index)];
+                if(current->sequenceNumber != change->sequenceNumber)
+                {
+                    break;
+                }
+                if(current == change || current->writerGUID == change->writerGUID)
+                {
+                    return index;
+                }
+            }
+            return m_size;
+        }
+
+        //! Removes the change at a position, moving the changes on its shorter side.
+        void erase(size_t index)
+        {
+            assert(index < m_size);
+            if(index < m_size / 2)
+            {
+                for(; index > 0; --index)
+                {
+                    m_buffer[slot(index)] = m_buffer[slot(index - 1)];
+                }
+                pop_front();
+            }
+            else
+            {
+                for(; index + 1 < m_size; ++index)
+                {
+                    m_buffer[slot(index)] = m_buffer[slot(index + 1)];
+                }
+                m_buffer[slot(index)] = nullptr;
+                --m_size;
+            }
+        }
+
+    private:
+
+        size_t slot(size_t index) const
+        {
+            size_t position = m_first + index;
+            return position < m_buffer.size() ? position : position - m_buffer.size();
+        }
+
+        void grow()
+        {
+            std::vector<CacheChange_t*> buffer(m_buffer.empty() ? 4 : 2 * m_buffer.size(), nullptr);
+            for(size_t index = 0; index < m_size; ++index)
+            {
+                buffer[index] = m_buffer[slot(index)];
+            }
+            m_buffer.swap(buffer);
+            m_first = 0;
+        }
+
+        std::vector<CacheChange_t*> m_buffer;
+
+        //! Slot of the oldest change.
+        size_t m_first;
+
+        size_t m_size;
+};
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
+
+#endif
+#endif /* INSTANCECHANGES_H_ */
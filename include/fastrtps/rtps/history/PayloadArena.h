@@ -0,0 +1,141 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PayloadArena.h
+ */
+
+#ifndef PAYLOADARENA_H_
+#define PAYLOADARENA_H_
+
+#include "../../fastrtps_dll.h"
+#include "../common/Types.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+/**
+ * Allocator of serialized payloads, used by the histories in DYNAMIC_RESERVE_MEMORY_MODE instead of allocating
+ * and freeing the payload of every sample.
+ * Payload sizes are rounded up to a power of two, and each size class is served from slabs of memory taken from
+ * the operating system, so payloads of similar size reuse the same blocks and the heap does not fragment.
+ * A slab is returned to the operating system as soon as all its blocks are free, except for one idle slab kept
+ * by each class. trim() returns those too.
+ * An arena may be shared by several histories, and be given a budget that its slabs cannot exceed.
+ * Payloads call it through virtual methods, so a History may also be given a different allocator.
+ * @ingroup RTPS_MODULE
+ */
+class RTPS_DllAPI PayloadArena
+{
+public:
+
+    /**
+     * @param max_memory Maximum number of bytes the slabs of the arena may take. 0 means no limit.
+     */
+    explicit PayloadArena(uint64_t max_memory = 0);
+
+    virtual ~PayloadArena();
+
+    /**
+     * Allocates a block for a payload.
+     * @param size Size of the payload.
+     * @param capacity Returned size of the block, which may be bigger than the requested size.
+     * @return Pointer to the block, or nullptr if the budget of the arena would be exceeded.
+     */
+    virtual octet* allocate(uint32_t size, uint32_t& capacity);
+
+    /**
+     * Returns a block to the arena.
+     * @param data Pointer returned by allocate.
+     */
+    virtual void deallocate(octet* data);
+
+    //! Returns the idle slabs to the operating system.
+    void trim();
+
+    //! Bytes taken from the operating system by the slabs of the arena.
+    uint64_t reserved_memory() const
+    {
+        return reserved_memory_.load(std::memory_order_relaxed);
+    }
+
+    //! Maximum bytes the slabs of the arena may take. 0 means no limit.
+    uint64_t max_memory() const
+    {
+        return max_memory_;
+    }
+
+private:
+
+    struct Slab;
+
+    //! Blocks of the same size, and the slabs they come from.
+    struct SizeClass
+    {
+        SizeClass() : block_size(0), slabs(nullptr), last_slab(nullptr), idle_slabs(0) {}
+
+        uint32_t block_size;
+
+        std::mutex mutex;
+
+        //! Slabs with free blocks. Partially used slabs come first, and idle ones last.
+        Slab* slabs;
+
+        Slab* last_slab;
+
+        //! Number of slabs without blocks in use.
+        uint32_t idle_slabs;
+    };
+
+    //! Smallest block size is 1 << s_minSizeShift bytes, and the biggest 1 << s_maxSizeShift.
+    static const uint32_t s_minSizeShift = 6;
+    static const uint32_t s_maxSizeShift = 31;
+    static const uint32_t s_classCount = s_maxSizeShift - s_minSizeShift + 1;
+
+    //! Size of the slabs shared by several blocks. Bigger blocks take a slab each.
+    static const size_t s_slabSize = 64 * 1024;
+
+    PayloadArena(const PayloadArena&) = delete;
+    PayloadArena& operator=(const PayloadArena&) = delete;
+
+    //! Maps a new slab for a class. The mutex of the class must be held.
+    Slab* create_slab(SizeClass& size_class);
+
+    //! Unmaps a slab, which must have no block in use and must not be linked to its class.
+    void destroy_slab(Slab* slab);
+
+    void link_first(SizeClass& size_class, Slab* slab);
+
+    void link_last(SizeClass& size_class, Slab* slab);
+
+    void unlink(SizeClass& size_class, Slab* slab);
+
+    const uint64_t max_memory_;
+
+    std::atomic<uint64_t> reserved_memory_;
+
+    SizeClass classes_[s_classCount];
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif /* PAYLOADARENA_H_ */
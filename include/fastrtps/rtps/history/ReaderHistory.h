@@ -21,9 +21,13 @@
 #define READERHISTORY_H_
 
 #include "History.h"
+#include "InstanceChanges.h"
 #include "../common/CacheChange.h"
 #include <fastrtps/utils/Semaphore.h>
 
+#include <map>
+#include <vector>
+
 namespace eprosima {
 namespace fastrtps{
 namespace rtps {
@@ -55,6 +59,8 @@ public:
 
     /**
      * Add a CacheChange_t to the ReaderHistory.
+     * Changes are kept ordered by sequence number. A change arriving in order is appended, and only one arriving
+     * out of order is inserted in its place.
      * @param a_change Pointer to the CacheChange to add.
      * @return True if added.
      */
@@ -75,6 +81,7 @@ public:
     RTPS_DllAPI bool remove_changes_with_guid(const GUID_t& a_guid);
     /**
      * Sort the CacheChange_t from the History.
+     * Changes are kept sorted when added, so it is only needed if the changes were modified from outside.
      */
     RTPS_DllAPI void sortCacheChanges();
     /**
@@ -90,11 +97,61 @@ public:
 
     RTPS_DllAPI bool get_min_change_from(CacheChange_t** min_change, const GUID_t& writerGuid);
 
+    /**
+     * Get the oldest change from a writer that has not been read.
+     * The position of the first change not read of each writer is kept, so the changes already read are not
+     * visited again.
+     * @param unread_change Pointer to pointer to the change found.
+     * @param writerGuid GUID of the writer.
+     * @return True if found.
+     */
+    RTPS_DllAPI bool get_first_unread_from(CacheChange_t** unread_change, const GUID_t& writerGuid);
+
+    /**
+     * Get the change with the minimum sequence number among the oldest changes of each writer that have not been
+     * read.
+     * @param unread_change Pointer to pointer to the change found.
+     * @return True if found.
+     */
+    RTPS_DllAPI bool get_first_unread(CacheChange_t** unread_change);
+
+    /**
+     * Lend a change to the user without copying its payload.
+     * The change is not returned to the pool until the loan is returned, even if it is removed from the History
+     * meanwhile.
+     * @param a_change Pointer to the change.
+     * @return Pointer to the lent change.
+     */
+    RTPS_DllAPI const CacheChange_t* loan_change(CacheChange_t* a_change);
+
+    /**
+     * Return a change lent by loan_change. When the last loan of a change already removed from the History is
+     * returned, the change goes back to the pool.
+     * @param a_change Pointer to the change.
+     * @return True if the change was lent.
+     */
+    RTPS_DllAPI bool return_loan(const CacheChange_t* a_change);
+
 protected:
+
+    //!Changes of a writer, and the position of the first one that has not been read.
+    struct WriterChanges
+    {
+        WriterChanges() : first_unread(0) {}
+
+        InstanceChanges changes;
+
+        //!All the changes before this position have been read.
+        size_t first_unread;
+    };
+
     //!Pointer to the reader
     RTPSReader* mp_reader;
     //!Pointer to the semaphore, used to halt execution until new message arrives.
     Semaphore* mp_semaphore;
+    //!Changes of each writer with changes in the history, ordered by sequence number.
+    std::map<GUID_t, WriterChanges> m_changesByWriter;
+
 };
 
 }
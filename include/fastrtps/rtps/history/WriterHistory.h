@@ -30,7 +30,9 @@ class RTPSWriter;
 class WriteParams;
 
 /**
- * Class WriterHistory, container of the different CacheChanges of a writer
+ * Class WriterHistory, container of the different CacheChanges of a writer.
+ * Changes are kept in increasing sequence number order, so they are found by their position instead of searched for,
+ * and the minimum one is removed without moving the others.
  * @ingroup WRITER_MODULE
  */
 class WriterHistory : public History
@@ -87,7 +89,30 @@ class WriterHistory : public History
 
     RTPS_DllAPI SequenceNumber_t next_sequence_number() const { return m_lastCacheChangeSeqNum + 1; }
 
+    RTPS_DllAPI bool get_change(const SequenceNumber_t& seq, const GUID_t& guid, CacheChange_t** change) override;
+
+    /**
+     * Lend a change of this History: one reserved to the user, who fills it before it is added or released, or
+     * an added one being delivered. A lent change removed from the History goes back to the pool when returned.
+     * @param a_change Pointer to the change.
+     */
+    RTPS_DllAPI void loan_change(CacheChange_t* a_change);
+
+    /**
+     * Return a change lent by loan_change.
+     * @param a_change Pointer to the change.
+     * @return True if the change was lent by this History.
+     */
+    RTPS_DllAPI bool return_loan(CacheChange_t* a_change);
+
     protected:
+
+    /**
+     * Find the change with a sequence number.
+     * @return Iterator to the change, or changesEnd() if it is not in the history.
+     */
+    std::vector<CacheChange_t*>::iterator find_change(const SequenceNumber_t& sequence_number);
+
     //!Last CacheChange Sequence Number added to the History.
     SequenceNumber_t m_lastCacheChangeSeqNum;
     //!Pointer to the associated RTPSWriter;
@@ -159,23 +159,16 @@ inline bool CDRMessage::readSequenceNumberSet(CDRMessage_t* msg,SequenceNumberSe
     valid &=CDRMessage::readSequenceNumber(msg,&sns->base);
     uint32_t numBits = 0;
     valid &=CDRMessage::readUInt32(msg,&numBits);
-    int32_t bitmap;
-    SequenceNumber_t seqNum;
+    if(numBits > SequenceNumberSet_t::c_max_bits)
+        return false;
+
+    // The bitmap is kept in wire order, so words are copied as they are read.
+    uint32_t bitmap[SequenceNumberSet_t::c_words];
     for(uint32_t i=0;i<(numBits+31)/32;++i)
-    {
-        valid &= CDRMessage::readInt32(msg,&bitmap);
-        for(uint8_t bit=0;bit<32;++bit)
-        {
-            if((bitmap & (1<<(31-bit%32)))==(1<<(31-bit%32)))
-            {
-                seqNum = sns->base+(i*32+bit);
-                if(!sns->add(seqNum))
-                {
-                    return false;
-                }
-            }
-        }
-    }
+        valid &= CDRMessage::readUInt32(msg,&bitmap[i]);
+
+    if(valid)
+        sns->set_bitmap(numBits, bitmap);
     return valid;
 }
 
@@ -527,42 +520,13 @@ inline bool CDRMessage::addSequenceNumberSet(CDRMessage_t* msg,
 {
     CDRMessage::addSequenceNumber(msg, &sns->base);
 
-    //Add set
-    if(sns->isSetEmpty())
-    {
-        addUInt32(msg,0); //numbits 0
-        return true;
-    }
-
-    SequenceNumber_t maxseqNum = sns->get_maxSeqNum();
-
-    uint32_t numBits = (maxseqNum - sns->base + 1).low;
-    assert((maxseqNum - sns->base + 1).high == 0);
-
-    if(numBits >= 256)
-        numBits = 255;
-
+    //Add set, an empty one having no bits
+    uint32_t numBits = sns->get_num_bits();
     addUInt32(msg, numBits);
-    uint8_t n_longs = (uint8_t)((numBits + 31) / 32);
-    uint32_t bitmap[8];
-
-    for(uint32_t i = 0; i < n_longs; i++)
-        bitmap[i] = 0;
-
-    uint32_t deltaN = 0;
-    for(auto it = sns->get_begin();
-            it != sns->get_end(); ++it)
-    {
-        deltaN = (*it - sns->base).low;
-        assert((*it - sns->base).high == 0);
-        if(deltaN < 256)
-            bitmap[(uint32_t)(deltaN/32)] = (bitmap[(uint32_t)(deltaN/32)] | (1<<(31-deltaN%32)));
-        else
-            break;
-    }
 
-    for(uint32_t i= 0;i<n_longs;i++)
-        addInt32(msg,bitmap[i]);
+    const uint32_t* bitmap = sns->get_bitmap();
+    for(uint32_t i= 0;i<(numBits+31)/32;i++)
+        addUInt32(msg,bitmap[i]);
 
     return true;
 }
@@ -26,6 +26,9 @@
 #include <fastrtps/rtps/writer/StatelessWriter.h>
 #include <fastrtps/rtps/writer/StatefulWriter.h>
 
+#include <atomic>
+#include <memory>
+#include <unordered_map>
 
 namespace eprosima {
 namespace fastrtps{
@@ -61,8 +64,9 @@ class MessageReceiver
          * @param[in] RTPSParticipantguidprefix RTPSParticipant Guid Prefix
          * @param[in] loc Locator indicating the sending address.
          * @param[in] msg Pointer to the message
+         * @param[in] buffer Pooled buffer holding the message, if any. Payloads are loaned from it instead of copied.
          */
-        void processCDRMsg(const Locator_t& loc, CDRMessage_t*msg);
+        void processCDRMsg(const Locator_t& loc, CDRMessage_t*msg, ReceiveBuffer* buffer = nullptr);
 
         //!Pointer to the Listen Resource that contains this MessageReceiver.
 
@@ -76,10 +80,81 @@ class MessageReceiver
         void associateEndpoint(Endpoint *to_add);
         void removeEndpoint(Endpoint *to_remove);
 
+        /**
+         * Updates the dispatch index after an associated reader matched a writer.
+         * @param reader Reader that matched the writer.
+         * @param writer_guid GUID of the matched writer.
+         * @param any_writer Whether the reader still takes messages from writers it is not matched with.
+         */
+        void readerMatchedWriter(RTPSReader* reader, const GUID_t& writer_guid, bool any_writer);
+
+        /**
+         * Updates the dispatch index after an associated reader unmatched a writer.
+         * @param reader Reader that unmatched the writer.
+         * @param writer_guid GUID of the unmatched writer.
+         * @param any_writer Whether the reader still takes messages from writers it is not matched with.
+         */
+        void readerUnmatchedWriter(RTPSReader* reader, const GUID_t& writer_guid, bool any_writer);
+
     private:
-        std::vector<RTPSWriter *> AssociatedWriters;
-        std::vector<RTPSReader *> AssociatedReaders;
+
+        struct EntityIdHash
+        {
+            std::size_t operator()(const EntityId_t& id) const;
+        };
+
+        struct GUIDHash
+        {
+            std::size_t operator()(const GUID_t& guid) const;
+        };
+
+        /**
+         * Associated endpoints, indexed for dispatching submessages.
+         * Tables are never modified once published, so processing a submessage takes no lock. A new table is
+         * published on each change, and removals wait until no message that could hold an older one is being
+         * processed.
+         */
+        struct EndpointTable
+        {
+
+            std::vector<RTPSWriter*> writers;
+            std::vector<RTPSReader*> readers;
+            std::unordered_map<GUID_t, RTPSWriter*, GUIDHash> writersByGuid;
+            std::unordered_map<EntityId_t, RTPSReader*, EntityIdHash> readersById;
+            //! Readers matched with each writer, for submessages not directed to a specific reader.
+            std::unordered_map<GUID_t, std::vector<RTPSReader*>, GUIDHash> readersByWriter;
+            //! Readers that may take messages from writers they are not matched with.
+            std::vector<RTPSReader*> readersForAnyWriter;
+        };
+
+        //! Current table.
+        std::shared_ptr<const EndpointTable> endpointTable() const;
+
+        //! Adds or removes a reader from readersForAnyWriter.
+        static void indexAnyWriter(EndpointTable& table, RTPSReader* reader, bool any_writer);
+
+        //! Publishes a table and returns the previous one. mtx must be held.
+        std::shared_ptr<const EndpointTable> publishTable(std::shared_ptr<const EndpointTable> table);
+
+        /**
+         * Calls f on each reader that may be interested in a submessage from the given writer.
+         * When the submessage is directed to a specific reader, only that one is considered.
+         */
+        template<typename Functor>
+        void forEachReader(const EndpointTable& table, EntityId_t& readerId, const GUID_t& writerGUID, Functor f);
+
+        //! Processes a message. Called by processCDRMsg() once the message is accounted as in flight.
+        void processMessage(const Locator_t& loc, CDRMessage_t* msg, ReceiveBuffer* buffer);
+
+        std::shared_ptr<const EndpointTable> mEndpoints;
+        //! Serializes changes to the endpoint table.
         std::mutex mtx;
+        //! Serializes removals, so only one of them flips mProcessingEpoch at a time.
+        std::mutex mRemovalMtx;
+        //! Selects the mProcessing counter taken by messages starting to be processed.
+        std::atomic<uint32_t> mProcessingEpoch;
+        //! Messages being processed, by the parity of mProcessingEpoch when they started.
+        std::atomic<uint32_t> mProcessing[2];
         //!Protocol version of the message
         ProtocolVersion_t sourceVersion;
         //!VendorID that created the message
@@ -96,6 +171,8 @@ class MessageReceiver
         ProtocolVersion_t destVersion;
 
         uint16_t mMaxPayload_;
+        //!Buffer holding the message being processed, if it was received into a pooled one.
+        ReceiveBuffer* mReceiveBuffer;
 
 
         /**@name Processing methods.
@@ -92,6 +92,9 @@ class RTPSMessageCreator
          * @param[out] msg Pointer to where the message is going to be created and stored.
          * @param[in] guidPrefix Guid Prefix of the RTPSParticipant.
          * @param[in] param Different parameters depending on the message.
+         * @param[in] copy_payload For DATA and DATA_FRAG submessages, when false the serialized payload and its
+         * alignment padding are accounted in the submessage length but not written, so the caller can send
+         * them from their own buffer right after the submessage.
          * @return True if correct.
          */
 
@@ -100,13 +103,14 @@ class RTPSMessageCreator
         static bool addMessageData(CDRMessage_t* msg, GuidPrefix_t& guidprefix, const CacheChange_t* change,
                 TopicKind_t topicKind, const EntityId_t& readerId, bool expectsInlineQos, ParameterList_t* inlineQos);
         static bool addSubmessageData(CDRMessage_t* msg, const CacheChange_t* change,
-                TopicKind_t topicKind, const EntityId_t& readerId, bool expectsInlineQos, ParameterList_t* inlineQos);
+                TopicKind_t topicKind, const EntityId_t& readerId, bool expectsInlineQos, ParameterList_t* inlineQos,
+                bool copy_payload = true);
 
         static bool addMessageDataFrag(CDRMessage_t* msg, GuidPrefix_t& guidprefix, const CacheChange_t* change, uint32_t fragment_number,
                 TopicKind_t topicKind, const EntityId_t& readerId, bool expectsInlineQos, ParameterList_t* inlineQos);
         static bool addSubmessageDataFrag(CDRMessage_t* msg, const CacheChange_t* change, uint32_t fragment_number,
                 uint32_t sample_size, TopicKind_t topicKind, const EntityId_t& readerId, bool expectsInlineQos,
-                ParameterList_t* inlineQos);
+                ParameterList_t* inlineQos, bool copy_payload = true);
 
         static bool addMessageGap(CDRMessage_t* msg, const GuidPrefix_t& guidprefix, const GuidPrefix_t& remoteGuidPrefix,
                 const SequenceNumber_t& seqNumFirst, const SequenceNumberSet_t& seqNumList,const EntityId_t& readerId,const EntityId_t& writerId);
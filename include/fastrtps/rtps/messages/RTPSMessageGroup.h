@@ -24,6 +24,7 @@
 #include "../messages/RTPSMessageCreator.h"
 #include "../../qos/ParameterList.h"
 #include <fastrtps/rtps/common/FragmentNumber.h>
+#include <fastrtps/rtps/common/NetworkBuffer.h>
 
 #include <vector>
 #include <cassert>
@@ -52,12 +53,16 @@ class RTPSMessageGroup_t
         {
             CDRMessage::initCDRMsg(&rtpsmsg_fullmsg_);
             RTPSMessageCreator::addHeader(&rtpsmsg_fullmsg_, participant_guid);
+            rtpsmsg_buffers_.reserve(s_maximumNetworkBuffers);
         }
 
         CDRMessage_t rtpsmsg_submessage_;
 
         CDRMessage_t rtpsmsg_fullmsg_;
 
+        //! Slices of the message being built, when some payloads are referenced instead of copied.
+        std::vector<NetworkBuffer> rtpsmsg_buffers_;
+
 #if HAVE_SECURITY
         CDRMessage_t rtpsmsg_encrypt_;
 #endif
@@ -180,7 +185,14 @@ class RTPSMessageGroup
         bool add_nackfrag(const std::vector<GUID_t>& remote_writers, SequenceNumber_t& writerSN,
                 FragmentNumberSet_t fnState, int32_t count, const LocatorList_t locators);
 
-        uint32_t get_current_bytes_processed() { return currentBytesSent_ + full_msg_->length; }
+        /**
+         * Changes the endpoint whose submessages are added next, so endpoints of the same participant can share
+         * the messages of a group.
+         * @param endpoint Pointer to the endpoint sending data.
+         */
+        void set_endpoint(Endpoint* endpoint);
+
+        uint32_t get_current_bytes_processed() { return currentBytesSent_ + full_msg_->length + referenced_bytes_; }
 
     private:
 
@@ -199,7 +211,24 @@ class RTPSMessageGroup
         void check_and_maybe_flush(const LocatorList_t& locator_list,
                 const std::vector<GUID_t>& remote_endpoints);
 
-        bool insert_submessage(const std::vector<GUID_t>& remote_endpoints);
+        /**
+         * Appends the submessage being built to the message, flushing it first if there is no room.
+         * @param remote_endpoints List of destination GUIDs.
+         * @param payload When not null, serialized payload to be sent after the submessage without copying it.
+         * @param payload_length Length of the payload, without alignment.
+         * @return True when the submessage was added.
+         */
+        bool insert_submessage(const std::vector<GUID_t>& remote_endpoints, const octet* payload = nullptr,
+                uint32_t payload_length = 0);
+
+        //! Checks whether a payload can be sent from the cache change instead of copied into the message.
+        bool can_reference_payload(const octet* payload, uint32_t payload_length) const;
+
+        //! Checks whether some bytes still fit in the message.
+        bool fits_in_message(uint32_t size) const
+        {
+            return full_msg_->length + referenced_bytes_ + size <= full_msg_->max_size;
+        }
 
         bool add_info_dst_in_buffer(CDRMessage_t* buffer, const std::vector<GUID_t>& remote_endpoints);
 
@@ -213,6 +242,14 @@ class RTPSMessageGroup
 
         CDRMessage_t* submessage_msg_;
 
+        std::vector<NetworkBuffer>* buffers_;
+
+        //! Bytes of the message that are referenced in buffers_ and not held in full_msg_.
+        uint32_t referenced_bytes_;
+
+        //! Position of full_msg_ where the slice following the last referenced payload starts.
+        uint32_t pending_slice_start_;
+
         uint32_t currentBytesSent_;
 
         LocatorList_t current_locators_;
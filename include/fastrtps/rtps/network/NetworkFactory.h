@@ -19,8 +19,10 @@
 #include <fastrtps/rtps/network/ReceiverResource.h>
 #include <fastrtps/rtps/network/SenderResource.h>
 #include <fastrtps/rtps/messages/MessageReceiver.h>
-#include <vector>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace eprosima{
 namespace fastrtps{
@@ -81,6 +83,20 @@ class NetworkFactory
 
         bool is_local_locator(const Locator_t& locator) const;
 
+        /**
+         * Adds to the list the locators of other transports reaching the same endpoints as a shared memory
+         * locator, which ShrinkLocatorLists left out in its favour. They are used when sending through shared
+         * memory fails.
+         * @return True if some locator was added.
+         * */
+        bool GetFallbackLocators(const Locator_t& locator, LocatorList_t& fallbackLocators) const;
+
+        /**
+         * Forgets the fallback locators of the shared memory locators in the list, once the endpoints they
+         * belong to are gone.
+         * */
+        void RemoveFallbackLocators(const LocatorList_t& locatorList);
+
         size_t numberOfRegisteredTransports() const;
 
         uint32_t get_max_message_size_between_transports() const { return maxMessageSizeBetweenTransports_; }
@@ -136,8 +152,20 @@ class NetworkFactory
 
     private:
 
+        /**
+         * When the list contains shared memory locators of this host, returns only those, so endpoints on
+         * the same host are not reached through the network. The rest are kept as their fallback.
+         * Otherwise returns the list unchanged.
+         * */
+        LocatorList_t PreferSharedMemoryLocators(const LocatorList_t& locatorList);
+
         std::vector<std::unique_ptr<TransportInterface> > mRegisteredTransports;
 
+        //! Locators of other transports left out in favour of each shared memory locator.
+        std::map<Locator_t, LocatorList_t> mFallbackLocators;
+
+        mutable std::mutex mFallbackLocatorsMutex;
+
         uint32_t maxMessageSizeBetweenTransports_;
 
         uint32_t minSendBufferSize_;
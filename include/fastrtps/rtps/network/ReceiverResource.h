@@ -18,6 +18,7 @@
 #include <functional>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include "../messages/MessageReceiver.h"
 #include "../../transport/TransportInterface.h"
 
@@ -50,6 +51,17 @@ public:
     virtual void OnDataReceived(const octet* data, const uint32_t size,
         const Locator_t& localLocator, const Locator_t& remoteLocator) override;
 
+    /**
+    * Method called by the transport when receiving data into a pooled buffer.
+    * Payloads of the message may be loaned from the buffer instead of copied.
+    * @param buffer Buffer holding the received data.
+    * @param size Number of bytes received.
+    * @param localLocator Locator identifying the local endpoint.
+    * @param remoteLocator Locator identifying the remote endpoint.
+    */
+    virtual void OnDataReceived(ReceiveBuffer& buffer, const uint32_t size,
+        const Locator_t& localLocator, const Locator_t& remoteLocator) override;
+
     /**
      * Reports whether this resource supports the given local locator (i.e., said locator
      * maps to the transport channel managed by this resource).
@@ -58,6 +70,8 @@ public:
 
     /**
      * Register a MessageReceiver object to be called upon reception of data.
+     * Up to max_concurrent_receptions() receivers can be registered, each of them used by one receiving
+     * thread at a time.
      * @param receiver The message receiver to register.
      */
     void RegisterReceiver(MessageReceiver* receiver);
@@ -68,6 +82,12 @@ public:
     */
     void UnregisterReceiver(MessageReceiver* receiver);
 
+    //! Number of threads the transport may deliver data from at the same time.
+    uint32_t max_concurrent_receptions() const
+    {
+        return static_cast<uint32_t>(mSlots.size());
+    }
+
     /**
      * Resources can only be transfered through move semantics. Copy, assignment, and
      * construction outside of the factory are forbidden.
@@ -85,9 +105,24 @@ private:
     std::function<bool(const Locator_t&)> LocatorMapsToManagedChannel;
     bool mValid; // Post-construction validity check for the NetworkFactory
 
-    std::mutex mtx;
-    MessageReceiver* receiver;
-    CDRMessage_t msg;
+    //! Reception state used by one receiving thread at a time.
+    struct ReceiverSlot
+    {
+        ReceiverSlot() : receiver(nullptr), msg(0) {}
+
+        std::mutex mtx;
+        MessageReceiver* receiver;
+        CDRMessage_t msg;
+    };
+
+    //! Passes the data, and the buffer holding it if any, to the receiver of the slot. Its mutex must be held.
+    void ProcessData(ReceiverSlot& slot, const octet* data, const uint32_t size, const Locator_t& remoteLocator,
+        ReceiveBuffer* buffer);
+
+    //! Locks a slot and passes the data to its receiver.
+    void Dispatch(const octet* data, const uint32_t size, const Locator_t& remoteLocator, ReceiveBuffer* buffer);
+
+    std::vector<std::unique_ptr<ReceiverSlot>> mSlots;
 };
 
 } // namespace rtps
@@ -17,6 +17,7 @@
 
 #include <functional>
 #include <vector>
+#include "../common/NetworkBuffer.h"
 
 namespace eprosima{
 namespace fastrtps{
@@ -52,6 +53,25 @@ public:
     */
    bool Send(const octet* data, uint32_t dataLength, const Locator_t& destinationLocator);
 
+   /**
+    * Sends a message made of several buffers to a destination locator, through the channel managed by this resource.
+    * @param buffers Slices of the message to be sent, in order.
+    * @param totalBytes Sum of the sizes of all the buffers.
+    * @param destinationLocator Locator describing the destination endpoint.
+    * @return Success of the send operation.
+    */
+   bool Send(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes, const Locator_t& destinationLocator);
+
+   /**
+    * Sends a message made of several buffers to several destination locators, through the channel managed
+    * by this resource.
+    * @param buffers Slices of the message to be sent, in order.
+    * @param totalBytes Sum of the sizes of all the buffers.
+    * @param destinationLocators Locators describing the destination endpoints.
+    * @return Success of the send operation on any of the destinations.
+    */
+   bool Send(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes, const LocatorList_t& destinationLocators);
+
    /**
    * Reports whether this resource supports the given local locator (i.e., said locator
    * maps to the transport channel managed by this resource).
@@ -87,6 +107,9 @@ private:
    std::function<void()> Cleanup;
    std::function<bool(const Locator_t&)> AddSenderLocatorToManagedChannel;
    std::function<bool(const octet*, uint32_t, const Locator_t&, ChannelResource*)> SendThroughAssociatedChannel;
+   std::function<bool(const std::vector<NetworkBuffer>&, uint32_t, const Locator_t&)> SendBuffersThroughAssociatedChannel;
+   std::function<bool(const std::vector<NetworkBuffer>&, uint32_t, const LocatorList_t&)>
+       SendToLocatorsThroughAssociatedChannel;
    std::function<bool(const Locator_t&)> LocatorMapsToManagedChannel;
    std::function<bool(const Locator_t&)> ManagedChannelMapsToRemote;
    bool mValid; // Post-construction validity check for the NetworkFactory
@@ -0,0 +1,160 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ChangeFromWriterWindow.h
+ */
+
+#ifndef CHANGEFROMWRITERWINDOW_H_
+#define CHANGEFROMWRITERWINDOW_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include "../common/CacheChange.h"
+#include "../common/SequenceNumber.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * State of the changes of a writer as seen by one reader.
+ * All the changes up to the low mark were received or lost. The window holds the status of every sequence number
+ * after it, up to the highest one the reader knows of, as one bitmap per status, so looking a change up takes
+ * constant time and operations over all the changes with a status scan those bitmaps a word at a time.
+ * @ingroup READER_MODULE
+ */
+class ChangeFromWriterWindow
+{
+    public:
+
+        ChangeFromWriterWindow();
+
+        //! Number of changes after the low mark.
+        size_t size() const
+        {
+            return m_end - m_first;
+        }
+
+        bool empty() const
+        {
+            return m_end == m_first;
+        }
+
+        //! Highest sequence number received or lost with all the previous ones.
+        const SequenceNumber_t& low_mark() const
+        {
+            return m_low_mark;
+        }
+
+        //! Highest sequence number in the window, or the low mark if it is empty.
+        SequenceNumber_t last_sequence_number() const
+        {
+            return m_low_mark + static_cast<uint32_t>(size());
+        }
+
+        //! Returns whether a sequence number is after the low mark and in the window.
+        bool contains(const SequenceNumber_t& sequence_number) const
+        {
+            return sequence_number > m_low_mark && sequence_number <= last_sequence_number();
+        }
+
+        //! Status of a sequence number, which must be in the window.
+        ChangeFromWriterStatus_t status(const SequenceNumber_t& sequence_number) const;
+
+        //! Relevance of a sequence number, which must be in the window.
+        bool is_relevant(const SequenceNumber_t& sequence_number) const;
+
+        //! Empties the window and moves the low mark.
+        void reset(const SequenceNumber_t& low_mark);
+
+        /**
+         * Adds the sequence numbers after the last one in the window, up to the given one, with a status.
+         * Nothing is done if the sequence number is already in the window or before the low mark.
+         */
+        void extend_to(const SequenceNumber_t& sequence_number, ChangeFromWriterStatus_t status);
+
+        //! Sets the status and relevance of a sequence number, which must be in the window.
+        void set(const SequenceNumber_t& sequence_number, ChangeFromWriterStatus_t status, bool relevant = true);
+
+        /**
+         * Changes the status of all the changes up to a sequence number from one status to another.
+         * @return Number of converted changes.
+         */
+        size_t convert_up_to(const SequenceNumber_t& sequence_number, ChangeFromWriterStatus_t previous,
+                ChangeFromWriterStatus_t next);
+
+        /**
+         * Removes all the changes with a lower sequence number, whatever their status, moving the low mark
+         * just before it.
+         */
+        void remove_until(const SequenceNumber_t& sequence_number);
+
+        //! Moves the low mark over the oldest changes while they are RECEIVED or LOST.
+        void remove_completed_front();
+
+        //! Number of changes with a lower sequence number that are UNKNOWN or MISSING.
+        size_t count_pending_before(const SequenceNumber_t& sequence_number) const;
+
+        //! Returns whether some change is in a status.
+        bool has_changes(ChangeFromWriterStatus_t status) const;
+
+        /**
+         * Adds the sequence numbers of the changes in a status to a set, stopping at the first one the set
+         * cannot hold.
+         * @return False if some sequence number did not fit in the set.
+         */
+        bool get_sequence_numbers(ChangeFromWriterStatus_t status, SequenceNumberSet_t& set) const;
+
+    private:
+
+        static const size_t c_bits = 64;
+
+        static const size_t c_statuses = LOST + 1;
+
+        size_t slot(const SequenceNumber_t& sequence_number) const
+        {
+            return m_first + static_cast<size_t>((sequence_number - m_low_mark).to64long()) - 1;
+        }
+
+        //! Clears every bitmap in the slots [first, last).
+        void clear_slots(size_t first, size_t last);
+
+        //! Reclaims the slots before the low mark once they are a large part of the window.
+        void compact();
+
+        //! Slots in each status.
+        std::vector<uint64_t> m_status[c_statuses];
+
+        //! Slots of changes that are not relevant.
+        std::vector<uint64_t> m_irrelevant;
+
+        SequenceNumber_t m_low_mark;
+
+        //! Slot of the sequence number after the low mark.
+        size_t m_first;
+
+        //! Slot after the last sequence number in the window.
+        size_t m_end;
+};
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
+
+#endif
+#endif /* CHANGEFROMWRITERWINDOW_H_ */
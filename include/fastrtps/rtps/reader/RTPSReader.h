@@ -26,6 +26,7 @@
 #include "../attributes/ReaderAttributes.h"
 
 #include <map>
+#include <vector>
 
 namespace eprosima
 {
@@ -79,6 +80,13 @@ namespace eprosima
                  */
                 RTPS_DllAPI virtual bool matched_writer_is_matched(const RemoteWriterAttributes& wdata) = 0;
 
+                /**
+                 * Lists the writers this reader takes messages from, so message receivers can index it by writer.
+                 * @param guids Filled with the GUIDs of the matched writers.
+                 * @return False if the reader may also take messages from writers it is not matched with.
+                 */
+                virtual bool matched_writer_guids(std::vector<GUID_t>& guids) = 0;
+
                 /**
                  * Returns true if the reader accepts a message directed to entityId.
                  */
@@ -88,7 +96,7 @@ namespace eprosima
                  * Processes a new DATA message. Previously the message must have been accepted by function acceptMsgDirectedTo.
                  *
                  * @param change Pointer to the CacheChange_t.
-                 * @return true if the reader accepts messages from the.
+                 * @return true if the change was accepted from the writer and is now (or was already) known by the reader.
                  */
                 RTPS_DllAPI virtual bool processDataMsg(CacheChange_t *change) = 0;
 
@@ -105,11 +113,16 @@ namespace eprosima
                 /**
                  * Processes a new HEARTBEAT message. Previously the message must have been accepted by function acceptMsgDirectedTo.
                  *
-                 * @return true if the reader accepts messages from the.
+                 * @return true if the reader accepts messages from the writer.
                  */
                 RTPS_DllAPI virtual bool processHeartbeatMsg(GUID_t &writerGUID, uint32_t hbCount, SequenceNumber_t &firstSN,
                         SequenceNumber_t &lastSN, bool finalFlag, bool livelinessFlag) = 0;
 
+                /**
+                 * Processes a new GAP message. Previously the message must have been accepted by function acceptMsgDirectedTo.
+                 *
+                 * @return true if the reader accepts messages from the writer.
+                 */
                 RTPS_DllAPI virtual bool processGapMsg(GUID_t &writerGUID, SequenceNumber_t &gapStart, SequenceNumberSet_t &gapList) = 0;
 
                 /**
@@ -164,6 +177,14 @@ namespace eprosima
                  */
                 RTPS_DllAPI virtual bool nextUntakenCache(CacheChange_t** change, WriterProxy** wp) = 0;
 
+                /**
+                 * Check whether a CacheChange_t of the history can be given to the user.
+                 * @param change Pointer to the CacheChange_t.
+                 * @param wp Pointer to pointer to the WriterProxy of the change, if the reader keeps one.
+                 * @return True if available.
+                 */
+                RTPS_DllAPI virtual bool isChangeAvailable(CacheChange_t* change, WriterProxy** wp) = 0;
+
                 /**
                  * @return True if the reader expects Inline QOS.
                  */
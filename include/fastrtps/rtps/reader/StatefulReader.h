@@ -72,6 +72,8 @@ class StatefulReader:public RTPSReader
          * @return True if it is matched.
          */
         bool matched_writer_is_matched(const RemoteWriterAttributes& wdata);
+
+        bool matched_writer_guids(std::vector<GUID_t>& guids) override;
         /**
          * Look for a specific WriterProxy.
          * @param writerGUID GUID_t of the writer we are looking for.
@@ -146,6 +148,15 @@ class StatefulReader:public RTPSReader
          */
         bool nextUntakenCache(CacheChange_t** change,WriterProxy** wpout=nullptr);
 
+        /**
+         * Check whether a CacheChange_t of the history can be given to the user. It is available once all the
+         * previous changes of its writer have been received or are known to be lost.
+         * @param change Pointer to the CacheChange_t.
+         * @param wpout Pointer to pointer the matched writer proxy
+         * @return True if available.
+         */
+        bool isChangeAvailable(CacheChange_t* change, WriterProxy** wpout=nullptr);
+
 
         /**
          * Update the times parameters of the Reader.
@@ -64,6 +64,8 @@ public:
      */
     bool matched_writer_is_matched(const RemoteWriterAttributes& wdata);
 
+    bool matched_writer_guids(std::vector<GUID_t>& guids) override;
+
     /**
      * Method to indicate the reader that some change has been removed due to HistoryQos requirements.
      * @param change Pointer to the CacheChange_t.
@@ -122,6 +124,14 @@ public:
      */
     bool nextUntakenCache(CacheChange_t** change,WriterProxy** wpout=nullptr);
 
+    /**
+     * Check whether a CacheChange_t of the history can be given to the user. Every change is available.
+     * @param change Pointer to the CacheChange_t.
+     * @param wpout Pointer to pointer of the matched writer proxy
+     * @return True if available.
+     */
+    bool isChangeAvailable(CacheChange_t* change, WriterProxy** wpout=nullptr);
+
     /**
      * Get the number of matched writers
      * @return Number of matched writers
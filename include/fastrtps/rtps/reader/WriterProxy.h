@@ -26,8 +26,7 @@
 #include "../common/Locator.h"
 #include "../common/CacheChange.h"
 #include "../attributes/ReaderAttributes.h"
-
-#include<set>
+#include "ChangeFromWriterWindow.h"
 
 // Testing purpose
 #ifndef TEST_FRIENDS
@@ -110,10 +109,12 @@ namespace eprosima
                     bool areThereMissing();
 
                     /**
-                     * The method returns a vector containing all missing changes.
-                     * @return Vector of missing changes..
+                     * Adds the sequence numbers of all missing changes to a set, which is based on the first
+                     * change not received yet.
+                     * @param[out] missing Set to fill. Missing changes beyond its bitmap are left out.
+                     * @return True if there is some missing change.
                      */
-                    const std::vector<ChangeFromWriter_t>  missing_changes();
+                    bool missing_changes(SequenceNumberSet_t& missing);
 
                     size_t unknown_missing_changes_up_to(const SequenceNumber_t& seqNum);
 
@@ -171,20 +172,8 @@ namespace eprosima
 
                 private:
 
-                    /*!
-                     * @brief Add ChangeFromWriter_t up to the sequenceNumber passed, but not including this.
-                     * Ex: If you have seqNums 1,2,3 and you receive seqNum 6, you need to add 4 and 5.
-                     * @param sequence_number
-                     * @param default_status ChangeFromWriter_t added will be created with this ChangeFromWriterStatus_t.
-                     * @return True if sequence_number will be the next after last element in the m_changesFromW container.
-                     * @remarks No thread-safe.
-                     */
-                    bool maybe_add_changes_from_writer_up_to(const SequenceNumber_t& sequence_number, const ChangeFromWriterStatus_t default_status = ChangeFromWriterStatus_t::UNKNOWN);
-
                     bool received_change_set(const SequenceNumber_t& seqNum, bool is_relevance);
 
-                    void cleanup();
-
                     //!Is the writer alive
                     bool m_isAlive;
                     //Print Method for log purposes
@@ -193,23 +182,11 @@ namespace eprosima
                     //!Mutex Pointer
                     std::recursive_mutex* mp_mutex;
 
-                    //!Vector containing the ChangeFromWriter_t objects.
-                    std::set<ChangeFromWriter_t, ChangeFromWriterCmp> m_changesFromW;
-                    SequenceNumber_t changesFromWLowMark_;
+                    //!Status of the changes after the last one received or lost with all the previous ones.
+                    ChangeFromWriterWindow m_changesFromW;
 
                     //! Store last ChacheChange_t notified.
                     SequenceNumber_t lastNotified_;
-
-                    void for_each_set_status_from(decltype(m_changesFromW)::iterator first,
-                            decltype(m_changesFromW)::iterator last,
-                            ChangeFromWriterStatus_t status,
-                            ChangeFromWriterStatus_t new_status);
-
-                    void for_each_set_status_from_and_maybe_remove(decltype(m_changesFromW)::iterator first,
-                            decltype(m_changesFromW)::iterator last,
-                            ChangeFromWriterStatus_t status,
-                            ChangeFromWriterStatus_t orstatus,
-                            ChangeFromWriterStatus_t new_status);
             };
 
         } /* namespace rtps */
@@ -54,10 +54,15 @@ class HeartbeatResponseDelay:public TimedEvent
              */
             void event(EventCode code, const char* msg= nullptr);
 
+            /**
+             * Adds the ACKNACK and NACKFRAG messages answering the writer to a message group shared with other
+             * endpoints of the participant.
+             * @param group Message group sending to any destination.
+             */
+            void add_messages(RTPSMessageGroup& group);
+
             //!Pointer to the WriterProxy associated with this specific event.
             WriterProxy* mp_WP;
-            //!CDRMessage_t used in the response.
-            RTPSMessageGroup_t m_cdrmessages;
             //!List of destination locators
             LocatorList_t m_destination_locators;
             //!List of destination endpoints
@@ -0,0 +1,173 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ChangeForReaderWindow.h
+ */
+
+#ifndef CHANGEFORREADERWINDOW_H_
+#define CHANGEFORREADERWINDOW_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include "../common/CacheChange.h"
+#include "../common/SequenceNumber.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * State of the changes of a writer with respect to one reader, indexed by sequence number.
+ * Slot i of the window holds the change with sequence number base + i, so looking a change up takes constant
+ * time and adding the newest one does not allocate once the window has grown to the number of unacknowledged
+ * changes. Each status has a bitmap of the slots in it, and operations over all the changes with a status scan
+ * those bitmaps a word at a time.
+ * Removed slots at the front are only reclaimed when new changes are added, so pointers to the changes stay
+ * valid until then.
+ * @ingroup WRITER_MODULE
+ */
+class ChangeForReaderWindow
+{
+    public:
+
+        ChangeForReaderWindow();
+
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        //! Oldest change in the window, or nullptr if it is empty.
+        ChangeForReader_t* front();
+
+        //! Sequence number of the newest change ever added, or unknown if none was added.
+        SequenceNumber_t last_sequence_number() const
+        {
+            return m_last;
+        }
+
+        /**
+         * Adds a change newer than all the others.
+         * @return False if the sequence number of the change is not greater than the last one added.
+         */
+        bool push_back(const ChangeForReader_t& change);
+
+        /**
+         * Moves all the changes of this window behind the ones of an older window, which is left empty.
+         * @param older Window whose changes all have lower sequence numbers.
+         * @return False if the windows overlap.
+         */
+        bool prepend(ChangeForReaderWindow& older);
+
+        //! Change with a sequence number, or nullptr if it is not in the window.
+        ChangeForReader_t* find(const SequenceNumber_t& sequence_number);
+
+        /**
+         * Sets the status of a change.
+         * @return False if the change is not in the window.
+         */
+        bool set_status(const SequenceNumber_t& sequence_number, ChangeForReaderStatus_t status);
+
+        /**
+         * Removes all the changes with a lower sequence number.
+         * @return Number of removed changes.
+         */
+        size_t remove_until(const SequenceNumber_t& sequence_number);
+
+        /**
+         * Removes the oldest changes while they are ACKNOWLEDGED.
+         * @return Sequence number of the last removed change, or unknown if none was removed.
+         */
+        SequenceNumber_t remove_acknowledged_front();
+
+        /**
+         * Changes the status of all the changes in a status to another one.
+         * @return Number of converted changes.
+         */
+        size_t convert_status(ChangeForReaderStatus_t previous, ChangeForReaderStatus_t next);
+
+        //! Appends all the changes in a status to a vector, ordered by sequence number.
+        void get_changes(ChangeForReaderStatus_t status, std::vector<ChangeForReader_t*>& changes);
+
+        void get_changes(ChangeForReaderStatus_t status, std::vector<const ChangeForReader_t*>& changes) const;
+
+        //! Returns whether some change is in a status.
+        bool has_changes(ChangeForReaderStatus_t status) const;
+
+    private:
+
+        static const size_t c_bits = 64;
+
+        static const size_t c_statuses = UNDERWAY + 1;
+
+        //! Empties the window, so the next change added is in its first slot.
+        void reset(const SequenceNumber_t& base);
+
+        //! Slot of a sequence number, or the number of slots if it is outside the window.
+        size_t slot(const SequenceNumber_t& sequence_number) const;
+
+        bool is_present(size_t slot) const
+        {
+            return (m_present[slot / c_bits] >> (slot % c_bits)) & 1u;
+        }
+
+        void set_bit(std::vector<uint64_t>& bits, size_t slot)
+        {
+            bits[slot / c_bits] |= uint64_t(1) << (slot % c_bits);
+        }
+
+        void clear_bit(std::vector<uint64_t>& bits, size_t slot)
+        {
+            bits[slot / c_bits] &= ~(uint64_t(1) << (slot % c_bits));
+        }
+
+        void remove_slot(size_t slot);
+
+        //! Reclaims the removed slots at the front once they are a large part of the window.
+        void compact();
+
+        //! Changes, slot i having the sequence number m_base + i.
+        std::vector<ChangeForReader_t> m_slots;
+
+        //! Slots holding a change.
+        std::vector<uint64_t> m_present;
+
+        //! Slots in each status.
+        std::vector<uint64_t> m_status[c_statuses];
+
+        SequenceNumber_t m_base;
+
+        //! First slot that may hold a change. All the previous ones were removed.
+        size_t m_first;
+
+        size_t m_size;
+
+        SequenceNumber_t m_last;
+};
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
+
+#endif
+#endif /* CHANGEFORREADERWINDOW_H_ */
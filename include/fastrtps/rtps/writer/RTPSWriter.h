@@ -34,6 +34,7 @@ namespace rtps {
 class WriterListener;
 class WriterHistory;
 class FlowController;
+class IntraprocessDelivery;
 struct CacheChange_t;
 
 
@@ -184,8 +185,65 @@ class RTPSWriter : public Endpoint
      */
     bool get_separate_sending () const { return m_separateSendingEnabled; }
 
+    /**
+     * Hands the pending changes to the matched readers of this process.
+     * Readers process them, and notify their listeners, without the writer mutex taken, so the listeners can
+     * write with other writers. If another thread is already delivering, it delivers these changes too.
+     * @remarks The writer mutex must not be taken by the calling thread.
+     */
+    void deliver_to_local_readers();
+
+    /**
+     * Tells the writer that the calling thread delivers the changes it is about to add to the readers of this
+     * process, by calling release_local_delivery once it releases the writer mutex.
+     * @remarks This function is non thread-safe.
+     */
+    void hold_local_delivery_nts();
+
+    /**
+     * Gives up a hold taken by hold_local_delivery_nts without delivering, for example to wait for
+     * acknowledgements with the writer mutex released.
+     * @remarks This function is non thread-safe.
+     */
+    void unhold_local_delivery_nts();
+
+    /**
+     * Delivers the changes held by hold_local_delivery_nts.
+     * @remarks The writer mutex must not be taken by the calling thread.
+     */
+    void release_local_delivery();
+
     protected:
 
+    //!Change, gap or heartbeat to hand to a reader of this process without the writer mutex taken.
+    struct LocalDelivery
+    {
+        enum Kind
+        {
+            DATA,
+            GAP,
+            HEARTBEAT
+        };
+
+        Kind kind;
+
+        GUID_t reader_guid;
+
+        //!Change of a DATA, lent from the history until the delivery finishes.
+        CacheChange_t* change;
+
+        //!Irrelevant sequence number of a GAP, or first available one of a HEARTBEAT.
+        SequenceNumber_t seq_num;
+
+        //!Count of a HEARTBEAT.
+        uint32_t count;
+
+        //!The following deliveries to the reader are skipped if it does not accept this one.
+        bool in_order;
+
+        bool delivered;
+    };
+
     //!Is the data sent directly or announced by HB and THEN send to the ones who ask for it?.
     bool m_pushMode;
     //!Group created to send messages more efficiently
@@ -200,6 +258,9 @@ class RTPSWriter : public Endpoint
     bool is_async_;
     //!Separate sending activated
     bool m_separateSendingEnabled;
+    //!Event delivering to the readers of this process when no writing thread does. Only set if intraprocess
+    //!delivery is enabled. It has to be deleted in child destructors.
+    IntraprocessDelivery* mp_intraprocessDelivery;
 
     LocatorList_t mAllShrinkedLocatorList;
 
@@ -208,6 +269,76 @@ class RTPSWriter : public Endpoint
     void update_cached_info_nts(std::vector<GUID_t>&& allRemoteReaders,
             std::vector<LocatorList_t>& allLocatorLists);
 
+    /**
+     * Checks whether a matched reader can receive changes directly, without using the transports.
+     * @param reader_guid GUID of the reader.
+     * @return True if intraprocess delivery is enabled and the reader lives in this process.
+     */
+    bool is_local_reader(const GUID_t& reader_guid) const;
+
+    /**
+     * Hands a change directly to a reader of this process.
+     * The reader processes it, and notifies its listener, in the context of the calling thread.
+     * @param change Pointer to the change.
+     * @param reader_guid GUID of the reader.
+     * @return True if the reader accepted the change.
+     */
+    bool intraprocess_delivery(CacheChange_t* change, const GUID_t& reader_guid);
+
+    /**
+     * Tells a reader of this process that a sequence number is not relevant for it.
+     * @param seq_num Irrelevant sequence number.
+     * @param reader_guid GUID of the reader.
+     * @return True if the reader accepted the gap.
+     */
+    bool intraprocess_gap(const SequenceNumber_t& seq_num, const GUID_t& reader_guid);
+
+    /**
+     * Tells a reader of this process the first sequence number available in this writer.
+     * @param first_seq First available sequence number.
+     * @param count Heartbeat count.
+     * @param reader_guid GUID of the reader.
+     * @return True if the reader accepted the heartbeat.
+     */
+    bool intraprocess_heartbeat(const SequenceNumber_t& first_seq, uint32_t count, const GUID_t& reader_guid);
+
+    /**
+     * Queues a change to be handed to a reader of this process once the writer mutex is released.
+     * The change is lent from the history until then.
+     * @remarks This function is non thread-safe.
+     * @param change Pointer to the change.
+     * @param reader_guid GUID of the reader.
+     */
+    void queue_local_delivery_nts(CacheChange_t* change, const GUID_t& reader_guid);
+
+    /**
+     * Drops the queued deliveries to a reader of this process.
+     * @remarks This function is non thread-safe.
+     * @param reader_guid GUID of the reader.
+     */
+    void unqueue_local_deliveries_nts(const GUID_t& reader_guid);
+
+    /**
+     * Records that there are changes for the readers of this process, and makes sure a thread delivers them.
+     * @remarks This function is non thread-safe.
+     */
+    void local_delivery_pending_nts();
+
+    /**
+     * Lists the deliveries to the readers of this process, in addition to the queued ones.
+     * Changes of DATA deliveries have to be lent from the history.
+     * @remarks This function is non thread-safe.
+     * @param deliveries Vector where the deliveries are appended.
+     */
+    virtual void collect_local_deliveries_nts(std::vector<LocalDelivery>& deliveries) { (void)deliveries; }
+
+    /**
+     * Records the result of the deliveries to the readers of this process.
+     * @remarks This function is non thread-safe.
+     * @param deliveries Performed deliveries.
+     */
+    virtual void local_deliveries_done_nts(const std::vector<LocalDelivery>& deliveries) { (void)deliveries; }
+
     /**
      * Initialize the header of hte CDRMessages.
      */
@@ -234,6 +365,20 @@ class RTPSWriter : public Endpoint
 
     private:
 
+    //!Delivers a change, gap or heartbeat to a reader of this process. Called without the writer mutex taken.
+    bool deliver_to_local_reader(const LocalDelivery& delivery);
+
+    //!Deliveries to the readers of this process queued since the last delivery.
+    std::vector<LocalDelivery> m_queuedLocalDeliveries;
+    //!Deliveries being performed. Only used by the thread delivering.
+    std::vector<LocalDelivery> m_localDeliveries;
+    //!There are changes for the readers of this process not handed to a delivering thread yet.
+    bool m_localDeliveryPending;
+    //!A thread is delivering to the readers of this process.
+    bool m_localDeliveryRunning;
+    //!Threads that deliver to the readers of this process once they release the writer mutex.
+    uint32_t m_localDeliveryHolders;
+
     RTPSWriter& operator=(const RTPSWriter&) = delete;
 };
 }
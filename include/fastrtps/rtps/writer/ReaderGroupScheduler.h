@@ -0,0 +1,123 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ReaderGroupScheduler.h
+ */
+
+#ifndef READERGROUPSCHEDULER_H_
+#define READERGROUPSCHEDULER_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include "../common/Guid.h"
+#include "../common/Locator.h"
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+class ReaderProxy;
+
+/**
+ * Remote readers matched with a writer, grouped by the locators they are reached through.
+ * Every reader of a group receives the datagrams sent to any other, so a message only has to be composed once per
+ * group. Groups are updated when readers are matched and unmatched, so sending does not have to look at the
+ * locators of each reader.
+ * @ingroup WRITER_MODULE
+ */
+class ReaderGroupScheduler
+{
+    public:
+
+        //! Readers sharing the same locators.
+        struct Group
+        {
+            LocatorList_t locators;
+
+            std::vector<ReaderProxy*> readers;
+
+            //! GUIDs of the readers, in the same order.
+            std::vector<GUID_t> guids;
+
+            //! Number of readers expecting inline QoS.
+            size_t inline_qos_readers;
+
+            bool expects_inline_qos() const
+            {
+                return inline_qos_readers > 0;
+            }
+        };
+
+        ReaderGroupScheduler();
+
+        //! Number of readers in all the groups.
+        size_t size() const
+        {
+            return m_members.size();
+        }
+
+        //! Whether some reader of any group expects inline QoS.
+        bool expects_inline_qos() const
+        {
+            return m_inline_qos_readers > 0;
+        }
+
+        const std::vector<Group>& groups() const
+        {
+            return m_groups;
+        }
+
+        /**
+         * Adds a reader to the group with its locators, creating the group if there is none.
+         * @return False if the reader was already added.
+         */
+        bool add_reader(ReaderProxy* reader, const GUID_t& guid, const LocatorList_t& locators,
+                bool expects_inline_qos);
+
+        /**
+         * Removes a reader from its group, which is removed when it becomes empty.
+         * Other groups may change their position.
+         * @return False if the reader was not added.
+         */
+        bool remove_reader(const ReaderProxy* reader);
+
+        //! Position of the group of a reader, or the number of groups if it was not added.
+        size_t group_of(const ReaderProxy* reader) const;
+
+    private:
+
+        struct Member
+        {
+            size_t group;
+
+            bool expects_inline_qos;
+        };
+
+        std::vector<Group> m_groups;
+
+        std::unordered_map<const ReaderProxy*, Member> m_members;
+
+        size_t m_inline_qos_readers;
+};
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
+
+#endif
+#endif /* READERGROUPSCHEDULER_H_ */
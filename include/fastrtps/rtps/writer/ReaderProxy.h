@@ -21,15 +21,13 @@
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 #include <algorithm>
 #include <mutex>
-#include <set>
 #include "../common/Types.h"
 #include "../common/Locator.h"
 #include "../common/SequenceNumber.h"
 #include "../common/CacheChange.h"
 #include "../common/FragmentNumber.h"
 #include "../attributes/WriterAttributes.h"
-
-#include <set>
+#include "ChangeForReaderWindow.h"
 
 namespace eprosima
 {
@@ -76,11 +74,11 @@ namespace eprosima
                 void acked_changes_set(const SequenceNumber_t& seqNum);
 
                 /**
-                 * Mark all changes in the vector as requested.
-                 * @param seqNumSet Vector of sequenceNumbers
+                 * Mark all changes in the set as requested.
+                 * @param seqNumSet Set of sequenceNumbers
                  * @return False if any change was set REQUESTED.
                  */
-                bool requested_changes_set(std::vector<SequenceNumber_t>& seqNumSet);
+                bool requested_changes_set(const SequenceNumberSet_t& seqNumSet);
 
                 /*!
                  * @brief Lists all unsent changes. These changes are also relevants and valid.
@@ -89,6 +87,16 @@ namespace eprosima
                 //TODO(Ricardo) Temporal
                 //std::vector<const ChangeForReader_t*> get_unsent_changes() const;
                 std::vector<ChangeForReader_t*> get_unsent_changes();
+                /*!
+                 * @brief Appends all unsent changes to a vector, so callers can reuse it between readers.
+                 * @param unsent_changes Vector where the unsent changes are appended.
+                 */
+                void get_unsent_changes(std::vector<ChangeForReader_t*>& unsent_changes);
+                /*!
+                 * @brief Appends all changes not acknowledged yet to a vector, ordered by sequence number.
+                 * @param changes Vector where the changes are appended.
+                 */
+                void get_unacknowledged_changes(std::vector<ChangeForReader_t*>& changes);
                 /*!
                  * @brief Lists all requested changes.
                  * @return STL vector with the requested change list.
@@ -120,6 +128,12 @@ namespace eprosima
                  */
                 bool thereIsUnacknowledged() const;
 
+                /*!
+                 * @brief Returns the oldest change not acknowledged by the reader.
+                 * @return Pointer to the change, or nullptr if the reader acknowledged all of them.
+                 */
+                const ChangeForReader_t* first_change();
+
                 /**
                  * Get a vector of all unacked changes by this Reader.
                  * @param reqChanges Pointer to a vector of pointers.
@@ -177,17 +191,57 @@ namespace eprosima
 
                 SequenceNumber_t get_low_mark() const { return changesFromRLowMark_; }
 
+                /*!
+                 * @brief Returns whether the reader lives in this process and receives changes without the transports.
+                 * @return True if changes are handed directly to the reader.
+                 */
+                bool is_local_reader() const { return is_local_reader_; }
+
+                /*!
+                 * @brief Sets whether the reader lives in this process and receives changes without the transports.
+                 * @param is_local True if changes are handed directly to the reader.
+                 */
+                void set_local_reader(bool is_local) { is_local_reader_ = is_local; }
+
+                /*!
+                 * @brief Returns whether the local reader already knows the first sequence number it can expect.
+                 */
+                bool local_reader_synchronized() const { return local_reader_synchronized_; }
+
+                //! Records that the local reader was told the first sequence number it can expect.
+                void set_local_reader_synchronized() { local_reader_synchronized_ = true; }
+
                 //!Mutex
                 std::recursive_mutex* mp_mutex;
 
-                std::set<ChangeForReader_t, ChangeForReaderCmp> m_changesForReader;
+                //!Position in the heap of low marks of the writer. Only used for reliable readers.
+                size_t low_mark_index_;
 
-                //!Set of the changes and its state.
                 private:
+
+                /*!
+                 * @brief Removes the oldest changes while they are acknowledged, moving the low mark after them.
+                 * @remarks The writer mutex has to be taken.
+                 */
+                void remove_acknowledged_front_();
+
+                /*!
+                 * @brief Moves the low mark, so the writer keeps track of the changes acknowledged by all readers.
+                 * @remarks The writer mutex has to be taken.
+                 */
+                void set_low_mark_(const SequenceNumber_t& low_mark);
+
+                //!Changes not acknowledged yet and their state.
+                ChangeForReaderWindow changesForReader_;
+
                 //! Last  NACKFRAG count.
                 uint32_t lastNackfragCount_;
 
                 SequenceNumber_t changesFromRLowMark_;
+
+                bool is_local_reader_;
+
+                bool local_reader_synchronized_;
             };
         }
     } /* namespace rtps */
@@ -22,6 +22,7 @@
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 
 #include "RTPSWriter.h"
+#include "ReaderGroupScheduler.h"
 #include "timedevent/PeriodicHeartbeat.h"
 #include <condition_variable>
 #include <mutex>
@@ -54,6 +55,21 @@ namespace eprosima
                 protected:
                 //!Constructor
                 StatefulWriter(RTPSParticipantImpl*,GUID_t& guid,WriterAttributes& att,WriterHistory* hist,WriterListener* listen=nullptr);
+
+                /**
+                 * Lists the changes not acknowledged yet by the matched readers of this process, in order, preceded
+                 * by a heartbeat for the late joiners.
+                 * @remarks This function is non thread-safe.
+                 */
+                void collect_local_deliveries_nts(std::vector<LocalDelivery>& deliveries) override;
+
+                /**
+                 * Marks the changes accepted by the readers of this process as acknowledged. Changes not accepted by
+                 * a reliable reader are retried with the next periodic heartbeat.
+                 * @remarks This function is non thread-safe.
+                 */
+                void local_deliveries_done_nts(const std::vector<LocalDelivery>& deliveries) override;
+
                 private:
                 //!Count of the sent heartbeats.
                 Count_t m_heartbeatCount;
@@ -62,6 +78,8 @@ namespace eprosima
 
                 //! Vector containin all the associated ReaderProxies.
                 std::vector<ReaderProxy*> matched_readers;
+                //! Remote readers of matched_readers grouped by their locators.
+                ReaderGroupScheduler reader_groups_;
                 //!EntityId used to send the HB.(only for builtin types performance)
                 EntityId_t m_HBReaderEntityId;
                 // TODO Join this mutex when main mutex would not be recursive.
@@ -72,6 +90,15 @@ namespace eprosima
                 std::mutex may_remove_change_mutex_;
                 std::condition_variable may_remove_change_cond_;
                 unsigned int may_remove_change_;
+                //! Reliable matched readers, as a binary min-heap on their low marks. The first one has the lowest.
+                std::vector<ReaderProxy*> reliable_low_marks_;
+                //! Number of best-effort matched readers. Their low marks move on every change sent, so they are not
+                //! kept in reliable_low_marks_ but checked when needed.
+                size_t best_effort_readers_;
+                //! Number of matched readers with changes they have not acknowledged yet.
+                size_t readers_with_unacked_changes_;
+                //! Changes of a reader of this process being listed for delivery, reused between readers.
+                std::vector<ChangeForReader_t*> local_changes_;
 
                 public:
                 /**
@@ -186,11 +213,47 @@ namespace eprosima
                  */
                 void send_heartbeat_to_nts(ReaderProxy& remoteReaderProxy, bool final = false);
 
+                /*!
+                 * @brief Adds the periodic heartbeat for the remote readers with unacknowledged changes to a message
+                 * group, which may be shared with other endpoints of the participant.
+                 * @remarks This function is non thread-safe.
+                 * @return True if some remote reader has unacknowledged changes.
+                 */
+                bool send_periodic_heartbeat_nts(RTPSMessageGroup& message_group);
+
+                /*!
+                 * @brief Locators reaching all the remote readers.
+                 * @remarks This function is non thread-safe.
+                 */
+                const LocatorList_t& remote_locators_nts() const { return mAllShrinkedLocatorList; }
+
                 void process_acknack(const GUID_t reader_guid, uint32_t ack_count,
                         const SequenceNumberSet_t& sn_set, bool final_flag);
 
+                /*!
+                 * @brief Retries handing their pending changes to the matched readers living in this process.
+                 */
+                void send_changes_to_local_readers();
+
                 private:
 
+                /*!
+                 * @brief Sends the unsent changes of the remote readers, one message for each group of readers
+                 * sharing their locators and their unsent changes.
+                 * @remarks This function is non thread-safe.
+                 * @return True if some change was sent to a reliable reader.
+                 */
+                bool send_unsent_changes_by_group_nts_();
+
+                /*!
+                 * @brief Gets the GUIDs and locators to send a message to some of the matched remote readers.
+                 * Locators are shrunk once per group of readers, or not at all when all of them are included.
+                 * @remarks This function is non thread-safe.
+                 * @return True if some of the readers expects inline QoS.
+                 */
+                bool get_destinations_nts_(const std::vector<ReaderProxy*>& readers,
+                        std::vector<GUID_t>& remote_readers, LocatorList_t& locators);
+
                 void send_heartbeat_piggyback_nts_(RTPSMessageGroup& message_group);
 
                 void send_heartbeat_piggyback_nts_(const std::vector<GUID_t>& remote_readers, const LocatorList_t& locators, 
@@ -201,6 +264,37 @@ namespace eprosima
 
                 void check_acked_status();
 
+                /*!
+                 * @brief Gets the last sequence number acknowledged by all the matched readers.
+                 * @remarks This function is non thread-safe.
+                 * @return Lowest low mark of the matched readers, or unknown if there are none.
+                 */
+                SequenceNumber_t acked_by_all_low_mark_nts_() const;
+
+                /*!
+                 * @brief Called by a matched reliable ReaderProxy when its low mark moves.
+                 * @remarks This function is non thread-safe.
+                 */
+                void reader_low_mark_changed_nts_(ReaderProxy& reader);
+
+                //! Adds a reliable reader to reliable_low_marks_.
+                void push_low_mark_nts_(ReaderProxy* reader);
+
+                //! Removes a reliable reader from reliable_low_marks_.
+                void erase_low_mark_nts_(ReaderProxy* reader);
+
+                //! Moves the reader at a position of reliable_low_marks_ up or down the heap to where its low mark goes.
+                void fix_low_mark_nts_(size_t index);
+
+                void swap_low_marks_nts_(size_t first, size_t second);
+
+                /*!
+                 * @brief Called by a matched ReaderProxy when it gets its first change to acknowledge,
+                 * or acknowledges the last one.
+                 * @remarks This function is non thread-safe.
+                 */
+                void reader_unacked_changes_changed_nts_(bool has_unacked_changes);
+
                 bool disableHeartbeatPiggyback_;
 
                 const uint32_t sendBufferSize_;
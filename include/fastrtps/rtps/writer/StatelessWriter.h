@@ -116,8 +116,12 @@ class StatelessWriter : public RTPSWriter
 
     void update_locators_nts_(const GUID_t& optionalGuid);
 
+    bool is_local_matched_reader_nts_(const GUID_t& reader_guid) const;
+
     std::vector<ReaderLocator> reader_locators, fixed_locators;
     std::vector<RemoteReaderAttributes> m_matched_readers;
+    //! Matched readers of this process, which receive changes without the transports.
+    std::vector<GUID_t> m_local_readers;
     std::vector<std::unique_ptr<FlowController> > m_controllers;
 };
 }
@@ -0,0 +1,63 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file IntraprocessDelivery.h
+ *
+ */
+
+#ifndef INTRAPROCESSDELIVERY_H_
+#define INTRAPROCESSDELIVERY_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include "../../resources/TimedEvent.h"
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps {
+
+class RTPSWriter;
+
+/**
+ * IntraprocessDelivery class, used to hand changes to the readers of this process when no writing thread does,
+ * for example to a reader just matched with a writer keeping its history.
+ * @ingroup WRITER_MODULE
+ */
+class IntraprocessDelivery : public TimedEvent
+{
+public:
+	virtual ~IntraprocessDelivery();
+	/**
+	*
+	* @param p_RTPSWriter
+	*/
+	IntraprocessDelivery(RTPSWriter* p_RTPSWriter);
+
+	/**
+	* Method invoked when the event occurs
+	*
+	* @param code Code representing the status of the event
+	* @param msg Message associated to the event
+	*/
+	void event(EventCode code, const char* msg= nullptr);
+
+	//!Pointer to the writer
+	RTPSWriter* mp_RTPSWriter;
+};
+
+}
+}
+} /* namespace eprosima */
+#endif
+#endif /* INTRAPROCESSDELIVERY_H_ */
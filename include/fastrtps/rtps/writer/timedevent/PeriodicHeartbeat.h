@@ -54,8 +54,16 @@ class PeriodicHeartbeat: public TimedEvent
          */
         void event(EventCode code, const char* msg= nullptr);
 
-        //!
-        RTPSMessageGroup_t m_cdrmessages;
+        /**
+         * Adds the heartbeat of the writer to a message group shared with other endpoints of the participant,
+         * restarting the timer while some remote reader has unacknowledged changes.
+         * @param group Message group sending to any destination.
+         */
+        void add_messages(RTPSMessageGroup& group);
+
+        //! Locators reaching the readers the heartbeat is sent to.
+        LocatorList_t destination_locators() const;
+
         //!
         StatefulWriter* mp_SFW;
 };
@@ -22,6 +22,10 @@
 
 #include "../rtps/common/Guid.h"
 #include "../attributes/SubscriberAttributes.h"
+#include "SampleInfo.h"
+
+#include <functional>
+#include <vector>
 
 
 
@@ -29,7 +33,6 @@ namespace eprosima {
 namespace fastrtps {
 
 class SubscriberImpl;
-class SampleInfo_t;
 
 /**
  * Class Subscriber, contains the public API that allows the user to control the reception of messages.
@@ -74,6 +77,93 @@ public:
      */
     bool takeNextData(void* data,SampleInfo_t* info);
 
+    /**
+     * Read up to max_samples unread samples from the Subscriber, locking its history only once.
+     * @param data_values Vector where the samples are appended. T must be the type of the topic.
+     * @param sample_infos Vector where the SampleInfo_t of each sample is appended.
+     * @param max_samples Maximum number of samples to read.
+     * @return Number of samples read.
+     */
+    template<typename T>
+    size_t read(std::vector<T>& data_values, std::vector<SampleInfo_t>& sample_infos, size_t max_samples)
+    {
+        return readData(next_value(data_values), sample_infos, max_samples);
+    }
+
+    /**
+     * Take up to max_samples samples from the Subscriber, locking its history only once.
+     * The samples are removed from the subscriber.
+     * @param data_values Vector where the samples are appended. T must be the type of the topic.
+     * @param sample_infos Vector where the SampleInfo_t of each sample is appended.
+     * @param max_samples Maximum number of samples to take.
+     * @return Number of samples taken.
+     */
+    template<typename T>
+    size_t take(std::vector<T>& data_values, std::vector<SampleInfo_t>& sample_infos, size_t max_samples)
+    {
+        return takeData(next_value(data_values), sample_infos, max_samples);
+    }
+
+    /**
+     * Read up to max_samples unread samples of one instance, locking the history only once.
+     * Only topics with key keep instances.
+     * @param data_values Vector where the samples are appended. T must be the type of the topic.
+     * @param sample_infos Vector where the SampleInfo_t of each sample is appended.
+     * @param max_samples Maximum number of samples to read.
+     * @param handle Handle of the instance.
+     * @return Number of samples read.
+     */
+    template<typename T>
+    size_t read_instance(std::vector<T>& data_values, std::vector<SampleInfo_t>& sample_infos,
+            size_t max_samples, const rtps::InstanceHandle_t& handle)
+    {
+        return readInstanceData(next_value(data_values), sample_infos, max_samples, handle);
+    }
+
+    /**
+     * Take up to max_samples samples of one instance, locking the history only once.
+     * Only topics with key keep instances.
+     * @param data_values Vector where the samples are appended. T must be the type of the topic.
+     * @param sample_infos Vector where the SampleInfo_t of each sample is appended.
+     * @param max_samples Maximum number of samples to take.
+     * @param handle Handle of the instance.
+     * @return Number of samples taken.
+     */
+    template<typename T>
+    size_t take_instance(std::vector<T>& data_values, std::vector<SampleInfo_t>& sample_infos,
+            size_t max_samples, const rtps::InstanceHandle_t& handle)
+    {
+        return takeInstanceData(next_value(data_values), sample_infos, max_samples, handle);
+    }
+
+    /**
+     * Read next unread sample from the Subscriber without copying it.
+     * The change holding the serialized payload of the sample is lent to the application, and it stays valid until
+     * it is given back with returnLoan. Every loan has to be returned before the Subscriber is removed.
+     * Samples of plain types are used in place through TopicDataType::plain_sample.
+     * @param change Returned pointer to the change of the sample.
+     * @param info Pointer to a SampleInfo_t structure that informs you about your sample.
+     * @return True if a sample was read.
+     */
+    bool readNextLoan(const rtps::CacheChange_t** change, SampleInfo_t* info);
+
+    /**
+     * Take next sample from the Subscriber without copying it. The sample is removed from the subscriber, but
+     * its change stays valid until it is given back with returnLoan.
+     * Every loan has to be returned before the Subscriber is removed.
+     * @param change Returned pointer to the change of the sample.
+     * @param info Pointer to a SampleInfo_t structure that informs you about your sample.
+     * @return True if a sample was taken.
+     */
+    bool takeNextLoan(const rtps::CacheChange_t** change, SampleInfo_t* info);
+
+    /**
+     * Give back a change lent by readNextLoan or takeNextLoan.
+     * @param change Pointer to the change.
+     * @return True if the change was lent by this Subscriber.
+     */
+    bool returnLoan(const rtps::CacheChange_t* change);
+
     /**
      * Update the Attributes of the subscriber;
      * @param att Reference to a SubscriberAttributes object to update the parameters;
@@ -102,6 +192,27 @@ public:
     uint64_t getUnreadCount() const;
 
 private:
+
+    //! Returns a function that appends a default constructed value to a vector and gives its address.
+    template<typename T>
+    static std::function<void*()> next_value(std::vector<T>& data_values)
+    {
+        return [&data_values]() -> void*
+        {
+            data_values.emplace_back();
+            return &data_values.back();
+        };
+    }
+
+    size_t readData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& sample_infos,
+            size_t max_samples);
+    size_t takeData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& sample_infos,
+            size_t max_samples);
+    size_t readInstanceData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& sample_infos,
+            size_t max_samples, const rtps::InstanceHandle_t& handle);
+    size_t takeInstanceData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& sample_infos,
+            size_t max_samples, const rtps::InstanceHandle_t& handle);
+
     SubscriberImpl* mp_impl;
 };
 
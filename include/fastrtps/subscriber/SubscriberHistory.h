@@ -23,9 +23,14 @@
 
 #include <fastrtps/rtps/resources/ResourceManagement.h>
 #include "../rtps/history/ReaderHistory.h"
+#include "../rtps/history/InstanceChanges.h"
 #include "../qos/QosPolicies.h"
 #include "SampleInfo.h"
 
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
 
 
 namespace eprosima {
@@ -46,8 +51,8 @@ class SubscriberHistory: public rtps::ReaderHistory
 {
     public:
 
-        typedef std::pair<rtps::InstanceHandle_t,std::vector<rtps::CacheChange_t*>> t_p_I_Change;
-        typedef std::vector<t_p_I_Change> t_v_Inst_Caches;
+        typedef std::unordered_map<rtps::InstanceHandle_t, rtps::InstanceChanges, rtps::InstanceHandleHash>
+            t_m_Inst_Caches;
 
         /**
          * Constructor. Requires information about the subscriner
@@ -55,9 +60,11 @@ class SubscriberHistory: public rtps::ReaderHistory
          * @param payloadMax Maximum payload size per change
          * @param history History QoS policy for the reader
          * @param resource Resource Limit QoS policy for the reader
+         * @param arena Arena of the payloads in DYNAMIC_RESERVE_MEMORY_MODE. If nullptr, the History creates its own.
          */
         SubscriberHistory(SubscriberImpl* pimpl,uint32_t payloadMax,
-                HistoryQosPolicy& history,ResourceLimitsQosPolicy& resource, rtps::MemoryManagementPolicy_t mempolicy);
+                HistoryQosPolicy& history,ResourceLimitsQosPolicy& resource, rtps::MemoryManagementPolicy_t mempolicy,
+                std::shared_ptr<rtps::PayloadArena> arena = nullptr);
         virtual ~SubscriberHistory();
 
         /**
@@ -80,17 +87,48 @@ class SubscriberHistory: public rtps::ReaderHistory
         bool takeNextData(void* data, SampleInfo_t* info);
         ///@}
 
+        /** @name Read or take several samples.
+         * Methods to read or take up to max_samples samples, locking the History only once for all of them.
+         * @param next_data Function returning the object where the next sample has to be stored.
+         * @param infos Vector where the SampleInfo_t of each sample is appended.
+         * @param max_samples Maximum number of samples to read or take.
+         * @param handle Instance of the samples, for the per-instance variants.
+         * @return Number of samples read or taken.
+         */
+        ///@{
+        size_t readData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& infos,
+                size_t max_samples);
+        size_t takeData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& infos,
+                size_t max_samples);
+        size_t readInstanceData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& infos,
+                size_t max_samples, const rtps::InstanceHandle_t& handle);
+        size_t takeInstanceData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& infos,
+                size_t max_samples, const rtps::InstanceHandle_t& handle);
+        ///@}
+
         bool readNextBuffer(SerializedPayload_t* data, SampleInfo_t* info);
         bool takeNextBuffer(SerializedPayload_t* data, SampleInfo_t* info);
 
+        /** @name Read or take loan methods.
+         * Methods to read or take the next sample lending its change instead of copying its payload.
+         * The change is valid until it is given back with return_loan.
+         * @param change Returned pointer to the change of the sample.
+         * @param info Pointer to a SampleInfo_t object where you want
+         * to store the information about the retrieved data
+         */
+        ///@{
+        bool readNextLoan(const rtps::CacheChange_t** change, SampleInfo_t* info);
+        bool takeNextLoan(const rtps::CacheChange_t** change, SampleInfo_t* info);
+        ///@}
+
 
         /**
          * This method is called to remove a change from the SubscriberHistory.
          * @param change Pointer to the CacheChange_t.
-         * @param vit Pointer to the iterator of the key-ordered cacheChange vector.
+         * @param vit Pointer to the iterator of the instance of the change.
          * @return True if removed.
          */
-        bool remove_change_sub(rtps::CacheChange_t* change,t_v_Inst_Caches::iterator* vit=nullptr);
+        bool remove_change_sub(rtps::CacheChange_t* change,t_m_Inst_Caches::iterator* vit=nullptr);
 
         //!Increase the unread count.
         inline void increaseUnreadCount()
@@ -117,8 +155,8 @@ class SubscriberHistory: public rtps::ReaderHistory
 
         //!Number of unread CacheChange_t.
         uint64_t m_unreadCacheCount;
-        //!Vector of pointer to the CacheChange_t divided by key.
-        t_v_Inst_Caches m_keyedChanges;
+        //!Changes of each instance, indexed by instance handle.
+        t_m_Inst_Caches m_keyedChanges;
         //!HistoryQosPolicy values.
         HistoryQosPolicy m_historyQos;
         //!ResourceLimitsQosPolicy values.
@@ -130,7 +168,52 @@ class SubscriberHistory: public rtps::ReaderHistory
         void * mp_getKeyObject;
 
 
-        bool find_Key(rtps::CacheChange_t* a_change,t_v_Inst_Caches::iterator* vecPairIterrator);
+        /**
+         * Finds the instance of a change, creating it if the limit of instances is not reached.
+         * @param a_change Pointer to the change.
+         * @param vit_out Returned iterator to the instance.
+         * @return True if the instance exists or was created.
+         */
+        bool find_Key(rtps::CacheChange_t* a_change,t_m_Inst_Caches::iterator* vit_out);
+
+        //!Sample of a change lent while it is deserialized without holding the mutex.
+        struct LentSample
+        {
+            LentSample() : change(nullptr), is_alive(false), needs_key(false) {}
+
+            const rtps::CacheChange_t* change;
+
+            bool is_alive;
+
+            //!True if the instance handle has to be got from the deserialized data.
+            bool needs_key;
+        };
+
+        //!Reads or takes up to max_samples samples, of all the instances or of one of them.
+        size_t get_data(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& infos,
+                size_t max_samples, const rtps::InstanceHandle_t* handle, bool take);
+
+        //!Lends the available samples of an instance, oldest first. The mutex must be held.
+        void get_instance_samples(std::vector<SampleInfo_t>& infos, size_t max_samples,
+                const rtps::InstanceHandle_t& handle, bool take, std::vector<LentSample>& samples);
+
+        /**
+         * Marks a change as read, fills its SampleInfo_t and lends its payload. The mutex must be held.
+         * @param change Pointer to the change.
+         * @param wp Pointer to the WriterProxy of the change, if any.
+         * @param info Pointer to the SampleInfo_t to fill, if any.
+         * @param take True to remove the change from the History.
+         * @param vit Pointer to the iterator of the instance of the change, if known.
+         * @return Lent sample.
+         */
+        LentSample lend_change(rtps::CacheChange_t* change, rtps::WriterProxy* wp, SampleInfo_t* info, bool take,
+                t_m_Inst_Caches::iterator* vit = nullptr);
+
+        //!Deserializes a lent sample and returns its loan. The mutex does not need to be held.
+        void deliver_sample(const LentSample& sample, void* data, SampleInfo_t* info);
+
+        //!Fills the SampleInfo_t of a change.
+        void fill_sample_info(rtps::CacheChange_t* change, rtps::WriterProxy* wp, SampleInfo_t* info);
 };
 
 } /* namespace fastrtps */
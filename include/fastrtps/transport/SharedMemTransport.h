@@ -0,0 +1,179 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef SHARED_MEM_TRANSPORT_H
+#define SHARED_MEM_TRANSPORT_H
+
+#include "TransportInterface.h"
+#include "SharedMemTransportDescriptor.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+class SharedMemSegment;
+class SharedMemChannelResource;
+
+/**
+ * Transport for participants living on the same host.
+ *    - Every input channel is a shared memory segment named after its port. The segment holds a lock-free
+ *       ring of message cells, so any number of local processes can write into it while a single thread of
+ *       the owner reads from it. Messages are processed in place, without going through the kernel.
+ *
+ *    - Locators of this transport carry as address an identifier of the machine boot and of the shared memory
+ *       namespace. Only locators with the identifier of this process are considered reachable, so the
+ *       NetworkFactory prefers them over the network locators of the same remote endpoint. Those network
+ *       locators are still used when sending through shared memory fails.
+ *
+ *    - Multicast is not supported. Discovery traffic keeps using the multicast locators of the other
+ *       registered transports.
+ * @ingroup TRANSPORT_MODULE
+ */
+class SharedMemTransport : public TransportInterface
+{
+public:
+
+    RTPS_DllAPI SharedMemTransport(const SharedMemTransportDescriptor&);
+
+    virtual ~SharedMemTransport() override;
+
+    bool init() override;
+
+    //! Checks whether the output channel is open. All local destinations share the same output channel.
+    virtual bool IsOutputChannelOpen(const Locator_t&) const override;
+
+    //! Checks whether the segment for the given port is created and being listened.
+    virtual bool IsInputChannelOpen(const Locator_t&) const override;
+
+    //! Checks for SHM kind.
+    virtual bool IsLocatorSupported(const Locator_t&) const override;
+
+    //! Only locators of this host are allowed.
+    virtual bool IsLocatorAllowed(const Locator_t&) const override;
+
+    virtual Locator_t RemoteToMainLocal(const Locator_t& remote) const override;
+
+    virtual bool OpenOutputChannel(const Locator_t&) override;
+    virtual bool OpenExtraOutputChannel(const Locator_t&) override;
+
+    /**
+    * Creates the shared memory segment for the locator port and starts listening on it.
+    * It fails when a live process already owns the segment.
+    */
+    virtual bool OpenInputChannel(const Locator_t&, TransportReceiverInterface*, uint32_t) override;
+
+    //! Unmaps every segment opened to send.
+    virtual bool CloseOutputChannel(const Locator_t&) override;
+
+    //! Stops the listening thread and removes the segment for the given port.
+    virtual bool CloseInputChannel(const Locator_t&) override;
+
+    //! Reports whether Locators correspond to the same port.
+    virtual bool DoInputLocatorsMatch(const Locator_t&, const Locator_t&) const override;
+    virtual bool DoOutputLocatorsMatch(const Locator_t&, const Locator_t&) const override;
+
+    /**
+    * Copies the message into the ring of the segment listening on the port of remoteLocator.
+    * It does not block: when the ring is full the message is dropped, as a full socket buffer would do.
+    * @param sendBuffer Slice into the raw data to send.
+    * @param sendBufferSize Size of the raw data. It must not exceed the maxMessageSize of the descriptor.
+    * @param localLocator Locator mapping to the channel we're sending from.
+    * @param remoteLocator Locator describing the remote destination we're sending to.
+    */
+    virtual bool Send(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator,
+        const Locator_t& remoteLocator) override;
+
+    virtual bool Send(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator,
+        const Locator_t& remoteLocator, ChannelResource* pChannelResource) override;
+
+    //! Gathers the buffers of the message straight into the cell of the remote segment.
+    virtual bool Send(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes, const Locator_t& localLocator,
+        const Locator_t& remoteLocator) override;
+
+    virtual LocatorList_t NormalizeLocator(const Locator_t& locator) override;
+
+    virtual LocatorList_t ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists) override;
+
+    //! Reports whether the locator points to a segment in this host.
+    virtual bool is_local_locator(const Locator_t& locator) const override;
+
+    TransportDescriptorInterface* get_configuration() override { return &mConfiguration_; }
+
+    virtual void AddDefaultOutputLocator(LocatorList_t &defaultList) override;
+
+    virtual bool getDefaultMetatrafficMulticastLocators(LocatorList_t &locators,
+        uint32_t metatraffic_multicast_port) const override;
+
+    virtual bool getDefaultMetatrafficUnicastLocators(LocatorList_t &locators,
+        uint32_t metatraffic_unicast_port) const override;
+
+    virtual bool getDefaultUnicastLocators(LocatorList_t &locators, uint32_t unicast_port) const override;
+
+    virtual bool fillMetatrafficMulticastLocator(Locator_t &locator,
+        uint32_t metatraffic_multicast_port) const override;
+
+    virtual bool fillMetatrafficUnicastLocator(Locator_t &locator, uint32_t metatraffic_unicast_port) const override;
+
+    virtual bool configureInitialPeerLocator(Locator_t &locator, const PortParameters &port_params, uint32_t domainId,
+        LocatorList_t& list) const override;
+
+    virtual bool fillUnicastLocator(Locator_t &locator, uint32_t well_known_port) const override;
+
+protected:
+
+    SharedMemTransportDescriptor mConfiguration_;
+
+    //! Identifier of the processes sharing segments with this one, stored as the locator address.
+    octet mHostId[16];
+
+    //! Whether the identifier could be determined. The transport cannot be used otherwise.
+    bool mHostIdValid;
+
+    mutable std::recursive_mutex mInputMapMutex;
+    std::map<uint32_t, SharedMemChannelResource*> mInputChannels;
+
+    mutable std::mutex mOutputMapMutex;
+    std::map<uint32_t, std::shared_ptr<SharedMemSegment>> mOutputSegments;
+    bool mOutputChannelOpen;
+
+    //! Fills the kind and address of the locator with the ones of this host.
+    void FillLocalLocator(Locator_t& locator) const;
+
+    //! Name of the shared memory segment listened on the given port.
+    std::string SegmentName(uint32_t port) const;
+
+    //! Returns the segment to write to the given port, mapping it if needed.
+    std::shared_ptr<SharedMemSegment> GetOutputSegment(uint32_t port);
+
+    //! Copies a message made of several buffers into the segment listening on the port of remoteLocator.
+    bool SendBuffers(const NetworkBuffer* buffers, size_t bufferCount, uint32_t totalBytes,
+        const Locator_t& localLocator, const Locator_t& remoteLocator);
+
+    /** Function to be called from a new thread, which takes care of waiting for messages on the
+    segment of the channel and delivering them to its receiver.
+    @param input_locator - Locator that triggered the creation of the resource
+    */
+    void performListenOperation(SharedMemChannelResource* pChannelResource, Locator_t input_locator);
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // SHARED_MEM_TRANSPORT_H
@@ -0,0 +1,67 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef SHARED_MEM_TRANSPORT_DESCRIPTOR_H
+#define SHARED_MEM_TRANSPORT_DESCRIPTOR_H
+
+#include "./TransportDescriptorInterface.h"
+#include "../fastrtps_dll.h"
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+class TransportInterface;
+
+static const uint32_t s_defaultSharedMemRingCells = 128;
+static const uint32_t s_defaultSharedMemSegmentPermissions = 0600;
+
+/**
+ * Shared memory transport configuration
+ *
+ * - ring_cell_count: number of messages each receiving port can hold before senders start
+ *                    dropping. Every cell reserves maxMessageSize bytes of shared memory.
+ *
+ * - segment_name_prefix: prefix of the shared memory objects created for every receiving port.
+ *                        Participants only reach each other when they use the same prefix.
+ *
+ * - segment_permissions: permissions of the shared memory objects created for every receiving port.
+ *                        By default only processes of the same user can send to them.
+ * @ingroup TRANSPORT_MODULE
+ */
+typedef struct SharedMemTransportDescriptor : public TransportDescriptorInterface
+{
+    virtual ~SharedMemTransportDescriptor(){}
+
+    virtual TransportInterface* create_transport() const override;
+
+    virtual uint32_t min_send_buffer_size() const override { return maxMessageSize * ring_cell_count; }
+
+    RTPS_DllAPI SharedMemTransportDescriptor();
+
+    RTPS_DllAPI SharedMemTransportDescriptor(const SharedMemTransportDescriptor& t);
+
+    uint32_t ring_cell_count;
+
+    std::string segment_name_prefix;
+
+    uint32_t segment_permissions;
+} SharedMemTransportDescriptor;
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // SHARED_MEM_TRANSPORT_DESCRIPTOR_H
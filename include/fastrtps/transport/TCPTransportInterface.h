@@ -206,6 +206,17 @@ public:
     virtual bool Send(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator,
         const Locator_t& remoteLocator, ChannelResource* pChannelResource) override;
 
+    /**
+    * Blocking Send of a message made of several buffers. They are written to the socket together with the
+    * TCP header in a single gathered write, without copying them.
+    * @param buffers Slices of the message, in order.
+    * @param totalBytes Sum of the sizes of all the buffers. It must not exceed the sendBufferSize of the descriptor.
+    * @param localLocator Locator mapping to the channel we're sending from.
+    * @param remoteLocator Locator describing the remote destination we're sending to.
+    */
+    virtual bool Send(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes, const Locator_t& localLocator,
+        const Locator_t& remoteLocator) override;
+
     virtual LocatorList_t ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists) override;
 
     //! Callback called each time that an incomming connection is accepted.
@@ -287,7 +298,10 @@ protected:
     //! Methods to manage the TCP headers and their CRC values.
     bool CheckCRC(const TCPHeader &header, const octet *data, uint32_t size) const;
     void CalculateCRC(TCPHeader &header, const octet *data, uint32_t size) const;
+    void CalculateCRC(TCPHeader &header, const NetworkBuffer* buffers, size_t bufferCount) const;
     void FillTCPHeader(TCPHeader& header, const octet* sendBuffer, uint32_t sendBufferSize, uint16_t logicalPort) const;
+    void FillTCPHeader(TCPHeader& header, const NetworkBuffer* buffers, size_t bufferCount, uint32_t totalBytes,
+        uint16_t logicalPort) const;
 
     //! Cleans the sockets pending to delete.
     void CleanDeletedSockets();
@@ -328,9 +342,21 @@ protected:
     size_t Send(TCPChannelResource* pChannelResource, const octet* data, size_t size, eSocketErrorCodes &error) const;
     size_t Send(TCPChannelResource* pChannelResource, const octet* data, size_t size) const;
 
-    //! Sends the given buffer by the given socket.
-    bool SendThroughSocket(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& remoteLocator,
-        TCPChannelResource* socket);
+    //! Writes an asio buffer sequence to the socket of the given channel.
+    template<typename ConstBufferSequence>
+    size_t SendBuffers(TCPChannelResource* pChannelResource, const ConstBufferSequence& buffers,
+        eSocketErrorCodes &error) const;
+
+    //! Returns the connected channel to send to the given locator, or nullptr if it is not ready yet.
+    TCPChannelResource* GetOutputChannelResource(const Locator_t& remoteLocator, uint32_t sendBufferSize);
+
+    //! Sends a message made of several buffers, preceded by its TCP header, through the given channel.
+    bool SendThroughChannel(const NetworkBuffer* buffers, size_t bufferCount, uint32_t totalBytes,
+        const Locator_t& remoteLocator, TCPChannelResource* pChannelResource);
+
+    //! Sends the given buffers by the given socket.
+    bool SendThroughSocket(const std::vector<asio::const_buffer>& buffers, uint32_t totalBytes,
+        const Locator_t& remoteLocator, TCPChannelResource* socket);
 
     virtual void SetReceiveBufferSize(uint32_t size) = 0;
     virtual void SetSendBufferSize(uint32_t size) = 0;
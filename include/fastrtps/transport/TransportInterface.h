@@ -15,9 +15,11 @@
 #ifndef TRANSPORT_INTERFACE_H
 #define TRANSPORT_INTERFACE_H
 
+#include <cstring>
 #include <memory>
 #include <vector>
 #include "../rtps/common/Locator.h"
+#include "../rtps/common/NetworkBuffer.h"
 #include "../rtps/common/PortParameters.h"
 #include "./TransportDescriptorInterface.h"
 #include "./TransportReceiverInterface.h"
@@ -92,6 +94,15 @@ public:
 
     virtual bool OpenInputChannel(const Locator_t&, TransportReceiverInterface*, uint32_t) = 0;
 
+    /**
+    * Reports how many threads may call the receiver of the input channel for the given locator at the same time.
+    * Receivers keep independent processing state for each of them.
+    */
+    virtual uint32_t max_concurrent_receptions(const Locator_t&) const
+    {
+        return 1;
+    }
+
     /**
     * Must close the channel that maps to/from the given locator.
     * IMPORTANT: It MUST be safe to call this method even during a Send operation on another thread. You must implement
@@ -119,6 +130,47 @@ public:
 
     virtual bool Send(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator, const Locator_t& remoteLocator, ChannelResource* pChannelResource) = 0;
 
+    /**
+     * Blocking send of a message made of several buffers, through the outbound channel that maps to the localLocator,
+     * targeted to the remote address defined by remoteLocator. The buffers are sent in order as a single message.
+     * Transports able to do so should gather them without copying. By default, they are copied into a contiguous
+     * buffer and sent with the single buffer version.
+     * @param buffers Slices of the message, in order. At most s_maximumNetworkBuffers are passed.
+     * @param totalBytes Sum of the sizes of all the buffers.
+     */
+    virtual bool Send(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes, const Locator_t& localLocator,
+        const Locator_t& remoteLocator)
+    {
+        static thread_local std::vector<octet> flat_buffer;
+        flat_buffer.resize(totalBytes);
+
+        uint32_t position = 0;
+        for (const NetworkBuffer& buffer : buffers)
+        {
+            memcpy(flat_buffer.data() + position, buffer.buffer, buffer.size);
+            position += buffer.size;
+        }
+
+        return Send(flat_buffer.data(), totalBytes, localLocator, remoteLocator);
+    }
+
+    /**
+     * Blocking send of the same message to several remote destinations, through the outbound channel that maps to
+     * the localLocator. Transports able to do so may send all the datagrams at once. By default, each destination
+     * is sent on its own.
+     * @return True if the message was sent to any of the destinations.
+     */
+    virtual bool SendToLocators(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes,
+        const Locator_t& localLocator, const LocatorList_t& remoteLocators)
+    {
+        bool success = false;
+        for (const Locator_t& remoteLocator : remoteLocators)
+        {
+            success |= Send(buffers, totalBytes, localLocator, remoteLocator);
+        }
+        return success;
+    }
+
     //virtual ChannelResource* FindSocket(const Locator_t& remoteLocator) = 0;
 
     virtual LocatorList_t NormalizeLocator(const Locator_t& locator) = 0;
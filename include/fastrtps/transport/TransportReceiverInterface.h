@@ -16,6 +16,7 @@
 #define TRANSPORT_RECEIVER_INTERFACE_H
 
 #include "../rtps/common/Locator.h"
+#include "../rtps/common/ReceiveBuffer.h"
 
 namespace eprosima {
 namespace fastrtps {
@@ -40,6 +41,20 @@ public:
      */
     virtual void OnDataReceived(const octet* data, const uint32_t size,
         const Locator_t& localLocator, const Locator_t& remoteLocator) = 0;
+
+    /**
+     * Method to be called by transports receiving into pooled buffers.
+     * The receiver may keep references to the buffer, so payloads are not copied out of it.
+     * @param buffer Buffer holding the received data, at its beginning.
+     * @param size Number of bytes received.
+     * @param localLocator Locator identifying the local endpoint.
+     * @param remoteLocator Locator identifying the remote endpoint.
+     */
+    virtual void OnDataReceived(ReceiveBuffer& buffer, const uint32_t size,
+        const Locator_t& localLocator, const Locator_t& remoteLocator)
+    {
+        OnDataReceived(buffer.data(), size, localLocator, remoteLocator);
+    }
 };
 
 } // namespace rtps
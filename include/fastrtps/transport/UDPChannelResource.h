@@ -16,6 +16,7 @@
 #define UDP_CHANNEL_RESOURCE_INFO_
 
 #include <fastrtps/transport/ChannelResource.h>
+#include <fastrtps/rtps/common/ReceiveBuffer.h>
 
 namespace eprosima{
 namespace fastrtps{
@@ -127,9 +128,22 @@ public:
         return mMsgReceiver;
     }
 
+    /**
+     * Buffer to receive the next message into.
+     * A new one is taken from the pool when payloads of the previous message still reference it.
+     */
+    ReceiveBuffer& GetReceiveBuffer();
+
+    inline const std::shared_ptr<ReceiveBufferPool>& GetReceiveBufferPool() const
+    {
+        return mReceiveBuffers;
+    }
+
 private:
 
     TransportReceiverInterface* mMsgReceiver; //Associated Readers/Writers inside of MessageReceiver
+    std::shared_ptr<ReceiveBufferPool> mReceiveBuffers;
+    ReceiveBuffer* mReceiveBuffer;
     eProsimaUDPSocket socket_;
     bool only_multicast_purpose_;
     std::string interface_;
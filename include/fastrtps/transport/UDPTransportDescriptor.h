@@ -31,6 +31,16 @@ class TransportInterface;
  *                  fail.
  *
  * - interfaceWhiteList: Lists the allowed interfaces.
+ *
+ * - max_messages_per_batch: Maximum number of datagrams received or sent with a single system call,
+ *                  where the platform supports it (recvmmsg/sendmmsg). Values lower than 2 disable batching.
+ *
+ * - reactor_threads: Number of threads of the epoll reactor shared by the input channels of every UDP transport
+ *                  of the process, where the platform supports it. 0 keeps a dedicated thread per input channel.
+ *
+ * - unicast_sockets_per_port: Number of sockets opened on each unicast input port with SO_REUSEPORT, where the
+ *                  platform supports it. The kernel spreads incoming flows among them, and each one is processed by
+ *                  its own thread and MessageReceiver.
  * @ingroup TRANSPORT_MODULE
  */
 typedef struct UDPTransportDescriptor: public SocketTransportDescriptor
@@ -42,6 +52,12 @@ typedef struct UDPTransportDescriptor: public SocketTransportDescriptor
    RTPS_DllAPI UDPTransportDescriptor(const UDPTransportDescriptor& t);
 
    uint16_t m_output_udp_socket;
+
+   uint32_t max_messages_per_batch;
+
+   uint32_t reactor_threads;
+
+   uint32_t unicast_sockets_per_port;
 } UDPTransportDescriptor;
 
 } // namespace rtps
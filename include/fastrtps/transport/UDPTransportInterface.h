@@ -32,6 +32,8 @@ namespace eprosima{
 namespace fastrtps{
 namespace rtps{
 
+class SocketReactor;
+
 class UDPTransportInterface : public TransportInterface
 {
 public:
@@ -65,6 +67,9 @@ public:
 
    //! Opens a socket on the given address and port (as long as they are white listed).
    virtual bool OpenOutputChannel(const Locator_t&) override;
+
+   //! Number of sockets opened on the port when it is a unicast locator, as each one has its own thread.
+   virtual uint32_t max_concurrent_receptions(const Locator_t&) const override;
    virtual bool OpenExtraOutputChannel(const Locator_t&) override;
 
    /**
@@ -104,6 +109,20 @@ public:
    virtual bool Send(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator,
        const Locator_t& remoteLocator, ChannelResource* pChannelResource) override;
 
+   /**
+   * Blocking Send of a message made of several buffers. They are gathered into a single datagram by the
+   * socket, without copying them.
+   */
+   virtual bool Send(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes, const Locator_t& localLocator,
+       const Locator_t& remoteLocator) override;
+
+   /**
+   * Blocking Send to several destinations. When batching is enabled in the descriptor, and the platform
+   * supports it, the datagrams for each socket are sent with as few system calls as possible.
+   */
+   virtual bool SendToLocators(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes,
+       const Locator_t& localLocator, const LocatorList_t& remoteLocators) override;
+
    virtual LocatorList_t ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists) override;
 
     virtual bool fillMetatrafficMulticastLocator(Locator_t &locator,
@@ -132,6 +151,12 @@ protected:
     uint32_t mSendBufferSize;
     uint32_t mReceiveBufferSize;
 
+    //! Reactor serving the input channels, when enabled in the descriptor. Otherwise each channel has its own thread.
+    std::shared_ptr<SocketReactor> mReactor;
+
+    //! Sockets opened on each unicast input port. More than one only where SO_REUSEPORT is supported.
+    uint32_t mUnicastSocketsPerPort;
+
     UDPTransportInterface();
 
     virtual bool CompareLocatorIP(const Locator_t& lh, const Locator_t& rh) const = 0;
@@ -164,8 +189,15 @@ protected:
     bool OpenAndBindInputSockets(const Locator_t& locator, TransportReceiverInterface* receiver, bool is_multicast,
         uint32_t maxMsgSize);
     UDPChannelResource* CreateInputChannelResource(const std::string& sInterface, const Locator_t& locator,
-        bool is_multicast, uint32_t maxMsgSize, TransportReceiverInterface* receiver);
-    virtual eProsimaUDPSocket OpenAndBindInputSocket(const std::string& sIp, uint16_t port, bool is_multicast) = 0;
+        bool is_multicast, uint32_t maxMsgSize, TransportReceiverInterface* receiver, bool reuse_port);
+    virtual eProsimaUDPSocket OpenAndBindInputSocket(const std::string& sIp, uint16_t port, bool is_multicast,
+        bool reuse_port) = 0;
+
+    //! Whether several sockets can share a unicast port with the kernel balancing flows among them.
+    static bool IsReusePortSupported();
+
+    //! Sets SO_REUSEPORT on a socket before binding it. Only to be called if IsReusePortSupported().
+    static void SetReusePort(eProsimaUDPSocket& socket);
     bool OpenAndBindOutputSockets(const Locator_t& locator);
     eProsimaUDPSocket OpenAndBindUnicastOutputSocket(const asio::ip::udp::endpoint& endpoint, uint16_t& port);
     /** Function to be called from a new thread, which takes cares of performing a blocking receive
@@ -174,9 +206,30 @@ protected:
     */
     void performListenOperation(UDPChannelResource* pChannelResource, Locator_t input_locator);
 
+    /** Variant of performListenOperation that drains up to max_messages_per_batch datagrams per system call.
+    Only available on platforms supporting recvmmsg.
+    @param input_locator - Locator that triggered the creation of the resource
+    */
+    void performBatchedListenOperation(UDPChannelResource* pChannelResource, Locator_t input_locator);
+
+    /** Called from the reactor when the socket of the channel is readable. Receives the queued datagrams
+    without blocking, up to a bounded number so other channels are not starved.
+    @param input_locator - Locator that triggered the creation of the resource
+    */
+    void performReactorReceive(UDPChannelResource* pChannelResource, const Locator_t& input_locator);
+
     bool SendThroughSocket(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& remoteLocator,
         eProsimaUDPSocketRef socket);
 
+    //! Sends an asio buffer sequence as a single datagram.
+    template<typename ConstBufferSequence>
+    bool SendBuffersThroughSocket(const ConstBufferSequence& buffers, const Locator_t& remoteLocator,
+        eProsimaUDPSocketRef socket);
+
+    //! Sends to all the given destinations with batched system calls. Only available on platforms supporting sendmmsg.
+    bool SendBatchThroughSocket(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes,
+        const LocatorList_t& remoteLocators, bool only_multicast, eProsimaUDPSocketRef socket);
+
     virtual void SetReceiveBufferSize(uint32_t size) = 0;
     virtual void SetSendBufferSize(uint32_t size) = 0;
     virtual void SetSocketOutbountInterface(eProsimaUDPSocket&, const std::string&) = 0;
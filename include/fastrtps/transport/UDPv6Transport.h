@@ -90,7 +90,8 @@ protected:
     virtual asio::ip::udp::endpoint GenerateLocalEndpoint(const Locator_t& loc, uint16_t port) override;
     virtual asio::ip::udp GenerateProtocol() const override;
     virtual void GetIPs(std::vector<IPFinder::info_IP>& locNames, bool return_loopback = false) override;
-    eProsimaUDPSocket OpenAndBindInputSocket(const std::string& sIp, uint16_t port, bool is_multicast) override;
+    eProsimaUDPSocket OpenAndBindInputSocket(const std::string& sIp, uint16_t port, bool is_multicast,
+        bool reuse_port) override;
 
     //! Checks for whether locator is allowed.
     virtual bool IsLocatorAllowed(const Locator_t&) const override;
@@ -45,6 +45,10 @@ public:
    virtual bool Send(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator,
                         const Locator_t& remoteLocator, ChannelResource* pChannelResource) override;
 
+   //! Flattens the buffers, so the message goes through the drop criteria.
+   virtual bool Send(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes, const Locator_t& localLocator,
+                        const Locator_t& remoteLocator) override;
+
 protected:
     void CalculateCRC(TCPHeader &header, const octet *data, uint32_t size);
 
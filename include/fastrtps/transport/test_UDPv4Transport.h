@@ -41,6 +41,14 @@ public:
     virtual bool Send(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator,
                         const Locator_t& remoteLocator, ChannelResource* pChannelResource) override;
 
+    //! Flattens the buffers, so the datagram goes through the drop criteria.
+    virtual bool Send(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes, const Locator_t& localLocator,
+                        const Locator_t& remoteLocator) override;
+
+    //! Sends to each destination on its own, so every datagram goes through the drop criteria.
+    virtual bool SendToLocators(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes,
+                        const Locator_t& localLocator, const LocatorList_t& remoteLocators) override;
+
     RTPS_DllAPI static bool test_UDPv4Transport_ShutdownAllNetwork;
     // Handle to a persistent log of dropped packets. Defaults to length 0 (no logging) to prevent wasted resources.
     RTPS_DllAPI static std::vector<std::vector<octet> > test_UDPv4Transport_DropLog;
@@ -0,0 +1,96 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file BitmapWord.h
+ *
+ */
+
+#ifndef BITMAPWORD_H_
+#define BITMAPWORD_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <cassert>
+#include <cstdint>
+
+namespace eprosima {
+namespace fastrtps {
+
+/**
+ * Number of bits set in a word of a bitmap.
+ * @ingroup UTILITIES_MODULE
+ */
+inline uint32_t bitmap_word_count(uint64_t word)
+{
+#if defined(__GNUC__)
+    return static_cast<uint32_t>(__builtin_popcountll(word));
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<uint32_t>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * Position of the lowest bit set in a word of a bitmap, which must not be zero.
+ * @ingroup UTILITIES_MODULE
+ */
+inline uint32_t bitmap_word_lowest(uint64_t word)
+{
+    assert(word != 0);
+#if defined(__GNUC__)
+    return static_cast<uint32_t>(__builtin_ctzll(word));
+#else
+    return bitmap_word_count((word & (~word + 1)) - 1);
+#endif
+}
+
+/**
+ * Number of zero bits above the highest bit set in a 32 bit word of a bitmap, which must not be zero.
+ * RTPS bitmaps store their first element in the most significant bit.
+ * @ingroup UTILITIES_MODULE
+ */
+inline uint32_t bitmap_word_leading(uint32_t word)
+{
+    assert(word != 0);
+#if defined(__GNUC__)
+    return static_cast<uint32_t>(__builtin_clz(word));
+#else
+    word |= word >> 1;
+    word |= word >> 2;
+    word |= word >> 4;
+    word |= word >> 8;
+    word |= word >> 16;
+    return 32 - bitmap_word_count(word);
+#endif
+}
+
+/**
+ * Word with the bits [first, last) set, both of them being positions inside a 64 bit word and last
+ * being 64 to reach its end.
+ * @ingroup UTILITIES_MODULE
+ */
+inline uint64_t bitmap_word_range(uint32_t first, uint32_t last)
+{
+    assert(first <= last && last <= 64);
+    uint64_t high = last == 64 ? ~uint64_t(0) : (uint64_t(1) << last) - 1;
+    return first == 64 ? 0 : high & (~uint64_t(0) << first);
+}
+
+} /* namespace fastrtps */
+} /* namespace eprosima */
+
+#endif
+#endif /* BITMAPWORD_H_ */
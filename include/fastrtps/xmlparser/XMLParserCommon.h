@@ -49,6 +49,9 @@ extern const char* TYPES;
 extern const char* TRANSPORT_DESCRIPTOR;
 extern const char* TRANSPORT_ID;
 extern const char* UDP_OUTPUT_PORT;
+extern const char* UDP_MAX_MESSAGES_PER_BATCH;
+extern const char* UDP_REACTOR_THREADS;
+extern const char* UDP_UNICAST_SOCKETS_PER_PORT;
 extern const char* TCP_WAN_ADDR;
 extern const char* RECEIVE_BUFFER_SIZE;
 extern const char* SEND_BUFFER_SIZE;
@@ -88,6 +91,7 @@ extern const char* IP6_TO_SEND;
 extern const char* THROUGHPUT_CONT;
 extern const char* USER_TRANS;
 extern const char* USE_BUILTIN_TRANS;
+extern const char* INTRAPROCESS_DELIVERY;
 extern const char* PROPERTIES_POLICY;
 extern const char* NAME;
 
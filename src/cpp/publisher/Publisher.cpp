@@ -44,6 +44,28 @@ bool Publisher::write(void* Data, WriteParams &wparams) {
     return mp_impl->create_new_change_with_params(ALIVE, Data, wparams);
 }
 
+CacheChange_t* Publisher::loan_sample()
+{
+    return mp_impl->loan_sample();
+}
+
+bool Publisher::write_loaned(CacheChange_t* change)
+{
+    logInfo(PUBLISHER,"Writing lent data");
+    return mp_impl->write_loaned(change, WriteParams::WRITE_PARAM_DEFAULT);
+}
+
+bool Publisher::write_loaned(CacheChange_t* change, WriteParams &wparams)
+{
+    logInfo(PUBLISHER,"Writing lent data with WriteParams");
+    return mp_impl->write_loaned(change, wparams);
+}
+
+bool Publisher::discard_loan(CacheChange_t* change)
+{
+    return mp_impl->discard_loan(change);
+}
+
 bool Publisher::dispose(void* Data)
 {
     logInfo(PUBLISHER,"Disposing of Data");
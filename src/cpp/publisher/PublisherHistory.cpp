@@ -35,7 +35,7 @@ using namespace eprosima::fastrtps;
 using namespace eprosima::fastrtps::rtps;
 
 PublisherHistory::PublisherHistory(PublisherImpl* pimpl, uint32_t payloadMaxSize, HistoryQosPolicy& history,
-        ResourceLimitsQosPolicy& resource, MemoryManagementPolicy_t mempolicy):
+        ResourceLimitsQosPolicy& resource, MemoryManagementPolicy_t mempolicy, std::shared_ptr<PayloadArena> arena):
     WriterHistory(HistoryAttributes(mempolicy, payloadMaxSize,
                 history.kind == KEEP_ALL_HISTORY_QOS ?
                         resource.allocated_samples :
@@ -46,7 +46,8 @@ PublisherHistory::PublisherHistory(PublisherImpl* pimpl, uint32_t payloadMaxSize
                         resource.max_samples :
                         pimpl->getAttributes().topic.getTopicKind() == NO_KEY ?
                             history.depth :
-                            history.depth * resource.max_instances)),
+                            history.depth * resource.max_instances,
+                arena)),
     m_historyQos(history),
     m_resourceLimitsQos(resource),
     mp_pubImpl(pimpl)
@@ -98,7 +99,7 @@ bool PublisherHistory::add_pub_change(CacheChange_t* change, WriteParams &wparam
     //HISTORY WITH KEY
     else if(mp_pubImpl->getAttributes().topic.getTopicKind() == WITH_KEY)
     {
-        t_v_Inst_Caches::iterator vit;
+        t_m_Inst_Caches::iterator vit;
         if(find_Key(change,&vit))
         {
             logInfo(RTPS_HISTORY,"Found key: "<< vit->first);
@@ -147,46 +148,38 @@ bool PublisherHistory::add_pub_change(CacheChange_t* change, WriteParams &wparam
     return returnedValue;
 }
 
-bool PublisherHistory::find_Key(CacheChange_t* a_change,t_v_Inst_Caches::iterator* vit_out)
+bool PublisherHistory::find_Key(CacheChange_t* a_change,t_m_Inst_Caches::iterator* vit_out)
 {
-    t_v_Inst_Caches::iterator vit;
-    bool found = false;
-    for(vit= m_keyedChanges.begin();vit!=m_keyedChanges.end();++vit)
+    t_m_Inst_Caches::iterator vit = m_keyedChanges.find(a_change->instanceHandle);
+    if(vit != m_keyedChanges.end())
     {
-        if(a_change->instanceHandle == vit->first)
-        {
-            *vit_out = vit;
-            return true;
-        }
+        *vit_out = vit;
+        return true;
     }
-    if(!found)
+
+    if((int)m_keyedChanges.size() >= m_resourceLimitsQos.max_instances)
     {
-        if((int)m_keyedChanges.size() < m_resourceLimitsQos.max_instances)
-        {
-            t_p_I_Change newpair;
-            newpair.first = a_change->instanceHandle;
-            m_keyedChanges.push_back(newpair);
-            *vit_out = m_keyedChanges.end()-1;
-            return true;
-        }
-        else
+        // An instance without changes is replaced by the new one.
+        for(vit = m_keyedChanges.begin(); vit != m_keyedChanges.end(); ++vit)
         {
-            for (vit = m_keyedChanges.begin(); vit != m_keyedChanges.end(); ++vit)
+            if(vit->second.empty())
             {
-                if (vit->second.size() == 0)
-                {
-                    m_keyedChanges.erase(vit);
-                    t_p_I_Change newpair;
-                    newpair.first = a_change->instanceHandle;
-                    m_keyedChanges.push_back(newpair);
-                    *vit_out = m_keyedChanges.end() - 1;
-                    return true;
-                }
+                break;
             }
-            logWarning(SUBSCRIBER, "History has reached the maximum number of instances" << endl;)
         }
+
+        if(vit == m_keyedChanges.end())
+        {
+            logWarning(PUBLISHER, "History has reached the maximum number of instances" << endl;)
+            return false;
+        }
+        m_keyedChanges.erase(vit);
     }
-    return false;
+
+    // With KEEP_LAST the ring of the instance never has to grow.
+    size_t capacity = m_historyQos.kind == KEEP_LAST_HISTORY_QOS ? (size_t)m_historyQos.depth : 0;
+    *vit_out = m_keyedChanges.emplace(a_change->instanceHandle, InstanceChanges(capacity)).first;
+    return true;
 }
 
 
@@ -196,9 +189,9 @@ bool PublisherHistory::removeAllChange(size_t* removed)
     size_t rem = 0;
     std::lock_guard<std::recursive_mutex> guard(*this->mp_mutex);
 
-    while(m_changes.size()>0)
+    while(changesBegin() != changesEnd())
     {
-        if(remove_change_pub(m_changes.front()))
+        if(remove_change_pub(*changesBegin()))
             ++rem;
         else
             break;
@@ -220,12 +213,12 @@ bool PublisherHistory::removeMinChange()
     }
 
     std::lock_guard<std::recursive_mutex> guard(*this->mp_mutex);
-    if(m_changes.size()>0)
-        return remove_change_pub(m_changes.front());
+    if(changesBegin() != changesEnd())
+        return remove_change_pub(*changesBegin());
     return false;
 }
 
-bool PublisherHistory::remove_change_pub(CacheChange_t* change,t_v_Inst_Caches::iterator* vit_in)
+bool PublisherHistory::remove_change_pub(CacheChange_t* change,t_m_Inst_Caches::iterator* vit_in)
 {
 
     if(mp_writer == nullptr || mp_mutex == nullptr)
@@ -247,27 +240,20 @@ bool PublisherHistory::remove_change_pub(CacheChange_t* change,t_v_Inst_Caches::
     }
     else
     {
-        t_v_Inst_Caches::iterator vit;
+        t_m_Inst_Caches::iterator vit;
         if(vit_in!=nullptr)
             vit = *vit_in;
-        else if(this->find_Key(change,&vit))
-        {
-
-        }
         else
-            return false;
-        for(auto chit = vit->second.begin();
-                chit!= vit->second.end();++chit)
+            vit = m_keyedChanges.find(change->instanceHandle);
+
+        if(vit != m_keyedChanges.end())
         {
-            if( ((*chit)->sequenceNumber == change->sequenceNumber)
-                    && ((*chit)->writerGUID == change->writerGUID) )
+            size_t index = vit->second.find(change);
+            if(index < vit->second.size() && remove_change(change))
             {
-                if(remove_change(change))
-                {
-                    vit->second.erase(chit);
-                    m_isHistoryFull = false;
-                    return true;
-                }
+                vit->second.erase(index);
+                m_isHistoryFull = false;
+                return true;
             }
         }
         logError(PUBLISHER,"Change not found, something is wrong");
@@ -48,13 +48,14 @@ PublisherImpl::PublisherImpl(ParticipantImpl* p,TopicDataType*pdatatype,
             + 20 /*SecureDataHeader*/ + 4 + ((2* 16) /*EVP_MAX_IV_LENGTH max block size*/ - 1 ) /* SecureDataBodey*/
             + 16 + 4 /*SecureDataTag*/
 #endif
-            , att.topic.historyQos, att.topic.resourceLimitsQos, att.historyMemoryPolicy),
+            , att.topic.historyQos, att.topic.resourceLimitsQos, att.historyMemoryPolicy, att.historyPayloadArena),
     mp_listener(listen),
 #pragma warning (disable : 4355 )
     m_writerListener(this),
     mp_userPublisher(nullptr),
     mp_rtpsParticipant(nullptr),
-    high_mark_for_frag_(0)
+    high_mark_for_frag_(0),
+    mp_key_sample(nullptr)
 {
 }
 
@@ -67,6 +68,11 @@ PublisherImpl::~PublisherImpl()
 
     RTPSDomain::removeRTPSWriter(mp_writer);
     delete(this->mp_userPublisher);
+
+    if(mp_key_sample != nullptr)
+    {
+        mp_type->deleteData(mp_key_sample);
+    }
 }
 
 
@@ -123,60 +129,161 @@ bool PublisherImpl::create_new_change_with_params(ChangeKind_t changeKind, void*
             }
         }
 
-        //TODO(Ricardo) This logic in a class. Then a user of rtps layer can use it.
-        if(high_mark_for_frag_ == 0)
-        {
-            uint32_t max_data_size = mp_writer->getMaxDataSize();
-            uint32_t writer_throughput_controller_bytes =
-                mp_writer->calculateMaxDataSize(m_att.throughputController.bytesPerPeriod);
-            uint32_t participant_throughput_controller_bytes =
-                mp_writer->calculateMaxDataSize(mp_rtpsParticipant->getRTPSParticipantAttributes().throughputController.bytesPerPeriod);
-
-            high_mark_for_frag_ =
-                max_data_size > writer_throughput_controller_bytes ?
-                writer_throughput_controller_bytes :
-                (max_data_size > participant_throughput_controller_bytes ?
-                 participant_throughput_controller_bytes :
-                 max_data_size);
-        }
+        return add_new_change(ch, wparams, lock);
+    }
 
-        uint32_t final_high_mark_for_frag = high_mark_for_frag_;
+    return false;
+}
 
-        // If needed inlineqos for related_sample_identity, then remove the inlinqos size from final fragment size.
-        if(wparams.related_sample_identity() != SampleIdentity::unknown())
+bool PublisherImpl::add_new_change(CacheChange_t* ch, WriteParams& wparams,
+        std::unique_lock<std::recursive_mutex>& lock)
+{
+    //TODO(Ricardo) This logic in a class. Then a user of rtps layer can use it.
+    if(high_mark_for_frag_ == 0)
+    {
+        uint32_t max_data_size = mp_writer->getMaxDataSize();
+        uint32_t writer_throughput_controller_bytes =
+            mp_writer->calculateMaxDataSize(m_att.throughputController.bytesPerPeriod);
+        uint32_t participant_throughput_controller_bytes =
+            mp_writer->calculateMaxDataSize(mp_rtpsParticipant->getRTPSParticipantAttributes().throughputController.bytesPerPeriod);
+
+        high_mark_for_frag_ =
+            max_data_size > writer_throughput_controller_bytes ?
+            writer_throughput_controller_bytes :
+            (max_data_size > participant_throughput_controller_bytes ?
+             participant_throughput_controller_bytes :
+             max_data_size);
+    }
+
+    uint32_t final_high_mark_for_frag = high_mark_for_frag_;
+
+    // If needed inlineqos for related_sample_identity, then remove the inlinqos size from final fragment size.
+    if(wparams.related_sample_identity() != SampleIdentity::unknown())
+    {
+        final_high_mark_for_frag -= 32;
+    }
+
+    // If it is big data, fragment it.
+    if(ch->serializedPayload.length > final_high_mark_for_frag)
+    {
+        // Check ASYNCHRONOUS_PUBLISH_MODE is being used, but it is an error case.
+        if( m_att.qos.m_publishMode.kind != ASYNCHRONOUS_PUBLISH_MODE)
         {
-            final_high_mark_for_frag -= 32;
+            logError(PUBLISHER, "Data cannot be sent. It's serialized size is " <<
+                    ch->serializedPayload.length << "' which exceeds the maximum payload size of '" <<
+                    final_high_mark_for_frag << "' and therefore ASYNCHRONOUS_PUBLISH_MODE must be used.");
+            m_history.release_Cache(ch);
+            return false;
         }
 
-        // If it is big data, fragment it.
-        if(ch->serializedPayload.length > final_high_mark_for_frag)
-        {
-            // Check ASYNCHRONOUS_PUBLISH_MODE is being used, but it is an error case.
-            if( m_att.qos.m_publishMode.kind != ASYNCHRONOUS_PUBLISH_MODE)
-            {
-                logError(PUBLISHER, "Data cannot be sent. It's serialized size is " <<
-                        ch->serializedPayload.length << "' which exceeds the maximum payload size of '" <<
-                        final_high_mark_for_frag << "' and therefore ASYNCHRONOUS_PUBLISH_MODE must be used.");
-                m_history.release_Cache(ch);
-                return false;
-            }
+        /// Fragment the data.
+        // Set the fragment size to the cachechange.
+        // Note: high_mark will always be a value that can be casted to uint16_t)
+        ch->setFragmentSize((uint16_t)final_high_mark_for_frag);
+    }
+
+    // Readers of this process get the change once the writer mutex is released.
+    mp_writer->hold_local_delivery_nts();
+
+    if(!this->m_history.add_pub_change(ch, wparams, lock))
+    {
+        m_history.release_Cache(ch);
+        lock.unlock();
+        mp_writer->release_local_delivery();
+        return false;
+    }
+
+    lock.unlock();
+    mp_writer->release_local_delivery();
+    return true;
+}
+
+CacheChange_t* PublisherImpl::loan_sample()
+{
+    if(!mp_type->is_bounded())
+    {
+        logError(PUBLISHER, "Samples can only be lent for types with a bounded serialized size");
+        return nullptr;
+    }
+
+    std::lock_guard<std::recursive_mutex> guard(*mp_writer->getMutex());
+
+    // The instance of the sample is only known when it is written.
+    uint32_t type_size = mp_type->m_typeSize;
+    CacheChange_t* ch = nullptr;
+    if(!m_history.reserve_Cache(&ch, [type_size]() -> uint32_t { return type_size; }))
+    {
+        logWarning(PUBLISHER, "Problem reserving Cache from the History");
+        return nullptr;
+    }
+    ch->kind = ALIVE;
+    ch->writerGUID = mp_writer->getGuid();
+    ch->instanceHandle = c_InstanceHandle_Unknown;
+    ch->serializedPayload.length = 0;
+    if(mp_type->is_plain())
+    {
+        // The application only has to write the object in place.
+        TopicDataType::write_plain_encapsulation(&ch->serializedPayload);
+        ch->serializedPayload.length = type_size;
+    }
+    m_history.loan_change(ch);
+    return ch;
+}
+
+bool PublisherImpl::write_loaned(CacheChange_t* ch, WriteParams& wparams)
+{
+    if(!m_history.return_loan(ch))
+    {
+        return false;
+    }
+
+    SerializedPayload_t* payload = &ch->serializedPayload;
+    if(payload->length == 0 || payload->length > payload->max_size)
+    {
+        logError(PUBLISHER, "Lent payload has an invalid length of '" << payload->length << "' bytes");
+        m_history.release_Cache(ch);
+        return false;
+    }
+
+    std::unique_lock<std::recursive_mutex> lock(*mp_writer->getMutex());
 
-            /// Fragment the data.
-            // Set the fragment size to the cachechange.
-            // Note: high_mark will always be a value that can be casted to uint16_t)
-            ch->setFragmentSize((uint16_t)final_high_mark_for_frag);
+    // The application may have set the instance handle already.
+    if(m_att.topic.topicKind == WITH_KEY && !ch->instanceHandle.isDefined())
+    {
+        // Only the type knows where the key is, so the payload is read into a sample kept for this, which for
+        // plain types is a single copy.
+        bool is_key_protected = false;
+#if HAVE_SECURITY
+        is_key_protected = mp_writer->getAttributes().security_attributes().is_key_protected;
+#endif
+        if(mp_key_sample == nullptr)
+        {
+            mp_key_sample = mp_type->createData();
         }
+        bool read = mp_type->deserialize(payload, mp_key_sample);
+        payload->pos = 0;
 
-        if(!this->m_history.add_pub_change(ch, wparams, lock))
+        if(!read)
         {
+            logWarning(PUBLISHER, "Lent payload could not be deserialized to get its key");
             m_history.release_Cache(ch);
             return false;
         }
+        mp_type->getKey(mp_key_sample, &ch->instanceHandle, is_key_protected);
+    }
+
+    return add_new_change(ch, wparams, lock);
+}
 
-        return true;
+bool PublisherImpl::discard_loan(CacheChange_t* ch)
+{
+    if(!m_history.return_loan(ch))
+    {
+        return false;
     }
 
-    return false;
+    m_history.release_Cache(ch);
+    return true;
 }
 
 
@@ -297,7 +404,12 @@ void PublisherImpl::PublisherWriterListener::onWriterChangeReceivedByAll(RTPSWri
 bool PublisherImpl::try_remove_change(std::unique_lock<std::recursive_mutex>& lock)
 {
     std::chrono::microseconds max_w(::TimeConv::Time_t2MicroSecondsInt64(m_att.qos.m_reliability.max_blocking_time));
-    return mp_writer->try_remove_change(max_w, lock);
+
+    // Readers of this process may have to be delivered to before they acknowledge the changes waited for.
+    mp_writer->unhold_local_delivery_nts();
+    bool ret = mp_writer->try_remove_change(max_w, lock);
+    mp_writer->hold_local_delivery_nts();
+    return ret;
 }
 
 bool PublisherImpl::wait_for_all_acked(const Time_t& max_wait)
@@ -82,6 +82,28 @@ class PublisherImpl
      */
     bool create_new_change_with_params(rtps::ChangeKind_t kind, void* Data, rtps::WriteParams &wparams);
 
+    /**
+     * Reserve a change in the history and lend it, so the sample is serialized in place into its payload.
+     * @return Pointer to the change, or nullptr if no change could be reserved.
+     */
+    rtps::CacheChange_t* loan_sample();
+
+    /**
+     * Write a change lent by loan_sample.
+     * @param change Pointer to the change, with the length of its payload set to the number of bytes written.
+     * For keyed topics, its instance handle is computed from the sample unless it was set.
+     * @param wparams Extra write parameters.
+     * @return True if correct.
+     */
+    bool write_loaned(rtps::CacheChange_t* change, rtps::WriteParams &wparams);
+
+    /**
+     * Return a change lent by loan_sample without writing it.
+     * @param change Pointer to the change.
+     * @return True if the change was lent by this publisher.
+     */
+    bool discard_loan(rtps::CacheChange_t* change);
+
     /**
      * Removes the cache change with the minimum sequence number
      * @return True if correct.
@@ -124,6 +146,17 @@ class PublisherImpl
     bool wait_for_all_acked(const rtps::Time_t& max_wait);
 
     private:
+
+    /**
+     * Add a serialized change to the history, fragmenting it if needed. The change is released on failure.
+     * @param ch Pointer to the change.
+     * @param wparams Extra write parameters.
+     * @param lock Lock of the writer mutex.
+     * @return True if added.
+     */
+    bool add_new_change(rtps::CacheChange_t* ch, rtps::WriteParams& wparams,
+            std::unique_lock<std::recursive_mutex>& lock);
+
     ParticipantImpl* mp_participant;
     //! Pointer to the associated Data Writer.
 	rtps::RTPSWriter* mp_writer;
@@ -151,6 +184,9 @@ class PublisherImpl
 	rtps::RTPSParticipant* mp_rtpsParticipant;
 
     uint32_t high_mark_for_frag_;
+
+    //! Sample lent changes of keyed topics are read into to get their key. Used with the writer mutex taken.
+    void* mp_key_sample;
 };
 
 
@@ -36,6 +36,9 @@
 #include <fastrtps/rtps/writer/RTPSWriter.h>
 #include <fastrtps/rtps/reader/RTPSReader.h>
 
+#include <algorithm>
+#include <iterator>
+
 namespace eprosima {
 namespace fastrtps{
 namespace rtps {
@@ -44,6 +47,16 @@ std::mutex RTPSDomain::m_mutex;
 std::atomic<uint32_t> RTPSDomain::m_maxRTPSParticipantID(1);
 std::vector<RTPSDomain::t_p_RTPSParticipant> RTPSDomain::m_RTPSParticipants;
 std::set<uint32_t> RTPSDomain::m_RTPSParticipantIDs;
+std::mutex RTPSDomain::m_local_readers_mutex;
+std::condition_variable RTPSDomain::m_local_readers_cv;
+std::map<GUID_t, RTPSDomain::LocalReaderEntry> RTPSDomain::m_local_readers;
+
+//! Readers acquired by the calling thread, which is delivering to them.
+static std::vector<GUID_t>& local_readers_acquired_by_thread()
+{
+    static thread_local std::vector<GUID_t> acquired;
+    return acquired;
+}
 
 void RTPSDomain::stopAll()
 {
@@ -251,6 +264,66 @@ bool RTPSDomain::removeRTPSReader(RTPSReader* reader)
     return false;
 }
 
+void RTPSDomain::register_local_reader(RTPSReader* reader)
+{
+    std::lock_guard<std::mutex> guard(m_local_readers_mutex);
+    m_local_readers[reader->getGuid()] = LocalReaderEntry{reader, 0};
+}
+
+void RTPSDomain::unregister_local_reader(const GUID_t& reader_guid)
+{
+    std::unique_lock<std::mutex> lock(m_local_readers_mutex);
+    auto it = m_local_readers.find(reader_guid);
+
+    if(it != m_local_readers.end())
+    {
+        // Stop handing out the reader and wait for the writers that are still delivering to it. A listener of the
+        // reader may be deleting it, so the deliveries of this thread are not waited for.
+        const std::vector<GUID_t>& acquired = local_readers_acquired_by_thread();
+        uint32_t own_users = static_cast<uint32_t>(std::count(acquired.begin(), acquired.end(), reader_guid));
+        it->second.reader = nullptr;
+        m_local_readers_cv.wait(lock, [&]() { return it->second.users == own_users; });
+        m_local_readers.erase(it);
+    }
+}
+
+bool RTPSDomain::is_local_reader(const GUID_t& reader_guid)
+{
+    std::lock_guard<std::mutex> guard(m_local_readers_mutex);
+    auto it = m_local_readers.find(reader_guid);
+    return it != m_local_readers.end() && it->second.reader != nullptr;
+}
+
+RTPSReader* RTPSDomain::acquire_local_reader(const GUID_t& reader_guid)
+{
+    std::lock_guard<std::mutex> guard(m_local_readers_mutex);
+    auto it = m_local_readers.find(reader_guid);
+
+    if(it == m_local_readers.end() || it->second.reader == nullptr)
+        return nullptr;
+
+    ++it->second.users;
+    local_readers_acquired_by_thread().push_back(reader_guid);
+    return it->second.reader;
+}
+
+void RTPSDomain::release_local_reader(const GUID_t& reader_guid)
+{
+    std::lock_guard<std::mutex> guard(m_local_readers_mutex);
+    auto it = m_local_readers.find(reader_guid);
+
+    std::vector<GUID_t>& acquired = local_readers_acquired_by_thread();
+    auto acquired_it = std::find(acquired.rbegin(), acquired.rend(), reader_guid);
+    if(acquired_it != acquired.rend())
+        acquired.erase(std::next(acquired_it).base());
+
+    if(it != m_local_readers.end())
+    {
+        --it->second.users;
+        m_local_readers_cv.notify_all();
+    }
+}
+
 } /* namespace  rtps */
 } /* namespace  fastrtps */
 } /* namespace eprosima */
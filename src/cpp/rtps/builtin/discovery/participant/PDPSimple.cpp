@@ -823,6 +823,14 @@ bool PDPSimple::removeRemoteParticipant(GUID_t& partGUID)
 
     if(pdata !=nullptr)
     {
+        NetworkFactory& network = mp_RTPSParticipant->network_factory();
+        network.RemoveFallbackLocators(pdata->m_metatrafficUnicastLocatorList);
+        network.RemoveFallbackLocators(pdata->m_defaultUnicastLocatorList);
+        for(ReaderProxyData* rdata : pdata->m_readers)
+            network.RemoveFallbackLocators(rdata->unicastLocatorList());
+        for(WriterProxyData* wdata : pdata->m_writers)
+            network.RemoveFallbackLocators(wdata->unicastLocatorList());
+
         if(mp_EDP!=nullptr)
         {
             RTPSParticipantListener* listener = mp_RTPSParticipant->getListener();
@@ -24,6 +24,8 @@
 #include <mutex>
 
 #include <cassert>
+#include <cmath>
+#include <cstdlib>
 
 
 namespace eprosima {
@@ -35,22 +37,32 @@ CacheChangePool::~CacheChangePool()
 {
     logInfo(RTPS_UTILS,"ChangePool destructor");
     //Deletion process does not depend on the memory management policy
-    for(std::vector<CacheChange_t*>::iterator it = m_allCaches.begin();it!=m_allCaches.end();++it)
+    uint32_t slot_count = m_slot_count.load(std::memory_order_acquire);
+    for(uint32_t index = 0; index < slot_count; ++index)
     {
-        delete(*it);
+        delete getSlot(index).change;
+    }
+    for(uint32_t chunk = 0; chunk < s_maxChunks; ++chunk)
+    {
+        delete[] m_chunks[chunk].load(std::memory_order_relaxed);
     }
 }
 
-CacheChangePool::CacheChangePool(int32_t pool_size, uint32_t payload_size, int32_t max_pool_size, MemoryManagementPolicy_t memoryPolicy) : 
-    memoryMode(memoryPolicy)
+CacheChangePool::CacheChangePool(int32_t pool_size, uint32_t payload_size, int32_t max_pool_size, MemoryManagementPolicy_t memoryPolicy,
+        std::shared_ptr<PayloadArena> arena) :
+    m_pool_size(0), m_free_count(0), m_free_head(s_noSlot), m_slot_count(0), memoryMode(memoryPolicy)
 {
+    for(uint32_t chunk = 0; chunk < s_maxChunks; ++chunk)
+    {
+        m_chunks[chunk].store(nullptr, std::memory_order_relaxed);
+    }
+
     //Common for all modes: Set the payload size (maximum allowed), size and size limit
     ++pool_size;
     logInfo(RTPS_UTILS,"Creating CacheChangePool of size: "<< pool_size << " with payload of size: " << payload_size);
 
     m_payload_size = payload_size;
     m_initial_payload_size = payload_size;
-    m_pool_size = 0;
     if(max_pool_size > 0)
     {
         if (pool_size > max_pool_size)
@@ -63,6 +75,7 @@ CacheChangePool::CacheChangePool(int32_t pool_size, uint32_t payload_size, int32
     else
         m_max_pool_size = 0;
 
+    std::lock_guard<std::mutex> guard(m_growth_mutex);
     switch(memoryMode)
     {
         case PREALLOCATED_MEMORY_MODE:
@@ -75,6 +88,7 @@ CacheChangePool::CacheChangePool(int32_t pool_size, uint32_t payload_size, int32
             break;
         case DYNAMIC_RESERVE_MEMORY_MODE:
             logInfo(RTPS_UTILS,"Dynamic Mode is active, CacheChanges are allocated on request");
+            m_arena = arena ? arena : std::make_shared<PayloadArena>();
             break;
     }
 }
@@ -97,52 +111,46 @@ bool CacheChangePool::reserve_Cache(CacheChange_t** chan, const std::function<ui
 
 bool CacheChangePool::reserve_Cache(CacheChange_t** chan, uint32_t dataSize)
 {
-    std::lock_guard<std::mutex> guard(this->mp_mutex);
-
-    switch(memoryMode)
+    if(memoryMode == DYNAMIC_RESERVE_MEMORY_MODE)
     {
-        case PREALLOCATED_MEMORY_MODE:
-            if(m_freeCaches.empty())
-            {
-                if (!allocateGroup((uint16_t)(ceil((float)m_pool_size / 10) + 10)))
-                {
-                    return false;
-                }
-            }
-            *chan = m_freeCaches.back();
-            m_freeCaches.erase(m_freeCaches.end()-1);
-            break;
-
-        case PREALLOCATED_WITH_REALLOC_MEMORY_MODE:
-            if(m_freeCaches.empty())
-            {
-                if (!allocateGroup((uint16_t)(ceil((float)m_pool_size / 10) + 10)))
-                {
-                    return false;
-                }
-            }
-            *chan = m_freeCaches.back();
-            m_freeCaches.erase(m_freeCaches.end()-1);
+        *chan = allocateSingle(dataSize); //Allocates a single, empty CacheChange. Allocated on Copy
+        return *chan != nullptr;
+    }
 
-            // TODO(Ricardo) Improve reallocation.
-            try
-            {
-                (*chan)->serializedPayload.reserve(dataSize);
-            }
-            catch(std::bad_alloc& ex)
+    uint32_t index = s_noSlot;
+    Slot* slot = popSlot(index);
+    while(slot == nullptr)
+    {
+        std::lock_guard<std::mutex> guard(m_growth_mutex);
+        // Another thread may have grown the pool meanwhile.
+        slot = popSlot(index);
+        if(slot == nullptr)
+        {
+            if (!allocateGroup((uint16_t)(ceil((float)m_pool_size.load(std::memory_order_relaxed) / 10) + 10)))
             {
-                logError(RTPS_HISTORY, "Failed to allocate memory for the serializedPayload, exception caught: " << ex.what());
-                delete(*chan);
-                *chan = nullptr;
                 return false;
             }
+            slot = popSlot(index);
+        }
+    }
+    m_free_count.fetch_sub(1, std::memory_order_relaxed);
+    *chan = slot->change;
 
-            break;
-
-        case DYNAMIC_RESERVE_MEMORY_MODE:
-            *chan = allocateSingle(dataSize); //Allocates a single, empty CacheChange. Allocated on Copy
-            if(*chan == nullptr) return false;
-            break;
+    if(memoryMode == PREALLOCATED_WITH_REALLOC_MEMORY_MODE)
+    {
+        // TODO(Ricardo) Improve reallocation.
+        try
+        {
+            (*chan)->serializedPayload.reserve(dataSize);
+        }
+        catch(std::bad_alloc& ex)
+        {
+            logError(RTPS_HISTORY, "Failed to allocate memory for the serializedPayload, exception caught: " << ex.what());
+            m_free_count.fetch_add(1, std::memory_order_relaxed);
+            pushSlot(index);
+            *chan = nullptr;
+            return false;
+        }
     }
 
     return true;
@@ -150,29 +158,23 @@ bool CacheChangePool::reserve_Cache(CacheChange_t** chan, uint32_t dataSize)
 
 void CacheChangePool::release_Cache(CacheChange_t* ch)
 {
-    std::lock_guard<std::mutex> guard(this->mp_mutex);
+    if(!is_pool_change(ch))
+    {
+        logInfo(RTPS_UTILS,"Tried to release a CacheChange that is not logged in the Pool");
+        return;
+    }
+
+    uint32_t index = ch->pool_index_;
 
     switch(memoryMode)
     {
         case PREALLOCATED_MEMORY_MODE:
-            ch->kind = ALIVE;
-            ch->sequenceNumber.high = 0;
-            ch->sequenceNumber.low = 0;
-            ch->writerGUID = c_Guid_Unknown;
-            ch->serializedPayload.length = 0;
-            ch->serializedPayload.pos = 0;
-            for(uint8_t i=0;i<16;++i)
-                ch->instanceHandle.value[i] = 0;
-            ch->isRead = 0;
-            ch->sourceTimestamp.seconds = 0;
-            ch->sourceTimestamp.fraction = 0;
-            m_freeCaches.push_back(ch);
-            break;
         case PREALLOCATED_WITH_REALLOC_MEMORY_MODE:
             ch->kind = ALIVE;
             ch->sequenceNumber.high = 0;
             ch->sequenceNumber.low = 0;
             ch->writerGUID = c_Guid_Unknown;
+            ch->serializedPayload.return_loan();
             ch->serializedPayload.length = 0;
             ch->serializedPayload.pos = 0;
             for(uint8_t i=0;i<16;++i)
@@ -180,59 +182,142 @@ void CacheChangePool::release_Cache(CacheChange_t* ch)
             ch->isRead = 0;
             ch->sourceTimestamp.seconds = 0;
             ch->sourceTimestamp.fraction = 0;
-            m_freeCaches.push_back(ch);
+            m_free_count.fetch_add(1, std::memory_order_relaxed);
+            pushSlot(index);
             break;
         case DYNAMIC_RESERVE_MEMORY_MODE:
-            // Find pointer in CacheChange vector, remove element, then delete it
-            std::vector<CacheChange_t*>::iterator target = m_allCaches.begin();	
-            target = find(m_allCaches.begin(),m_allCaches.end(), ch);
-            if(target != m_allCaches.end())
-            {
-                m_allCaches.erase(target);
-            }else{
-                logInfo(RTPS_UTILS,"Tried to release a CacheChange that is not logged in the Pool");
-                break;
-            }
+            getSlot(index).change = nullptr;
             delete(ch);
-            --m_pool_size;
+            pushSlot(index);
+            m_pool_size.fetch_sub(1, std::memory_order_relaxed);
             break;
+    }
+}
+
+bool CacheChangePool::is_pool_change(const CacheChange_t* ch)
+{
+    uint32_t index = ch->pool_index_;
+    return index < m_slot_count.load(std::memory_order_acquire) && getSlot(index).change == ch;
+}
 
+CacheChangePool::Slot& CacheChangePool::getSlot(uint32_t index)
+{
+    uint32_t chunk = 0;
+    uint32_t chunk_size = s_firstChunkSize;
+    while(index >= chunk_size)
+    {
+        index -= chunk_size;
+        chunk_size <<= 1;
+        ++chunk;
+    }
+    return m_chunks[chunk].load(std::memory_order_acquire)[index];
+}
+
+CacheChangePool::Slot* CacheChangePool::popSlot(uint32_t& index)
+{
+    uint64_t head = m_free_head.load(std::memory_order_acquire);
+    for(;;)
+    {
+        uint32_t top = static_cast<uint32_t>(head);
+        if(top == s_noSlot)
+        {
+            return nullptr;
+        }
+
+        // The tag makes the exchange fail if the slot was popped and pushed again meanwhile.
+        Slot& slot = getSlot(top);
+        uint64_t new_head = (((head >> 32) + 1) << 32) | slot.next.load(std::memory_order_relaxed);
+        if(m_free_head.compare_exchange_weak(head, new_head, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            index = top;
+            return &slot;
+        }
     }
 }
 
+void CacheChangePool::pushSlot(uint32_t index)
+{
+    Slot& slot = getSlot(index);
+    uint64_t head = m_free_head.load(std::memory_order_relaxed);
+    uint64_t new_head;
+    do
+    {
+        slot.next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        new_head = (((head >> 32) + 1) << 32) | index;
+    }
+    while(!m_free_head.compare_exchange_weak(head, new_head, std::memory_order_release, std::memory_order_relaxed));
+}
+
+bool CacheChangePool::addSlots(uint32_t count, uint32_t& first)
+{
+    first = m_slot_count.load(std::memory_order_relaxed);
+    uint64_t needed = static_cast<uint64_t>(first) + count;
+
+    uint64_t capacity = 0;
+    uint32_t chunk_size = s_firstChunkSize;
+    for(uint32_t chunk = 0; capacity < needed; ++chunk)
+    {
+        if(chunk == s_maxChunks)
+        {
+            logError(RTPS_HISTORY, "Cannot add " << count << " changes to a pool of " << first);
+            return false;
+        }
+        if(m_chunks[chunk].load(std::memory_order_relaxed) == nullptr)
+        {
+            m_chunks[chunk].store(new Slot[chunk_size], std::memory_order_release);
+        }
+        capacity += chunk_size;
+        chunk_size <<= 1;
+    }
+
+    m_slot_count.store(static_cast<uint32_t>(needed), std::memory_order_release);
+    return true;
+}
+
 bool CacheChangePool::allocateGroup(uint32_t group_size)
 {
     // This method should only called from within PREALLOCATED_MEMORY_MODE
     assert(memoryMode != DYNAMIC_RESERVE_MEMORY_MODE);
 
     logInfo(RTPS_UTILS,"Allocating group of cache changes of size: "<< group_size);
-    bool added = false;
+    uint32_t pool_size = m_pool_size.load(std::memory_order_relaxed);
     uint32_t reserved = 0;
     if (m_max_pool_size == 0)
         reserved = group_size;
     else
     {
-        if (m_pool_size + group_size > m_max_pool_size)
+        if (pool_size + group_size > m_max_pool_size)
         {
-            reserved = m_max_pool_size - m_pool_size;
+            reserved = m_max_pool_size - pool_size;
         }
         else
         {
             reserved = group_size;
         }
     }
-    for(uint32_t i = 0; i < reserved; ++i)
+
+    uint32_t first = 0;
+    if (reserved == 0 || !addSlots(reserved, first))
+    {
+        logWarning(RTPS_HISTORY, "Maximum number of allowed reserved caches reached");
+        return false;
+    }
+
+    for(uint32_t index = first; index < first + reserved; ++index)
     {
         CacheChange_t* ch = new CacheChange_t(m_payload_size);
-        m_allCaches.push_back(ch);
-        m_freeCaches.push_back(ch);
-        ++m_pool_size;
-        added = true;
+        ch->pool_index_ = index;
+        getSlot(index).change = ch;
+    }
+    m_pool_size.store(pool_size + reserved, std::memory_order_relaxed);
+
+    m_free_count.fetch_add(reserved, std::memory_order_relaxed);
+    for(uint32_t index = first; index < first + reserved; ++index)
+    {
+        pushSlot(index);
     }
-    if (!added)
-        logWarning(RTPS_HISTORY, "Maximum number of allowed reserved caches reached");
     //logInfo(RTPS_UTILS,"Finish allocating CacheChange_t");
-    return added;
+    return true;
 }
 
 CacheChange_t* CacheChangePool::allocateSingle(uint32_t dataSize)
@@ -241,32 +326,66 @@ CacheChange_t* CacheChangePool::allocateSingle(uint32_t dataSize)
      *   In Dynamic Memory Mode CacheChanges are only allocated when they are needed.
      *   This means when the buffer of the message receiver is copied into this struct, the size is allocated.
      *   When the change is released and comes back to the pool, it is deallocated correspondingly.
+     *   Payloads are taken from the arena of the pool, so their memory is reused by later changes of similar size.
      *
      *   In Preallocated mode, changes are allocated with a static maximum size and then they are dealt as
      *   they are needed. In Dynamic mode, they are only allocated when they are needed. In Dynamic mode only
-     *   the m_allCaches vector is used, in order to keep track of all the changes that are dealt for destruction
-     *   purposes.
+     *   empty slots are kept in the free stack, and a change is placed in one of them while it is in use, so
+     *   all the changes that are dealt can be found for destruction purposes.
      *
      */
-    bool added = false;
-    CacheChange_t*ch = nullptr;
 
     // This method should only be called from within DYNAMIC_RESERVE_MEMORY_MODE
     assert(memoryMode == DYNAMIC_RESERVE_MEMORY_MODE);
 
-    if((m_max_pool_size == 0) | (m_pool_size < m_max_pool_size)) { //If no limit or curren changes < max changes
-        ++m_pool_size;
-        ch = new CacheChange_t(dataSize);
-        m_allCaches.push_back(ch);
-        added = true;
+    uint32_t pool_size = m_pool_size.load(std::memory_order_relaxed);
+    do
+    {
+        if((m_max_pool_size != 0) && (pool_size >= m_max_pool_size)) //If limit and current changes >= max changes
+        {
+            logWarning(RTPS_HISTORY, "Maximum number of allowed reserved caches reached");
+            return NULL;
+        }
     }
+    while(!m_pool_size.compare_exchange_weak(pool_size, pool_size + 1, std::memory_order_relaxed));
 
-    if(!added)
+    CacheChange_t* ch = new CacheChange_t(0);
+    ch->serializedPayload.arena = m_arena.get();
+    try
     {
-        logWarning(RTPS_HISTORY, "Maximum number of allowed reserved caches reached");
+        ch->serializedPayload.reserve(dataSize);
+    }
+    catch(std::bad_alloc& ex)
+    {
+        logWarning(RTPS_HISTORY, "Failed to allocate memory for the serializedPayload, exception caught: " << ex.what());
+        delete(ch);
+        m_pool_size.fetch_sub(1, std::memory_order_relaxed);
         return NULL;
     }
 
+    uint32_t index = s_noSlot;
+    Slot* slot = popSlot(index);
+    if(slot == nullptr)
+    {
+        std::lock_guard<std::mutex> guard(m_growth_mutex);
+        uint32_t count = m_slot_count.load(std::memory_order_relaxed) / 10 + 10;
+        uint32_t first = 0;
+        if(!addSlots(count, first))
+        {
+            delete(ch);
+            m_pool_size.fetch_sub(1, std::memory_order_relaxed);
+            return NULL;
+        }
+        for(uint32_t extra = first + 1; extra < first + count; ++extra)
+        {
+            pushSlot(extra);
+        }
+        index = first;
+        slot = &getSlot(first);
+    }
+
+    ch->pool_index_ = index;
+    slot->change = ch;
     return ch;
 }
 
@@ -25,6 +25,7 @@
 
 #include <fastrtps/log/Log.h>
 
+#include <algorithm>
 #include <mutex>
 
 namespace eprosima {
@@ -37,9 +38,10 @@ typedef std::vector<t_pairKeyChanges> t_vectorPairKeyChanges;
 
 History::History(const HistoryAttributes & att):
     m_att(att),
+    m_firstChange(0),
     m_isHistoryFull(false),
     mp_invalidCache(nullptr),
-    m_changePool(att.initialReservedCaches,att.payloadMaxSize,att.maximumReservedCaches,att.memoryPolicy),
+    m_changePool(att.initialReservedCaches,att.payloadMaxSize,att.maximumReservedCaches,att.memoryPolicy,att.payloadArena),
     mp_minSeqCacheChange(nullptr),
     mp_maxSeqCacheChange(nullptr),
     mp_mutex(nullptr)
@@ -72,13 +74,14 @@ bool History::remove_all_changes()
     }
 
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
-    if(!m_changes.empty())
+    if(changesBegin() != changesEnd())
     {
-        while(!m_changes.empty())
+        while(changesBegin() != changesEnd())
         {
-            remove_change(m_changes.front());
+            remove_change(*changesBegin());
         }
         m_changes.clear();
+        m_firstChange = 0;
         m_isHistoryFull = false;
         updateMaxMinSeqNum();
         return true;
@@ -86,6 +89,34 @@ bool History::remove_all_changes()
     return false;
 }
 
+void History::erase_change(std::vector<CacheChange_t*>::iterator chit)
+{
+    std::vector<CacheChange_t*>::iterator first = changesBegin();
+    if(chit - first < changesEnd() - chit - 1)
+    {
+        std::move_backward(first, chit, chit + 1);
+        *first = nullptr;
+        ++m_firstChange;
+
+        // Unused positions are reclaimed once they outnumber the changes.
+        if(m_firstChange > m_changes.size() - m_firstChange)
+        {
+            m_changes.erase(m_changes.begin(), changesBegin());
+            m_firstChange = 0;
+        }
+    }
+    else
+    {
+        m_changes.erase(chit);
+    }
+
+    if(m_firstChange == m_changes.size())
+    {
+        m_changes.clear();
+        m_firstChange = 0;
+    }
+}
+
 bool History::get_min_change(CacheChange_t** min_change)
 {
     if(mp_minSeqCacheChange->sequenceNumber != mp_invalidCache->sequenceNumber)
@@ -116,8 +147,8 @@ bool History::get_change(const SequenceNumber_t& seq, const GUID_t& guid,CacheCh
     }
 
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
-    for(std::vector<CacheChange_t*>::iterator it = m_changes.begin();
-            it!=m_changes.end();++it)
+    for(std::vector<CacheChange_t*>::iterator it = changesBegin();
+            it!=changesEnd();++it)
     {
         if((*it)->sequenceNumber == seq && (*it)->writerGUID == guid)
         {
@@ -144,8 +175,8 @@ namespace rtps{
 void History::print_changes_seqNum2()
 {
     std::stringstream ss;
-    for(std::vector<CacheChange_t*>::iterator it = m_changes.begin();
-            it!=m_changes.end();++it)
+    for(std::vector<CacheChange_t*>::iterator it = changesBegin();
+            it!=changesEnd();++it)
     {
         ss << (*it)->sequenceNumber << "-";
     }
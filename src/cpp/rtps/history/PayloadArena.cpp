@@ -0,0 +1,369 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PayloadArena.cpp
+ *
+ */
+
+#include <fastrtps/rtps/history/PayloadArena.h>
+#include <fastrtps/log/Log.h>
+
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps {
+
+/**
+ * Header at the start of every slab. Each block is preceded by a pointer to its slab, and free blocks are
+ * linked through their first bytes.
+ */
+struct PayloadArena::Slab
+{
+    SizeClass* size_class;
+    size_t mapped_size;
+    Slab* previous;
+    Slab* next;
+    octet* free_blocks;
+    octet* first_block;
+    uint32_t block_count;
+    uint32_t used_count;
+    //! Blocks handed out at least once. Blocks are carved on demand, so unused pages of a slab are not touched.
+    uint32_t carved_count;
+};
+
+//! Bytes before each block holding its slab, which keep blocks aligned to 16 bytes.
+static const size_t s_blockHeaderSize = 16;
+
+static size_t page_size()
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<size_t>(info.dwPageSize);
+#else
+    long size = sysconf(_SC_PAGESIZE);
+    return size > 0 ? static_cast<size_t>(size) : 4096;
+#endif
+}
+
+static void* map_memory(size_t size)
+{
+#ifdef _WIN32
+    return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return memory == MAP_FAILED ? nullptr : memory;
+#endif
+}
+
+static void unmap_memory(void* memory, size_t size)
+{
+#ifdef _WIN32
+    (void)size;
+    VirtualFree(memory, 0, MEM_RELEASE);
+#else
+    munmap(memory, size);
+#endif
+}
+
+PayloadArena::PayloadArena(uint64_t max_memory)
+    : max_memory_(max_memory)
+    , reserved_memory_(0)
+{
+    for(uint32_t index = 0; index < s_classCount; ++index)
+    {
+        classes_[index].block_size = static_cast<uint32_t>(1ull << (index + s_minSizeShift));
+    }
+}
+
+PayloadArena::~PayloadArena()
+{
+    for(uint32_t index = 0; index < s_classCount; ++index)
+    {
+        SizeClass& size_class = classes_[index];
+        while(size_class.slabs != nullptr)
+        {
+            Slab* slab = size_class.slabs;
+            unlink(size_class, slab);
+            if(slab->used_count == 0)
+            {
+                destroy_slab(slab);
+            }
+        }
+    }
+
+    if(reserved_memory_.load(std::memory_order_relaxed) != 0)
+    {
+        logError(RTPS_HISTORY, "PayloadArena destroyed while payloads are in use, "
+                << reserved_memory_.load(std::memory_order_relaxed) << " bytes are leaked");
+    }
+}
+
+octet* PayloadArena::allocate(uint32_t size, uint32_t& capacity)
+{
+    uint32_t shift = s_minSizeShift;
+    while((1ull << shift) < size)
+    {
+        ++shift;
+    }
+    if(shift > s_maxSizeShift)
+    {
+        logWarning(RTPS_HISTORY, "Payload of " << size << " bytes is too big for the arena");
+        return nullptr;
+    }
+
+    SizeClass& size_class = classes_[shift - s_minSizeShift];
+    std::lock_guard<std::mutex> guard(size_class.mutex);
+
+    Slab* slab = size_class.slabs;
+    if(slab == nullptr)
+    {
+        slab = create_slab(size_class);
+        if(slab == nullptr)
+        {
+            return nullptr;
+        }
+        link_first(size_class, slab);
+        ++size_class.idle_slabs;
+    }
+
+    if(slab->used_count == 0)
+    {
+        --size_class.idle_slabs;
+    }
+
+    octet* block = slab->free_blocks;
+    if(block != nullptr)
+    {
+        memcpy(&slab->free_blocks, block, sizeof(octet*));
+    }
+    else
+    {
+        octet* header = slab->first_block + slab->carved_count * (s_blockHeaderSize + size_class.block_size);
+        memcpy(header, &slab, sizeof(Slab*));
+        block = header + s_blockHeaderSize;
+        ++slab->carved_count;
+    }
+
+    if(++slab->used_count == slab->block_count)
+    {
+        unlink(size_class, slab);
+    }
+
+    capacity = size_class.block_size;
+    return block;
+}
+
+void PayloadArena::deallocate(octet* data)
+{
+    if(data == nullptr)
+    {
+        return;
+    }
+
+    Slab* slab = nullptr;
+    memcpy(&slab, data - s_blockHeaderSize, sizeof(Slab*));
+    SizeClass& size_class = *slab->size_class;
+    Slab* released = nullptr;
+
+    {
+        std::lock_guard<std::mutex> guard(size_class.mutex);
+
+        memcpy(data, &slab->free_blocks, sizeof(octet*));
+        slab->free_blocks = data;
+
+        bool was_full = slab->used_count == slab->block_count;
+        if(--slab->used_count == 0)
+        {
+            if(!was_full)
+            {
+                unlink(size_class, slab);
+            }
+
+            // One idle slab is kept, so a class does not map and unmap a slab on every sample.
+            if(size_class.idle_slabs > 0)
+            {
+                released = slab;
+            }
+            else
+            {
+                link_last(size_class, slab);
+                ++size_class.idle_slabs;
+            }
+        }
+        else if(was_full)
+        {
+            link_first(size_class, slab);
+        }
+    }
+
+    if(released != nullptr)
+    {
+        destroy_slab(released);
+    }
+}
+
+void PayloadArena::trim()
+{
+    for(uint32_t index = 0; index < s_classCount; ++index)
+    {
+        SizeClass& size_class = classes_[index];
+        Slab* idle = nullptr;
+
+        {
+            std::lock_guard<std::mutex> guard(size_class.mutex);
+            while(size_class.last_slab != nullptr && size_class.last_slab->used_count == 0)
+            {
+                Slab* slab = size_class.last_slab;
+                unlink(size_class, slab);
+                slab->next = idle;
+                idle = slab;
+            }
+            size_class.idle_slabs = 0;
+        }
+
+        while(idle != nullptr)
+        {
+            Slab* slab = idle;
+            idle = slab->next;
+            destroy_slab(slab);
+        }
+    }
+}
+
+PayloadArena::Slab* PayloadArena::create_slab(SizeClass& size_class)
+{
+    static const size_t s_pageSize = page_size();
+
+    size_t header_size = (sizeof(Slab) + s_blockHeaderSize - 1) & ~(s_blockHeaderSize - 1);
+    size_t block_stride = s_blockHeaderSize + size_class.block_size;
+    size_t mapped_size = s_slabSize;
+    uint32_t block_count = 1;
+
+    if(header_size + 2 * block_stride <= s_slabSize)
+    {
+        block_count = static_cast<uint32_t>((s_slabSize - header_size) / block_stride);
+    }
+    else
+    {
+        mapped_size = (header_size + block_stride + s_pageSize - 1) & ~(s_pageSize - 1);
+    }
+
+    uint64_t reserved = reserved_memory_.load(std::memory_order_relaxed);
+    do
+    {
+        if(max_memory_ != 0 && reserved + mapped_size > max_memory_)
+        {
+            logWarning(RTPS_HISTORY, "PayloadArena memory budget of " << max_memory_ << " bytes reached");
+            return nullptr;
+        }
+    }
+    while(!reserved_memory_.compare_exchange_weak(reserved, reserved + mapped_size, std::memory_order_relaxed));
+
+    void* memory = map_memory(mapped_size);
+    if(memory == nullptr)
+    {
+        logError(RTPS_HISTORY, "Cannot map a slab of " << mapped_size << " bytes");
+        reserved_memory_.fetch_sub(mapped_size, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Slab* slab = new (memory) Slab();
+    slab->size_class = &size_class;
+    slab->mapped_size = mapped_size;
+    slab->previous = nullptr;
+    slab->next = nullptr;
+    slab->free_blocks = nullptr;
+    slab->first_block = static_cast<octet*>(memory) + header_size;
+    slab->block_count = block_count;
+    slab->used_count = 0;
+    slab->carved_count = 0;
+    return slab;
+}
+
+void PayloadArena::destroy_slab(Slab* slab)
+{
+    size_t mapped_size = slab->mapped_size;
+    slab->~Slab();
+    unmap_memory(slab, mapped_size);
+    reserved_memory_.fetch_sub(mapped_size, std::memory_order_relaxed);
+}
+
+void PayloadArena::link_first(SizeClass& size_class, Slab* slab)
+{
+    slab->previous = nullptr;
+    slab->next = size_class.slabs;
+    if(size_class.slabs != nullptr)
+    {
+        size_class.slabs->previous = slab;
+    }
+    else
+    {
+        size_class.last_slab = slab;
+    }
+    size_class.slabs = slab;
+}
+
+void PayloadArena::link_last(SizeClass& size_class, Slab* slab)
+{
+    slab->next = nullptr;
+    slab->previous = size_class.last_slab;
+    if(size_class.last_slab != nullptr)
+    {
+        size_class.last_slab->next = slab;
+    }
+    else
+    {
+        size_class.slabs = slab;
+    }
+    size_class.last_slab = slab;
+}
+
+void PayloadArena::unlink(SizeClass& size_class, Slab* slab)
+{
+    if(slab->previous != nullptr)
+    {
+        slab->previous->next = slab->next;
+    }
+    else
+    {
+        size_class.slabs = slab->next;
+    }
+
+    if(slab->next != nullptr)
+    {
+        slab->next->previous = slab->previous;
+    }
+    else
+    {
+        size_class.last_slab = slab->previous;
+    }
+
+    slab->previous = nullptr;
+    slab->next = nullptr;
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
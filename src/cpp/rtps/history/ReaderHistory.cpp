@@ -24,6 +24,7 @@
 #include <fastrtps/rtps/reader/RTPSReader.h>
 #include <fastrtps/rtps/reader/ReaderListener.h>
 
+#include <algorithm>
 #include <mutex>
 
 namespace eprosima {
@@ -39,6 +40,24 @@ inline bool sort_ReaderHistoryCache(CacheChange_t*c1, CacheChange_t*c2)
     return c1->sequenceNumber < c2->sequenceNumber;
 }
 
+/*!
+ * Finds a change in a range ordered by sequence number.
+ * @return Iterator to the change with the same sequence number and writer, or last if there is none.
+ */
+static std::vector<CacheChange_t*>::iterator find_ordered(std::vector<CacheChange_t*>::iterator first,
+        std::vector<CacheChange_t*>::iterator last, const CacheChange_t* a_change)
+{
+    auto chit = std::lower_bound(first, last, const_cast<CacheChange_t*>(a_change), sort_ReaderHistoryCache);
+    for(; chit != last && (*chit)->sequenceNumber == a_change->sequenceNumber; ++chit)
+    {
+        if((*chit)->writerGUID == a_change->writerGUID)
+        {
+            return chit;
+        }
+    }
+    return last;
+}
+
 
 ReaderHistory::ReaderHistory(const HistoryAttributes& att):
                         History(att),
@@ -81,8 +100,22 @@ bool ReaderHistory::add_change(CacheChange_t* a_change)
         logError(RTPS_HISTORY,"The Writer GUID_t must be defined");
     }
 
-    m_changes.push_back(a_change);
-    sortCacheChanges();
+    WriterChanges& writer = m_changesByWriter[a_change->writerGUID];
+    size_t position = writer.changes.insert_ordered(a_change);
+    if(position < writer.first_unread)
+    {
+        writer.first_unread = position;
+    }
+
+    // Changes usually arrive in order, so they are appended without searching.
+    if(changesBegin() == changesEnd() || !(a_change->sequenceNumber < m_changes.back()->sequenceNumber))
+    {
+        m_changes.push_back(a_change);
+    }
+    else
+    {
+        m_changes.insert(std::upper_bound(changesBegin(), changesEnd(), a_change, sort_ReaderHistoryCache), a_change);
+    }
     updateMaxMinSeqNum();
     logInfo(RTPS_HISTORY, "Change " << a_change->sequenceNumber << " added with " << a_change->serializedPayload.length << " bytes");
 
@@ -104,20 +137,41 @@ bool ReaderHistory::remove_change(CacheChange_t* a_change)
         logError(RTPS_HISTORY,"Pointer is not valid")
         return false;
     }
-    for(std::vector<CacheChange_t*>::iterator chit = m_changes.begin();
-            chit!=m_changes.end();++chit)
+    std::vector<CacheChange_t*>::iterator chit = find_ordered(changesBegin(), changesEnd(), a_change);
+    if(chit != changesEnd())
     {
-        if((*chit)->sequenceNumber == a_change->sequenceNumber &&
-                (*chit)->writerGUID == a_change->writerGUID)
+        logInfo(RTPS_HISTORY,"Removing change "<< a_change->sequenceNumber);
+        auto writer_it = m_changesByWriter.find(a_change->writerGUID);
+        if(writer_it != m_changesByWriter.end())
+        {
+            WriterChanges& writer = writer_it->second;
+            size_t position = writer.changes.find(a_change);
+            if(position < writer.changes.size())
+            {
+                writer.changes.erase(position);
+                if(position < writer.first_unread)
+                {
+                    --writer.first_unread;
+                }
+            }
+            if(writer.changes.empty())
+            {
+                m_changesByWriter.erase(writer_it);
+            }
+        }
+        mp_reader->change_removed_by_history(a_change);
+        if(a_change->loan_count_ > 0)
+        {
+            // The user still holds the change, so it goes back to the pool when it is returned.
+            a_change->removed_while_lent_ = true;
+        }
+        else
         {
-            logInfo(RTPS_HISTORY,"Removing change "<< a_change->sequenceNumber);
-            mp_reader->change_removed_by_history(a_change);
             m_changePool.release_Cache(a_change);
-            m_changes.erase(chit);
-            sortCacheChanges();
-            updateMaxMinSeqNum();
-            return true;
         }
+        erase_change(chit);
+        updateMaxMinSeqNum();
+        return true;
     }
     logWarning(RTPS_HISTORY,"SequenceNumber "<<a_change->sequenceNumber << " not found");
     return false;
@@ -135,17 +189,15 @@ bool ReaderHistory::remove_changes_with_guid(const GUID_t& a_guid)
 
     {//Lock scope
         std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
-        for(std::vector<CacheChange_t*>::iterator chit = m_changes.begin(); chit!=m_changes.end();++chit)
+        auto writer_it = m_changesByWriter.find(a_guid);
+        if(writer_it != m_changesByWriter.end())
         {
-            bool matches = true;
-            unsigned int size = a_guid.guidPrefix.size;
-            if( !std::equal( (*chit)->writerGUID.guidPrefix.value , (*chit)->writerGUID.guidPrefix.value + size -1, a_guid.guidPrefix.value ) )
-                matches = false;
-            size = a_guid.entityId.size;
-            if( !std::equal( (*chit)->writerGUID.entityId.value , (*chit)->writerGUID.entityId.value + size -1, a_guid.entityId.value ) )
-                    matches = false;
-            if(matches)
-                changes_to_remove.push_back( (*chit) );
+            const InstanceChanges& changes = writer_it->second.changes;
+            for(size_t index = 0; index < changes.size(); ++index)
+            {
+                changes_to_remove.push_back(changes[index]);
+            }
+            m_changesByWriter.erase(writer_it);
         }
     }//End lock scope
 
@@ -159,19 +211,19 @@ bool ReaderHistory::remove_changes_with_guid(const GUID_t& a_guid)
 
 void ReaderHistory::sortCacheChanges()
 {
-    std::sort(m_changes.begin(),m_changes.end(),sort_ReaderHistoryCache);
+    std::sort(changesBegin(),changesEnd(),sort_ReaderHistoryCache);
 }
 
 void ReaderHistory::updateMaxMinSeqNum()
 {
-    if(m_changes.size()==0)
+    if(getHistorySize()==0)
     {
         mp_minSeqCacheChange = mp_invalidCache;
         mp_maxSeqCacheChange = mp_invalidCache;
     }
     else
     {
-        mp_minSeqCacheChange = m_changes.front();
+        mp_minSeqCacheChange = *changesBegin();
         mp_maxSeqCacheChange = m_changes.back();
     }
 }
@@ -188,20 +240,83 @@ void ReaderHistory::waitSemaphore() //TODO CAMBIAR NOMBRE PARA que el usuario se
 
 bool ReaderHistory::get_min_change_from(CacheChange_t** min_change, const GUID_t& writerGuid)
 {
-    bool ret = false;
     *min_change = nullptr;
 
-    for(auto it = m_changes.begin(); it != m_changes.end(); ++it)
+    auto writer_it = m_changesByWriter.find(writerGuid);
+    if(writer_it == m_changesByWriter.end() || writer_it->second.changes.empty())
+    {
+        return false;
+    }
+
+    *min_change = writer_it->second.changes.front();
+    return true;
+}
+
+bool ReaderHistory::get_first_unread_from(CacheChange_t** unread_change, const GUID_t& writerGuid)
+{
+    *unread_change = nullptr;
+
+    auto writer_it = m_changesByWriter.find(writerGuid);
+    if(writer_it == m_changesByWriter.end())
+    {
+        return false;
+    }
+
+    WriterChanges& writer = writer_it->second;
+    while(writer.first_unread < writer.changes.size() && writer.changes[writer.first_unread]->isRead)
+    {
+        ++writer.first_unread;
+    }
+
+    if(writer.first_unread == writer.changes.size())
+    {
+        return false;
+    }
+
+    *unread_change = writer.changes[writer.first_unread];
+    return true;
+}
+
+bool ReaderHistory::get_first_unread(CacheChange_t** unread_change)
+{
+    *unread_change = nullptr;
+
+    for(auto writer_it = m_changesByWriter.begin(); writer_it != m_changesByWriter.end(); ++writer_it)
     {
-        if((*it)->writerGUID == writerGuid)
+        CacheChange_t* writer_change = nullptr;
+        if(get_first_unread_from(&writer_change, writer_it->first) &&
+                (*unread_change == nullptr || writer_change->sequenceNumber < (*unread_change)->sequenceNumber))
         {
-            *min_change = *it;
-            ret = true;
-            break;
+            *unread_change = writer_change;
         }
     }
 
-    return ret;
+    return *unread_change != nullptr;
+}
+
+const CacheChange_t* ReaderHistory::loan_change(CacheChange_t* a_change)
+{
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    ++a_change->loan_count_;
+    return a_change;
+}
+
+bool ReaderHistory::return_loan(const CacheChange_t* a_change)
+{
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    CacheChange_t* change = const_cast<CacheChange_t*>(a_change);
+    if(!m_changePool.is_pool_change(change) || change->loan_count_ == 0)
+    {
+        logError(RTPS_HISTORY, "The change was not lent by this History");
+        return false;
+    }
+
+    if(--change->loan_count_ == 0 && change->removed_while_lent_)
+    {
+        change->removed_while_lent_ = false;
+        m_changePool.release_Cache(change);
+    }
+    return true;
 }
 
 }
@@ -22,6 +22,7 @@
 #include <fastrtps/rtps/writer/RTPSWriter.h>
 #include "fastrtps/rtps/common/WriteParams.h"
 
+#include <algorithm>
 #include <mutex>
 
 namespace eprosima {
@@ -94,7 +95,7 @@ bool WriterHistory::add_change(CacheChange_t* a_change, WriteParams& wparams)
 
     m_changes.push_back(a_change);
 
-    if(static_cast<int32_t>(m_changes.size()) == m_att.maximumReservedCaches)
+    if(static_cast<int32_t>(getHistorySize()) == m_att.maximumReservedCaches)
     {
         m_isHistoryFull = true;
     }
@@ -130,18 +131,23 @@ bool WriterHistory::remove_change(CacheChange_t* a_change)
         return false;
     }
 
-    for(std::vector<CacheChange_t*>::iterator chit = m_changes.begin();
-            chit!=m_changes.end();++chit)
+    std::vector<CacheChange_t*>::iterator chit = find_change(a_change->sequenceNumber);
+    if(chit != changesEnd())
     {
-        if((*chit)->sequenceNumber == a_change->sequenceNumber)
+        mp_writer->change_removed_by_history(a_change);
+        if(a_change->loan_count_ > 0)
+        {
+            // Still being delivered, so it goes back to the pool when it is returned.
+            a_change->removed_while_lent_ = true;
+        }
+        else
         {
-            mp_writer->change_removed_by_history(a_change);
             m_changePool.release_Cache(a_change);
-            m_changes.erase(chit);
-            updateMaxMinSeqNum();
-            m_isHistoryFull = false;
-            return true;
         }
+        erase_change(chit);
+        updateMaxMinSeqNum();
+        m_isHistoryFull = false;
+        return true;
     }
     logWarning(RTPS_HISTORY,"SequenceNumber "<<a_change->sequenceNumber << " not found");
     return false;
@@ -162,18 +168,23 @@ bool WriterHistory::remove_change(const SequenceNumber_t& sequence_number)
 
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    for(std::vector<CacheChange_t*>::iterator chit = m_changes.begin();
-            chit!=m_changes.end();++chit)
+    std::vector<CacheChange_t*>::iterator chit = find_change(sequence_number);
+    if(chit != changesEnd())
     {
-        if((*chit)->sequenceNumber == sequence_number)
+        mp_writer->change_removed_by_history(*chit);
+        if((*chit)->loan_count_ > 0)
+        {
+            // Still being delivered, so it goes back to the pool when it is returned.
+            (*chit)->removed_while_lent_ = true;
+        }
+        else
         {
-            mp_writer->change_removed_by_history(*chit);
             m_changePool.release_Cache(*chit);
-            m_changes.erase(chit);
-            updateMaxMinSeqNum();
-            m_isHistoryFull = false;
-            return true;
         }
+        erase_change(chit);
+        updateMaxMinSeqNum();
+        m_isHistoryFull = false;
+        return true;
     }
 
     logWarning(RTPS_HISTORY,"SequenceNumber " <<  sequence_number << " not found");
@@ -190,18 +201,15 @@ CacheChange_t* WriterHistory::remove_change_and_reuse(const SequenceNumber_t& se
 
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    for(std::vector<CacheChange_t*>::iterator chit = m_changes.begin();
-            chit!=m_changes.end();++chit)
+    std::vector<CacheChange_t*>::iterator chit = find_change(sequence_number);
+    if(chit != changesEnd())
     {
-        if((*chit)->sequenceNumber == sequence_number)
-        {
-            CacheChange_t* change = *chit;
-            mp_writer->change_removed_by_history(change);
-            m_changes.erase(chit);
-            updateMaxMinSeqNum();
-            m_isHistoryFull = false;
-            return change;
-        }
+        CacheChange_t* change = *chit;
+        mp_writer->change_removed_by_history(change);
+        erase_change(chit);
+        updateMaxMinSeqNum();
+        m_isHistoryFull = false;
+        return change;
     }
 
     logWarning(RTPS_HISTORY,"SequenceNumber " <<  sequence_number << " not found");
@@ -210,18 +218,91 @@ CacheChange_t* WriterHistory::remove_change_and_reuse(const SequenceNumber_t& se
 
 void WriterHistory::updateMaxMinSeqNum()
 {
-    if(m_changes.size()==0)
+    if(changesBegin() == changesEnd())
     {
         mp_minSeqCacheChange = mp_invalidCache;
         mp_maxSeqCacheChange = mp_invalidCache;
     }
     else
     {
-        mp_minSeqCacheChange = m_changes.front();
+        mp_minSeqCacheChange = *changesBegin();
         mp_maxSeqCacheChange = m_changes.back();
     }
 }
 
+bool WriterHistory::get_change(const SequenceNumber_t& seq, const GUID_t& guid, CacheChange_t** change)
+{
+    if(mp_mutex == nullptr)
+    {
+        logError(RTPS_HISTORY,"You need to create a RTPS Entity with this History before using it");
+        return false;
+    }
+
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    std::vector<CacheChange_t*>::iterator chit = find_change(seq);
+    if(chit != changesEnd() && (*chit)->writerGUID == guid)
+    {
+        *change = *chit;
+        return true;
+    }
+    return false;
+}
+
+void WriterHistory::loan_change(CacheChange_t* a_change)
+{
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    ++a_change->loan_count_;
+}
+
+bool WriterHistory::return_loan(CacheChange_t* a_change)
+{
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    if(!m_changePool.is_pool_change(a_change) || a_change->loan_count_ == 0)
+    {
+        logError(RTPS_HISTORY, "The change was not lent by this History");
+        return false;
+    }
+
+    if(--a_change->loan_count_ == 0 && a_change->removed_while_lent_)
+    {
+        a_change->removed_while_lent_ = false;
+        m_changePool.release_Cache(a_change);
+    }
+    return true;
+}
+
+std::vector<CacheChange_t*>::iterator WriterHistory::find_change(const SequenceNumber_t& sequence_number)
+{
+    std::vector<CacheChange_t*>::iterator first = changesBegin();
+    std::vector<CacheChange_t*>::iterator last = changesEnd();
+    if(first == last || sequence_number < (*first)->sequenceNumber)
+    {
+        return last;
+    }
+
+    // Sequence numbers are consecutive unless changes were removed, in which case the change can only be closer.
+    uint64_t distance = sequence_number.to64long() - (*first)->sequenceNumber.to64long();
+    if(distance < static_cast<uint64_t>(last - first))
+    {
+        last = first + static_cast<std::ptrdiff_t>(distance);
+        if((*last)->sequenceNumber == sequence_number)
+        {
+            return last;
+        }
+        ++last;
+    }
+
+    std::vector<CacheChange_t*>::iterator chit = std::lower_bound(first, last, sequence_number,
+            [](const CacheChange_t* change, const SequenceNumber_t& seq)
+            {
+                return change->sequenceNumber < seq;
+            });
+    if(chit != last && (*chit)->sequenceNumber == sequence_number)
+    {
+        return chit;
+    }
+    return changesEnd();
+}
 
 bool WriterHistory::remove_min_change()
 {
@@ -233,7 +314,7 @@ bool WriterHistory::remove_min_change()
     }
 
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
-    if(m_changes.size() > 0 && remove_change_g(mp_minSeqCacheChange))
+    if(changesBegin() != changesEnd() && remove_change_g(mp_minSeqCacheChange))
     {
         updateMaxMinSeqNum();
         return true;
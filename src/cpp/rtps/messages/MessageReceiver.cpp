@@ -34,6 +34,8 @@
 #include "../participant/RTPSParticipantImpl.h"
 
 #include <mutex>
+#include <thread>
+#include <algorithm>
 
 #include <limits>
 #include <cassert>
@@ -54,7 +56,9 @@ MessageReceiver::MessageReceiver(RTPSParticipantImpl* participant, uint32_t rec_
 #if HAVE_SECURITY
     m_crypto_msg(rec_buffer_size),
 #endif
-    sourceVendorId(c_VendorId_Unknown), participant_(participant)
+    mEndpoints(std::make_shared<EndpointTable>()),
+    mProcessingEpoch(0),
+    sourceVendorId(c_VendorId_Unknown), mReceiveBuffer(nullptr), participant_(participant)
 {
     init(rec_buffer_size);
 }
@@ -68,6 +72,9 @@ void MessageReceiver::init(uint32_t rec_buffer_size){
     haveTimestamp = false;
     timestamp = c_TimeInvalid;
 
+    mProcessing[0] = 0;
+    mProcessing[1] = 0;
+
     logInfo(RTPS_MSG_IN,"Created with CDRMessage of size: "<< rec_buffer_size);
     mMaxPayload_ = ((uint32_t)std::numeric_limits<uint16_t>::max() < rec_buffer_size) ? std::numeric_limits<uint16_t>::max() : (uint16_t)rec_buffer_size;
 }
@@ -75,60 +82,215 @@ void MessageReceiver::init(uint32_t rec_buffer_size){
 MessageReceiver::~MessageReceiver()
 {
     logInfo(RTPS_MSG_IN,"");
-    assert(AssociatedWriters.size() == 0);
-    assert(AssociatedReaders.size() == 0);
+    assert(mEndpoints->writers.size() == 0);
+    assert(mEndpoints->readers.size() == 0);
+}
+
+std::size_t MessageReceiver::EntityIdHash::operator()(const EntityId_t& id) const
+{
+    return (static_cast<std::size_t>(id.value[0]) << 24) | (static_cast<std::size_t>(id.value[1]) << 16) |
+        (static_cast<std::size_t>(id.value[2]) << 8) | static_cast<std::size_t>(id.value[3]);
+}
+
+std::size_t MessageReceiver::GUIDHash::operator()(const GUID_t& guid) const
+{
+    std::size_t seed = EntityIdHash()(guid.entityId);
+    for(octet byte : guid.guidPrefix.value)
+    {
+        seed = seed * 31 + byte;
+    }
+    return seed;
 }
 
 void MessageReceiver::associateEndpoint(Endpoint *to_add){
-    bool found = false;
     std::lock_guard<std::mutex> guard(mtx);
+    std::shared_ptr<EndpointTable> table = std::make_shared<EndpointTable>(*mEndpoints);
     if(to_add->getAttributes().endpointKind == WRITER)
     {
-        for(auto it = AssociatedWriters.begin(); it != AssociatedWriters.end(); ++it)
+        RTPSWriter* writer = (RTPSWriter*)to_add;
+        if(std::find(table->writers.begin(), table->writers.end(), writer) != table->writers.end())
         {
-            if( (*it) == (RTPSWriter*)to_add )
-            {
-                found = true;
-                break;
-            }
+            return;
         }
-        if(!found) AssociatedWriters.push_back((RTPSWriter*)to_add);
+        table->writers.push_back(writer);
+        table->writersByGuid[writer->getGuid()] = writer;
     }
     else
     {
-        for(auto it = AssociatedReaders.begin(); it != AssociatedReaders.end(); ++it)
+        RTPSReader* reader = (RTPSReader*)to_add;
+        if(std::find(table->readers.begin(), table->readers.end(), reader) != table->readers.end())
         {
-            if( (*it) == (RTPSReader*)to_add )
+            return;
+        }
+        table->readers.push_back(reader);
+        table->readersById[reader->getGuid().entityId] = reader;
+
+        std::vector<GUID_t> guids;
+        if(reader->matched_writer_guids(guids))
+        {
+            for(const GUID_t& guid : guids)
             {
-                found = true;
-                break;
+                table->readersByWriter[guid].push_back(reader);
             }
         }
-        if(!found) AssociatedReaders.push_back((RTPSReader*)to_add);
+        else
+        {
+            table->readersForAnyWriter.push_back(reader);
+        }
     }
-    return;
+    publishTable(table);
 }
+
 void MessageReceiver::removeEndpoint(Endpoint *to_remove){
+    std::lock_guard<std::mutex> removal_guard(mRemovalMtx);
+    {
+        std::lock_guard<std::mutex> guard(mtx);
+        std::shared_ptr<EndpointTable> table = std::make_shared<EndpointTable>(*mEndpoints);
+        if(to_remove->getAttributes().endpointKind == WRITER)
+        {
+            RTPSWriter* writer = (RTPSWriter*)to_remove;
+            auto it = std::find(table->writers.begin(), table->writers.end(), writer);
+            if(it == table->writers.end())
+            {
+                return;
+            }
+            table->writers.erase(it);
+            table->writersByGuid.erase(writer->getGuid());
+        }
+        else
+        {
+            RTPSReader* reader = (RTPSReader*)to_remove;
+            auto it = std::find(table->readers.begin(), table->readers.end(), reader);
+            if(it == table->readers.end())
+            {
+                return;
+            }
+            table->readers.erase(it);
+            table->readersById.erase(reader->getGuid().entityId);
+            indexAnyWriter(*table, reader, false);
+            for(auto writer_it = table->readersByWriter.begin(); writer_it != table->readersByWriter.end();)
+            {
+                std::vector<RTPSReader*>& readers = writer_it->second;
+                readers.erase(std::remove(readers.begin(), readers.end(), reader), readers.end());
+                writer_it = readers.empty() ? table->readersByWriter.erase(writer_it) : std::next(writer_it);
+            }
+        }
+        publishTable(table);
+    }
 
+    // Messages may take any table generation published before the one above, and keep it until they are
+    // processed. New messages are counted on the other parity from now on, so once the messages counted on the
+    // previous one finish, nothing can be using the endpoint.
+    uint32_t previous = mProcessingEpoch.fetch_add(1) & 1;
+    while(mProcessing[previous].load() != 0)
+    {
+        std::this_thread::yield();
+    }
+}
+
+void MessageReceiver::readerMatchedWriter(RTPSReader* reader, const GUID_t& writer_guid, bool any_writer)
+{
     std::lock_guard<std::mutex> guard(mtx);
-    if(to_remove->getAttributes().endpointKind == WRITER){
-        RTPSWriter* var = (RTPSWriter *)to_remove;
-        for(auto it=AssociatedWriters.begin(); it !=AssociatedWriters.end(); ++it){
-            if ((*it) == var){
-                AssociatedWriters.erase(it);
-                break;
-            }
+    if(std::find(mEndpoints->readers.begin(), mEndpoints->readers.end(), reader) == mEndpoints->readers.end())
+    {
+        return;
+    }
+
+    // Readers taking messages from any writer are not indexed by writer, so they are not given a message twice.
+    std::shared_ptr<EndpointTable> table = std::make_shared<EndpointTable>(*mEndpoints);
+    if(!any_writer)
+    {
+        std::vector<RTPSReader*>& readers = table->readersByWriter[writer_guid];
+        if(std::find(readers.begin(), readers.end(), reader) == readers.end())
+        {
+            readers.push_back(reader);
         }
-    }else{
-        RTPSReader *var = (RTPSReader *)to_remove;
-        for(auto it=AssociatedReaders.begin(); it !=AssociatedReaders.end(); ++it){
-            if ((*it) == var){
-                AssociatedReaders.erase(it);
-                break;
+    }
+    indexAnyWriter(*table, reader, any_writer);
+    publishTable(table);
+}
+
+void MessageReceiver::readerUnmatchedWriter(RTPSReader* reader, const GUID_t& writer_guid, bool any_writer)
+{
+    std::lock_guard<std::mutex> guard(mtx);
+    if(std::find(mEndpoints->readers.begin(), mEndpoints->readers.end(), reader) == mEndpoints->readers.end())
+    {
+        return;
+    }
+
+    // The reader stays associated, so messages still using the previous table need not be waited for.
+    std::shared_ptr<EndpointTable> table = std::make_shared<EndpointTable>(*mEndpoints);
+    auto writer_it = table->readersByWriter.find(writer_guid);
+    if(writer_it != table->readersByWriter.end())
+    {
+        std::vector<RTPSReader*>& readers = writer_it->second;
+        readers.erase(std::remove(readers.begin(), readers.end(), reader), readers.end());
+        if(readers.empty())
+        {
+            table->readersByWriter.erase(writer_it);
+        }
+    }
+    indexAnyWriter(*table, reader, any_writer);
+    publishTable(table);
+}
+
+std::shared_ptr<const MessageReceiver::EndpointTable> MessageReceiver::endpointTable() const
+{
+    return std::atomic_load(&mEndpoints);
+}
+
+void MessageReceiver::indexAnyWriter(EndpointTable& table, RTPSReader* reader, bool any_writer)
+{
+    auto it = std::find(table.readersForAnyWriter.begin(), table.readersForAnyWriter.end(), reader);
+    if(any_writer && it == table.readersForAnyWriter.end())
+    {
+        table.readersForAnyWriter.push_back(reader);
+    }
+    else if(!any_writer && it != table.readersForAnyWriter.end())
+    {
+        table.readersForAnyWriter.erase(it);
+    }
+}
+
+std::shared_ptr<const MessageReceiver::EndpointTable> MessageReceiver::publishTable(
+        std::shared_ptr<const EndpointTable> table)
+{
+    return std::atomic_exchange(&mEndpoints, std::move(table));
+}
+
+template<typename Functor>
+void MessageReceiver::forEachReader(const EndpointTable& table, EntityId_t& readerId, const GUID_t& writerGUID,
+        Functor f)
+{
+    if(readerId != c_EntityId_Unknown)
+    {
+        auto it = table.readersById.find(readerId);
+        if(it != table.readersById.end())
+        {
+            f(it->second);
+        }
+        return;
+    }
+
+    auto it = table.readersByWriter.find(writerGUID);
+    if(it != table.readersByWriter.end())
+    {
+        for(RTPSReader* reader : it->second)
+        {
+            if(reader->acceptMsgDirectedTo(readerId))
+            {
+                f(reader);
             }
         }
     }
-    return;
+
+    for(RTPSReader* reader : table.readersForAnyWriter)
+    {
+        if(reader->acceptMsgDirectedTo(readerId))
+        {
+            f(reader);
+        }
+    }
 }
 
 
@@ -142,10 +304,21 @@ void MessageReceiver::reset(){
     timestamp = c_TimeInvalid;
 }
 
-void MessageReceiver::processCDRMsg(const Locator_t& loc, CDRMessage_t*msg)
+void MessageReceiver::processCDRMsg(const Locator_t& loc, CDRMessage_t*msg, ReceiveBuffer* buffer)
+{
+    // Counted before taking any table, so removeEndpoint() either waits for this message or is seen by it.
+    std::atomic<uint32_t>& processing = mProcessing[mProcessingEpoch.load() & 1];
+    ++processing;
+    processMessage(loc, msg, buffer);
+    --processing;
+}
+
+void MessageReceiver::processMessage(const Locator_t& loc, CDRMessage_t*msg, ReceiveBuffer* buffer)
 {
     (void)loc;
 
+    mReceiveBuffer = buffer;
+
     if(msg->length < RTPSMESSAGE_HEADER_SIZE)
     {
         logWarning(RTPS_MSG_IN,IDSTRING"Received message too short, ignoring");
@@ -405,7 +578,7 @@ bool MessageReceiver::readSubmessageHeader(CDRMessage_t* msg, SubmessageHeader_t
 
 bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh, bool* last)
 {
-    std::lock_guard<std::mutex> guard(mtx);
+    std::shared_ptr<const EndpointTable> table = endpointTable();
 
     //READ and PROCESS
     if(smh->submessageLength < RTPSMESSAGE_DATA_MIN_LENGTH)
@@ -443,23 +616,13 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
 
     //WE KNOW THE READER THAT THE MESSAGE IS DIRECTED TO SO WE LOOK FOR IT:
 
-    RTPSReader* firstReader = nullptr;
-    if(AssociatedReaders.empty())
+    if(table->readers.empty())
     {
         logWarning(RTPS_MSG_IN,IDSTRING"Data received when NO readers are listening");
         return false;
     }
 
-    for(std::vector<RTPSReader*>::iterator it=AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
-    {
-        if((*it)->acceptMsgDirectedTo(readerID)) //add
-        {
-            firstReader = *it;
-            break;
-        }
-    }
-    if(firstReader == nullptr) //Reader not found
+    if(readerID != c_EntityId_Unknown && table->readersById.find(readerID) == table->readersById.end()) //Reader not found
     {
         logWarning(RTPS_MSG_IN, IDSTRING"No Reader accepts this message (directed to: " <<readerID << ")");
         return false;
@@ -522,8 +685,16 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
         {
             if(ch.serializedPayload.max_size >= payload_size && payload_size > 0)
             {
-                ch.serializedPayload.data = &msg->buffer[msg->pos];
-                ch.serializedPayload.length = payload_size;
+                // Decoded secure messages are not in the receive buffer, and cannot be loaned from it.
+                if(mReceiveBuffer != nullptr && mReceiveBuffer->contains(&msg->buffer[msg->pos], payload_size))
+                {
+                    ch.serializedPayload.loan(mReceiveBuffer, &msg->buffer[msg->pos], payload_size);
+                }
+                else
+                {
+                    ch.serializedPayload.data = &msg->buffer[msg->pos];
+                    ch.serializedPayload.length = payload_size;
+                }
                 msg->pos += payload_size;
                 ch.kind = ALIVE;
             }
@@ -568,18 +739,15 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
 
 
     //FIXME: DO SOMETHING WITH PARAMETERLIST CREATED.
-    logInfo(RTPS_MSG_IN,IDSTRING"from Writer " << ch.writerGUID << "; possible RTPSReaders: "<<AssociatedReaders.size());
+    logInfo(RTPS_MSG_IN,IDSTRING"from Writer " << ch.writerGUID << "; possible RTPSReaders: "<<table->readers.size());
     //Look for the correct reader to add the change
-    for(std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    forEachReader(*table, readerID, ch.writerGUID, [&ch](RTPSReader* reader)
     {
-        if((*it)->acceptMsgDirectedTo(readerID))
-        {
-            (*it)->processDataMsg(&ch);
-        }
-    }
+        reader->processDataMsg(&ch);
+    });
 
     //TODO(Ricardo) If a exception is thrown (ex, by fastcdr), this line is not executed -> segmentation fault
+    ch.serializedPayload.return_loan();
     ch.serializedPayload.data = nullptr;
 
     logInfo(RTPS_MSG_IN,IDSTRING"Sub Message DATA processed");
@@ -588,7 +756,7 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
 
 bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t* smh, bool* last)
 {
-    std::lock_guard<std::mutex> guard(mtx);
+    std::shared_ptr<const EndpointTable> table = endpointTable();
 
     //READ and PROCESS
     if (smh->submessageLength < RTPSMESSAGE_DATA_MIN_LENGTH)
@@ -620,24 +788,13 @@ bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t
     valid &= CDRMessage::readEntityId(msg, &readerID);
 
     //WE KNOW THE READER THAT THE MESSAGE IS DIRECTED TO SO WE LOOK FOR IT:
-    if(AssociatedReaders.empty())
+    if(table->readers.empty())
     {
         logWarning(RTPS_MSG_IN, IDSTRING"Data received when NO readers are listening");
         return false;
     }
 
-    RTPSReader* firstReader = nullptr;
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
-    {
-        if ((*it)->acceptMsgDirectedTo(readerID)) //add
-        {
-            firstReader = *it;
-            break;
-        }
-    }
-
-    if (firstReader == nullptr) //Reader not found
+    if (readerID != c_EntityId_Unknown && table->readersById.find(readerID) == table->readersById.end()) //Reader not found
     {
         logWarning(RTPS_MSG_IN, IDSTRING"No Reader accepts this message (directed to: " << readerID << ")");
         return false;
@@ -768,16 +925,12 @@ bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t
         ch.sourceTimestamp = this->timestamp;
 
     //FIXME: DO SOMETHING WITH PARAMETERLIST CREATED.
-    logInfo(RTPS_MSG_IN, IDSTRING"from Writer " << ch.writerGUID << "; possible RTPSReaders: " << AssociatedReaders.size());
+    logInfo(RTPS_MSG_IN, IDSTRING"from Writer " << ch.writerGUID << "; possible RTPSReaders: " << table->readers.size());
     //Look for the correct reader to add the change
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    forEachReader(*table, readerID, ch.writerGUID, [&](RTPSReader* reader)
     {
-        if ((*it)->acceptMsgDirectedTo(readerID))
-        {
-            (*it)->processDataFragMsg(&ch, sampleSize, fragmentStartingNum);
-        }
-    }
+        reader->processDataFragMsg(&ch, sampleSize, fragmentStartingNum);
+    });
 
     ch.serializedPayload.data = nullptr;
 
@@ -815,16 +968,12 @@ bool MessageReceiver::proc_Submsg_Heartbeat(CDRMessage_t* msg,SubmessageHeader_t
     uint32_t HBCount;
     CDRMessage::readUInt32(msg,&HBCount);
 
-    std::lock_guard<std::mutex> guard(mtx);
+    std::shared_ptr<const EndpointTable> table = endpointTable();
     //Look for the correct reader and writers:
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    forEachReader(*table, readerGUID.entityId, writerGUID, [&](RTPSReader* reader)
     {
-        if((*it)->acceptMsgDirectedTo(readerGUID.entityId))
-        {
-            (*it)->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
-        }
-    }
+        reader->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
+    });
     //Is the final message?
     if(smh->submessageLength == 0)
         *last = true;
@@ -856,28 +1005,25 @@ bool MessageReceiver::proc_Submsg_Acknack(CDRMessage_t* msg,SubmessageHeader_t*
     if(smh->submessageLength == 0)
         *last = true;
 
-    std::lock_guard<std::mutex> guard(mtx);
+    std::shared_ptr<const EndpointTable> table = endpointTable();
     //Look for the correct writer to use the acknack
-    for (std::vector<RTPSWriter*>::iterator it = AssociatedWriters.begin();
-            it != AssociatedWriters.end(); ++it)
+    auto it = table->writersByGuid.find(writerGUID);
+    if(it != table->writersByGuid.end())
     {
-        if((*it)->getGuid() == writerGUID)
+        if(it->second->getAttributes().reliabilityKind == RELIABLE)
         {
-            if((*it)->getAttributes().reliabilityKind == RELIABLE)
-            {
-                StatefulWriter* SF = (StatefulWriter*)(*it);
-                SF->process_acknack(readerGUID, Ackcount, SNSet, finalFlag);
-                return true;
-            }
-            else
-            {
-                logInfo(RTPS_MSG_IN,IDSTRING"Acknack msg to NOT stateful writer ");
-                return false;
-            }
+            StatefulWriter* SF = (StatefulWriter*)it->second;
+            SF->process_acknack(readerGUID, Ackcount, SNSet, finalFlag);
+            return true;
+        }
+        else
+        {
+            logInfo(RTPS_MSG_IN,IDSTRING"Acknack msg to NOT stateful writer ");
+            return false;
         }
     }
     logInfo(RTPS_MSG_IN,IDSTRING"Acknack msg to UNKNOWN writer (I loooked through "
-            << AssociatedWriters.size() << " writers in this ListenResource)");
+            << table->writers.size() << " writers in this ListenResource)");
     return false;
 }
 
@@ -908,15 +1054,11 @@ bool MessageReceiver::proc_Submsg_Gap(CDRMessage_t* msg,SubmessageHeader_t* smh,
     if(gapStart <= SequenceNumber_t(0, 0))
         return false;
 
-    std::lock_guard<std::mutex> guard(mtx);
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    std::shared_ptr<const EndpointTable> table = endpointTable();
+    forEachReader(*table, readerGUID.entityId, writerGUID, [&](RTPSReader* reader)
     {
-        if((*it)->acceptMsgDirectedTo(readerGUID.entityId))
-        {
-            (*it)->processGapMsg(writerGUID, gapStart, gapList);
-        }
-    }
+        reader->processGapMsg(writerGUID, gapStart, gapList);
+    });
 
     return true;
 }
@@ -1020,18 +1162,17 @@ bool MessageReceiver::proc_Submsg_NackFrag(CDRMessage_t*msg, SubmessageHeader_t*
     if (smh->submessageLength == 0)
         *last = true;
 
-    std::lock_guard<std::mutex> guard(mtx);
+    std::shared_ptr<const EndpointTable> table = endpointTable();
     //Look for the correct writer to use the acknack
-    for (std::vector<RTPSWriter*>::iterator it = AssociatedWriters.begin();
-            it != AssociatedWriters.end(); ++it)
+    auto it = table->writersByGuid.find(writerGUID);
+    if (it != table->writersByGuid.end())
     {
         //Look for the readerProxy the acknack is from
-        std::lock_guard<std::recursive_mutex> guardW(*(*it)->getMutex());
-        if ((*it)->getGuid() == writerGUID)
+        std::lock_guard<std::recursive_mutex> guardW(*it->second->getMutex());
         {
-            if ((*it)->getAttributes().reliabilityKind == RELIABLE)
+            if (it->second->getAttributes().reliabilityKind == RELIABLE)
             {
-                StatefulWriter* SF = (StatefulWriter*)(*it);
+                StatefulWriter* SF = (StatefulWriter*)it->second;
 
                 for (auto rit = SF->matchedReadersBegin(); rit != SF->matchedReadersEnd(); ++rit)
                 {
@@ -1061,7 +1202,7 @@ bool MessageReceiver::proc_Submsg_NackFrag(CDRMessage_t*msg, SubmessageHeader_t*
         }
     }
     logInfo(RTPS_MSG_IN, IDSTRING"Acknack msg to UNKNOWN writer (I looked through "
-            << AssociatedWriters.size() << " writers in this ListenResource)");
+            << table->writers.size() << " writers in this ListenResource)");
     return false;
 }
 
@@ -1091,18 +1232,13 @@ bool MessageReceiver::proc_Submsg_HeartbeatFrag(CDRMessage_t*msg, SubmessageHead
 
     // XXX TODO VALIDATE DATA?
 
-    std::lock_guard<std::mutex> guard(mtx);
     //Look for the correct reader and writers:
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
-    {
-        /* XXX TODO PROCESS
-           if ((*it)->acceptMsgDirectedTo(readerGUID.entityId))
-           {
-           (*it)->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
-           }
-           */
-    }
+    /* XXX TODO PROCESS
+       forEachReader(*endpointTable(), readerGUID.entityId, writerGUID, [&](RTPSReader* reader)
+       {
+       reader->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
+       });
+       */
 
     //Is the final message?
     if (smh->submessageLength == 0)
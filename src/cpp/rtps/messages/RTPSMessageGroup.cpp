@@ -20,7 +20,10 @@
 #include <fastrtps/rtps/messages/RTPSMessageGroup.h>
 #include <fastrtps/rtps/messages/RTPSMessageCreator.h>
 #include <fastrtps/rtps/writer/RTPSWriter.h>
-#include "../participant/RTPSParticipantImpl.h"
+#include <rtps/participant/RTPSParticipantImpl.h>
+#if HAVE_SECURITY
+#include <rtps/security/SecurityManager.h>
+#endif
 #include "../flowcontrol/FlowController.h"
 
 #include <fastrtps/log/Log.h>
@@ -31,6 +34,12 @@ namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+/**
+ * Payloads smaller than this are copied into the message, as that is cheaper than
+ * an additional slice for the transport to gather.
+ */
+static const uint32_t c_MinReferencedPayloadSize = 512;
+
 bool sort_changes_group (CacheChange_t* c1,CacheChange_t* c2)
 {
     return(c1->sequenceNumber < c2->sequenceNumber);
@@ -142,7 +151,8 @@ const EntityId_t& get_entity_id(const std::vector<GUID_t>& endpoints)
 RTPSMessageGroup::RTPSMessageGroup(RTPSParticipantImpl* participant, Endpoint* endpoint, ENDPOINT_TYPE type,
         RTPSMessageGroup_t& msg_group) :
     participant_(participant), endpoint_(endpoint), full_msg_(&msg_group.rtpsmsg_fullmsg_),
-    submessage_msg_(&msg_group.rtpsmsg_submessage_), currentBytesSent_(0),
+    submessage_msg_(&msg_group.rtpsmsg_submessage_), buffers_(&msg_group.rtpsmsg_buffers_),
+    referenced_bytes_(0), pending_slice_start_(0), currentBytesSent_(0),
     fixed_destination_(false), fixed_destination_locators_(nullptr), 
     fixed_destination_guids_(nullptr), fixed_destination_prefix_()
 #if HAVE_SECURITY
@@ -216,11 +226,37 @@ RTPSMessageGroup::~RTPSMessageGroup()
     send();
 }
 
+void RTPSMessageGroup::set_endpoint(Endpoint* endpoint)
+{
+    assert(endpoint);
+
+#if HAVE_SECURITY
+    // Whether the whole message is encoded depends on the endpoint, so it cannot mix protected and unprotected ones.
+    if(participant_->security_attributes().is_rtps_protected &&
+            endpoint->supports_rtps_protection() != endpoint_->supports_rtps_protection())
+    {
+        flush();
+
+        if(!fixed_destination_)
+        {
+            // Next submessage will set the destination again.
+            current_locators_.clear();
+        }
+        current_dst_ = c_GuidPrefix_Unknown;
+    }
+#endif
+
+    endpoint_ = endpoint;
+}
+
 void RTPSMessageGroup::reset_to_header()
 {
     CDRMessage::initCDRMsg(full_msg_);
     full_msg_->pos = RTPSMESSAGE_HEADER_SIZE;
     full_msg_->length = RTPSMESSAGE_HEADER_SIZE;
+    buffers_->clear();
+    referenced_bytes_ = 0;
+    pending_slice_start_ = 0;
 }
 
 bool RTPSMessageGroup::check_preconditions(const LocatorList_t& locator_list,
@@ -269,14 +305,27 @@ void RTPSMessageGroup::send()
             msgToSend = encrypt_msg_;
         }
 #endif
-        const LocatorList_t & destinations =
-            fixed_destination_ ? *fixed_destination_locators_ : current_locators_;
-        for(const auto& lit : destinations)
+        uint32_t total_bytes = msgToSend->length;
+        if(buffers_->empty())
         {
-            participant_->sendSync(msgToSend, endpoint_, lit);
+            buffers_->emplace_back(msgToSend->buffer, msgToSend->length);
         }
+        else
+        {
+            // Payloads were referenced. Security is not applied in that case, so full_msg_ is the one to send.
+            if(full_msg_->length > pending_slice_start_)
+            {
+                buffers_->emplace_back(full_msg_->buffer + pending_slice_start_,
+                        full_msg_->length - pending_slice_start_);
+            }
+            total_bytes += referenced_bytes_;
+        }
+
+        const LocatorList_t & destinations =
+            fixed_destination_ ? *fixed_destination_locators_ : current_locators_;
+        participant_->sendSync(*buffers_, total_bytes, endpoint_, destinations);
 
-        currentBytesSent_ += msgToSend->length;
+        currentBytesSent_ += total_bytes;
     }
 }
 
@@ -314,9 +363,15 @@ void RTPSMessageGroup::check_and_maybe_flush(const LocatorList_t& locator_list,
     add_info_dst_in_buffer(submessage_msg_, remote_endpoints);
 }
 
-bool RTPSMessageGroup::insert_submessage(const std::vector<GUID_t>& remote_endpoints)
+bool RTPSMessageGroup::insert_submessage(const std::vector<GUID_t>& remote_endpoints, const octet* payload,
+        uint32_t payload_length)
 {
-    if(!CDRMessage::appendMsg(full_msg_, submessage_msg_))
+    // Referenced payloads are followed by the padding that aligns the next submessage.
+    uint32_t padding = payload != nullptr ? (4 - payload_length % 4) & 3 : 0;
+    uint32_t referenced_size = payload != nullptr ? payload_length + padding : 0;
+
+    if(!fits_in_message(submessage_msg_->length + referenced_size) ||
+            !CDRMessage::appendMsg(full_msg_, submessage_msg_))
     {
         // Retry
         flush();
@@ -329,13 +384,48 @@ bool RTPSMessageGroup::insert_submessage(const std::vector<GUID_t>& remote_endpo
             return false;
         }
 
-        if(!CDRMessage::appendMsg(full_msg_, submessage_msg_))
+        if(!fits_in_message(submessage_msg_->length + referenced_size) ||
+                !CDRMessage::appendMsg(full_msg_, submessage_msg_))
         {
             logError(RTPS_WRITER,"Cannot add RTPS submesage to the CDRMessage. Buffer too small");
             return false;
         }
     }
 
+    if(payload != nullptr)
+    {
+        // Close the slice of full_msg_ built so far and reference the payload after it.
+        buffers_->emplace_back(full_msg_->buffer + pending_slice_start_, full_msg_->length - pending_slice_start_);
+        buffers_->emplace_back(payload, payload_length);
+        pending_slice_start_ = full_msg_->length;
+        referenced_bytes_ += payload_length;
+
+        for(uint32_t count = 0; count < padding; ++count)
+            CDRMessage::addOctet(full_msg_, 0);
+    }
+
+    return true;
+}
+
+bool RTPSMessageGroup::can_reference_payload(const octet* payload, uint32_t payload_length) const
+{
+    if(payload == nullptr || payload_length < c_MinReferencedPayloadSize)
+        return false;
+
+    // A referenced payload takes two slices, and one more is needed for what follows it.
+    if(buffers_->size() + 3 > s_maximumNetworkBuffers)
+        return false;
+
+#if HAVE_SECURITY
+    // Encoding needs the whole submessage or message in a contiguous buffer.
+    if(participant_->security_attributes().is_rtps_protected && endpoint_->supports_rtps_protection())
+        return false;
+
+    if(endpoint_->getAttributes().security_attributes().is_submessage_protected ||
+            endpoint_->getAttributes().security_attributes().is_payload_protected)
+        return false;
+#endif
+
     return true;
 }
 
@@ -443,8 +533,16 @@ bool RTPSMessageGroup::add_data(const CacheChange_t& change, const std::vector<G
 
     // TODO (Ricardo). Check to create special wrapper.
 
+    // Large payloads are sent straight from the cache change.
+    const octet* payload = nullptr;
+    if(change.kind == ALIVE &&
+            can_reference_payload(change.serializedPayload.data, change.serializedPayload.length))
+    {
+        payload = change.serializedPayload.data;
+    }
+
     if(!RTPSMessageCreator::addSubmessageData(submessage_msg_, &change, endpoint_->getAttributes().topicKind,
-                readerId, expectsInlineQos, inlineQos))
+                readerId, expectsInlineQos, inlineQos, payload == nullptr))
     {
         logError(RTPS_WRITER, "Cannot add DATA submsg to the CDRMessage. Buffer too small");
         return false;
@@ -476,7 +574,7 @@ bool RTPSMessageGroup::add_data(const CacheChange_t& change, const std::vector<G
     }
 #endif
 
-    return insert_submessage(remote_readers);
+    return insert_submessage(remote_readers, payload, payload != nullptr ? change.serializedPayload.length : 0);
 }
 
 bool RTPSMessageGroup::add_data_frag(const CacheChange_t& change, const uint32_t fragment_number,
@@ -537,9 +635,16 @@ bool RTPSMessageGroup::add_data_frag(const CacheChange_t& change, const uint32_t
     }
 #endif
 
+    // Large fragments are sent straight from the cache change.
+    const octet* payload = nullptr;
+    if(change.kind == ALIVE && can_reference_payload(change_to_add.serializedPayload.data, fragment_size))
+    {
+        payload = change_to_add.serializedPayload.data;
+    }
+
     if(!RTPSMessageCreator::addSubmessageDataFrag(submessage_msg_, &change_to_add, fragment_number,
                 change.serializedPayload.length, endpoint_->getAttributes().topicKind, readerId,
-                expectsInlineQos, inlineQos))
+                expectsInlineQos, inlineQos, payload == nullptr))
     {
         logError(RTPS_WRITER, "Cannot add DATA_FRAG submsg to the CDRMessage. Buffer too small");
         change_to_add.serializedPayload.data = NULL;
@@ -573,7 +678,7 @@ bool RTPSMessageGroup::add_data_frag(const CacheChange_t& change, const uint32_t
     }
 #endif
 
-    return insert_submessage(remote_readers);
+    return insert_submessage(remote_readers, payload, payload != nullptr ? fragment_size : 0);
 }
 
 bool RTPSMessageGroup::add_heartbeat(const std::vector<GUID_t>& remote_readers, const SequenceNumber_t& firstSN,
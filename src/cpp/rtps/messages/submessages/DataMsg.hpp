@@ -46,8 +46,10 @@ bool RTPSMessageCreator::addMessageData(CDRMessage_t* msg,
 
 
 bool RTPSMessageCreator::addSubmessageData(CDRMessage_t* msg, const CacheChange_t* change,
-        TopicKind_t topicKind, const EntityId_t& readerId, bool expectsInlineQos, ParameterList_t* inlineQos) {
-    CDRMessage_t& submsgElem = g_pool_submsg.reserve_CDRMsg((uint16_t)change->serializedPayload.length);
+        TopicKind_t topicKind, const EntityId_t& readerId, bool expectsInlineQos, ParameterList_t* inlineQos,
+        bool copy_payload) {
+    CDRMessage_t& submsgElem = g_pool_submsg.reserve_CDRMsg(
+            copy_payload ? (uint16_t)change->serializedPayload.length : 0);
     CDRMessage::initCDRMsg(&submsgElem);
     //Create the two CDR msgs
     //CDRMessage_t submsgElem;
@@ -150,8 +152,14 @@ bool RTPSMessageCreator::addSubmessageData(CDRMessage_t* msg, const CacheChange_
         }
 
         //Add Serialized Payload
+        uint32_t payload_not_copied = 0;
         if(dataFlag)
-            added_no_error &= CDRMessage::addData(&submsgElem, change->serializedPayload.data, change->serializedPayload.length);
+        {
+            if(copy_payload)
+                added_no_error &= CDRMessage::addData(&submsgElem, change->serializedPayload.data, change->serializedPayload.length);
+            else
+                payload_not_copied = change->serializedPayload.length;
+        }
 
         if(keyFlag)
         {
@@ -168,9 +176,12 @@ bool RTPSMessageCreator::addSubmessageData(CDRMessage_t* msg, const CacheChange_
         }
 
         // Align submessage to rtps alignment (4).
-        uint32_t align = (4 - submsgElem.pos % 4) & 3;
-        for(uint32_t count = 0; count < align; ++count)
-            added_no_error &= CDRMessage::addOctet(&submsgElem, 0);
+        uint32_t align = (4 - (submsgElem.pos + payload_not_copied) % 4) & 3;
+        if(payload_not_copied > 0)
+            payload_not_copied += align;
+        else
+            for(uint32_t count = 0; count < align; ++count)
+                added_no_error &= CDRMessage::addOctet(&submsgElem, 0);
 
         //if(align > 0)
         {
@@ -179,7 +190,8 @@ bool RTPSMessageCreator::addSubmessageData(CDRMessage_t* msg, const CacheChange_
         }
 
         //Once the submessage elements are added, the submessage header is created, assigning the correct size.
-        added_no_error &= RTPSMessageCreator::addSubmessageHeader(msg, DATA,flags, (uint16_t)submsgElem.length);
+        added_no_error &= RTPSMessageCreator::addSubmessageHeader(msg, DATA,flags,
+                (uint16_t)(submsgElem.length + payload_not_copied));
         //Append Submessage elements to msg
 
         added_no_error &= CDRMessage::appendMsg(msg, &submsgElem);
@@ -236,9 +248,10 @@ bool RTPSMessageCreator::addMessageDataFrag(CDRMessage_t* msg, GuidPrefix_t& gui
 
 bool RTPSMessageCreator::addSubmessageDataFrag(CDRMessage_t* msg, const CacheChange_t* change, uint32_t fragment_number,
         uint32_t sample_size, TopicKind_t topicKind, const EntityId_t& readerId, bool expectsInlineQos,
-        ParameterList_t* inlineQos)
+        ParameterList_t* inlineQos, bool copy_payload)
 {
-    CDRMessage_t& submsgElem = g_pool_submsg.reserve_CDRMsg((uint16_t)change->serializedPayload.length);
+    CDRMessage_t& submsgElem = g_pool_submsg.reserve_CDRMsg(
+            copy_payload ? (uint16_t)change->serializedPayload.length : 0);
     CDRMessage::initCDRMsg(&submsgElem);
     //Create the two CDR msgs
     //CDRMessage_t submsgElem;
@@ -349,10 +362,18 @@ bool RTPSMessageCreator::addSubmessageDataFrag(CDRMessage_t* msg, const CacheCha
         }
 
         //Add Serialized Payload XXX TODO
+        uint32_t payload_not_copied = 0;
         if (!keyFlag) // keyflag = 0 means that the serializedPayload SubmessageElement contains the serialized Data 
         {
-            added_no_error &= CDRMessage::addData(&submsgElem, change->serializedPayload.data,
-                    change->serializedPayload.length);
+            if (copy_payload)
+            {
+                added_no_error &= CDRMessage::addData(&submsgElem, change->serializedPayload.data,
+                        change->serializedPayload.length);
+            }
+            else
+            {
+                payload_not_copied = change->serializedPayload.length;
+            }
         }
         else
         {   // keyflag = 1 means that the serializedPayload SubmessageElement contains the serialized Key 
@@ -373,12 +394,20 @@ bool RTPSMessageCreator::addSubmessageDataFrag(CDRMessage_t* msg, const CacheCha
 
         // TODO(Ricardo) This should be on cachechange.
         // Align submessage to rtps alignment (4).
-        uint32_t align = (4 - submsgElem.pos % 4) & 3;
-        for (uint32_t count = 0; count < align; ++count)
-            added_no_error &= CDRMessage::addOctet(&submsgElem, 0);
+        uint32_t align = (4 - (submsgElem.pos + payload_not_copied) % 4) & 3;
+        if (payload_not_copied > 0)
+        {
+            payload_not_copied += align;
+        }
+        else
+        {
+            for (uint32_t count = 0; count < align; ++count)
+                added_no_error &= CDRMessage::addOctet(&submsgElem, 0);
+        }
 
         //Once the submessage elements are added, the submessage header is created, assigning the correct size.
-        added_no_error &= RTPSMessageCreator::addSubmessageHeader(msg, DATA_FRAG, flags, (uint16_t)submsgElem.length);
+        added_no_error &= RTPSMessageCreator::addSubmessageHeader(msg, DATA_FRAG, flags,
+                (uint16_t)(submsgElem.length + payload_not_copied));
 
         //Append Submessage elements to msg
         added_no_error &= CDRMessage::appendMsg(msg, &submsgElem);
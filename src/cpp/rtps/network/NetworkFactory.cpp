@@ -126,12 +126,16 @@ void NetworkFactory::NormalizeLocators(LocatorList_t& locators)
 LocatorList_t NetworkFactory::ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists)
 {
     LocatorList_t returnedList;
+    std::vector<LocatorList_t> preferredLocatorLists;
+
+    for(auto& locatorList : locatorLists)
+        preferredLocatorLists.push_back(PreferSharedMemoryLocators(locatorList));
 
     for(auto& transport : mRegisteredTransports)
     {
         std::vector<LocatorList_t> transportLocatorLists;
 
-        for(auto& locatorList : locatorLists)
+        for(auto& locatorList : preferredLocatorLists)
         {
             LocatorList_t resultList;
 
@@ -148,6 +152,57 @@ LocatorList_t NetworkFactory::ShrinkLocatorLists(const std::vector<LocatorList_t
     return returnedList;
 }
 
+LocatorList_t NetworkFactory::PreferSharedMemoryLocators(const LocatorList_t& locatorList)
+{
+    LocatorList_t sharedMemoryList;
+    LocatorList_t otherList;
+
+    for(auto it = locatorList.begin(); it != locatorList.end(); ++it)
+    {
+        if(it->kind == LOCATOR_KIND_SHM && is_local_locator(*it))
+            sharedMemoryList.push_back(*it);
+        else if(it->kind != LOCATOR_KIND_SHM)
+            otherList.push_back(*it);
+    }
+
+    // Remote endpoints on other hosts keep all their locators.
+    if(sharedMemoryList.empty())
+        return locatorList;
+
+    // The latest list describing a shared memory port replaces the previous one, which may be outdated.
+    std::lock_guard<std::mutex> guard(mFallbackLocatorsMutex);
+    for(auto it = sharedMemoryList.begin(); it != sharedMemoryList.end(); ++it)
+    {
+        if(otherList.empty())
+            mFallbackLocators.erase(*it);
+        else
+            mFallbackLocators[*it] = otherList;
+    }
+
+    return sharedMemoryList;
+}
+
+bool NetworkFactory::GetFallbackLocators(const Locator_t& locator, LocatorList_t& fallbackLocators) const
+{
+    std::lock_guard<std::mutex> guard(mFallbackLocatorsMutex);
+    auto it = mFallbackLocators.find(locator);
+    if(it == mFallbackLocators.end())
+        return false;
+
+    fallbackLocators.push_back(it->second);
+    return true;
+}
+
+void NetworkFactory::RemoveFallbackLocators(const LocatorList_t& locatorList)
+{
+    std::lock_guard<std::mutex> guard(mFallbackLocatorsMutex);
+    for(auto it = locatorList.begin(); it != locatorList.end(); ++it)
+    {
+        if(it->kind == LOCATOR_KIND_SHM)
+            mFallbackLocators.erase(*it);
+    }
+}
+
 bool NetworkFactory::is_local_locator(const Locator_t& locator) const
 {
     for(auto& transport : mRegisteredTransports)
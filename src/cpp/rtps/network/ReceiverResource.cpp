@@ -14,7 +14,9 @@
 
 #include <fastrtps/rtps/network/ReceiverResource.h>
 #include <fastrtps/rtps/messages/MessageReceiver.h>
+#include <algorithm>
 #include <cassert>
+#include <thread>
 #include <fastrtps/log/Log.h>
 
 #define IDSTRING "(ID:" << std::this_thread::get_id() <<") "<<
@@ -27,9 +29,13 @@ namespace rtps{
 
 ReceiverResource::ReceiverResource(TransportInterface& transport, const Locator_t& locator, uint32_t max_size)
         : mValid(false)
-        , receiver(nullptr)
-        , msg(0)
 {
+    uint32_t concurrency = std::max<uint32_t>(transport.max_concurrent_receptions(locator), 1);
+    for (uint32_t i = 0; i < concurrency; ++i)
+    {
+        mSlots.emplace_back(new ReceiverSlot());
+    }
+
     // Internal channel is opened and assigned to this resource.
     mValid = transport.OpenInputChannel(locator, this, max_size);
     if (!mValid)
@@ -47,11 +53,9 @@ ReceiverResource::ReceiverResource(ReceiverResource&& rValueResource)
 {
     Cleanup.swap(rValueResource.Cleanup);
     LocatorMapsToManagedChannel.swap(rValueResource.LocatorMapsToManagedChannel);
-    receiver = rValueResource.receiver;
-    rValueResource.receiver = nullptr;
     mValid = rValueResource.mValid;
     rValueResource.mValid = false;
-    msg = std::move(rValueResource.msg);
+    mSlots = std::move(rValueResource.mSlots);
 }
 
 bool ReceiverResource::SupportsLocator(const Locator_t& localLocator)
@@ -65,37 +69,78 @@ bool ReceiverResource::SupportsLocator(const Locator_t& localLocator)
 
 void ReceiverResource::RegisterReceiver(MessageReceiver* rcv)
 {
-    std::unique_lock<std::mutex> lock(mtx);
-    if (receiver == nullptr)
-        receiver = rcv;
+    for (auto& slot : mSlots)
+    {
+        std::unique_lock<std::mutex> lock(slot->mtx);
+        if (slot->receiver == nullptr)
+        {
+            slot->receiver = rcv;
+            return;
+        }
+    }
 }
 
 void ReceiverResource::UnregisterReceiver(MessageReceiver* rcv)
 {
-    std::unique_lock<std::mutex> lock(mtx);
-    if (receiver == rcv)
-        receiver = nullptr;
+    for (auto& slot : mSlots)
+    {
+        std::unique_lock<std::mutex> lock(slot->mtx);
+        if (slot->receiver == rcv)
+        {
+            slot->receiver = nullptr;
+        }
+    }
 }
 
 void ReceiverResource::OnDataReceived(const octet * data, const uint32_t size,
     const Locator_t & localLocator, const Locator_t & remoteLocator)
 {
     (void)localLocator;
+    Dispatch(data, size, remoteLocator, nullptr);
+}
+
+void ReceiverResource::OnDataReceived(ReceiveBuffer& buffer, const uint32_t size,
+    const Locator_t& localLocator, const Locator_t& remoteLocator)
+{
+    (void)localLocator;
+    Dispatch(buffer.data(), size, remoteLocator, &buffer);
+}
+
+void ReceiverResource::Dispatch(const octet* data, const uint32_t size, const Locator_t& remoteLocator,
+    ReceiveBuffer* buffer)
+{
+    // Any idle slot will do. They are all busy only when more threads than slots are receiving.
+    for (auto& slot : mSlots)
+    {
+        std::unique_lock<std::mutex> lock(slot->mtx, std::try_to_lock);
+        if (lock.owns_lock() && slot->receiver != nullptr)
+        {
+            ProcessData(*slot, data, size, remoteLocator, buffer);
+            return;
+        }
+    }
 
-    std::unique_lock<std::mutex> lock(mtx);
-    MessageReceiver* rcv = receiver;
+    size_t index = std::hash<std::thread::id>()(std::this_thread::get_id()) % mSlots.size();
+    ReceiverSlot& slot = *mSlots[index];
+    std::unique_lock<std::mutex> lock(slot.mtx);
+    ProcessData(slot, data, size, remoteLocator, buffer);
+}
+
+void ReceiverResource::ProcessData(ReceiverSlot& slot, const octet* data, const uint32_t size,
+    const Locator_t& remoteLocator, ReceiveBuffer* buffer)
+{
+    MessageReceiver* rcv = slot.receiver;
 
     if (rcv != nullptr)
     {
-        msg.wraps = true;
-        msg.buffer = const_cast<octet*>(data);
-        msg.length = size;
-        msg.max_size = size;
+        slot.msg.wraps = true;
+        slot.msg.buffer = const_cast<octet*>(data);
+        slot.msg.length = size;
+        slot.msg.max_size = size;
 
         // TODO: Should we unlock in case UnregisterReceiver is called from callback ?
-        rcv->processCDRMsg(remoteLocator, &msg);
+        rcv->processCDRMsg(remoteLocator, &slot.msg, buffer);
     }
-
 }
 
 ReceiverResource::~ReceiverResource()
@@ -57,6 +57,18 @@ SenderResource::SenderResource(TransportInterface& transport, Locator_t& locator
                 return transport.Send(data, dataSize, locator, destination, pChannelResource);
             }
         };
+    SendBuffersThroughAssociatedChannel =
+        [&transport, locator]
+        (const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes, const Locator_t& destination)-> bool
+        {
+            return transport.Send(buffers, totalBytes, locator, destination);
+        };
+    SendToLocatorsThroughAssociatedChannel =
+        [&transport, locator]
+        (const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes, const LocatorList_t& destinations)-> bool
+        {
+            return transport.SendToLocators(buffers, totalBytes, locator, destinations);
+        };
     LocatorMapsToManagedChannel = [&transport, locator](const Locator_t& locatorToCheck) -> bool
         {
             return transport.DoOutputLocatorsMatch(locator, locatorToCheck);
@@ -86,12 +98,34 @@ bool SenderResource::Send(const octet* data, uint32_t dataLength, const Locator_
     return false;
 }
 
+bool SenderResource::Send(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes,
+        const Locator_t& destinationLocator)
+{
+    if (SendBuffersThroughAssociatedChannel)
+    {
+        return SendBuffersThroughAssociatedChannel(buffers, totalBytes, destinationLocator);
+    }
+    return false;
+}
+
+bool SenderResource::Send(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes,
+        const LocatorList_t& destinationLocators)
+{
+    if (SendToLocatorsThroughAssociatedChannel)
+    {
+        return SendToLocatorsThroughAssociatedChannel(buffers, totalBytes, destinationLocators);
+    }
+    return false;
+}
+
 SenderResource::SenderResource(SenderResource&& rValueResource)
 {
     mValid = rValueResource.mValid;
     Cleanup.swap(rValueResource.Cleanup);
     AddSenderLocatorToManagedChannel.swap(rValueResource.AddSenderLocatorToManagedChannel);
     SendThroughAssociatedChannel.swap(rValueResource.SendThroughAssociatedChannel);
+    SendBuffersThroughAssociatedChannel.swap(rValueResource.SendBuffersThroughAssociatedChannel);
+    SendToLocatorsThroughAssociatedChannel.swap(rValueResource.SendToLocatorsThroughAssociatedChannel);
     LocatorMapsToManagedChannel.swap(rValueResource.LocatorMapsToManagedChannel);
     ManagedChannelMapsToRemote.swap(rValueResource.ManagedChannelMapsToRemote);
     //m_pChannelResource = rValueResource.m_pChannelResource;
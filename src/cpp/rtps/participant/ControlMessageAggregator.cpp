@@ -0,0 +1,173 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ControlMessageAggregator.cpp
+ *
+ */
+
+#include "ControlMessageAggregator.h"
+#include <rtps/participant/RTPSParticipantImpl.h>
+
+#include <fastrtps/rtps/resources/ResourceEvent.h>
+#include <fastrtps/rtps/writer/StatefulWriter.h>
+#include <fastrtps/rtps/writer/timedevent/PeriodicHeartbeat.h>
+#include <fastrtps/rtps/reader/StatefulReader.h>
+#include <fastrtps/rtps/reader/WriterProxy.h>
+#include <fastrtps/rtps/reader/timedevent/HeartbeatResponseDelay.h>
+
+#include <fastrtps/log/Log.h>
+
+#include <algorithm>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+ControlMessageAggregator::ControlMessageAggregator(RTPSParticipantImpl* participant, double window)
+    : TimedEvent(participant->getEventResource().getIOService(), participant->getEventResource().getThread(),
+            window)
+    , participant_(participant)
+    , scheduled_(false)
+    , messages_(participant->getMaxMessageSize(), participant->getGuid().guidPrefix)
+{
+}
+
+ControlMessageAggregator::~ControlMessageAggregator()
+{
+    destroy();
+}
+
+void ControlMessageAggregator::add_heartbeat(PeriodicHeartbeat* heartbeat)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    if(std::find(heartbeats_.begin(), heartbeats_.end(), heartbeat) == heartbeats_.end())
+    {
+        heartbeats_.push_back(heartbeat);
+        schedule_nts();
+    }
+}
+
+void ControlMessageAggregator::add_heartbeat_response(HeartbeatResponseDelay* response)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    if(std::find(responses_.begin(), responses_.end(), response) == responses_.end())
+    {
+        responses_.push_back(response);
+        schedule_nts();
+    }
+}
+
+void ControlMessageAggregator::remove_heartbeat(PeriodicHeartbeat* heartbeat)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    heartbeats_.erase(std::remove(heartbeats_.begin(), heartbeats_.end(), heartbeat), heartbeats_.end());
+}
+
+void ControlMessageAggregator::remove_heartbeat_response(HeartbeatResponseDelay* response)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    responses_.erase(std::remove(responses_.begin(), responses_.end(), response), responses_.end());
+}
+
+void ControlMessageAggregator::schedule_nts()
+{
+    if(!scheduled_)
+    {
+        scheduled_ = true;
+        restart_timer();
+    }
+}
+
+ControlMessageAggregator::Destination& ControlMessageAggregator::destination(std::vector<Destination>& destinations,
+        const LocatorList_t& locators)
+{
+    auto it = std::find_if(destinations.begin(), destinations.end(), [&locators](const Destination& destination)
+    {
+        return destination.locators == locators;
+    });
+
+    if(it != destinations.end())
+    {
+        return *it;
+    }
+
+    destinations.emplace_back();
+    destinations.back().locators = locators;
+    return destinations.back();
+}
+
+void ControlMessageAggregator::event(EventCode code, const char* msg)
+{
+    // Unused in release mode.
+    (void)msg;
+
+    if(code == EVENT_SUCCESS)
+    {
+        // Held while sending, so the events cannot be destroyed in the meantime.
+        std::lock_guard<std::mutex> guard(mutex_);
+        scheduled_ = false;
+
+        // Events sending to the same locators are added one after the other, so the group does not flush
+        // between them.
+        std::vector<Destination> destinations;
+        for(PeriodicHeartbeat* heartbeat : heartbeats_)
+        {
+            destination(destinations, heartbeat->destination_locators()).heartbeats.push_back(heartbeat);
+        }
+        for(HeartbeatResponseDelay* response : responses_)
+        {
+            destination(destinations, response->m_destination_locators).responses.push_back(response);
+        }
+        heartbeats_.clear();
+        responses_.clear();
+
+        if(destinations.empty())
+        {
+            return;
+        }
+
+        const Destination& first = destinations.front();
+        Endpoint* endpoint = first.heartbeats.empty() ?
+            static_cast<Endpoint*>(first.responses.front()->mp_WP->mp_SFR) :
+            static_cast<Endpoint*>(first.heartbeats.front()->mp_SFW);
+        RTPSMessageGroup group(participant_, endpoint, RTPSMessageGroup::WRITER, messages_);
+
+        for(Destination& destination : destinations)
+        {
+            for(PeriodicHeartbeat* heartbeat : destination.heartbeats)
+            {
+                heartbeat->add_messages(group);
+            }
+            for(HeartbeatResponseDelay* response : destination.responses)
+            {
+                response->add_messages(group);
+            }
+        }
+    }
+    else if(code == EVENT_ABORT)
+    {
+        logInfo(RTPS_PARTICIPANT, "ControlMessageAggregator aborted");
+    }
+    else
+    {
+        logInfo(RTPS_PARTICIPANT, "ControlMessageAggregator event message: " << msg);
+    }
+}
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
@@ -0,0 +1,125 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ControlMessageAggregator.h
+ *
+ */
+
+#ifndef CONTROLMESSAGEAGGREGATOR_H_
+#define CONTROLMESSAGEAGGREGATOR_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <fastrtps/rtps/resources/TimedEvent.h>
+#include <fastrtps/rtps/messages/RTPSMessageGroup.h>
+
+#include <mutex>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+class RTPSParticipantImpl;
+class PeriodicHeartbeat;
+class HeartbeatResponseDelay;
+
+/**
+ * Sends the periodic heartbeats and the heartbeat responses of the endpoints of a participant.
+ * Events becoming due within a short window are sent together, and those sending to the same locators share
+ * their datagrams instead of sending one each.
+ * @ingroup RTPS_MODULE
+ */
+class ControlMessageAggregator : public TimedEvent
+{
+    public:
+
+        /**
+         * @param participant Participant whose endpoints are aggregated.
+         * @param window Milliseconds an event waits for others before being sent.
+         */
+        ControlMessageAggregator(RTPSParticipantImpl* participant, double window);
+
+        virtual ~ControlMessageAggregator();
+
+        /**
+         * Schedules the heartbeat of a writer for the next aggregated send.
+         * @param heartbeat Event of the writer.
+         */
+        void add_heartbeat(PeriodicHeartbeat* heartbeat);
+
+        /**
+         * Schedules the response to the heartbeats of a remote writer for the next aggregated send.
+         * @param response Event of the writer proxy.
+         */
+        void add_heartbeat_response(HeartbeatResponseDelay* response);
+
+        /**
+         * Forgets a heartbeat event being destroyed, waiting for the send using it to finish.
+         * @param heartbeat Event of the writer.
+         */
+        void remove_heartbeat(PeriodicHeartbeat* heartbeat);
+
+        /**
+         * Forgets a heartbeat response event being destroyed, waiting for the send using it to finish.
+         * @param response Event of the writer proxy.
+         */
+        void remove_heartbeat_response(HeartbeatResponseDelay* response);
+
+        /**
+         * Method invoked when the event occurs
+         *
+         * @param code Code representing the status of the event
+         * @param msg Message associated to the event
+         */
+        void event(EventCode code, const char* msg = nullptr);
+
+    private:
+
+        //! Events sending to the same locators.
+        struct Destination
+        {
+            LocatorList_t locators;
+
+            std::vector<PeriodicHeartbeat*> heartbeats;
+
+            std::vector<HeartbeatResponseDelay*> responses;
+        };
+
+        //! Arms the window if it is not running. Called with mutex_ held.
+        void schedule_nts();
+
+        //! Destination for some locators, added when there is none.
+        static Destination& destination(std::vector<Destination>& destinations, const LocatorList_t& locators);
+
+        RTPSParticipantImpl* participant_;
+
+        //! Protects the pending events and the sending, so events are not destroyed while being sent.
+        std::mutex mutex_;
+
+        std::vector<PeriodicHeartbeat*> heartbeats_;
+
+        std::vector<HeartbeatResponseDelay*> responses_;
+
+        bool scheduled_;
+
+        RTPSMessageGroup_t messages_;
+};
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
+
+#endif
+#endif /* CONTROLMESSAGEAGGREGATOR_H_ */
@@ -18,6 +18,7 @@
  */
 
 #include "RTPSParticipantImpl.h"
+#include "ControlMessageAggregator.h"
 
 #include "../flowcontrol/ThroughputController.h"
 #include "../persistence/PersistenceService.h"
@@ -61,6 +62,12 @@ namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
+/**
+ * Heartbeats and heartbeat responses becoming due within this time are sent together, sharing datagrams
+ * when they go to the same locators.
+ */
+static const double c_ControlMessageWindowMilliSec = 1.0;
+
 static EntityId_t TrustedWriter(const EntityId_t& reader)
 {
     return
@@ -84,6 +91,7 @@ RTPSParticipantImpl::RTPSParticipantImpl(const RTPSParticipantAttributes& PParam
     : m_att(PParam)
     , m_guid(guidP ,c_EntityId_RTPSParticipant)
     , mp_event_thr(nullptr)
+    , mp_controlAggregator(nullptr)
     , mp_builtinProtocols(nullptr)
     , mp_ResourceSemaphore(new Semaphore(0))
     , IdCounter(0)
@@ -112,6 +120,7 @@ RTPSParticipantImpl::RTPSParticipantImpl(const RTPSParticipantAttributes& PParam
     mp_userParticipant->mp_impl = this;
     mp_event_thr = new ResourceEvent();
     mp_event_thr->init_thread(this);
+    mp_controlAggregator = new ControlMessageAggregator(this, c_ControlMessageWindowMilliSec);
 
     // Throughput controller, if the descriptor has valid values
     if (PParam.throughputController.bytesPerPeriod != UINT32_MAX && PParam.throughputController.periodMillisecs != 0)
@@ -245,7 +254,10 @@ RTPSParticipantImpl::~RTPSParticipantImpl()
     // Safely abort threads.
     for(auto& block : m_receiverResourcelist)
     {
-        block.Receiver->UnregisterReceiver(block.mp_receiver);
+        for (MessageReceiver* receiver : block.mp_receivers)
+        {
+            block.Receiver->UnregisterReceiver(receiver);
+        }
     }
 
     while(m_userReaderList.size() > 0)
@@ -267,7 +279,10 @@ RTPSParticipantImpl::~RTPSParticipantImpl()
     // Destruct message receivers
     for (auto& block : m_receiverResourcelist)
     {
-        delete block.mp_receiver;
+        for (MessageReceiver* receiver : block.mp_receivers)
+        {
+            delete receiver;
+        }
     }
     m_receiverResourcelist.clear();
 
@@ -275,6 +290,7 @@ RTPSParticipantImpl::~RTPSParticipantImpl()
     delete(this->mp_userParticipant);
     m_senderResourceList.clear();
 
+    delete(this->mp_controlAggregator);
     delete(this->mp_event_thr);
     delete(this->mp_mutex);
 }
@@ -576,6 +592,12 @@ bool RTPSParticipantImpl::createReader(RTPSReader** ReaderOut, ReaderAttributes&
         }
     }
 
+    // Registered before being announced, so local writers can reach it as soon as they match it.
+    if (!isBuiltin && m_att.intraprocess_delivery)
+    {
+        RTPSDomain::register_local_reader(SReader);
+    }
+
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
     m_allReaderList.push_back(SReader);
     if (!isBuiltin)
@@ -598,12 +620,38 @@ bool RTPSParticipantImpl::enableReader(RTPSReader *reader)
 // Avoid to receive PDPSimple reader a DATA while calling ~PDPSimple and EDP was destroy already.
 void RTPSParticipantImpl::disableReader(RTPSReader *reader)
 {
-    m_receiverResourcelistMutex.lock();
+    // Removing waits for messages being processed, which may match readers and so need the receivers list.
+    for (MessageReceiver* receiver : message_receivers())
+    {
+        receiver->removeEndpoint(reader);
+    }
+}
+
+void RTPSParticipantImpl::reader_matched_writer(RTPSReader* reader, const GUID_t& writer_guid, bool any_writer)
+{
+    for (MessageReceiver* receiver : message_receivers())
+    {
+        receiver->readerMatchedWriter(reader, writer_guid, any_writer);
+    }
+}
+
+void RTPSParticipantImpl::reader_unmatched_writer(RTPSReader* reader, const GUID_t& writer_guid, bool any_writer)
+{
+    for (MessageReceiver* receiver : message_receivers())
+    {
+        receiver->readerUnmatchedWriter(reader, writer_guid, any_writer);
+    }
+}
+
+std::vector<MessageReceiver*> RTPSParticipantImpl::message_receivers()
+{
+    std::vector<MessageReceiver*> receivers;
+    std::lock_guard<std::mutex> guard(m_receiverResourcelistMutex);
     for (auto it = m_receiverResourcelist.begin(); it != m_receiverResourcelist.end(); ++it)
     {
-        it->mp_receiver->removeEndpoint(reader);
+        receivers.insert(receivers.end(), it->mp_receivers.begin(), it->mp_receivers.end());
     }
-    m_receiverResourcelistMutex.unlock();
+    return receivers;
 }
 
 bool RTPSParticipantImpl::registerWriter(RTPSWriter* Writer, const TopicAttributes& topicAtt, const WriterQos& wqos)
@@ -731,7 +779,10 @@ bool RTPSParticipantImpl::assignEndpoint2LocatorList(Endpoint* endp, LocatorList
             if (it->Receiver->SupportsLocator(*lit))
             {
                 //Supported! Take mutex and update lists - We maintain reader/writer discrimination just in case
-                it->mp_receiver->associateEndpoint(endp);
+                for (MessageReceiver* receiver : it->mp_receivers)
+                {
+                    receiver->associateEndpoint(endp);
+                }
                 // end association between reader/writer and the receive resources
             }
 
@@ -797,11 +848,15 @@ void RTPSParticipantImpl::createReceiverResources(LocatorList_t& Locator_list, b
             std::lock_guard<std::mutex> lock(m_receiverResourcelistMutex);
             //Push the new items into the ReceiverResource buffer
             m_receiverResourcelist.push_back(ReceiverControlBlock(std::move(*it_buffer)));
-            //Create and init the MessageReceiver
-            auto mr = new MessageReceiver(this, size);
-            m_receiverResourcelist.back().mp_receiver = mr;
-            //Start reception
-            m_receiverResourcelist.back().Receiver->RegisterReceiver(mr);
+            //Create and init the MessageReceivers, one for each thread that may receive concurrently
+            ReceiverControlBlock& block = m_receiverResourcelist.back();
+            for (uint32_t i = 0; i < block.Receiver->max_concurrent_receptions(); ++i)
+            {
+                auto mr = new MessageReceiver(this, size);
+                block.mp_receivers.push_back(mr);
+                //Start reception
+                block.Receiver->RegisterReceiver(mr);
+            }
         }
         newItemsBuffer.clear();
     }
@@ -852,12 +907,16 @@ void RTPSParticipantImpl::createSenderResources(LocatorList_t& Locator_list, boo
 
 bool RTPSParticipantImpl::deleteUserEndpoint(Endpoint* p_endpoint)
 {
-    m_receiverResourcelistMutex.lock();
-    for (auto it = m_receiverResourcelist.begin(); it != m_receiverResourcelist.end(); ++it)
+    if (p_endpoint->getAttributes().endpointKind == READER)
     {
-        it->mp_receiver->removeEndpoint(p_endpoint);
+        // Waits for local writers that could be delivering to this reader.
+        RTPSDomain::unregister_local_reader(p_endpoint->getGuid());
+    }
+
+    for (MessageReceiver* receiver : message_receivers())
+    {
+        receiver->removeEndpoint(p_endpoint);
     }
-    m_receiverResourcelistMutex.unlock();
 
     bool found = false, found_in_users = false;
     {
@@ -952,6 +1011,11 @@ ResourceEvent& RTPSParticipantImpl::getEventResource()
     return *this->mp_event_thr;
 }
 
+ControlMessageAggregator& RTPSParticipantImpl::control_message_aggregator()
+{
+    return *this->mp_controlAggregator;
+}
+
 std::vector<std::string> RTPSParticipantImpl::getParticipantNames() const
 {
     std::vector<std::string> participant_names;
@@ -982,6 +1046,74 @@ void RTPSParticipantImpl::sendSync(CDRMessage_t* msg, Endpoint* /*pend*/, const
     }
 }
 
+bool RTPSParticipantImpl::send_through_resources_nts(const std::vector<NetworkBuffer>& buffers, uint32_t total_bytes,
+        const Locator_t& destination_loc)
+{
+    bool sent = false;
+    for (auto& resource : m_senderResourceList)
+    {
+        if (resource.SupportsLocator(destination_loc))
+        {
+            sent |= buffers.size() == 1 ?
+                resource.Send(buffers.front().buffer, total_bytes, destination_loc) :
+                resource.Send(buffers, total_bytes, destination_loc);
+        }
+    }
+    return sent;
+}
+
+void RTPSParticipantImpl::sendSync(const std::vector<NetworkBuffer>& buffers, uint32_t total_bytes, Endpoint* /*pend*/,
+        const LocatorList_t& destination_locators)
+{
+    std::lock_guard<std::mutex> guard(m_send_resources_mutex);
+
+    // Shared memory destinations are sent one by one, so the ones failing are sent through the other transports.
+    m_send_fallback_locators.clear();
+    for (const Locator_t& destination_loc : destination_locators)
+    {
+        if (destination_loc.kind == LOCATOR_KIND_SHM &&
+                !send_through_resources_nts(buffers, total_bytes, destination_loc))
+        {
+            m_network_Factory.GetFallbackLocators(destination_loc, m_send_fallback_locators);
+        }
+    }
+
+    for (auto& resource : m_senderResourceList)
+    {
+        m_send_locators.clear();
+        for (const Locator_t& destination_loc : destination_locators)
+        {
+            if (destination_loc.kind != LOCATOR_KIND_SHM && resource.SupportsLocator(destination_loc))
+            {
+                m_send_locators.push_back(destination_loc);
+            }
+        }
+        for (const Locator_t& destination_loc : m_send_fallback_locators)
+        {
+            if (resource.SupportsLocator(destination_loc))
+            {
+                m_send_locators.push_back(destination_loc);
+            }
+        }
+
+        if (m_send_locators.size() == 1)
+        {
+            if (buffers.size() == 1)
+            {
+                resource.Send(buffers.front().buffer, total_bytes, *m_send_locators.begin());
+            }
+            else
+            {
+                resource.Send(buffers, total_bytes, *m_send_locators.begin());
+            }
+        }
+        else if (m_send_locators.size() > 1)
+        {
+            resource.Send(buffers, total_bytes, m_send_locators);
+        }
+    }
+}
+
 void RTPSParticipantImpl::setGuid(GUID_t& guid)
 {
     m_guid = guid;
@@ -62,6 +62,7 @@ namespace rtps
 class RTPSParticipant;
 class RTPSParticipantListener;
 class ResourceEvent;
+class ControlMessageAggregator;
 class AsyncWriterThread;
 class BuiltinProtocols;
 struct CDRMessage_t;
@@ -90,18 +91,18 @@ class RTPSParticipantImpl
     Receiver Control block is a struct we use to encapsulate the resources that take part in message reception.
     It contains:
     -A ReceiverResource (as produced by the NetworkFactory Element)
-    -Its associated MessageReceiver
+    -Its associated MessageReceivers, one per thread the transport may receive from concurrently
     */
     typedef struct ReceiverControlBlock
     {
         std::shared_ptr<ReceiverResource> Receiver;
-        MessageReceiver* mp_receiver; //Associated Readers/Writers inside of MessageReceiver
-        ReceiverControlBlock(std::shared_ptr<ReceiverResource>&& rec) :Receiver(std::move(rec)), mp_receiver(nullptr)
+        std::vector<MessageReceiver*> mp_receivers; //Associated Readers/Writers inside of MessageReceiver
+        ReceiverControlBlock(std::shared_ptr<ReceiverResource>&& rec) :Receiver(std::move(rec))
         {
         }
-        ReceiverControlBlock(ReceiverControlBlock&& origen) :Receiver(std::move(origen.Receiver)), mp_receiver(origen.mp_receiver)
+        ReceiverControlBlock(ReceiverControlBlock&& origen) :Receiver(std::move(origen.Receiver)),
+            mp_receivers(std::move(origen.mp_receivers))
         {
-            origen.mp_receiver = nullptr;
         }
 
     private:
@@ -170,9 +171,21 @@ public:
     //!Get Pointer to the Event Resource.
     ResourceEvent& getEventResource();
 
+    //!Get the aggregator sending the heartbeats and heartbeat responses of the endpoints.
+    ControlMessageAggregator& control_message_aggregator();
+
     //!Send Method - Deprecated - Stays here for reference purposes
     void sendSync(CDRMessage_t* msg, Endpoint *pend, const Locator_t& destination_loc);
 
+    /**
+     * Sends a message made of several buffers to several destinations, letting each sender resource
+     * send to all the destinations it supports at once.
+     * @param buffers Slices of the message, in order. They are not copied unless a transport needs it.
+     * @param total_bytes Sum of the sizes of all the buffers.
+     */
+    void sendSync(const std::vector<NetworkBuffer>& buffers, uint32_t total_bytes, Endpoint *pend,
+            const LocatorList_t& destination_locators);
+
     //!Get the participant Mutex
     std::recursive_mutex* getParticipantMutex() const { return mp_mutex; };
 
@@ -235,6 +248,22 @@ public:
 
     uint32_t get_min_network_send_buffer_size() { return m_network_Factory.get_min_send_buffer_size(); }
 
+    /**
+     * Called by readers after matching a writer, so message receivers index it.
+     * @param reader Reader that matched the writer.
+     * @param writer_guid GUID of the matched writer.
+     * @param any_writer Whether the reader still takes messages from writers it is not matched with.
+     */
+    void reader_matched_writer(RTPSReader* reader, const GUID_t& writer_guid, bool any_writer);
+
+    /**
+     * Called by readers after unmatching a writer, so message receivers drop it from their index.
+     * @param reader Reader that unmatched the writer.
+     * @param writer_guid GUID of the unmatched writer.
+     * @param any_writer Whether the reader still takes messages from writers it is not matched with.
+     */
+    void reader_unmatched_writer(RTPSReader* reader, const GUID_t& writer_guid, bool any_writer);
+
 private:
     //!Attributes of the RTPSParticipant
     RTPSParticipantAttributes m_att;
@@ -244,6 +273,8 @@ private:
     // ResourceSend* mp_send_thr;
     //! Event Resource
     ResourceEvent* mp_event_thr;
+    //! Aggregates the periodic heartbeats and heartbeat responses of the endpoints.
+    ControlMessageAggregator* mp_controlAggregator;
     //! BuiltinProtocols of this RTPSParticipant
     BuiltinProtocols* mp_builtinProtocols;
     //!Semaphore to wait for the listen thread creation.
@@ -279,6 +310,10 @@ private:
     //!SenderResource List
     std::mutex m_send_resources_mutex;
     std::vector<SenderResource> m_senderResourceList;
+    //! Destinations handled by a sender resource. Protected by m_send_resources_mutex.
+    LocatorList_t m_send_locators;
+    //! Destinations replacing the shared memory ones that failed. Protected by m_send_resources_mutex.
+    LocatorList_t m_send_fallback_locators;
 
     //!Participant Listener
     RTPSParticipantListener* mp_participantListener;
@@ -295,6 +330,14 @@ private:
         */
     bool existsEntityId(const EntityId_t& ent, EndpointKind_t kind) const;
 
+    /**
+        * Sends a message to a destination through every sender resource supporting it.
+        * Called with m_send_resources_mutex held.
+        * @return True if some resource could send it.
+        */
+    bool send_through_resources_nts(const std::vector<NetworkBuffer>& buffers, uint32_t total_bytes,
+        const Locator_t& destination_loc);
+
     /**
         * Assign an endpoint to the ReceiverResources, based on its LocatorLists.
         * @param endp Pointer to the endpoint.
@@ -311,6 +354,12 @@ private:
         */
     bool assignEndpoint2LocatorList(Endpoint* pend, LocatorList_t& list);
 
+    /**
+     * Gets the message receivers of all receiver resources. They live as long as the participant, so they can be
+     * used once m_receiverResourcelistMutex is released.
+     */
+    std::vector<MessageReceiver*> message_receivers();
+
     /** Create the new ReceiverResources needed for a new Locator, contains the calls to assignEndpointListenResources
         and consequently assignEndpoint2LocatorList
         @param pend - Pointer to the endpoint which triggered the creation of the Receivers
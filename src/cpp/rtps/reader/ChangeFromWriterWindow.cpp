@@ -0,0 +1,294 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ChangeFromWriterWindow.cpp
+ *
+ */
+
+#include <fastrtps/rtps/reader/ChangeFromWriterWindow.h>
+#include <fastrtps/utils/BitmapWord.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/*!
+ * Calls a function for every word of a bitmap covering the slots [first, last), with the mask of those slots
+ * in the word.
+ */
+template<typename Function>
+static void for_each_word(size_t first, size_t last, Function function)
+{
+    if(first >= last)
+    {
+        return;
+    }
+
+    const size_t bits = 64;
+    size_t first_word = first / bits;
+    size_t last_word = (last - 1) / bits;
+    for(size_t word = first_word; word <= last_word; ++word)
+    {
+        uint32_t first_bit = word == first_word ? static_cast<uint32_t>(first % bits) : 0;
+        uint32_t last_bit = word == last_word ? static_cast<uint32_t>(last - word * bits) : 64;
+        function(word, bitmap_word_range(first_bit, last_bit));
+    }
+}
+
+ChangeFromWriterWindow::ChangeFromWriterWindow()
+    : m_first(0)
+    , m_end(0)
+{
+}
+
+ChangeFromWriterStatus_t ChangeFromWriterWindow::status(const SequenceNumber_t& sequence_number) const
+{
+    assert(contains(sequence_number));
+    size_t position = slot(sequence_number);
+    for(size_t status = 0; status < c_statuses; ++status)
+    {
+        if((m_status[status][position / c_bits] >> (position % c_bits)) & 1u)
+        {
+            return static_cast<ChangeFromWriterStatus_t>(status);
+        }
+    }
+    return UNKNOWN;
+}
+
+bool ChangeFromWriterWindow::is_relevant(const SequenceNumber_t& sequence_number) const
+{
+    assert(contains(sequence_number));
+    size_t position = slot(sequence_number);
+    return ((m_irrelevant[position / c_bits] >> (position % c_bits)) & 1u) == 0;
+}
+
+void ChangeFromWriterWindow::reset(const SequenceNumber_t& low_mark)
+{
+    // Vectors keep their capacity, so a window that empties often does not allocate again.
+    for(size_t status = 0; status < c_statuses; ++status)
+    {
+        m_status[status].clear();
+    }
+    m_irrelevant.clear();
+    m_low_mark = low_mark;
+    m_first = 0;
+    m_end = 0;
+}
+
+void ChangeFromWriterWindow::extend_to(const SequenceNumber_t& sequence_number, ChangeFromWriterStatus_t status)
+{
+    SequenceNumber_t last = last_sequence_number();
+    if(!(sequence_number > last))
+    {
+        return;
+    }
+
+    compact();
+
+    size_t end = m_end + static_cast<size_t>((sequence_number - last).to64long());
+    size_t words = (end + c_bits - 1) / c_bits;
+    if(m_irrelevant.size() < words)
+    {
+        for(size_t index = 0; index < c_statuses; ++index)
+        {
+            m_status[index].resize(words, 0);
+        }
+        m_irrelevant.resize(words, 0);
+    }
+
+    std::vector<uint64_t>& bitmap = m_status[status];
+    for_each_word(m_end, end, [&bitmap](size_t word, uint64_t mask)
+    {
+        bitmap[word] |= mask;
+    });
+    m_end = end;
+}
+
+void ChangeFromWriterWindow::set(const SequenceNumber_t& sequence_number, ChangeFromWriterStatus_t status,
+        bool relevant)
+{
+    assert(contains(sequence_number));
+    size_t position = slot(sequence_number);
+    size_t word = position / c_bits;
+    uint64_t bit = uint64_t(1) << (position % c_bits);
+
+    for(size_t index = 0; index < c_statuses; ++index)
+    {
+        m_status[index][word] &= ~bit;
+    }
+    m_status[status][word] |= bit;
+
+    if(relevant)
+    {
+        m_irrelevant[word] &= ~bit;
+    }
+    else
+    {
+        m_irrelevant[word] |= bit;
+    }
+}
+
+size_t ChangeFromWriterWindow::convert_up_to(const SequenceNumber_t& sequence_number,
+        ChangeFromWriterStatus_t previous, ChangeFromWriterStatus_t next)
+{
+    if(empty() || !(sequence_number > m_low_mark) || previous == next)
+    {
+        return 0;
+    }
+
+    size_t end = contains(sequence_number) ? slot(sequence_number) + 1 : m_end;
+    std::vector<uint64_t>& from = m_status[previous];
+    std::vector<uint64_t>& to = m_status[next];
+    size_t converted = 0;
+    for_each_word(m_first, end, [&](size_t word, uint64_t mask)
+    {
+        uint64_t bits = from[word] & mask;
+        from[word] &= ~bits;
+        to[word] |= bits;
+        converted += bitmap_word_count(bits);
+    });
+    return converted;
+}
+
+void ChangeFromWriterWindow::clear_slots(size_t first, size_t last)
+{
+    for_each_word(first, last, [this](size_t word, uint64_t mask)
+    {
+        for(size_t status = 0; status < c_statuses; ++status)
+        {
+            m_status[status][word] &= ~mask;
+        }
+        m_irrelevant[word] &= ~mask;
+    });
+}
+
+void ChangeFromWriterWindow::remove_until(const SequenceNumber_t& sequence_number)
+{
+    if(!(sequence_number > m_low_mark + 1))
+    {
+        return;
+    }
+
+    SequenceNumber_t low_mark = sequence_number - 1;
+    if(!(low_mark < last_sequence_number()))
+    {
+        reset(low_mark);
+        return;
+    }
+
+    size_t first = slot(sequence_number);
+    clear_slots(m_first, first);
+    m_first = first;
+    m_low_mark = low_mark;
+}
+
+void ChangeFromWriterWindow::remove_completed_front()
+{
+    // Looks for the first slot that is neither RECEIVED nor LOST.
+    size_t first = m_end;
+    for(size_t word = m_first / c_bits; word * c_bits < m_end; ++word)
+    {
+        uint32_t first_bit = word == m_first / c_bits ? static_cast<uint32_t>(m_first % c_bits) : 0;
+        uint32_t last_bit = static_cast<uint32_t>(std::min(m_end - word * c_bits, size_t(c_bits)));
+        uint64_t pending = ~(m_status[RECEIVED][word] | m_status[LOST][word]) &
+            bitmap_word_range(first_bit, last_bit);
+        if(pending != 0)
+        {
+            first = word * c_bits + bitmap_word_lowest(pending);
+            break;
+        }
+    }
+
+    if(first == m_first)
+    {
+        return;
+    }
+
+    SequenceNumber_t low_mark = m_low_mark + static_cast<uint32_t>(first - m_first);
+    if(first == m_end)
+    {
+        reset(low_mark);
+        return;
+    }
+
+    clear_slots(m_first, first);
+    m_first = first;
+    m_low_mark = low_mark;
+}
+
+size_t ChangeFromWriterWindow::count_pending_before(const SequenceNumber_t& sequence_number) const
+{
+    if(empty() || !(sequence_number > m_low_mark))
+    {
+        return 0;
+    }
+
+    size_t end = contains(sequence_number) ? slot(sequence_number) : m_end;
+    size_t pending = 0;
+    for_each_word(m_first, end, [&](size_t word, uint64_t mask)
+    {
+        pending += bitmap_word_count((m_status[UNKNOWN][word] | m_status[MISSING][word]) & mask);
+    });
+    return pending;
+}
+
+bool ChangeFromWriterWindow::has_changes(ChangeFromWriterStatus_t status) const
+{
+    // Slots outside the window have no bits set.
+    const std::vector<uint64_t>& bitmap = m_status[status];
+    return std::any_of(bitmap.begin() + m_first / c_bits, bitmap.end(), [](uint64_t bits) { return bits != 0; });
+}
+
+bool ChangeFromWriterWindow::get_sequence_numbers(ChangeFromWriterStatus_t status, SequenceNumberSet_t& set) const
+{
+    const std::vector<uint64_t>& bitmap = m_status[status];
+    for(size_t word = m_first / c_bits; word < bitmap.size(); ++word)
+    {
+        for(uint64_t bits = bitmap[word]; bits != 0; bits &= bits - 1)
+        {
+            size_t position = word * c_bits + bitmap_word_lowest(bits);
+            if(!set.add(m_low_mark + static_cast<uint32_t>(position - m_first + 1)))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void ChangeFromWriterWindow::compact()
+{
+    // Only whole words are reclaimed, so the bitmaps do not have to be shifted bit by bit.
+    size_t words = m_first / c_bits;
+    if(words == 0 || m_first < m_end / 2)
+    {
+        return;
+    }
+
+    for(size_t status = 0; status < c_statuses; ++status)
+    {
+        m_status[status].erase(m_status[status].begin(), m_status[status].begin() + words);
+    }
+    m_irrelevant.erase(m_irrelevant.begin(), m_irrelevant.begin() + words);
+    m_first -= words * c_bits;
+    m_end -= words * c_bits;
+}
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
@@ -64,7 +64,7 @@ StatefulReader::StatefulReader(RTPSParticipantImpl* pimpl,GUID_t& guid,
 
 bool StatefulReader::matched_writer_add(RemoteWriterAttributes& wdata)
 {
-    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    std::unique_lock<std::recursive_mutex> lock(*mp_mutex);
     for(std::vector<WriterProxy*>::iterator it=matched_writers.begin();
             it!=matched_writers.end();++it)
     {
@@ -88,6 +88,9 @@ bool StatefulReader::matched_writer_add(RemoteWriterAttributes& wdata)
     wp->loaded_from_storage_nts(get_last_notified(wdata.guid));
     matched_writers.push_back(wp);
     logInfo(RTPS_READER,"Writer Proxy " <<wp->m_att.guid <<" added to " <<m_guid.entityId);
+    lock.unlock();
+
+    mp_RTPSParticipant->reader_matched_writer(this, wdata.guid, false);
     return true;
 }
 
@@ -113,6 +116,11 @@ bool StatefulReader::matched_writer_remove(const RemoteWriterAttributes& wdata)
 
     lock.unlock();
 
+    if(wproxy != nullptr)
+    {
+        mp_RTPSParticipant->reader_unmatched_writer(this, wdata.guid, false);
+    }
+
     if(wproxy != nullptr)
     {
         delete wproxy;
@@ -145,6 +153,11 @@ bool StatefulReader::matched_writer_remove(const RemoteWriterAttributes& wdata,
 
     lock.unlock();
 
+    if(wproxy != nullptr)
+    {
+        mp_RTPSParticipant->reader_unmatched_writer(this, wdata.guid, false);
+    }
+
     if(wproxy != nullptr && deleteWP)
     {
         delete(wproxy);
@@ -168,6 +181,16 @@ bool StatefulReader::matched_writer_is_matched(const RemoteWriterAttributes& wda
     return false;
 }
 
+bool StatefulReader::matched_writer_guids(std::vector<GUID_t>& guids)
+{
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    for(WriterProxy* wp : matched_writers)
+    {
+        guids.push_back(wp->m_att.guid);
+    }
+    return true;
+}
+
 
 bool StatefulReader::matched_writer_lookup(const GUID_t& writerGUID, WriterProxy** WP)
 {
@@ -238,7 +261,7 @@ bool StatefulReader::processDataMsg(CacheChange_t *change)
                 else
                 {
 #endif
-                    if (!change_to_add->copy(change))
+                    if (!change_to_add->copy_or_loan(change))
                     {
                         logWarning(RTPS_MSG_IN,IDSTRING"Problem copying CacheChange, received data is: " << change->serializedPayload.length
                                 << " bytes and max size in reader " << getGuid().entityId << " is " << change_to_add->serializedPayload.max_size);
@@ -271,11 +294,15 @@ bool StatefulReader::processDataMsg(CacheChange_t *change)
                 {
                     mp_RTPSParticipant->assertRemoteRTPSParticipantLiveliness(change->writerGUID.guidPrefix);
                 }
+
+                return false;
             }
         }
+
+        return true;
     }
 
-    return true;
+    return false;
 }
 
 bool StatefulReader::processDataFragMsg(CacheChange_t *incomingChange, uint32_t sampleSize, uint32_t fragmentStartingNum)
@@ -390,9 +417,11 @@ bool StatefulReader::processHeartbeatMsg(GUID_t &writerGUID, uint32_t hbCount, S
             // Maybe now we have to notify user from new CacheChanges.
             NotifyChanges(pWP);
         }
+
+        return true;
     }
 
-    return true;
+    return false;
 }
 
 bool StatefulReader::processGapMsg(GUID_t &writerGUID, SequenceNumber_t &gapStart, SequenceNumberSet_t &gapList)
@@ -417,9 +446,11 @@ bool StatefulReader::processGapMsg(GUID_t &writerGUID, SequenceNumber_t &gapStar
             if(pWP->irrelevant_change_set((*it)))
                 fragmentedChangePitStop_->try_to_remove((*it), pWP->m_att.guid);
         }
+
+        return true;
     }
 
-    return true;
+    return false;
 }
 
 bool StatefulReader::acceptMsgFrom(GUID_t &writerId, WriterProxy **wp)
@@ -531,117 +562,66 @@ void StatefulReader::NotifyChanges(WriterProxy* prox)
 bool StatefulReader::nextUntakenCache(CacheChange_t** change,WriterProxy** wpout)
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
-    std::vector<CacheChange_t*> toremove;
     bool takeok = false;
-    for(std::vector<CacheChange_t*>::iterator it = mp_history->changesBegin();
-            it!=mp_history->changesEnd();++it)
+
+    // Changes of a writer are made available in order, so only the oldest change of each writer has to be checked.
+    for(WriterProxy* wp : matched_writers)
     {
-        WriterProxy* wp;
-        if(this->matched_writer_lookup((*it)->writerGUID, &wp))
-        {
-            // TODO Revisar la comprobacion
-            SequenceNumber_t seq = wp->available_changes_max();
-            if(seq >= (*it)->sequenceNumber)
-            {
-                *change = *it;
-                if(wpout !=nullptr)
-                    *wpout = wp;
-
-                takeok = true;
-                break;
-                //				if((*it)->kind == ALIVE)
-                //				{
-                //					this->mp_type->deserialize(&(*it)->serializedPayload,data);
-                //				}
-                //				(*it)->isRead = true;
-                //				if(info!=NULL)
-                //				{
-                //					info->sampleKind = (*it)->kind;
-                //					info->writerGUID = (*it)->writerGUID;
-                //					info->sourceTimestamp = (*it)->sourceTimestamp;
-                //					info->iHandle = (*it)->instanceHandle;
-                //					if(this->m_qos.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS)
-                //						info->ownershipStrength = wp->m_data->m_qos.m_ownershipStrength.value;
-                //				}
-                //				m_reader_cache.decreaseUnreadCount();
-                //				logInfo(RTPS_READER,this->getGuid().entityId<<": reading change "<< (*it)->sequenceNumber.to64long());
-                //				readok = true;
-                //				break;
-            }
-        }
-        else
+        CacheChange_t* min_change = nullptr;
+        if(mp_history->get_min_change_from(&min_change, wp->m_att.guid) &&
+                wp->available_changes_max() >= min_change->sequenceNumber &&
+                (!takeok || min_change->sequenceNumber < (*change)->sequenceNumber))
         {
-            toremove.push_back((*it));
+            *change = min_change;
+            if(wpout !=nullptr)
+                *wpout = wp;
+
+            takeok = true;
         }
     }
 
-    for(std::vector<CacheChange_t*>::iterator it = toremove.begin();
-            it!=toremove.end();++it)
-    {
-        logWarning(RTPS_READER,"Removing change "<<(*it)->sequenceNumber << " from " << (*it)->writerGUID << " because is no longer paired");
-        mp_history->remove_change(*it);
-    }
     return takeok;
 }
 
-// TODO Porque elimina aqui y no cuando hay unpairing
 bool StatefulReader::nextUnreadCache(CacheChange_t** change,WriterProxy** wpout)
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
-    std::vector<CacheChange_t*> toremove;
     bool readok = false;
-    for(std::vector<CacheChange_t*>::iterator it = mp_history->changesBegin();
-            it!=mp_history->changesEnd();++it)
+
+    // Changes of a writer are made available in order, so only the first unread change of each writer has to be
+    // checked.
+    for(WriterProxy* wp : matched_writers)
     {
-        if((*it)->isRead)
-            continue;
-        WriterProxy* wp;
-        if(this->matched_writer_lookup((*it)->writerGUID,&wp))
+        CacheChange_t* unread_change = nullptr;
+        if(mp_history->get_first_unread_from(&unread_change, wp->m_att.guid) &&
+                wp->available_changes_max() >= unread_change->sequenceNumber &&
+                (!readok || unread_change->sequenceNumber < (*change)->sequenceNumber))
         {
-            SequenceNumber_t seq;
-            seq = wp->available_changes_max();
-            if(seq >= (*it)->sequenceNumber)
-            {
-                *change = *it;
-                if(wpout !=nullptr)
-                    *wpout = wp;
-
-                readok = true;
-                break;
-                //				if((*it)->kind == ALIVE)
-                //				{
-                //					this->mp_type->deserialize(&(*it)->serializedPayload,data);
-                //				}
-                //				(*it)->isRead = true;
-                //				if(info!=NULL)
-                //				{
-                //					info->sampleKind = (*it)->kind;
-                //					info->writerGUID = (*it)->writerGUID;
-                //					info->sourceTimestamp = (*it)->sourceTimestamp;
-                //					info->iHandle = (*it)->instanceHandle;
-                //					if(this->m_qos.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS)
-                //						info->ownershipStrength = wp->m_data->m_qos.m_ownershipStrength.value;
-                //				}
-                //				m_reader_cache.decreaseUnreadCount();
-                //				logInfo(RTPS_READER,this->getGuid().entityId<<": reading change "<< (*it)->sequenceNumber.to64long());
-                //				readok = true;
-                //				break;
-            }
-        }
-        else
-        {
-            toremove.push_back((*it));
+            *change = unread_change;
+            if(wpout !=nullptr)
+                *wpout = wp;
+
+            readok = true;
         }
     }
 
-    for(std::vector<CacheChange_t*>::iterator it = toremove.begin();
-            it!=toremove.end();++it)
+    return readok;
+}
+
+bool StatefulReader::isChangeAvailable(CacheChange_t* change, WriterProxy** wpout)
+{
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    WriterProxy* wp = nullptr;
+
+    if(!findWriterProxy(change->writerGUID, &wp) || wp->available_changes_max() < change->sequenceNumber)
     {
-        logWarning(RTPS_READER,"Removing change "<<(*it)->sequenceNumber << " from " << (*it)->writerGUID << " because is no longer paired");
-        mp_history->remove_change(*it);
+        return false;
     }
 
-    return readok;
+    if(wpout != nullptr)
+        *wpout = wp;
+
+    return true;
 }
 
 bool StatefulReader::updateTimes(const ReaderTimes& ti)
@@ -50,7 +50,7 @@ StatelessReader::StatelessReader(RTPSParticipantImpl* pimpl,GUID_t& guid,
 
 bool StatelessReader::matched_writer_add(RemoteWriterAttributes& wdata)
 {
-    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    std::unique_lock<std::recursive_mutex> lock(*mp_mutex);
     for(auto it = m_matched_writers.begin();it!=m_matched_writers.end();++it)
     {
         if((*it).guid == wdata.guid)
@@ -63,11 +63,15 @@ bool StatelessReader::matched_writer_add(RemoteWriterAttributes& wdata)
     m_matched_writers.push_back(wdata);
     add_persistence_guid(wdata);
     m_acceptMessagesFromUnkownWriters = false;
+    bool any_writer = m_trustedWriterEntityId != c_EntityId_Unknown;
+    lock.unlock();
+
+    mp_RTPSParticipant->reader_matched_writer(this, wdata.guid, any_writer);
     return true;
 }
 bool StatelessReader::matched_writer_remove(const RemoteWriterAttributes& wdata)
 {
-    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    std::unique_lock<std::recursive_mutex> lock(*mp_mutex);
     for(auto it = m_matched_writers.begin();it!=m_matched_writers.end();++it)
     {
         if((*it).guid == wdata.guid)
@@ -75,12 +79,31 @@ bool StatelessReader::matched_writer_remove(const RemoteWriterAttributes& wdata)
             logInfo(RTPS_READER,"Writer " <<wdata.guid<< " removed from "<<m_guid.entityId);
             m_matched_writers.erase(it);
             remove_persistence_guid(wdata);
+            bool any_writer = m_acceptMessagesFromUnkownWriters || m_trustedWriterEntityId != c_EntityId_Unknown;
+            lock.unlock();
+
+            mp_RTPSParticipant->reader_unmatched_writer(this, wdata.guid, any_writer);
             return true;
         }
     }
     return false;
 }
 
+bool StatelessReader::matched_writer_guids(std::vector<GUID_t>& guids)
+{
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    if(m_acceptMessagesFromUnkownWriters || m_trustedWriterEntityId != c_EntityId_Unknown)
+    {
+        return false;
+    }
+
+    for(auto it = m_matched_writers.begin();it!=m_matched_writers.end();++it)
+    {
+        guids.push_back((*it).guid);
+    }
+    return true;
+}
+
 bool StatelessReader::matched_writer_is_matched(const RemoteWriterAttributes& wdata)
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
@@ -126,22 +149,8 @@ bool StatelessReader::nextUntakenCache(CacheChange_t** change, WriterProxy** /*w
 bool StatelessReader::nextUnreadCache(CacheChange_t** change,WriterProxy** /*wpout*/)
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
-    //m_reader_cache.sortCacheChangesBySeqNum();
-    bool found = false;
-    std::vector<CacheChange_t*>::iterator it;
-    //TODO PROTEGER ACCESO A HISTORIA AQUI??? YO CREO QUE NO, YA ESTA EL READER PROTEGIDO
-    for(it = mp_history->changesBegin();
-            it!=mp_history->changesEnd();++it)
-    {
-        if(!(*it)->isRead)
-        {
-            found = true;
-            break;
-        }
-    }
-    if(found)
+    if(mp_history->get_first_unread(change))
     {
-        *change = *it;
         return true;
     }
     logInfo(RTPS_READER,"No Unread elements left");
@@ -149,6 +158,11 @@ bool StatelessReader::nextUnreadCache(CacheChange_t** change,WriterProxy** /*wpo
 }
 
 
+bool StatelessReader::isChangeAvailable(CacheChange_t* /*change*/, WriterProxy** /*wpout*/)
+{
+    return true;
+}
+
 bool StatelessReader::change_removed_by_history(CacheChange_t* /*ch*/, WriterProxy* /*prox*/)
 {
     return true;
@@ -183,7 +197,7 @@ bool StatelessReader::processDataMsg(CacheChange_t *change)
             else
             {
 #endif
-                if (!change_to_add->copy(change))
+                if (!change_to_add->copy_or_loan(change))
                 {
                     logWarning(RTPS_MSG_IN,IDSTRING"Problem copying CacheChange, received data is: " << change->serializedPayload.length
                             << " bytes and max size in reader " << getGuid().entityId << " is " << change_to_add->serializedPayload.max_size);
@@ -210,10 +224,14 @@ bool StatelessReader::processDataMsg(CacheChange_t *change)
             {
                 mp_RTPSParticipant->assertRemoteRTPSParticipantLiveliness(change->writerGUID.guidPrefix);
             }
+
+            return false;
         }
+
+        return true;
     }
 
-    return true;
+    return false;
 }
 
 bool StatelessReader::processDataFragMsg(CacheChange_t *incomingChange, uint32_t sampleSize, uint32_t fragmentStartingNum)
@@ -23,6 +23,7 @@
 
 #include <fastrtps/rtps/reader/StatefulReader.h>
 #include "../../participant/RTPSParticipantImpl.h"
+#include "../../participant/ControlMessageAggregator.h"
 
 #include <fastrtps/rtps/messages/RTPSMessageCreator.h>
 #include <fastrtps/rtps/messages/CDRMessage.h>
@@ -38,13 +39,13 @@ namespace rtps {
 HeartbeatResponseDelay::~HeartbeatResponseDelay()
 {
     destroy();
+    mp_WP->mp_SFR->getRTPSParticipant()->control_message_aggregator().remove_heartbeat_response(this);
 }
 
 HeartbeatResponseDelay::HeartbeatResponseDelay(WriterProxy* p_WP,double interval):
     TimedEvent(p_WP->mp_SFR->getRTPSParticipant()->getEventResource().getIOService(),
             p_WP->mp_SFR->getRTPSParticipant()->getEventResource().getThread(), interval),
-    mp_WP(p_WP), m_cdrmessages(p_WP->mp_SFR->getRTPSParticipant()->getMaxMessageSize(),
-            p_WP->mp_SFR->getRTPSParticipant()->getGuid().guidPrefix),
+    mp_WP(p_WP),
     m_destination_locators(p_WP->m_att.endpoint.unicastLocatorList),
     m_remote_endpoints(1, p_WP->m_att.guid)
 {
@@ -61,100 +62,101 @@ void HeartbeatResponseDelay::event(EventCode code, const char* msg)
     {
         logInfo(RTPS_READER,"");
 
-        // Protect reader
-        std::lock_guard<std::recursive_mutex> guard(*mp_WP->mp_SFR->getMutex());
+        // The response is sent with the messages of other endpoints becoming due.
+        mp_WP->mp_SFR->getRTPSParticipant()->control_message_aggregator().add_heartbeat_response(this);
+    }
+    else if(code == EVENT_ABORT)
+    {
+        logInfo(RTPS_READER,"HeartbeatResponseDelay aborted");
+    }
+    else
+    {
+        logInfo(RTPS_READER,"HeartbeatResponseDelay event message: " <<msg);
+    }
+}
 
-        const std::vector<ChangeFromWriter_t> missing_changes = mp_WP->missing_changes();
-        // Stores missing changes but there is some fragments received.
-        std::vector<CacheChange_t*> uncompleted_changes;
+void HeartbeatResponseDelay::add_messages(RTPSMessageGroup& group)
+{
+    // Protect reader
+    std::lock_guard<std::recursive_mutex> guard(*mp_WP->mp_SFR->getMutex());
+
+    SequenceNumberSet_t missing_changes;
+    bool are_there_missing = mp_WP->missing_changes(missing_changes);
+    // Stores missing changes but there is some fragments received.
+    std::vector<CacheChange_t*> uncompleted_changes;
 
-        RTPSMessageGroup group(mp_WP->mp_SFR->getRTPSParticipant(), mp_WP->mp_SFR, RTPSMessageGroup::READER, m_cdrmessages,
-            m_destination_locators, m_remote_endpoints);
+    group.set_endpoint(mp_WP->mp_SFR);
 
-        if(!missing_changes.empty() || !mp_WP->m_heartbeatFinalFlag)
+    if(are_there_missing || !mp_WP->m_heartbeatFinalFlag)
+    {
+        SequenceNumberSet_t sns;
+        sns.base = missing_changes.base;
+
+        for(auto seq_num = missing_changes.get_begin(); seq_num != missing_changes.get_end(); ++seq_num)
         {
-            SequenceNumberSet_t sns;
-            sns.base = mp_WP->available_changes_max();
-            sns.base++;
+            // Check if the CacheChange_t is uncompleted.
+            CacheChange_t* uncomplete_change = mp_WP->mp_SFR->findCacheInFragmentedCachePitStop(*seq_num, mp_WP->m_att.guid);
 
-            for(auto ch : missing_changes)
+            if(uncomplete_change == nullptr)
             {
-                // Check if the CacheChange_t is uncompleted.
-                CacheChange_t* uncomplete_change = mp_WP->mp_SFR->findCacheInFragmentedCachePitStop(ch.getSequenceNumber(), mp_WP->m_att.guid);
-
-                if(uncomplete_change == nullptr)
-                {
-                    if(!sns.add(ch.getSequenceNumber()))
-                    {
-                        logInfo(RTPS_READER,"Sequence number " << ch.getSequenceNumber()
-                                << " exceeded bitmap limit of AckNack. SeqNumSet Base: " << sns.base);
-                    }
-                }
-                else
-                {
-                    uncompleted_changes.push_back(uncomplete_change);
-                }
+                sns.add(*seq_num);
             }
+            else
+            {
+                uncompleted_changes.push_back(uncomplete_change);
+            }
+        }
 
-            // TODO Protect
-            mp_WP->mp_SFR->m_acknackCount++;
-            logInfo(RTPS_READER,"Sending ACKNACK: "<< sns;);
+        // TODO Protect
+        mp_WP->mp_SFR->m_acknackCount++;
+        logInfo(RTPS_READER,"Sending ACKNACK: "<< sns;);
 
-            bool final = false;
-            if(sns.isSetEmpty())
-                final = true;
+        bool final = false;
+        if(sns.isSetEmpty())
+            final = true;
 
-            group.add_acknack(m_remote_endpoints, sns, mp_WP->mp_SFR->m_acknackCount, final, m_destination_locators);
-        }
+        group.add_acknack(m_remote_endpoints, sns, mp_WP->mp_SFR->m_acknackCount, final, m_destination_locators);
+    }
 
-        // Now generage NACK_FRAGS
-        if(!uncompleted_changes.empty())
+    // Now generage NACK_FRAGS
+    if(!uncompleted_changes.empty())
+    {
+        for(auto cit : uncompleted_changes)
         {
-            for(auto cit : uncompleted_changes)
+            FragmentNumberSet_t frag_sns;
+
+            //  Search first fragment not present.
+            uint32_t frag_num = 0;
+            auto fit = cit->getDataFragments()->begin();
+            for(; fit != cit->getDataFragments()->end(); ++fit)
             {
-                FragmentNumberSet_t frag_sns;
-
-                //  Search first fragment not present.
-                uint32_t frag_num = 0;
-                auto fit = cit->getDataFragments()->begin();
-                for(; fit != cit->getDataFragments()->end(); ++fit)
-                {
-                    ++frag_num;
-                    if(*fit == ChangeFragmentStatus_t::NOT_PRESENT)
-                        break;
-                }
-
-                // Never should happend.
-                assert(frag_num != 0);
-                assert(fit != cit->getDataFragments()->end());
-
-                // Store FragmentNumberSet_t base.
-                frag_sns.base = frag_num;
-
-                // Fill the FragmentNumberSet_t bitmap.
-                for(; fit != cit->getDataFragments()->end(); ++fit)
-                {
-                    if(*fit == ChangeFragmentStatus_t::NOT_PRESENT)
-                        frag_sns.add(frag_num);
-
-                    ++frag_num;
-                }
-
-                ++mp_WP->mp_SFR->m_nackfragCount;
-                logInfo(RTPS_READER,"Sending NACKFRAG for sample" << cit->sequenceNumber << ": "<< frag_sns;);
-
-                group.add_nackfrag(m_remote_endpoints, cit->sequenceNumber, frag_sns, mp_WP->mp_SFR->m_nackfragCount, m_destination_locators);
+                ++frag_num;
+                if(*fit == ChangeFragmentStatus_t::NOT_PRESENT)
+                    break;
             }
+
+            // Never should happend.
+            assert(frag_num != 0);
+            assert(fit != cit->getDataFragments()->end());
+
+            // Store FragmentNumberSet_t base.
+            frag_sns.base = frag_num;
+
+            // Fill the FragmentNumberSet_t bitmap.
+            for(; fit != cit->getDataFragments()->end(); ++fit)
+            {
+                if(*fit == ChangeFragmentStatus_t::NOT_PRESENT)
+                    frag_sns.add(frag_num);
+
+                ++frag_num;
+            }
+
+            ++mp_WP->mp_SFR->m_nackfragCount;
+            logInfo(RTPS_READER,"Sending NACKFRAG for sample" << cit->sequenceNumber << ": "<< frag_sns;);
+
+            group.add_nackfrag(m_remote_endpoints, cit->sequenceNumber, frag_sns, mp_WP->mp_SFR->m_nackfragCount, m_destination_locators);
         }
     }
-    else if(code == EVENT_ABORT)
-    {
-        logInfo(RTPS_READER,"HeartbeatResponseDelay aborted");
-    }
-    else
-    {
-        logInfo(RTPS_READER,"HeartbeatResponseDelay event message: " <<msg);
-    }
 }
 
 }
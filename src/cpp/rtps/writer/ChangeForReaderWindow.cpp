@@ -0,0 +1,312 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ChangeForReaderWindow.cpp
+ *
+ */
+
+#include <fastrtps/rtps/writer/ChangeForReaderWindow.h>
+#include <fastrtps/utils/BitmapWord.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+ChangeForReaderWindow::ChangeForReaderWindow()
+    : m_first(0)
+    , m_size(0)
+    , m_last(c_SequenceNumber_Unknown)
+{
+}
+
+void ChangeForReaderWindow::reset(const SequenceNumber_t& base)
+{
+    // Vectors keep their capacity, so a window that empties often does not allocate again.
+    m_slots.clear();
+    m_present.clear();
+    for(size_t status = 0; status < c_statuses; ++status)
+    {
+        m_status[status].clear();
+    }
+    m_base = base;
+    m_first = 0;
+    m_size = 0;
+}
+
+size_t ChangeForReaderWindow::slot(const SequenceNumber_t& sequence_number) const
+{
+    if(m_slots.empty() || sequence_number < m_base)
+    {
+        return m_slots.size();
+    }
+
+    uint64_t offset = (sequence_number - m_base).to64long();
+    return offset < m_slots.size() ? static_cast<size_t>(offset) : m_slots.size();
+}
+
+ChangeForReader_t* ChangeForReaderWindow::front()
+{
+    if(m_size == 0)
+    {
+        return nullptr;
+    }
+
+    // Slots before the first change were removed, so m_first can be moved up to it.
+    size_t word = m_first / c_bits;
+    uint64_t bits = m_present[word] & ~bitmap_word_range(0, static_cast<uint32_t>(m_first % c_bits));
+    while(bits == 0)
+    {
+        bits = m_present[++word];
+    }
+    m_first = word * c_bits + bitmap_word_lowest(bits);
+    return &m_slots[m_first];
+}
+
+bool ChangeForReaderWindow::push_back(const ChangeForReader_t& change)
+{
+    SequenceNumber_t sequence_number = change.getSequenceNumber();
+    if(!(sequence_number > m_last))
+    {
+        return false;
+    }
+
+    if(m_size == 0)
+    {
+        reset(sequence_number);
+    }
+    else
+    {
+        compact();
+    }
+
+    size_t position = static_cast<size_t>((sequence_number - m_base).to64long());
+    // Sequence numbers not sent to this reader leave empty slots.
+    m_slots.resize(position);
+    m_slots.push_back(change);
+
+    size_t words = position / c_bits + 1;
+    if(m_present.size() < words)
+    {
+        m_present.resize(words, 0);
+        for(size_t status = 0; status < c_statuses; ++status)
+        {
+            m_status[status].resize(words, 0);
+        }
+    }
+
+    set_bit(m_present, position);
+    set_bit(m_status[change.getStatus()], position);
+    ++m_size;
+    m_last = sequence_number;
+    return true;
+}
+
+bool ChangeForReaderWindow::prepend(ChangeForReaderWindow& older)
+{
+    ChangeForReader_t* first = front();
+    if(first != nullptr && !(first->getSequenceNumber() > older.m_last))
+    {
+        return false;
+    }
+
+    SequenceNumber_t last = m_last;
+    for(size_t word = m_first / c_bits; word < m_present.size(); ++word)
+    {
+        for(uint64_t bits = m_present[word]; bits != 0; bits &= bits - 1)
+        {
+            older.push_back(m_slots[word * c_bits + bitmap_word_lowest(bits)]);
+        }
+    }
+    if(older.m_last < last)
+    {
+        older.m_last = last;
+    }
+
+    std::swap(*this, older);
+    older.reset(SequenceNumber_t());
+    older.m_last = c_SequenceNumber_Unknown;
+    return true;
+}
+
+ChangeForReader_t* ChangeForReaderWindow::find(const SequenceNumber_t& sequence_number)
+{
+    size_t position = slot(sequence_number);
+    if(position >= m_slots.size() || position < m_first || !is_present(position))
+    {
+        return nullptr;
+    }
+    return &m_slots[position];
+}
+
+bool ChangeForReaderWindow::set_status(const SequenceNumber_t& sequence_number, ChangeForReaderStatus_t status)
+{
+    ChangeForReader_t* change = find(sequence_number);
+    if(change == nullptr)
+    {
+        return false;
+    }
+
+    size_t position = static_cast<size_t>(change - m_slots.data());
+    clear_bit(m_status[change->getStatus()], position);
+    set_bit(m_status[status], position);
+    change->setStatus(status);
+    return true;
+}
+
+void ChangeForReaderWindow::remove_slot(size_t position)
+{
+    clear_bit(m_status[m_slots[position].getStatus()], position);
+    clear_bit(m_present, position);
+    --m_size;
+    if(position == m_first)
+    {
+        ++m_first;
+    }
+}
+
+size_t ChangeForReaderWindow::remove_until(const SequenceNumber_t& sequence_number)
+{
+    if(m_size == 0 || !(sequence_number > m_base))
+    {
+        return 0;
+    }
+
+    uint64_t offset = (sequence_number - m_base).to64long();
+    size_t end = offset < m_slots.size() ? static_cast<size_t>(offset) : m_slots.size();
+    if(end <= m_first)
+    {
+        return 0;
+    }
+
+    // Whole words are cleared at once, only the words at both ends need a mask.
+    size_t removed = 0;
+    size_t last_word = (end - 1) / c_bits;
+    for(size_t word = m_first / c_bits; word <= last_word; ++word)
+    {
+        uint32_t first_bit = word == m_first / c_bits ? static_cast<uint32_t>(m_first % c_bits) : 0;
+        uint32_t last_bit = word == last_word ? static_cast<uint32_t>(end - word * c_bits) :
+            static_cast<uint32_t>(c_bits);
+        uint64_t mask = bitmap_word_range(first_bit, last_bit);
+
+        removed += bitmap_word_count(m_present[word] & mask);
+        m_present[word] &= ~mask;
+        for(size_t status = 0; status < c_statuses; ++status)
+        {
+            m_status[status][word] &= ~mask;
+        }
+    }
+
+    m_first = end;
+    m_size -= removed;
+    return removed;
+}
+
+SequenceNumber_t ChangeForReaderWindow::remove_acknowledged_front()
+{
+    SequenceNumber_t last_removed = c_SequenceNumber_Unknown;
+    for(ChangeForReader_t* first = front(); first != nullptr && first->getStatus() == ACKNOWLEDGED; first = front())
+    {
+        last_removed = first->getSequenceNumber();
+        remove_slot(m_first);
+    }
+    return last_removed;
+}
+
+size_t ChangeForReaderWindow::convert_status(ChangeForReaderStatus_t previous, ChangeForReaderStatus_t next)
+{
+    if(previous == next)
+    {
+        return 0;
+    }
+
+    std::vector<uint64_t>& from = m_status[previous];
+    std::vector<uint64_t>& to = m_status[next];
+    size_t converted = 0;
+    for(size_t word = m_first / c_bits; word < from.size(); ++word)
+    {
+        uint64_t bits = from[word];
+        if(bits == 0)
+        {
+            continue;
+        }
+
+        from[word] = 0;
+        to[word] |= bits;
+        converted += bitmap_word_count(bits);
+        for(; bits != 0; bits &= bits - 1)
+        {
+            m_slots[word * c_bits + bitmap_word_lowest(bits)].setStatus(next);
+        }
+    }
+    return converted;
+}
+
+void ChangeForReaderWindow::get_changes(ChangeForReaderStatus_t status, std::vector<ChangeForReader_t*>& changes)
+{
+    const std::vector<uint64_t>& bitmap = m_status[status];
+    for(size_t word = m_first / c_bits; word < bitmap.size(); ++word)
+    {
+        for(uint64_t bits = bitmap[word]; bits != 0; bits &= bits - 1)
+        {
+            changes.push_back(&m_slots[word * c_bits + bitmap_word_lowest(bits)]);
+        }
+    }
+}
+
+void ChangeForReaderWindow::get_changes(ChangeForReaderStatus_t status,
+        std::vector<const ChangeForReader_t*>& changes) const
+{
+    const std::vector<uint64_t>& bitmap = m_status[status];
+    for(size_t word = m_first / c_bits; word < bitmap.size(); ++word)
+    {
+        for(uint64_t bits = bitmap[word]; bits != 0; bits &= bits - 1)
+        {
+            changes.push_back(&m_slots[word * c_bits + bitmap_word_lowest(bits)]);
+        }
+    }
+}
+
+bool ChangeForReaderWindow::has_changes(ChangeForReaderStatus_t status) const
+{
+    const std::vector<uint64_t>& bitmap = m_status[status];
+    return std::any_of(bitmap.begin() + m_first / c_bits, bitmap.end(), [](uint64_t bits) { return bits != 0; });
+}
+
+void ChangeForReaderWindow::compact()
+{
+    // Only whole words are reclaimed, so the bitmaps do not have to be shifted bit by bit.
+    size_t words = m_first / c_bits;
+    if(words == 0 || m_first < m_slots.size() / 2)
+    {
+        return;
+    }
+
+    size_t slots = words * c_bits;
+    m_slots.erase(m_slots.begin(), m_slots.begin() + slots);
+    m_present.erase(m_present.begin(), m_present.begin() + words);
+    for(size_t status = 0; status < c_statuses; ++status)
+    {
+        m_status[status].erase(m_status[status].begin(), m_status[status].begin() + words);
+    }
+    m_base = m_base + static_cast<uint32_t>(slots);
+    m_first -= slots;
+}
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
@@ -18,13 +18,17 @@
  */
 
 #include <fastrtps/rtps/writer/RTPSWriter.h>
+#include <fastrtps/rtps/writer/timedevent/IntraprocessDelivery.h>
 #include <fastrtps/rtps/history/WriterHistory.h>
+#include <fastrtps/rtps/reader/RTPSReader.h>
+#include <fastrtps/rtps/RTPSDomain.h>
 #include <fastrtps/rtps/messages/RTPSMessageCreator.h>
 #include <fastrtps/log/Log.h>
 #include "../participant/RTPSParticipantImpl.h"
 #include "../flowcontrol/FlowController.h"
 
 #include <mutex>
+#include <algorithm>
 
 using namespace eprosima::fastrtps::rtps;
 
@@ -43,13 +47,23 @@ RTPSWriter::RTPSWriter(RTPSParticipantImpl* impl, GUID_t& guid, WriterAttributes
     mp_history(hist),
     mp_listener(listen),
     is_async_(att.mode == SYNCHRONOUS_WRITER ? false : true),
-    m_separateSendingEnabled(false)
+    m_separateSendingEnabled(false),
+    mp_intraprocessDelivery(nullptr)
 #if HAVE_SECURITY
     , encrypt_payload_(mp_history->getTypeMaxSerialized())
 #endif
+    , m_localDeliveryPending(false)
+    , m_localDeliveryRunning(false)
+    , m_localDeliveryHolders(0)
 {
     mp_history->mp_writer = this;
     mp_history->mp_mutex = mp_mutex;
+
+    if(impl->getRTPSParticipantAttributes().intraprocess_delivery)
+    {
+        mp_intraprocessDelivery = new IntraprocessDelivery(this);
+    }
+
     logInfo(RTPS_WRITER,"RTPSWriter created");
 }
 
@@ -59,6 +73,14 @@ RTPSWriter::~RTPSWriter()
 
     // Deletion of the events has to be made in child destructor.
 
+    for(LocalDelivery& delivery : m_queuedLocalDeliveries)
+    {
+        if(delivery.kind == LocalDelivery::DATA)
+        {
+            mp_history->return_loan(delivery.change);
+        }
+    }
+
     mp_history->mp_writer = nullptr;
     mp_history->mp_mutex = nullptr;
 }
@@ -170,6 +192,208 @@ void RTPSWriter::update_cached_info_nts(std::vector<GUID_t>&& allRemoteReaders,
     mAllShrinkedLocatorList.push_back(mp_RTPSParticipant->network_factory().ShrinkLocatorLists(allLocatorLists));
 }
 
+bool RTPSWriter::is_local_reader(const GUID_t& reader_guid) const
+{
+    return mp_RTPSParticipant->getRTPSParticipantAttributes().intraprocess_delivery &&
+        RTPSDomain::is_local_reader(reader_guid);
+}
+
+bool RTPSWriter::intraprocess_delivery(CacheChange_t* change, const GUID_t& reader_guid)
+{
+    RTPSReader* reader = RTPSDomain::acquire_local_reader(reader_guid);
+
+    if(reader == nullptr)
+    {
+        return false;
+    }
+
+    bool ret_code = reader->processDataMsg(change);
+    RTPSDomain::release_local_reader(reader_guid);
+    return ret_code;
+}
+
+bool RTPSWriter::intraprocess_gap(const SequenceNumber_t& seq_num, const GUID_t& reader_guid)
+{
+    RTPSReader* reader = RTPSDomain::acquire_local_reader(reader_guid);
+
+    if(reader == nullptr)
+    {
+        return false;
+    }
+
+    GUID_t writer_guid = m_guid;
+    SequenceNumber_t gap_start = seq_num;
+    SequenceNumberSet_t gap_list;
+    gap_list.base = seq_num + 1;
+    bool ret_code = reader->processGapMsg(writer_guid, gap_start, gap_list);
+    RTPSDomain::release_local_reader(reader_guid);
+    return ret_code;
+}
+
+bool RTPSWriter::intraprocess_heartbeat(const SequenceNumber_t& first_seq, uint32_t count, const GUID_t& reader_guid)
+{
+    RTPSReader* reader = RTPSDomain::acquire_local_reader(reader_guid);
+
+    if(reader == nullptr)
+    {
+        return false;
+    }
+
+    // Final heartbeat announcing nothing available yet: the reader only learns which changes it will never get.
+    GUID_t writer_guid = m_guid;
+    SequenceNumber_t first_sn = first_seq;
+    SequenceNumber_t last_sn = first_seq - 1;
+    bool ret_code = reader->processHeartbeatMsg(writer_guid, count, first_sn, last_sn, true, false);
+    RTPSDomain::release_local_reader(reader_guid);
+    return ret_code;
+}
+
+void RTPSWriter::queue_local_delivery_nts(CacheChange_t* change, const GUID_t& reader_guid)
+{
+    LocalDelivery delivery;
+    delivery.kind = LocalDelivery::DATA;
+    delivery.reader_guid = reader_guid;
+    delivery.change = change;
+    delivery.seq_num = change->sequenceNumber;
+    delivery.count = 0;
+    delivery.in_order = false;
+    delivery.delivered = false;
+
+    mp_history->loan_change(change);
+    m_queuedLocalDeliveries.push_back(delivery);
+    local_delivery_pending_nts();
+}
+
+void RTPSWriter::unqueue_local_deliveries_nts(const GUID_t& reader_guid)
+{
+    auto it = m_queuedLocalDeliveries.begin();
+    while(it != m_queuedLocalDeliveries.end())
+    {
+        if(it->reader_guid == reader_guid)
+        {
+            if(it->kind == LocalDelivery::DATA)
+            {
+                mp_history->return_loan(it->change);
+            }
+            it = m_queuedLocalDeliveries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void RTPSWriter::local_delivery_pending_nts()
+{
+    m_localDeliveryPending = true;
+
+    // A thread already delivering, or about to, will take these changes too.
+    if(!m_localDeliveryRunning && m_localDeliveryHolders == 0 && mp_intraprocessDelivery != nullptr)
+    {
+        mp_intraprocessDelivery->restart_timer();
+    }
+}
+
+void RTPSWriter::hold_local_delivery_nts()
+{
+    if(mp_intraprocessDelivery != nullptr)
+    {
+        ++m_localDeliveryHolders;
+    }
+}
+
+void RTPSWriter::unhold_local_delivery_nts()
+{
+    if(mp_intraprocessDelivery != nullptr)
+    {
+        --m_localDeliveryHolders;
+
+        if(m_localDeliveryPending && !m_localDeliveryRunning && m_localDeliveryHolders == 0)
+        {
+            mp_intraprocessDelivery->restart_timer();
+        }
+    }
+}
+
+void RTPSWriter::release_local_delivery()
+{
+    if(mp_intraprocessDelivery == nullptr)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+        --m_localDeliveryHolders;
+    }
+
+    deliver_to_local_readers();
+}
+
+void RTPSWriter::deliver_to_local_readers()
+{
+    std::unique_lock<std::recursive_mutex> lock(*mp_mutex);
+
+    if(m_localDeliveryRunning)
+    {
+        return;
+    }
+
+    m_localDeliveryRunning = true;
+
+    while(m_localDeliveryPending)
+    {
+        m_localDeliveryPending = false;
+        m_localDeliveries.swap(m_queuedLocalDeliveries);
+        collect_local_deliveries_nts(m_localDeliveries);
+
+        // Readers take their own mutex and call their listeners, which may write with other writers.
+        lock.unlock();
+
+        for(auto it = m_localDeliveries.begin(); it != m_localDeliveries.end(); ++it)
+        {
+            // Nothing else is delivered to a reader after it refuses a delivery it needs in order.
+            bool refused = std::any_of(m_localDeliveries.begin(), it, [&it](const LocalDelivery& previous)
+            {
+                return previous.reader_guid == it->reader_guid && previous.in_order && !previous.delivered;
+            });
+
+            it->delivered = !refused && deliver_to_local_reader(*it);
+        }
+
+        lock.lock();
+
+        local_deliveries_done_nts(m_localDeliveries);
+
+        for(LocalDelivery& delivery : m_localDeliveries)
+        {
+            if(delivery.kind == LocalDelivery::DATA)
+            {
+                mp_history->return_loan(delivery.change);
+            }
+        }
+        m_localDeliveries.clear();
+    }
+
+    m_localDeliveryRunning = false;
+}
+
+bool RTPSWriter::deliver_to_local_reader(const LocalDelivery& delivery)
+{
+    switch(delivery.kind)
+    {
+        case LocalDelivery::DATA:
+            return intraprocess_delivery(delivery.change, delivery.reader_guid);
+        case LocalDelivery::GAP:
+            return intraprocess_gap(delivery.seq_num, delivery.reader_guid);
+        case LocalDelivery::HEARTBEAT:
+            return intraprocess_heartbeat(delivery.seq_num, delivery.count, delivery.reader_guid);
+    }
+
+    return false;
+}
+
 #if HAVE_SECURITY
 bool RTPSWriter::encrypt_cachechange(CacheChange_t* change)
 {
@@ -182,14 +406,19 @@ bool RTPSWriter::encrypt_cachechange(CacheChange_t* change)
             (mp_history->m_att.memoryPolicy == MemoryManagementPolicy_t::PREALLOCATED_WITH_REALLOC_MEMORY_MODE ||
             mp_history->m_att.memoryPolicy == MemoryManagementPolicy_t::DYNAMIC_RESERVE_MEMORY_MODE))
         {
-            encrypt_payload_.data = (octet*)realloc(encrypt_payload_.data, change->serializedPayload.length +
-                    // In future v2 changepool is in writer, and writer set this value to cachechagepool.
-                    + 20 /*SecureDataHeader*/ + 4 + ((2* 16) /*EVP_MAX_IV_LENGTH max block size*/ - 1 ) /* SecureDataBodey*/
-                    + 16 + 4 /*SecureDataTag*/);
-            encrypt_payload_.max_size = change->serializedPayload.length +
-                // In future v2 changepool is in writer, and writer set this value to cachechagepool.
-                + 20 /*SecureDataHeader*/ + 4 + ((2* 16) /*EVP_MAX_IV_LENGTH max block size*/ - 1 ) /* SecureDataBodey*/
-                + 16 + 4 /*SecureDataTag*/;
+            // After a previous swap the buffer may belong to the arena of the history, so it is grown through reserve.
+            try
+            {
+                encrypt_payload_.reserve(change->serializedPayload.length +
+                        // In future v2 changepool is in writer, and writer set this value to cachechagepool.
+                        + 20 /*SecureDataHeader*/ + 4 + ((2* 16) /*EVP_MAX_IV_LENGTH max block size*/ - 1 ) /* SecureDataBodey*/
+                        + 16 + 4 /*SecureDataTag*/);
+            }
+            catch(std::bad_alloc& ex)
+            {
+                logError(RTPS_WRITER, "Failed to allocate memory for the encrypted payload: " << ex.what());
+                return false;
+            }
         }
 
         if(!mp_RTPSParticipant->security_manager().encode_serialized_payload(change->serializedPayload,
@@ -201,16 +430,19 @@ bool RTPSWriter::encrypt_cachechange(CacheChange_t* change)
 
         octet* data = change->serializedPayload.data;
         uint32_t max_size = change->serializedPayload.max_size;
+        PayloadArena* arena = change->serializedPayload.arena;
 
         change->serializedPayload.length = encrypt_payload_.length;
         change->serializedPayload.data = encrypt_payload_.data;
         change->serializedPayload.max_size = encrypt_payload_.max_size;
         change->serializedPayload.pos = encrypt_payload_.pos;
+        change->serializedPayload.arena = encrypt_payload_.arena;
 
         encrypt_payload_.data = data;;
         encrypt_payload_.length = 0;
         encrypt_payload_.max_size = max_size;
         encrypt_payload_.pos = 0;
+        encrypt_payload_.arena = arena;
 
         change->setFragmentSize(change->getFragmentSize());
     }
@@ -0,0 +1,114 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ReaderGroupScheduler.cpp
+ *
+ */
+
+#include <fastrtps/rtps/writer/ReaderGroupScheduler.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+ReaderGroupScheduler::ReaderGroupScheduler()
+    : m_inline_qos_readers(0)
+{
+}
+
+bool ReaderGroupScheduler::add_reader(ReaderProxy* reader, const GUID_t& guid, const LocatorList_t& locators,
+        bool expects_inline_qos)
+{
+    if(m_members.find(reader) != m_members.end())
+    {
+        return false;
+    }
+
+    size_t position = 0;
+    while(position < m_groups.size() && !(m_groups[position].locators == locators))
+    {
+        ++position;
+    }
+
+    if(position == m_groups.size())
+    {
+        m_groups.emplace_back();
+        m_groups.back().locators = locators;
+        m_groups.back().inline_qos_readers = 0;
+    }
+
+    Group& group = m_groups[position];
+    group.readers.push_back(reader);
+    group.guids.push_back(guid);
+    if(expects_inline_qos)
+    {
+        ++group.inline_qos_readers;
+        ++m_inline_qos_readers;
+    }
+
+    m_members.emplace(reader, Member{position, expects_inline_qos});
+    return true;
+}
+
+bool ReaderGroupScheduler::remove_reader(const ReaderProxy* reader)
+{
+    auto member = m_members.find(reader);
+    if(member == m_members.end())
+    {
+        return false;
+    }
+
+    size_t position = member->second.group;
+    Group& group = m_groups[position];
+    auto it = std::find(group.readers.begin(), group.readers.end(), reader);
+    assert(it != group.readers.end());
+    group.guids.erase(group.guids.begin() + (it - group.readers.begin()));
+    group.readers.erase(it);
+    if(member->second.expects_inline_qos)
+    {
+        --group.inline_qos_readers;
+        --m_inline_qos_readers;
+    }
+    m_members.erase(member);
+
+    if(group.readers.empty())
+    {
+        // The last group takes the place of the removed one.
+        if(position != m_groups.size() - 1)
+        {
+            m_groups[position] = std::move(m_groups.back());
+            for(ReaderProxy* moved : m_groups[position].readers)
+            {
+                m_members[moved].group = position;
+            }
+        }
+        m_groups.pop_back();
+    }
+
+    return true;
+}
+
+size_t ReaderGroupScheduler::group_of(const ReaderProxy* reader) const
+{
+    auto member = m_members.find(reader);
+    return member == m_members.end() ? m_groups.size() : member->second.group;
+}
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
@@ -30,6 +30,7 @@
 #include <mutex>
 
 #include <cassert>
+#include <algorithm>
 
 using namespace eprosima::fastrtps::rtps;
 
@@ -37,7 +38,8 @@ using namespace eprosima::fastrtps::rtps;
 ReaderProxy::ReaderProxy(const RemoteReaderAttributes& rdata,const WriterTimes& times,StatefulWriter* SW) :
     m_att(rdata), mp_SFW(SW),
     mp_nackResponse(nullptr), mp_nackSupression(nullptr), m_lastAcknackCount(0),
-    mp_mutex(new std::recursive_mutex()), lastNackfragCount_(0)
+    mp_mutex(new std::recursive_mutex()), low_mark_index_(0), lastNackfragCount_(0),
+    is_local_reader_(false), local_reader_synchronized_(false)
 {
     if(rdata.endpoint.reliabilityKind == RELIABLE)
     {
@@ -79,18 +81,19 @@ void ReaderProxy::addChange(const ChangeForReader_t& change)
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
     assert(change.getSequenceNumber() > changesFromRLowMark_);
-    assert(m_changesForReader.rbegin() != m_changesForReader.rend() ?
-            change.getSequenceNumber() > m_changesForReader.rbegin()->getSequenceNumber() :
-            true);
+    assert(change.getSequenceNumber() > changesForReader_.last_sequence_number());
 
     // For best effort readers, changes are acked when being sent
-    if(m_changesForReader.size() == 0 && change.getStatus() == ACKNOWLEDGED)
+    if(changesForReader_.empty() && change.getStatus() == ACKNOWLEDGED)
     {
-        changesFromRLowMark_ = change.getSequenceNumber();
+        set_low_mark_(change.getSequenceNumber());
         return;
     }
 
-    m_changesForReader.insert(change);
+    bool had_changes = !changesForReader_.empty();
+    changesForReader_.push_back(change);
+    if(!had_changes)
+        mp_SFW->reader_unacked_changes_changed_nts_(true);
     //TODO (Ricardo) Remove this functionality from here. It is not his place.
     if (change.getStatus() == UNSENT)
         AsyncWriterThread::wakeUp(mp_SFW);
@@ -99,7 +102,7 @@ void ReaderProxy::addChange(const ChangeForReader_t& change)
 size_t ReaderProxy::countChangesForReader() const
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
-    return m_changesForReader.size();
+    return changesForReader_.size();
 }
 
 bool ReaderProxy::change_is_acked(const SequenceNumber_t& sequence_number)
@@ -109,21 +112,21 @@ bool ReaderProxy::change_is_acked(const SequenceNumber_t& sequence_number)
     if(sequence_number <= changesFromRLowMark_)
         return true;
 
-    auto chit = m_changesForReader.find(ChangeForReader_t(sequence_number));
-    assert(chit != m_changesForReader.end());
+    const ChangeForReader_t* change = changesForReader_.find(sequence_number);
+    assert(change != nullptr);
 
-    return !chit->isRelevant() || chit->getStatus() == ACKNOWLEDGED;
+    return change == nullptr || !change->isRelevant() || change->getStatus() == ACKNOWLEDGED;
 }
 
 void ReaderProxy::acked_changes_set(const SequenceNumber_t& seqNum)
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
     SequenceNumber_t future_low_mark = seqNum;
+    bool had_changes = !changesForReader_.empty();
 
     if(seqNum > changesFromRLowMark_)
     {
-        auto chit = m_changesForReader.find(seqNum);
-        m_changesForReader.erase(m_changesForReader.begin(), chit);
+        changesForReader_.remove_until(seqNum);
     }
     else
     {
@@ -137,6 +140,8 @@ void ReaderProxy::acked_changes_set(const SequenceNumber_t& seqNum)
         }
         future_low_mark = current_sequence;
 
+        // Changes are added again in front of the ones the reader still has to acknowledge.
+        ChangeForReaderWindow restored;
         for(; current_sequence <= changesFromRLowMark_; ++current_sequence)
         {
             CacheChange_t* change = nullptr;
@@ -145,40 +150,37 @@ void ReaderProxy::acked_changes_set(const SequenceNumber_t& seqNum)
             {
                 ChangeForReader_t cr(change);
                 cr.setStatus(UNACKNOWLEDGED);
-                m_changesForReader.insert(cr);
+                restored.push_back(cr);
             }
             else
             {
-                ChangeForReader_t cr;
+                ChangeForReader_t cr(current_sequence);
                 cr.setStatus(UNACKNOWLEDGED);
                 cr.notValid();
-                m_changesForReader.insert(cr);
+                restored.push_back(cr);
             }
         }
+        changesForReader_.prepend(restored);
     }
 
-    changesFromRLowMark_ = future_low_mark - 1;
+    set_low_mark_(future_low_mark - 1);
+    if(had_changes == changesForReader_.empty())
+        mp_SFW->reader_unacked_changes_changed_nts_(!had_changes);
 }
 
-bool ReaderProxy::requested_changes_set(std::vector<SequenceNumber_t>& seqNumSet)
+bool ReaderProxy::requested_changes_set(const SequenceNumberSet_t& seqNumSet)
 {
     bool isSomeoneWasSetRequested = false;
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    for(std::vector<SequenceNumber_t>::iterator sit=seqNumSet.begin();sit!=seqNumSet.end();++sit)
+    for(SequenceNumberSet_t::const_iterator sit=seqNumSet.get_begin();sit!=seqNumSet.get_end();++sit)
     {
-        auto chit = m_changesForReader.find(ChangeForReader_t(*sit));
+        ChangeForReader_t* change = changesForReader_.find(*sit);
 
-        if(chit != m_changesForReader.end())
+        if(change != nullptr)
         {
-            ChangeForReader_t newch(*chit);
-            newch.setStatus(REQUESTED);
-            newch.markAllFragmentsAsUnsent();
-
-            auto hint = m_changesForReader.erase(chit);
-
-            m_changesForReader.insert(hint, newch);
-
+            changesForReader_.set_status(*sit, REQUESTED);
+            change->markAllFragmentsAsUnsent();
             isSomeoneWasSetRequested = true;
         }
     }
@@ -187,7 +189,7 @@ bool ReaderProxy::requested_changes_set(std::vector<SequenceNumber_t>& seqNumSet
     {
         logInfo(RTPS_WRITER,"Requested Changes: " << seqNumSet);
     }
-    else if(!seqNumSet.empty())
+    else if(!seqNumSet.isSetEmpty())
     {
         logWarning(RTPS_WRITER,"Requested Changes: " << seqNumSet
                    << " not found (low mark: " << changesFromRLowMark_ << ")");
@@ -204,24 +206,39 @@ std::vector<ChangeForReader_t*> ReaderProxy::get_unsent_changes()
     std::vector<ChangeForReader_t*> unsent_changes;
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    for(auto &change_for_reader : m_changesForReader)
-        if(change_for_reader.getStatus() == UNSENT)
-            unsent_changes.push_back(const_cast<ChangeForReader_t*>(&change_for_reader));
+    changesForReader_.get_changes(UNSENT, unsent_changes);
 
     return unsent_changes;
 }
 
+void ReaderProxy::get_unsent_changes(std::vector<ChangeForReader_t*>& unsent_changes)
+{
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    changesForReader_.get_changes(UNSENT, unsent_changes);
+}
+
+void ReaderProxy::get_unacknowledged_changes(std::vector<ChangeForReader_t*>& changes)
+{
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    size_t first = changes.size();
+    changesForReader_.get_changes(UNSENT, changes);
+    changesForReader_.get_changes(UNACKNOWLEDGED, changes);
+    changesForReader_.get_changes(REQUESTED, changes);
+    changesForReader_.get_changes(UNDERWAY, changes);
+    std::sort(changes.begin() + first, changes.end(), [](const ChangeForReader_t* ch1, const ChangeForReader_t* ch2)
+    {
+        return ch1->getSequenceNumber() < ch2->getSequenceNumber();
+    });
+}
+
 std::vector<const ChangeForReader_t*> ReaderProxy::get_requested_changes() const
 {
-    std::vector<const ChangeForReader_t*> unsent_changes;
+    std::vector<const ChangeForReader_t*> requested_changes;
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    auto it = m_changesForReader.begin();
-    for (; it!= m_changesForReader.end(); ++it)
-        if(it->getStatus() == REQUESTED)
-            unsent_changes.push_back(&(*it));
+    changesForReader_.get_changes(REQUESTED, requested_changes);
 
-    return unsent_changes;
+    return requested_changes;
 }
 
 void ReaderProxy::set_change_to_status(const SequenceNumber_t& seq_num, ChangeForReaderStatus_t status)
@@ -229,28 +246,18 @@ void ReaderProxy::set_change_to_status(const SequenceNumber_t& seq_num, ChangeFo
     if(seq_num <= changesFromRLowMark_)
         return;
 
-    auto it = m_changesForReader.find(ChangeForReader_t(seq_num));
-    bool mustWakeUpAsyncThread = false;
-
-    if(it != m_changesForReader.end())
+    if(changesForReader_.set_status(seq_num, status))
     {
-        if(status == ACKNOWLEDGED && it == m_changesForReader.begin())
+        if(status == ACKNOWLEDGED)
         {
-            m_changesForReader.erase(it);
-            changesFromRLowMark_ = seq_num;
+            // Changes acknowledged after the first one leave the window as soon as all the previous ones are.
+            remove_acknowledged_front_();
         }
-        else
+        else if(status == UNSENT)
         {
-            ChangeForReader_t newch(*it);
-            newch.setStatus(status);
-            if (status == UNSENT) mustWakeUpAsyncThread = true;
-            auto hint = m_changesForReader.erase(it);
-            m_changesForReader.insert(hint, newch);
+            AsyncWriterThread::wakeUp(mp_SFW);
         }
     }
-
-    if (mustWakeUpAsyncThread)
-        AsyncWriterThread::wakeUp(mp_SFW);
 }
 
 bool ReaderProxy::mark_fragment_as_sent_for_change(const CacheChange_t* change, FragmentNumber_t fragment)
@@ -259,22 +266,19 @@ bool ReaderProxy::mark_fragment_as_sent_for_change(const CacheChange_t* change,
         return false;
 
     bool allFragmentsSent = false;
-    auto it = m_changesForReader.find(ChangeForReader_t(change->sequenceNumber));
+    ChangeForReader_t* change_for_reader = changesForReader_.find(change->sequenceNumber);
 
     bool mustWakeUpAsyncThread = false; 
 
-    if(it != m_changesForReader.end())
+    if(change_for_reader != nullptr)
     {
-        ChangeForReader_t newch(*it);
-        newch.markFragmentsAsSent(fragment);
-        if (newch.getUnsentFragments().isSetEmpty())
+        change_for_reader->markFragmentsAsSent(fragment);
+        if (change_for_reader->getUnsentFragments().isSetEmpty())
         {
             allFragmentsSent = true;
         }
         else
             mustWakeUpAsyncThread = true;
-        auto hint = m_changesForReader.erase(it);
-        m_changesForReader.insert(hint, newch);
     }
 
     if (mustWakeUpAsyncThread)
@@ -286,33 +290,18 @@ bool ReaderProxy::mark_fragment_as_sent_for_change(const CacheChange_t* change,
 void ReaderProxy::convert_status_on_all_changes(ChangeForReaderStatus_t previous, ChangeForReaderStatus_t next)
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
-    bool mustWakeUpAsyncThread = false;
 
-    auto it = m_changesForReader.begin();
-    while(it != m_changesForReader.end())
-    {
-        if(it->getStatus() == previous)
-        {
-            if(next == ACKNOWLEDGED && it == m_changesForReader.begin())
-            {
-                changesFromRLowMark_ = it->getSequenceNumber();
-                it = m_changesForReader.erase(it);
-                continue;
-            }
-            else
-            {
-                // Note: we can perform this cast as we are not touching the sorting field (seq_num)
-                const_cast<ChangeForReader_t&>(*it).setStatus(next);
-                if (next == UNSENT && previous != UNSENT)
-                    mustWakeUpAsyncThread = true;
-            }
-        }
+    if(changesForReader_.convert_status(previous, next) == 0)
+        return;
 
-        ++it;
+    if(next == ACKNOWLEDGED)
+    {
+        remove_acknowledged_front_();
     }
-
-    if (mustWakeUpAsyncThread)
+    else if(next == UNSENT && previous != UNSENT)
+    {
         AsyncWriterThread::wakeUp(mp_SFW);
+    }
 }
 
 //TODO(Ricardo)
@@ -322,51 +311,70 @@ void ReaderProxy::setNotValid(CacheChange_t* change)
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
     // Check sequence number is in the container, because it was not clean up.
-    if(m_changesForReader.size() == 0 || change->sequenceNumber < m_changesForReader.begin()->getSequenceNumber())
+    ChangeForReader_t* first = changesForReader_.front();
+    if(first == nullptr || change->sequenceNumber < first->getSequenceNumber())
         return;
 
-    auto chit = m_changesForReader.find(ChangeForReader_t(change));
+    ChangeForReader_t* change_for_reader = changesForReader_.find(change->sequenceNumber);
 
     // Element must be in the container. In other case, bug.
-    assert(chit != m_changesForReader.end());
-
-    // Note: we can perform this cast as we are not touching the sorting field (seq_num)
-    auto & newch = const_cast<ChangeForReader_t&>(*chit);
+    assert(change_for_reader != nullptr);
+    if(change_for_reader == nullptr)
+        return;
 
-    if(chit == m_changesForReader.begin())
+    if(change_for_reader == first)
     {
-        assert(chit->getStatus() != ACKNOWLEDGED);
+        assert(change_for_reader->getStatus() != ACKNOWLEDGED);
 
         // if it is the first element, set state to unacknowledge because from now reader has to confirm
         // it will not be expecting it.
-        // Note: we can perform this cast as we are not touching the sorting field (seq_num)
-        newch.setStatus(UNACKNOWLEDGED);
+        changesForReader_.set_status(change->sequenceNumber, UNACKNOWLEDGED);
     }
     else
     {
         // In case its state is not ACKNOWLEDGED, set it to UNACKNOWLEDGE because from now reader has to confirm
         // it will not be expecting it.
-        if (newch.getStatus() != ACKNOWLEDGED)
-            newch.setStatus(UNACKNOWLEDGED);
+        if (change_for_reader->getStatus() != ACKNOWLEDGED)
+            changesForReader_.set_status(change->sequenceNumber, UNACKNOWLEDGED);
     }
-    newch.notValid();
+    change_for_reader->notValid();
 }
 
-bool ReaderProxy::thereIsUnacknowledged() const
+void ReaderProxy::remove_acknowledged_front_()
 {
-    bool returnedValue = false;
-    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    SequenceNumber_t last_removed = changesForReader_.remove_acknowledged_front();
+    if(last_removed != c_SequenceNumber_Unknown)
+    {
+        set_low_mark_(last_removed);
+        if(changesForReader_.empty())
+            mp_SFW->reader_unacked_changes_changed_nts_(false);
+    }
+}
 
-    for(auto it = m_changesForReader.begin(); it!=m_changesForReader.end(); ++it)
+void ReaderProxy::set_low_mark_(const SequenceNumber_t& low_mark)
+{
+    if(low_mark != changesFromRLowMark_)
     {
-        if(it->getStatus() == UNACKNOWLEDGED)
+        changesFromRLowMark_ = low_mark;
+
+        // Best-effort readers are not tracked by the writer, as their low mark moves on every change sent.
+        if(m_att.endpoint.reliabilityKind == RELIABLE)
         {
-            returnedValue = true;
-            break;
+            mp_SFW->reader_low_mark_changed_nts_(*this);
         }
     }
+}
+
+bool ReaderProxy::thereIsUnacknowledged() const
+{
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    return changesForReader_.has_changes(UNACKNOWLEDGED);
+}
 
-    return returnedValue;
+const ChangeForReader_t* ReaderProxy::first_change()
+{
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    return changesForReader_.front();
 }
 
 bool change_min(const ChangeForReader_t* ch1, const ChangeForReader_t* ch2)
@@ -387,20 +395,15 @@ bool ReaderProxy::requested_fragment_set(SequenceNumber_t sequence_number, const
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
     // Locate the outbound change referenced by the NACK_FRAG
-    auto changeIter = std::find_if(m_changesForReader.begin(), m_changesForReader.end(), 
-            [sequence_number](const ChangeForReader_t& change)
-            {return change.getSequenceNumber() == sequence_number;});
-    if (changeIter == m_changesForReader.end())
+    ChangeForReader_t* change = changesForReader_.find(sequence_number);
+    if (change == nullptr)
         return false;
 
-    ChangeForReader_t newch(*changeIter);
-    auto hint = m_changesForReader.erase(changeIter);
-    newch.markFragmentsAsUnsent(frag_set);
+    change->markFragmentsAsUnsent(frag_set);
 
     // If it was UNSENT, we shouldn't switch back to REQUESTED to prevent stalling.
-    if (newch.getStatus() != UNSENT)
-        newch.setStatus(REQUESTED);
-    m_changesForReader.insert(hint, newch);
+    if (change->getStatus() != UNSENT)
+        changesForReader_.set_status(sequence_number, REQUESTED);
 
     return true;
 }
@@ -31,6 +31,7 @@
 #include <fastrtps/rtps/writer/timedevent/PeriodicHeartbeat.h>
 #include <fastrtps/rtps/writer/timedevent/NackSupressionDuration.h>
 #include <fastrtps/rtps/writer/timedevent/NackResponseDelay.h>
+#include <fastrtps/rtps/writer/timedevent/IntraprocessDelivery.h>
 
 #include <fastrtps/rtps/history/WriterHistory.h>
 
@@ -40,8 +41,10 @@
 #include "RTPSWriterCollector.h"
 #include "StatefulWriterOrganizer.h"
 
+#include <algorithm>
 #include <mutex>
 #include <vector>
+#include <set>
 
 using namespace eprosima::fastrtps::rtps;
 
@@ -50,7 +53,7 @@ StatefulWriter::StatefulWriter(RTPSParticipantImpl* pimpl,GUID_t& guid,
         WriterAttributes& att,WriterHistory* hist,WriterListener* listen):
     RTPSWriter(pimpl, guid, att, hist, listen),
     mp_periodicHB(nullptr), m_times(att.times),
-    all_acked_(false), may_remove_change_(0),
+    all_acked_(false), may_remove_change_(0), best_effort_readers_(0), readers_with_unacked_changes_(0),
     disableHeartbeatPiggyback_(att.disableHeartbeatPiggyback),
     sendBufferSize_(pimpl->get_min_network_send_buffer_size()),
     currentUsageSendBufferSize_(static_cast<int32_t>(pimpl->get_min_network_send_buffer_size()))
@@ -74,6 +77,9 @@ StatefulWriter::~StatefulWriter()
 
     logInfo(RTPS_WRITER,"StatefulWriter destructor");
 
+    if(mp_intraprocessDelivery != nullptr)
+        delete(mp_intraprocessDelivery);
+
     for(std::vector<ReaderProxy*>::iterator it = matched_readers.begin();
             it != matched_readers.end(); ++it)
         (*it)->destroy_timers();
@@ -107,14 +113,20 @@ void StatefulWriter::unsent_change_added_to_history(CacheChange_t* change)
         {
             //TODO(Ricardo) Temporal.
             bool expectsInlineQos = false;
-            std::vector<GUID_t> guids(1);
+            bool has_local_readers = false;
 
             for(auto it = matched_readers.begin(); it != matched_readers.end(); ++it)
             {
                 ChangeForReader_t changeForReader(change);
 
+                if((*it)->is_local_reader())
+                {
+                    // Handed to the reader once all proxies know the change.
+                    changeForReader.setStatus(UNACKNOWLEDGED);
+                    has_local_readers = true;
+                }
                 // TODO(Ricardo) Study next case: Not push mode, writer reliable and reader besteffort.
-                if(m_pushMode)
+                else if(m_pushMode)
                 {
                     if((*it)->m_att.endpoint.reliabilityKind == RELIABLE)
                     {
@@ -133,26 +145,35 @@ void StatefulWriter::unsent_change_added_to_history(CacheChange_t* change)
                 (*it)->mp_mutex->lock();
                 changeForReader.setRelevance((*it)->rtps_is_relevant(change));
                 (*it)->addChange(changeForReader);
-                expectsInlineQos |= (*it)->m_att.expectsInlineQos;
                 (*it)->mp_mutex->unlock();
 
+                if((*it)->is_local_reader())
+                {
+                    continue;
+                }
+
+                expectsInlineQos |= (*it)->m_att.expectsInlineQos;
+
                 if((*it)->mp_nackSupression != nullptr) // It is reliable
                     (*it)->mp_nackSupression->restart_timer();
+            }
 
-                if (m_separateSendingEnabled)
+            if (m_separateSendingEnabled)
+            {
+                // Readers sharing their locators receive the same datagram anyway.
+                for (const ReaderGroupScheduler::Group& reader_group : reader_groups_.groups())
                 {
-                    guids.at(0) = (*it)->m_att.guid;
-                    RTPSMessageGroup group(mp_RTPSParticipant, this, RTPSMessageGroup::WRITER, m_cdrmessages, 
-                        (*it)->m_att.endpoint.remoteLocatorList, guids);
-                    if (!group.add_data(*change, guids, (*it)->m_att.endpoint.remoteLocatorList, (*it)->m_att.expectsInlineQos))
+                    RTPSMessageGroup group(mp_RTPSParticipant, this, RTPSMessageGroup::WRITER, m_cdrmessages,
+                        reader_group.locators, reader_group.guids);
+                    if (!group.add_data(*change, reader_group.guids, reader_group.locators,
+                                reader_group.expects_inline_qos()))
                     {
                         logError(RTPS_WRITER, "Error sending change " << change->sequenceNumber);
                     }
-                    send_heartbeat_piggyback_nts_(guids, (*it)->m_att.endpoint.remoteLocatorList, group);
+                    send_heartbeat_piggyback_nts_(reader_group.guids, reader_group.locators, group);
                 }
             }
-
-            if (!m_separateSendingEnabled)
+            else if (!mAllRemoteReaders.empty())
             {
                 RTPSMessageGroup group(mp_RTPSParticipant, this, RTPSMessageGroup::WRITER, m_cdrmessages);
                 if (!group.add_data(*change, mAllRemoteReaders, mAllShrinkedLocatorList, expectsInlineQos))
@@ -164,6 +185,11 @@ void StatefulWriter::unsent_change_added_to_history(CacheChange_t* change)
                 send_heartbeat_piggyback_nts_(group);
             }
 
+            if (has_local_readers)
+            {
+                local_delivery_pending_nts();
+            }
+
             this->mp_periodicHB->restart_timer();
             if ( (mp_listener != nullptr) && this->is_acked_by_all(change) )
             {
@@ -231,64 +257,16 @@ void StatefulWriter::send_any_unsent_changes()
     //TODO(Mcc) separate sending for asynchronous writers
     if (m_pushMode && m_separateSendingEnabled && isAsync())
     {
-        std::vector<GUID_t> guids(1);
-
         for (auto remoteReader : matched_readers)
         {
-            std::lock_guard<std::recursive_mutex> rguard(*remoteReader->mp_mutex);
-
-            // For possible GAP
-            std::set<SequenceNumber_t> irrelevant;
-
-            // Specific destination message group
-            guids.at(0) = remoteReader->m_att.guid;
-            const LocatorList_t& locators = remoteReader->m_att.endpoint.remoteLocatorList;
-            RTPSMessageGroup group(mp_RTPSParticipant, this, RTPSMessageGroup::WRITER, m_cdrmessages, locators, guids);
-
-            // Loop all changes
-            bool is_reliable = (remoteReader->m_att.endpoint.reliabilityKind == RELIABLE);
-            std::vector<ChangeForReader_t*> unsentChanges = remoteReader->get_unsent_changes();
-            for (auto unsentChange : unsentChanges)
+            if (remoteReader->is_local_reader())
             {
-                SequenceNumber_t seqNum = unsentChange->getSequenceNumber();
-
-                if (unsentChange->isRelevant() && unsentChange->isValid())
-                {
-                    // As we checked we are not async, we know we cannot have fragments
-                    if (group.add_data(*(unsentChange->getChange()), guids, locators, remoteReader->m_att.expectsInlineQos))
-                    {
-                        if (is_reliable)
-                        {
-                            remoteReader->set_change_to_status(seqNum, UNDERWAY);
-                            activateHeartbeatPeriod = true;
-                            assert(remoteReader->mp_nackSupression != nullptr);
-                            remoteReader->mp_nackSupression->restart_timer();
-                        }
-                        else
-                        {
-                            remoteReader->set_change_to_status(seqNum, ACKNOWLEDGED);
-                        }
-                    }
-                    else
-                    {
-                        logError(RTPS_WRITER, "Error sending change " << seqNum);
-                    }
-                }
-                else
-                {
-                    if (is_reliable)
-                    {
-                        irrelevant.emplace(seqNum);
-                    }
-                    remoteReader->set_change_to_status(seqNum, UNDERWAY); //TODO(Ricardo) Review
-                } // Relevance
-            } // Changes loop
-
-            if (!irrelevant.empty())
-            {
-                group.add_gap(irrelevant, guids, locators);
+                local_delivery_pending_nts();
+                break;
             }
-        } // Readers loop
+        }
+
+        activateHeartbeatPeriod |= send_unsent_changes_by_group_nts_();
     }
     else
     {
@@ -298,6 +276,13 @@ void StatefulWriter::send_any_unsent_changes()
 
         for (auto remoteReader : matched_readers)
         {
+            // Readers of this process do not go through the flow controllers.
+            if (remoteReader->is_local_reader())
+            {
+                local_delivery_pending_nts();
+                continue;
+            }
+
             std::lock_guard<std::recursive_mutex> rguard(*remoteReader->mp_mutex);
             std::vector<ChangeForReader_t*> unsentChanges = remoteReader->get_unsent_changes();
 
@@ -334,20 +319,13 @@ void StatefulWriter::send_any_unsent_changes()
 
             RTPSMessageGroup group(mp_RTPSParticipant, this, RTPSMessageGroup::WRITER, m_cdrmessages);
             uint32_t lastBytesProcessed = 0;
+            std::vector<GUID_t> remote_readers;
+            LocatorList_t locators;
 
             while (!relevantChanges.empty())
             {
                 RTPSWriterCollector<ReaderProxy*>::Item changeToSend = relevantChanges.pop();
-                std::vector<GUID_t> remote_readers;
-                std::vector<LocatorList_t> locatorLists;
-                bool expectsInlineQos = false;
-
-                for (auto remoteReader : changeToSend.remoteReaders)
-                {
-                    remote_readers.push_back(remoteReader->m_att.guid);
-                    locatorLists.push_back(remoteReader->m_att.endpoint.remoteLocatorList);
-                    expectsInlineQos |= remoteReader->m_att.expectsInlineQos;
-                }
+                bool expectsInlineQos = get_destinations_nts_(changeToSend.remoteReaders, remote_readers, locators);
 
                 // TODO(Ricardo) Flowcontroller has to be used in RTPSMessageGroup. Study.
                 // And controllers are notified about the changes being sent
@@ -356,8 +334,7 @@ void StatefulWriter::send_any_unsent_changes()
                 if (changeToSend.fragmentNumber != 0)
                 {
                     if (group.add_data_frag(*changeToSend.cacheChange, changeToSend.fragmentNumber, remote_readers,
-                        mp_RTPSParticipant->network_factory().ShrinkLocatorLists(locatorLists),
-                        expectsInlineQos))
+                        locators, expectsInlineQos))
                     {
                         for (auto remoteReader : changeToSend.remoteReaders)
                         {
@@ -391,9 +368,7 @@ void StatefulWriter::send_any_unsent_changes()
                 }
                 else
                 {
-                    if (group.add_data(*changeToSend.cacheChange, remote_readers,
-                        mp_RTPSParticipant->network_factory().ShrinkLocatorLists(locatorLists),
-                        expectsInlineQos))
+                    if (group.add_data(*changeToSend.cacheChange, remote_readers, locators, expectsInlineQos))
                     {
                         for (auto remoteReader : changeToSend.remoteReaders)
                         {
@@ -437,18 +412,10 @@ void StatefulWriter::send_any_unsent_changes()
                 }
             }
 
-            for (auto pair : notRelevantChanges.elements())
+            for (auto& pair : notRelevantChanges.elements())
             {
-                std::vector<GUID_t> remote_readers;
-                std::vector<LocatorList_t> locatorLists;
-
-                for (auto remoteReader : pair.first)
-                {
-                    remote_readers.push_back(remoteReader->m_att.guid);
-                    locatorLists.push_back(remoteReader->m_att.endpoint.remoteLocatorList);
-                }
-                group.add_gap(pair.second, remote_readers,
-                    mp_RTPSParticipant->network_factory().ShrinkLocatorLists(locatorLists));
+                get_destinations_nts_(pair.first, remote_readers, locators);
+                group.add_gap(pair.second, remote_readers, locators);
             }
         }
         else
@@ -467,6 +434,174 @@ void StatefulWriter::send_any_unsent_changes()
     logInfo(RTPS_WRITER, "Finish sending unsent changes");
 }
 
+/*!
+ * Readers of a group with the same unsent changes, which are sent to all of them in the same messages.
+ */
+struct UnsentChangesBatch
+{
+    std::vector<ReaderProxy*> readers;
+    std::vector<GUID_t> guids;
+    //! Unsent changes of the first reader. The other ones have the same sequence numbers and relevance.
+    std::vector<ChangeForReader_t*> changes;
+    bool is_reliable;
+    bool expects_inline_qos;
+};
+
+static bool is_sendable(const ChangeForReader_t* change)
+{
+    return change->isRelevant() && change->isValid();
+}
+
+static bool has_same_unsent_changes(const UnsentChangesBatch& batch, const ReaderProxy& reader,
+        const std::vector<ChangeForReader_t*>& changes)
+{
+    if (batch.is_reliable != (reader.m_att.endpoint.reliabilityKind == RELIABLE) ||
+            batch.changes.size() != changes.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < changes.size(); ++i)
+    {
+        if (batch.changes[i]->getSequenceNumber() != changes[i]->getSequenceNumber() ||
+                is_sendable(batch.changes[i]) != is_sendable(changes[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool StatefulWriter::send_unsent_changes_by_group_nts_()
+{
+    bool activateHeartbeatPeriod = false;
+    std::vector<UnsentChangesBatch> batches;
+    std::vector<ChangeForReader_t*> unsentChanges;
+
+    for (const ReaderGroupScheduler::Group& reader_group : reader_groups_.groups())
+    {
+        // Readers of the group are batched by their unsent changes, usually all of them having the same ones.
+        batches.clear();
+        for (ReaderProxy* remoteReader : reader_group.readers)
+        {
+            unsentChanges.clear();
+            remoteReader->get_unsent_changes(unsentChanges);
+            if (unsentChanges.empty())
+            {
+                continue;
+            }
+
+            auto batch = std::find_if(batches.begin(), batches.end(),
+                    [&](const UnsentChangesBatch& b) { return has_same_unsent_changes(b, *remoteReader, unsentChanges); });
+            if (batch == batches.end())
+            {
+                batches.emplace_back();
+                batch = batches.end() - 1;
+                batch->changes.swap(unsentChanges);
+                batch->is_reliable = remoteReader->m_att.endpoint.reliabilityKind == RELIABLE;
+                batch->expects_inline_qos = false;
+            }
+            batch->readers.push_back(remoteReader);
+            batch->guids.push_back(remoteReader->m_att.guid);
+            batch->expects_inline_qos |= remoteReader->m_att.expectsInlineQos;
+        }
+
+        for (UnsentChangesBatch& batch : batches)
+        {
+            // For possible GAP
+            std::set<SequenceNumber_t> irrelevant;
+
+            // Specific destination message group
+            RTPSMessageGroup group(mp_RTPSParticipant, this, RTPSMessageGroup::WRITER, m_cdrmessages,
+                reader_group.locators, batch.guids);
+
+            for (ChangeForReader_t* unsentChange : batch.changes)
+            {
+                SequenceNumber_t seqNum = unsentChange->getSequenceNumber();
+                ChangeForReaderStatus_t status = UNDERWAY;
+
+                if (is_sendable(unsentChange))
+                {
+                    // As we checked we are not async, we know we cannot have fragments
+                    if (!group.add_data(*(unsentChange->getChange()), batch.guids, reader_group.locators,
+                                batch.expects_inline_qos))
+                    {
+                        logError(RTPS_WRITER, "Error sending change " << seqNum);
+                        continue;
+                    }
+
+                    if (batch.is_reliable)
+                    {
+                        activateHeartbeatPeriod = true;
+                    }
+                    else
+                    {
+                        status = ACKNOWLEDGED;
+                    }
+                }
+                else if (batch.is_reliable)
+                {
+                    irrelevant.emplace(seqNum);
+                }
+
+                for (ReaderProxy* remoteReader : batch.readers)
+                {
+                    std::lock_guard<std::recursive_mutex> rguard(*remoteReader->mp_mutex);
+                    remoteReader->set_change_to_status(seqNum, status);
+                    if (status == UNDERWAY && is_sendable(unsentChange))
+                    {
+                        assert(remoteReader->mp_nackSupression != nullptr);
+                        remoteReader->mp_nackSupression->restart_timer();
+                    }
+                }
+            } // Changes loop
+
+            if (!irrelevant.empty())
+            {
+                group.add_gap(irrelevant, batch.guids, reader_group.locators);
+            }
+        } // Batches loop
+    } // Groups loop
+
+    return activateHeartbeatPeriod;
+}
+
+bool StatefulWriter::get_destinations_nts_(const std::vector<ReaderProxy*>& readers,
+        std::vector<GUID_t>& remote_readers, LocatorList_t& locators)
+{
+    remote_readers.clear();
+
+    // Every remote reader, whose locators are already shrunk.
+    if (readers.size() == mAllRemoteReaders.size())
+    {
+        remote_readers.assign(mAllRemoteReaders.begin(), mAllRemoteReaders.end());
+        locators = mAllShrinkedLocatorList;
+        return reader_groups_.expects_inline_qos();
+    }
+
+    const std::vector<ReaderGroupScheduler::Group>& groups = reader_groups_.groups();
+    std::vector<bool> group_added(groups.size(), false);
+    std::vector<LocatorList_t> locatorLists;
+    bool expectsInlineQos = false;
+
+    for (ReaderProxy* remoteReader : readers)
+    {
+        remote_readers.push_back(remoteReader->m_att.guid);
+        expectsInlineQos |= remoteReader->m_att.expectsInlineQos;
+
+        size_t position = reader_groups_.group_of(remoteReader);
+        assert(position < groups.size());
+        if (!group_added[position])
+        {
+            group_added[position] = true;
+            locatorLists.push_back(groups[position].locators);
+        }
+    }
+
+    locators = mp_RTPSParticipant->network_factory().ShrinkLocatorLists(locatorLists);
+    return expectsInlineQos;
+}
 
 /*
  *	MATCHED_READER-RELATED METHODS
@@ -494,15 +629,25 @@ bool StatefulWriter::matched_reader_add(RemoteReaderAttributes& rdata)
             return false;
         }
 
+        if((*it)->is_local_reader())
+        {
+            continue;
+        }
+
         allRemoteReaders.push_back((*it)->m_att.guid);
         allLocatorLists.push_back((*it)->m_att.endpoint.remoteLocatorList);
     }
 
+    bool is_local = is_local_reader(rdata.guid);
+
     // Add info of new datareader.
-    allRemoteReaders.push_back(rdata.guid);
-    LocatorList_t locators(rdata.endpoint.unicastLocatorList);
-    locators.push_back(rdata.endpoint.multicastLocatorList);
-    allLocatorLists.push_back(locators);
+    if(!is_local)
+    {
+        allRemoteReaders.push_back(rdata.guid);
+        LocatorList_t locators(rdata.endpoint.unicastLocatorList);
+        locators.push_back(rdata.endpoint.multicastLocatorList);
+        allLocatorLists.push_back(locators);
+    }
 
     update_cached_info_nts(std::move(allRemoteReaders), allLocatorLists);
 
@@ -512,6 +657,15 @@ bool StatefulWriter::matched_reader_add(RemoteReaderAttributes& rdata)
         mp_RTPSParticipant->network_factory().ShrinkLocatorLists({rdata.endpoint.unicastLocatorList});
 
     ReaderProxy* rp = new ReaderProxy(rdata, m_times, this);
+    rp->set_local_reader(is_local);
+    if(rp->m_att.endpoint.reliabilityKind == RELIABLE)
+    {
+        push_low_mark_nts_(rp);
+    }
+    else
+    {
+        ++best_effort_readers_;
+    }
     std::set<SequenceNumber_t> not_relevant_changes;
 
     SequenceNumber_t current_seq = get_seq_num_min();
@@ -557,6 +711,17 @@ bool StatefulWriter::matched_reader_add(RemoteReaderAttributes& rdata)
 
         assert(last_seq + 1 == current_seq);
 
+        if(is_local)
+        {
+            matched_readers.push_back(rp);
+            local_delivery_pending_nts();
+
+            logInfo(RTPS_WRITER, "Local Reader Proxy " << rp->m_att.guid << " added to " << this->m_guid.entityId);
+
+            check_acked_status();
+            return true;
+        }
+
         std::vector<GUID_t> guids(1, rp->m_att.guid);
         const LocatorList_t& locatorsList = rp->m_att.endpoint.remoteLocatorList;
         RTPSMessageGroup group(mp_RTPSParticipant, this, RTPSMessageGroup::WRITER, m_cdrmessages, locatorsList, guids);
@@ -574,12 +739,17 @@ bool StatefulWriter::matched_reader_add(RemoteReaderAttributes& rdata)
         // The state has to be updated.
         this->mp_periodicHB->restart_timer();
     }
-    else
+    else if(!is_local)
     {
         send_heartbeat_to_nts(*rp, false);
     }
 
     matched_readers.push_back(rp);
+    if(!is_local)
+    {
+        reader_groups_.add_reader(rp, rp->m_att.guid, rp->m_att.endpoint.remoteLocatorList,
+                rp->m_att.expectsInlineQos);
+    }
 
     logInfo(RTPS_WRITER, "Reader Proxy "<< rp->m_att.guid<< " added to " << this->m_guid.entityId << " with "
             <<rp->m_att.endpoint.unicastLocatorList.size()<<"(u)-"
@@ -607,6 +777,23 @@ bool StatefulWriter::matched_reader_remove(const RemoteReaderAttributes& rdata)
             rproxy = std::move(*it);
             it = matched_readers.erase(it);
 
+            if(rproxy->m_att.endpoint.reliabilityKind == RELIABLE)
+            {
+                erase_low_mark_nts_(rproxy);
+            }
+            else
+            {
+                --best_effort_readers_;
+            }
+            if(rproxy->countChangesForReader() > 0)
+                --readers_with_unacked_changes_;
+
+            continue;
+        }
+
+        if((*it)->is_local_reader())
+        {
+            ++it;
             continue;
         }
 
@@ -617,6 +804,9 @@ bool StatefulWriter::matched_reader_remove(const RemoteReaderAttributes& rdata)
 
     update_cached_info_nts(std::move(allRemoteReaders), allLocatorLists);
 
+    if(rproxy != nullptr)
+        reader_groups_.remove_reader(rproxy);
+
     if(matched_readers.size()==0)
         this->mp_periodicHB->cancel_timer();
 
@@ -675,6 +865,13 @@ bool StatefulWriter::is_acked_by_all(const CacheChange_t* change) const
         return false;
     }
 
+    SequenceNumber_t low_mark = acked_by_all_low_mark_nts_();
+    if(low_mark == SequenceNumber_t::unknown() || change->sequenceNumber <= low_mark)
+    {
+        return true;
+    }
+
+    // Changes after the low mark may have been acknowledged out of order, or not be relevant to some readers.
     for(auto it = matched_readers.begin(); it!=matched_readers.end(); ++it)
     {
         if(!(*it)->change_is_acked(change->sequenceNumber))
@@ -691,17 +888,7 @@ bool StatefulWriter::wait_for_all_acked(const Duration_t& max_wait)
     std::unique_lock<std::recursive_mutex> lock(*mp_mutex);
     std::unique_lock<std::mutex> all_acked_lock(all_acked_mutex_);
 
-    all_acked_ = true;
-
-    for(auto it = matched_readers.begin(); it != matched_readers.end(); ++it)
-    {
-        std::lock_guard<std::recursive_mutex> rguard(*(*it)->mp_mutex);
-        if((*it)->countChangesForReader() > 0)
-        {
-            all_acked_ = false;
-            break;
-        }
-    }
+    all_acked_ = readers_with_unacked_changes_ == 0;
     lock.unlock();
 
     if(!all_acked_)
@@ -713,45 +900,128 @@ bool StatefulWriter::wait_for_all_acked(const Duration_t& max_wait)
     return all_acked_;
 }
 
-void StatefulWriter::check_acked_status()
+SequenceNumber_t StatefulWriter::acked_by_all_low_mark_nts_() const
 {
-    std::unique_lock<std::recursive_mutex> lock(*mp_mutex);
+    SequenceNumber_t low_mark = reliable_low_marks_.empty() ?
+        SequenceNumber_t::unknown() : reliable_low_marks_.front()->get_low_mark();
 
-    bool all_acked = true;
-    SequenceNumber_t min_low_mark;
+    if(best_effort_readers_ > 0)
+    {
+        for(const ReaderProxy* reader : matched_readers)
+        {
+            if(reader->m_att.endpoint.reliabilityKind != RELIABLE &&
+                    (low_mark == SequenceNumber_t::unknown() || reader->get_low_mark() < low_mark))
+            {
+                low_mark = reader->get_low_mark();
+            }
+        }
+    }
+
+    return low_mark;
+}
 
+void StatefulWriter::reader_low_mark_changed_nts_(ReaderProxy& reader)
+{
+    assert(reader.low_mark_index_ < reliable_low_marks_.size());
+    assert(reliable_low_marks_[reader.low_mark_index_] == &reader);
+    fix_low_mark_nts_(reader.low_mark_index_);
+}
+
+void StatefulWriter::push_low_mark_nts_(ReaderProxy* reader)
+{
+    reader->low_mark_index_ = reliable_low_marks_.size();
+    reliable_low_marks_.push_back(reader);
+    fix_low_mark_nts_(reader->low_mark_index_);
+}
+
+void StatefulWriter::erase_low_mark_nts_(ReaderProxy* reader)
+{
+    size_t index = reader->low_mark_index_;
+    assert(index < reliable_low_marks_.size() && reliable_low_marks_[index] == reader);
 
-    for(auto it = matched_readers.begin(); it != matched_readers.end(); ++it)
+    // The last reader takes its place, and then goes wherever its low mark belongs.
+    swap_low_marks_nts_(index, reliable_low_marks_.size() - 1);
+    reliable_low_marks_.pop_back();
+    if(index < reliable_low_marks_.size())
     {
-        std::lock_guard<std::recursive_mutex> rguard(*(*it)->mp_mutex);
+        fix_low_mark_nts_(index);
+    }
+}
 
-        if(min_low_mark == SequenceNumber_t() || (*it)->get_low_mark() < min_low_mark)
+void StatefulWriter::fix_low_mark_nts_(size_t index)
+{
+    while(index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if(!(reliable_low_marks_[index]->get_low_mark() < reliable_low_marks_[parent]->get_low_mark()))
         {
-            min_low_mark = (*it)->get_low_mark();
+            break;
         }
+        swap_low_marks_nts_(index, parent);
+        index = parent;
+    }
 
-        if((*it)->countChangesForReader() > 0)
+    for(;;)
+    {
+        size_t lowest = index;
+        size_t child = 2 * index + 1;
+        for(size_t last = std::min(child + 2, reliable_low_marks_.size()); child < last; ++child)
         {
-            all_acked = false;
+            if(reliable_low_marks_[child]->get_low_mark() < reliable_low_marks_[lowest]->get_low_mark())
+            {
+                lowest = child;
+            }
         }
+
+        if(lowest == index)
+        {
+            break;
+        }
+        swap_low_marks_nts_(index, lowest);
+        index = lowest;
+    }
+}
+
+void StatefulWriter::swap_low_marks_nts_(size_t first, size_t second)
+{
+    std::swap(reliable_low_marks_[first], reliable_low_marks_[second]);
+    reliable_low_marks_[first]->low_mark_index_ = first;
+    reliable_low_marks_[second]->low_mark_index_ = second;
+}
+
+void StatefulWriter::reader_unacked_changes_changed_nts_(bool has_unacked_changes)
+{
+    if(has_unacked_changes)
+    {
+        ++readers_with_unacked_changes_;
+    }
+    else
+    {
+        assert(readers_with_unacked_changes_ > 0);
+        --readers_with_unacked_changes_;
+    }
+}
+
+void StatefulWriter::check_acked_status()
+{
+    std::unique_lock<std::recursive_mutex> lock(*mp_mutex);
+
+    SequenceNumber_t min_low_mark = acked_by_all_low_mark_nts_();
+    if(min_low_mark == SequenceNumber_t::unknown())
+    {
+        min_low_mark = SequenceNumber_t();
     }
 
     if(get_seq_num_min() != SequenceNumber_t::unknown())
     {
-        // Inform of samples acked.
+        // Inform of samples acked. History is ordered, so they are the first ones.
         if(mp_listener != nullptr)
         {
             std::vector<CacheChange_t*> all_acked_changes;
-            for(SequenceNumber_t current_seq = get_seq_num_min(); current_seq <= min_low_mark; ++current_seq)
+            for(std::vector<CacheChange_t*>::iterator cit = mp_history->changesBegin();
+                    cit != mp_history->changesEnd() && (*cit)->sequenceNumber <= min_low_mark; ++cit)
             {
-                for(std::vector<CacheChange_t*>::iterator cit = mp_history->changesBegin();
-                        cit != mp_history->changesEnd(); ++cit)
-                {
-                    if((*cit)->sequenceNumber == current_seq)
-                    {
-                        all_acked_changes.push_back(*cit);
-                    }
-                }
+                all_acked_changes.push_back(*cit);
             }
             for(auto cit = all_acked_changes.begin(); cit != all_acked_changes.end(); ++cit)
             {
@@ -759,9 +1029,7 @@ void StatefulWriter::check_acked_status()
             }
         }
 
-        SequenceNumber_t calc = min_low_mark < get_seq_num_min() ? SequenceNumber_t() :
-            (min_low_mark - get_seq_num_min()) + 1;
-        if (calc > SequenceNumber_t())
+        if(!(min_low_mark < get_seq_num_min()))
         {
             std::unique_lock<std::mutex> may_lock(may_remove_change_mutex_);
             may_remove_change_ = 1;
@@ -769,7 +1037,7 @@ void StatefulWriter::check_acked_status()
         }
     }
 
-    if(all_acked)
+    if(readers_with_unacked_changes_ == 0)
     {
         std::unique_lock<std::mutex> all_acked_lock(all_acked_mutex_);
         all_acked_ = true;
@@ -782,16 +1050,10 @@ bool StatefulWriter::try_remove_change(std::chrono::microseconds& microseconds,
 {
     logInfo(RTPS_WRITER, "Starting process try remove change for writer " << getGuid());
 
-    SequenceNumber_t min_low_mark;
-
-    for(auto it = matched_readers.begin(); it != matched_readers.end(); ++it)
+    SequenceNumber_t min_low_mark = acked_by_all_low_mark_nts_();
+    if(min_low_mark == SequenceNumber_t::unknown())
     {
-        std::lock_guard<std::recursive_mutex> rguard(*(*it)->mp_mutex);
-
-        if(min_low_mark == SequenceNumber_t() || (*it)->get_low_mark() < min_low_mark)
-        {
-            min_low_mark = (*it)->get_low_mark();
-        }
+        min_low_mark = SequenceNumber_t();
     }
 
     SequenceNumber_t calc = min_low_mark < get_seq_num_min() ? SequenceNumber_t() :
@@ -897,6 +1159,47 @@ void StatefulWriter::send_heartbeat_to_nts(ReaderProxy& remoteReaderProxy, bool
     send_heartbeat_nts_(tmp_guids, locators, group, final);
 }
 
+bool StatefulWriter::send_periodic_heartbeat_nts(RTPSMessageGroup& message_group)
+{
+    bool unacked_changes = false;
+
+    if(m_separateSendingEnabled)
+    {
+        std::vector<GUID_t> remote_reader(1);
+        for(ReaderProxy* remoteReaderProxy : matched_readers)
+        {
+            if(!remoteReaderProxy->is_local_reader() && remoteReaderProxy->thereIsUnacknowledged())
+            {
+                remote_reader[0] = remoteReaderProxy->m_att.guid;
+                send_heartbeat_nts_(remote_reader, remoteReaderProxy->m_att.endpoint.remoteLocatorList,
+                        message_group);
+                unacked_changes = true;
+            }
+        }
+    }
+    else
+    {
+        unacked_changes = std::any_of(matched_readers.begin(), matched_readers.end(),
+                [](ReaderProxy* remoteReaderProxy)
+                {
+                    return !remoteReaderProxy->is_local_reader() && remoteReaderProxy->thereIsUnacknowledged();
+                });
+
+        // Nothing to announce when the history is empty.
+        if(unacked_changes && get_seq_num_min() == c_SequenceNumber_Unknown)
+        {
+            unacked_changes = false;
+        }
+
+        if(unacked_changes)
+        {
+            send_heartbeat_nts_(mAllRemoteReaders, mAllShrinkedLocatorList, message_group);
+        }
+    }
+
+    return unacked_changes;
+}
+
 void StatefulWriter::send_heartbeat_nts_(const std::vector<GUID_t>& remote_readers, const LocatorList_t &locators,
         RTPSMessageGroup& message_group, bool final)
 {
@@ -971,6 +1274,12 @@ void StatefulWriter::process_acknack(const GUID_t reader_guid, uint32_t ack_coun
 
         if(remote_reader->m_att.guid == reader_guid)
         {
+            // Changes handed directly to the reader are acknowledged on delivery.
+            if(remote_reader->is_local_reader())
+            {
+                break;
+            }
+
             if(remote_reader->m_lastAcknackCount < ack_count)
             {
                 remote_reader->m_lastAcknackCount = ack_count;
@@ -978,8 +1287,7 @@ void StatefulWriter::process_acknack(const GUID_t reader_guid, uint32_t ack_coun
                 {
                     // Sequence numbers before Base are set as Acknowledged.
                     remote_reader->acked_changes_set(sn_set.base);
-                    std::vector<SequenceNumber_t> set_vec = sn_set.get_set();
-                    if (remote_reader->requested_changes_set(set_vec) && remote_reader->mp_nackResponse != nullptr)
+                    if (remote_reader->requested_changes_set(sn_set) && remote_reader->mp_nackResponse != nullptr)
                     {
                         remote_reader->mp_nackResponse->restart_timer();
                     }
@@ -1001,3 +1309,134 @@ void StatefulWriter::process_acknack(const GUID_t reader_guid, uint32_t ack_coun
         }
     }
 }
+
+void StatefulWriter::send_changes_to_local_readers()
+{
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+
+    for(auto remote_reader : matched_readers)
+    {
+        if(remote_reader->is_local_reader())
+        {
+            local_delivery_pending_nts();
+            return;
+        }
+    }
+}
+
+void StatefulWriter::collect_local_deliveries_nts(std::vector<LocalDelivery>& deliveries)
+{
+    for(auto remote_reader : matched_readers)
+    {
+        if(!remote_reader->is_local_reader())
+        {
+            continue;
+        }
+
+        std::lock_guard<std::recursive_mutex> rguard(*remote_reader->mp_mutex);
+
+        local_changes_.clear();
+        remote_reader->get_unacknowledged_changes(local_changes_);
+        if(local_changes_.empty())
+        {
+            continue;
+        }
+
+        LocalDelivery delivery;
+        delivery.reader_guid = remote_reader->m_att.guid;
+        delivery.change = nullptr;
+        delivery.count = 0;
+        delivery.in_order = remote_reader->m_att.endpoint.reliabilityKind == RELIABLE;
+        delivery.delivered = false;
+
+        // A late joiner has to learn which previous changes it will never receive.
+        if(!remote_reader->local_reader_synchronized())
+        {
+            incrementHBCount();
+            delivery.kind = LocalDelivery::HEARTBEAT;
+            delivery.seq_num = local_changes_.front()->getSequenceNumber();
+            delivery.count = m_heartbeatCount;
+            deliveries.push_back(delivery);
+            delivery.count = 0;
+        }
+
+        for(ChangeForReader_t* change_for_reader : local_changes_)
+        {
+            delivery.seq_num = change_for_reader->getSequenceNumber();
+
+            if(change_for_reader->isRelevant() && change_for_reader->isValid())
+            {
+                delivery.kind = LocalDelivery::DATA;
+                delivery.change = change_for_reader->getChange();
+                mp_history->loan_change(delivery.change);
+            }
+            else
+            {
+                delivery.kind = LocalDelivery::GAP;
+                delivery.change = nullptr;
+            }
+
+            deliveries.push_back(delivery);
+        }
+    }
+}
+
+void StatefulWriter::local_deliveries_done_nts(const std::vector<LocalDelivery>& deliveries)
+{
+    if(deliveries.empty())
+    {
+        return;
+    }
+
+    bool pending_changes = false;
+    GUID_t reader_guid = c_Guid_Unknown;
+    ReaderProxy* remote_reader = nullptr;
+
+    // Deliveries to the same reader are consecutive.
+    for(const LocalDelivery& delivery : deliveries)
+    {
+        if(delivery.reader_guid != reader_guid)
+        {
+            reader_guid = delivery.reader_guid;
+            auto it = std::find_if(matched_readers.begin(), matched_readers.end(),
+                    [&reader_guid](const ReaderProxy* proxy)
+                    {
+                        return proxy->m_att.guid == reader_guid;
+                    });
+            // The reader may have been unmatched meanwhile.
+            remote_reader = it != matched_readers.end() ? *it : nullptr;
+        }
+
+        if(remote_reader == nullptr)
+        {
+            continue;
+        }
+
+        std::lock_guard<std::recursive_mutex> rguard(*remote_reader->mp_mutex);
+
+        if(delivery.kind == LocalDelivery::HEARTBEAT)
+        {
+            if(delivery.delivered)
+            {
+                remote_reader->set_local_reader_synchronized();
+            }
+        }
+        else if(delivery.delivered || !delivery.in_order)
+        {
+            remote_reader->set_change_to_status(delivery.seq_num, ACKNOWLEDGED);
+        }
+        else
+        {
+            logInfo(RTPS_WRITER, "Change " << delivery.seq_num << " not accepted yet by local reader " << reader_guid);
+            pending_changes = true;
+        }
+    }
+
+    // Readers of this process do not answer heartbeats. The changes are retried on the next one.
+    if(pending_changes)
+    {
+        mp_periodicHB->restart_timer();
+    }
+
+    check_acked_status();
+}
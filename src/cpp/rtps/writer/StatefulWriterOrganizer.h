@@ -51,7 +51,7 @@ class StatefulWriterOrganizer
 
                 bool inserted = false;
 
-                for(auto pair : mElements_)
+                for(auto& pair : mElements_)
                 {
                     if(pair.second == mLastSeqList_)
                     {
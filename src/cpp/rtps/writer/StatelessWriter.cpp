@@ -21,10 +21,12 @@
 #include <fastrtps/rtps/writer/WriterListener.h>
 #include <fastrtps/rtps/history/WriterHistory.h>
 #include <fastrtps/rtps/resources/AsyncWriterThread.h>
+#include <fastrtps/rtps/writer/timedevent/IntraprocessDelivery.h>
 #include "../participant/RTPSParticipantImpl.h"
 #include "../flowcontrol/FlowController.h"
 #include "RTPSWriterCollector.h"
 
+#include <algorithm>
 #include <mutex>
 #include <vector>
 #include <set>
@@ -46,6 +48,10 @@ StatelessWriter::StatelessWriter(RTPSParticipantImpl* pimpl,GUID_t& guid,
 StatelessWriter::~StatelessWriter()
 {
     AsyncWriterThread::removeWriter(*this);
+
+    if(mp_intraprocessDelivery != nullptr)
+        delete(mp_intraprocessDelivery);
+
     logInfo(RTPS_WRITER,"StatelessWriter destructor";);
 }
 
@@ -71,13 +77,27 @@ void StatelessWriter::unsent_change_added_to_history(CacheChange_t* cptr)
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    if (!reader_locators.empty())
+    if (!reader_locators.empty() || !m_local_readers.empty())
     {
 #if HAVE_SECURITY
         encrypt_cachechange(cptr);
 #endif
 
-        if (!isAsync())
+        // Readers of this process get the change as soon as the writer mutex is released, also on asynchronous
+        // writers.
+        for (const GUID_t& reader_guid : m_local_readers)
+        {
+            queue_local_delivery_nts(cptr, reader_guid);
+        }
+
+        if (reader_locators.empty())
+        {
+            if (mp_listener != nullptr)
+            {
+                mp_listener->onWriterChangeReceivedByAll(this, cptr);
+            }
+        }
+        else if (!isAsync())
         {
             this->setLivelinessAsserted(true);
 
@@ -86,6 +106,11 @@ void StatelessWriter::unsent_change_added_to_history(CacheChange_t* cptr)
                 std::vector<GUID_t> guids(1);
                 for (auto it = m_matched_readers.begin(); it != m_matched_readers.end(); ++it)
                 {
+                    if (is_local_matched_reader_nts_(it->guid))
+                    {
+                        continue;
+                    }
+
                     guids.at(0) = it->guid;
                     RTPSMessageGroup group(mp_RTPSParticipant, this, RTPSMessageGroup::WRITER, m_cdrmessages,
                         it->endpoint.unicastLocatorList, guids);
@@ -289,6 +314,9 @@ bool StatelessWriter::matched_reader_add(RemoteReaderAttributes& rdata)
             return false;
         }
 
+        if(is_local_matched_reader_nts_((*it).guid))
+            continue;
+
         if(addGuid)
             allRemoteReaders.push_back((*it).guid);
         LocatorList_t locators((*it).endpoint.unicastLocatorList);
@@ -296,18 +324,39 @@ bool StatelessWriter::matched_reader_add(RemoteReaderAttributes& rdata)
         allLocatorLists.push_back(locators);
     }
 
+    bool is_local = is_local_reader(rdata.guid);
+
     // Add info of new datareader.
-    if(addGuid)
-        allRemoteReaders.push_back(rdata.guid);
-    LocatorList_t locators(rdata.endpoint.unicastLocatorList);
-    locators.push_back(rdata.endpoint.multicastLocatorList);
-    allLocatorLists.push_back(locators);
+    if(!is_local)
+    {
+        if(addGuid)
+            allRemoteReaders.push_back(rdata.guid);
+        LocatorList_t locators(rdata.endpoint.unicastLocatorList);
+        locators.push_back(rdata.endpoint.multicastLocatorList);
+        allLocatorLists.push_back(locators);
+    }
 
     update_cached_info_nts(std::move(allRemoteReaders), allLocatorLists);
 
     this->m_matched_readers.push_back(rdata);
 
-    update_locators_nts_(rdata.endpoint.durabilityKind >= TRANSIENT_LOCAL ? rdata.guid : c_Guid_Unknown);
+    if(is_local)
+    {
+        m_local_readers.push_back(rdata.guid);
+        update_locators_nts_(c_Guid_Unknown);
+
+        if(rdata.endpoint.durabilityKind >= TRANSIENT_LOCAL)
+        {
+            for(auto cit = mp_history->changesBegin(); cit != mp_history->changesEnd(); ++cit)
+            {
+                queue_local_delivery_nts(*cit, rdata.guid);
+            }
+        }
+    }
+    else
+    {
+        update_locators_nts_(rdata.endpoint.durabilityKind >= TRANSIENT_LOCAL ? rdata.guid : c_Guid_Unknown);
+    }
 
     getRTPSParticipant()->createSenderResources(mAllShrinkedLocatorList, false);
 
@@ -391,6 +440,9 @@ void StatelessWriter::update_locators_nts_(const GUID_t& optionalGuid)
         // Find guids
         for(auto remoteReader = m_matched_readers.begin(); remoteReader != m_matched_readers.end(); ++remoteReader)
         {
+            if(is_local_matched_reader_nts_(remoteReader->guid))
+                continue;
+
             bool found = false;
 
             for(auto loc = remoteReader->endpoint.unicastLocatorList.begin(); loc != remoteReader->endpoint.unicastLocatorList.end(); ++loc)
@@ -443,6 +495,12 @@ bool StatelessWriter::matched_reader_remove(const RemoteReaderAttributes& rdata)
             continue;
         }
 
+        if(is_local_matched_reader_nts_((*rit).guid))
+        {
+            ++rit;
+            continue;
+        }
+
         if(addGuid)
             allRemoteReaders.push_back((*rit).guid);
         LocatorList_t locators((*rit).endpoint.unicastLocatorList);
@@ -451,6 +509,10 @@ bool StatelessWriter::matched_reader_remove(const RemoteReaderAttributes& rdata)
         ++rit;
     }
 
+    m_local_readers.erase(std::remove(m_local_readers.begin(), m_local_readers.end(), rdata.guid),
+            m_local_readers.end());
+    unqueue_local_deliveries_nts(rdata.guid);
+
     update_cached_info_nts(std::move(allRemoteReaders), allLocatorLists);
 
     update_locators_nts_(c_Guid_Unknown);
@@ -458,6 +520,11 @@ bool StatelessWriter::matched_reader_remove(const RemoteReaderAttributes& rdata)
     return found;
 }
 
+bool StatelessWriter::is_local_matched_reader_nts_(const GUID_t& reader_guid) const
+{
+    return std::find(m_local_readers.begin(), m_local_readers.end(), reader_guid) != m_local_readers.end();
+}
+
 bool StatelessWriter::matched_reader_is_matched(const RemoteReaderAttributes& rdata)
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
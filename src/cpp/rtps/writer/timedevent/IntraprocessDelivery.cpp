@@ -0,0 +1,66 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file IntraprocessDelivery.cpp
+ *
+ */
+
+#include <fastrtps/rtps/writer/timedevent/IntraprocessDelivery.h>
+#include <fastrtps/rtps/resources/ResourceEvent.h>
+#include <fastrtps/rtps/writer/RTPSWriter.h>
+#include "../../participant/RTPSParticipantImpl.h"
+
+#include <fastrtps/log/Log.h>
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps {
+
+
+IntraprocessDelivery::~IntraprocessDelivery()
+{
+    destroy();
+}
+
+IntraprocessDelivery::IntraprocessDelivery(RTPSWriter* p_SW):
+TimedEvent(p_SW->getRTPSParticipant()->getEventResource().getIOService(),
+p_SW->getRTPSParticipant()->getEventResource().getThread(), 0),
+mp_RTPSWriter(p_SW)
+{
+
+}
+
+void IntraprocessDelivery::event(EventCode code, const char* msg)
+{
+
+    // Unused in release mode.
+    (void)msg;
+
+    if(code == EVENT_SUCCESS)
+    {
+        mp_RTPSWriter->deliver_to_local_readers();
+    }
+    else if(code == EVENT_ABORT)
+    {
+        logInfo(RTPS_WRITER,"Aborted");
+    }
+    else
+    {
+        logInfo(RTPS_WRITER,"Event message: " <<msg);
+    }
+}
+}
+} /* namespace dds */
+} /* namespace eprosima */
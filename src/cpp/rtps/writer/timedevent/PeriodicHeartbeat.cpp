@@ -24,6 +24,7 @@
 #include <fastrtps/rtps/writer/ReaderProxy.h>
 
 #include "../../participant/RTPSParticipantImpl.h"
+#include "../../participant/ControlMessageAggregator.h"
 
 #include <fastrtps/rtps/messages/RTPSMessageCreator.h>
 
@@ -40,13 +41,13 @@ PeriodicHeartbeat::~PeriodicHeartbeat()
 {
     logInfo(RTPS_WRITER,"Destroying PeriodicHB");
     destroy();
+    mp_SFW->getRTPSParticipant()->control_message_aggregator().remove_heartbeat(this);
 }
 
 PeriodicHeartbeat::PeriodicHeartbeat(StatefulWriter* p_SFW, double interval):
     TimedEvent(p_SFW->getRTPSParticipant()->getEventResource().getIOService(),
             p_SFW->getRTPSParticipant()->getEventResource().getThread(), interval),
-    m_cdrmessages(p_SFW->getRTPSParticipant()->getMaxMessageSize(),
-            p_SFW->getRTPSParticipant()->getGuid().guidPrefix), mp_SFW(p_SFW)
+    mp_SFW(p_SFW)
 {
 
 }
@@ -59,85 +60,11 @@ void PeriodicHeartbeat::event(EventCode code, const char* msg)
 
     if(code == EVENT_SUCCESS)
     {
-        SequenceNumber_t firstSeq, lastSeq;
-        bool unacked_changes = false;
-
-        if (mp_SFW->get_separate_sending())
-        {
-            std::lock_guard<std::recursive_mutex> guardW(*mp_SFW->getMutex());
-            for (std::vector<ReaderProxy*>::iterator it = mp_SFW->matchedReadersBegin();
-                it != mp_SFW->matchedReadersEnd(); ++it)
-            {
-                if ((*it)->thereIsUnacknowledged())
-                {
-                    // FinalFlag is always false because this class is used only by StatefulWriter in Reliable.
-                    mp_SFW->send_heartbeat_to_nts(**it, false);
-                    unacked_changes = true;
-                }
-            }
-        }
-        else
-        {
-            Count_t heartbeatCount = 0;
-            LocatorList_t locList;
-            std::vector<GUID_t> remote_readers;
-
-            {//BEGIN PROTECTION
-                std::lock_guard<std::recursive_mutex> guardW(*mp_SFW->getMutex());
-                for (std::vector<ReaderProxy*>::iterator it = mp_SFW->matchedReadersBegin();
-                    it != mp_SFW->matchedReadersEnd(); ++it)
-                {
-                    if (!unacked_changes)
-                    {
-                        if ((*it)->thereIsUnacknowledged())
-                        {
-                            unacked_changes = true;
-                        }
-                    }
-                    locList.push_back((*it)->m_att.endpoint.unicastLocatorList);
-                    locList.push_back((*it)->m_att.endpoint.multicastLocatorList);
-                    remote_readers.push_back((*it)->m_att.guid);
-                }
-
-                if (unacked_changes)
-                {
-                    firstSeq = mp_SFW->get_seq_num_min();
-                    lastSeq = mp_SFW->get_seq_num_max();
-
-                    if (firstSeq == c_SequenceNumber_Unknown || lastSeq == c_SequenceNumber_Unknown)
-                    {
-                        return;
-                    }
-                    else
-                    {
-                        (void)firstSeq;
-                        assert(firstSeq <= lastSeq);
-                    }
-
-                    mp_SFW->incrementHBCount();
-                    heartbeatCount = mp_SFW->getHeartbeatCount();
-
-                    // TODO(Ricardo) Use StatefulWriter::send_heartbeat_to_nts.
-                }
-            }
-
-            if (unacked_changes)
-            {
-                RTPSMessageGroup group(mp_SFW->getRTPSParticipant(), mp_SFW, RTPSMessageGroup::WRITER, m_cdrmessages);
-
-                // FinalFlag is always false because this class is used only by StatefulWriter in Reliable.
-                group.add_heartbeat(remote_readers,
-                    firstSeq, lastSeq, heartbeatCount, false, false, locList);
-                logInfo(RTPS_WRITER, mp_SFW->getGuid().entityId << " Sending Heartbeat (" << firstSeq << " - " << lastSeq << ")");
-            }
-        }
-
-        if (unacked_changes)
-        {
-            //Reset TIMER
-            this->restart_timer();
-        }
+        // Readers of this process do not answer heartbeats. Retry handing them their pending changes instead.
+        mp_SFW->send_changes_to_local_readers();
 
+        // The heartbeat is sent with those of other endpoints becoming due, which restarts the timer if needed.
+        mp_SFW->getRTPSParticipant()->control_message_aggregator().add_heartbeat(this);
     }
     else if(code == EVENT_ABORT)
     {
@@ -149,6 +76,24 @@ void PeriodicHeartbeat::event(EventCode code, const char* msg)
     }
 }
 
+void PeriodicHeartbeat::add_messages(RTPSMessageGroup& group)
+{
+    std::lock_guard<std::recursive_mutex> guardW(*mp_SFW->getMutex());
+
+    group.set_endpoint(mp_SFW);
+    if(mp_SFW->send_periodic_heartbeat_nts(group))
+    {
+        //Reset TIMER
+        this->restart_timer();
+    }
+}
+
+LocatorList_t PeriodicHeartbeat::destination_locators() const
+{
+    std::lock_guard<std::recursive_mutex> guardW(*mp_SFW->getMutex());
+    return mp_SFW->remote_locators_nts();
+}
+
 }
 }
 } /* namespace eprosima */
@@ -42,6 +42,45 @@ bool Subscriber::takeNextData(void* data,SampleInfo_t* info)
     return mp_impl->takeNextData(data,info);
 }
 
+size_t Subscriber::readData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& sample_infos,
+        size_t max_samples)
+{
+    return mp_impl->readData(next_data, sample_infos, max_samples);
+}
+
+size_t Subscriber::takeData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& sample_infos,
+        size_t max_samples)
+{
+    return mp_impl->takeData(next_data, sample_infos, max_samples);
+}
+
+size_t Subscriber::readInstanceData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& sample_infos,
+        size_t max_samples, const InstanceHandle_t& handle)
+{
+    return mp_impl->readInstanceData(next_data, sample_infos, max_samples, handle);
+}
+
+size_t Subscriber::takeInstanceData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& sample_infos,
+        size_t max_samples, const InstanceHandle_t& handle)
+{
+    return mp_impl->takeInstanceData(next_data, sample_infos, max_samples, handle);
+}
+
+bool Subscriber::readNextLoan(const CacheChange_t** change, SampleInfo_t* info)
+{
+    return mp_impl->readNextLoan(change, info);
+}
+
+bool Subscriber::takeNextLoan(const CacheChange_t** change, SampleInfo_t* info)
+{
+    return mp_impl->takeNextLoan(change, info);
+}
+
+bool Subscriber::returnLoan(const CacheChange_t* change)
+{
+    return mp_impl->returnLoan(change);
+}
+
 bool Subscriber::updateAttributes(const SubscriberAttributes& att)
 {
     return mp_impl->updateAttributes(att);
@@ -31,15 +31,10 @@
 using namespace eprosima::fastrtps;
 using namespace eprosima::fastrtps::rtps;
 
-inline bool sort_ReaderHistoryCache(CacheChange_t*c1,CacheChange_t*c2)
-{
-    return c1->sequenceNumber < c2->sequenceNumber;
-}
-
 SubscriberHistory::SubscriberHistory(SubscriberImpl* simpl,uint32_t payloadMaxSize,
         HistoryQosPolicy& history,
-        ResourceLimitsQosPolicy& resource,MemoryManagementPolicy_t mempolicy):
-    ReaderHistory(HistoryAttributes(mempolicy, payloadMaxSize,resource.allocated_samples,resource.max_samples + 1)),
+        ResourceLimitsQosPolicy& resource,MemoryManagementPolicy_t mempolicy, std::shared_ptr<PayloadArena> arena):
+    ReaderHistory(HistoryAttributes(mempolicy, payloadMaxSize,resource.allocated_samples,resource.max_samples + 1, arena)),
     m_unreadCacheCount(0),
     m_historyQos(history),
     m_resourceLimitsQos(resource),
@@ -78,14 +73,14 @@ bool SubscriberHistory::received_change(CacheChange_t* a_change, size_t unknown_
         if (m_historyQos.kind == KEEP_ALL_HISTORY_QOS)
         {
             // TODO(Ricardo) Check
-            if (m_changes.size() + unknown_missing_changes_up_to < (size_t)m_resourceLimitsQos.max_samples)
+            if (getHistorySize() + unknown_missing_changes_up_to < (size_t)m_resourceLimitsQos.max_samples)
             {
                 add = true;
             }
         }
         else if (m_historyQos.kind == KEEP_LAST_HISTORY_QOS)
         {
-            if (m_changes.size() < (size_t)m_historyQos.depth)
+            if (getHistorySize() < (size_t)m_historyQos.depth)
             {
                 add = true;
             }
@@ -96,14 +91,10 @@ bool SubscriberHistory::received_change(CacheChange_t* a_change, size_t unknown_
                 // Try to substitute a older samples.
                 CacheChange_t* older = nullptr;
 
-                for (auto it = m_changes.begin(); it != m_changes.end(); ++it)
+                if (get_min_change_from(&older, a_change->writerGUID) &&
+                    !(older->sequenceNumber < a_change->sequenceNumber))
                 {
-                    if ((*it)->writerGUID == a_change->writerGUID &&
-                        (*it)->sequenceNumber < a_change->sequenceNumber)
-                    {
-                        older = *it;
-                        break;
-                    }
+                    older = nullptr;
                 }
 
                 if (older != nullptr)
@@ -134,7 +125,7 @@ bool SubscriberHistory::received_change(CacheChange_t* a_change, size_t unknown_
             if (this->add_change(a_change))
             {
                 increaseUnreadCount();
-                if ((int32_t)m_changes.size() == m_resourceLimitsQos.max_samples)
+                if ((int32_t)getHistorySize() == m_resourceLimitsQos.max_samples)
                     m_isHistoryFull = true;
                 logInfo(SUBSCRIBER, this->mp_subImpl->getGuid().entityId
                     << ": Change " << a_change->sequenceNumber << " added from: "
@@ -165,7 +156,7 @@ bool SubscriberHistory::received_change(CacheChange_t* a_change, size_t unknown_
                 << " and no method to obtain it";);
             return false;
         }
-        t_v_Inst_Caches::iterator vit;
+        t_m_Inst_Caches::iterator vit;
         if (find_Key(a_change, &vit))
         {
             //logInfo(RTPS_EDP,"Trying to add change with KEY: "<< vit->first << endl;);
@@ -190,26 +181,29 @@ bool SubscriberHistory::received_change(CacheChange_t* a_change, size_t unknown_
                 }
                 else
                 {
-                    // Try to substitude a older samples.
-                    auto older_sample = m_changes.rend();
-                    for (auto it = m_changes.rbegin(); it != m_changes.rend(); ++it)
+                    // Try to substitude the oldest sample of the instance from the same writer.
+                    CacheChange_t* older_sample = nullptr;
+                    for (size_t index = 0; index < vit->second.size(); ++index)
                     {
-
-                        if ((*it)->writerGUID == a_change->writerGUID)
+                        CacheChange_t* instance_change = vit->second[index];
+                        if (instance_change->writerGUID == a_change->writerGUID)
                         {
-                            if ((*it)->sequenceNumber < a_change->sequenceNumber)
-                                older_sample = it;
+                            if (instance_change->sequenceNumber < a_change->sequenceNumber)
+                            {
+                                if (older_sample == nullptr)
+                                    older_sample = instance_change;
+                            }
                             // Already received
-                            else if ((*it)->sequenceNumber == a_change->sequenceNumber)
+                            else if (instance_change->sequenceNumber == a_change->sequenceNumber)
                                 return false;
                         }
                     }
 
-                    if (older_sample != m_changes.rend())
+                    if (older_sample != nullptr)
                     {
-                        bool read = (*older_sample)->isRead;
+                        bool read = older_sample->isRead;
 
-                        if (this->remove_change_sub(*older_sample, &vit))
+                        if (this->remove_change_sub(older_sample, &vit))
                         {
                             if (!read)
                             {
@@ -233,22 +227,10 @@ bool SubscriberHistory::received_change(CacheChange_t* a_change, size_t unknown_
                 if (this->add_change(a_change))
                 {
                     increaseUnreadCount();
-                    if ((int32_t)m_changes.size() == m_resourceLimitsQos.max_samples)
+                    if ((int32_t)getHistorySize() == m_resourceLimitsQos.max_samples)
                         m_isHistoryFull = true;
-                    //ADD TO KEY VECTOR
-                    if (vit->second.size() == 0)
-                    {
-                        vit->second.push_back(a_change);
-                    }
-                    else if (vit->second.back()->sequenceNumber < a_change->sequenceNumber)
-                    {
-                        vit->second.push_back(a_change);
-                    }
-                    else
-                    {
-                        vit->second.push_back(a_change);
-                        std::sort(vit->second.begin(), vit->second.end(), sort_ReaderHistoryCache);
-                    }
+                    //ADD TO KEY RING
+                    vit->second.insert_ordered(a_change);
                     logInfo(SUBSCRIBER, this->mp_reader->getGuid().entityId
                         << ": Change " << a_change->sequenceNumber << " added from: "
                         << a_change->writerGUID << " with KEY: " << a_change->instanceHandle;);
@@ -364,43 +346,21 @@ bool SubscriberHistory::readNextData(void* data, SampleInfo_t* info)
         return false;
     }
 
-    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
-    CacheChange_t* change;
-    WriterProxy * wp;
-    if (this->mp_reader->nextUnreadCache(&change, &wp))
+    LentSample sample;
     {
-        change->isRead = true;
-        this->decreaseUnreadCount();
-        logInfo(SUBSCRIBER, this->mp_reader->getGuid().entityId << ": reading " << change->sequenceNumber);
-        if (change->kind == ALIVE)
-        {
-            this->mp_subImpl->getType()->deserialize(&change->serializedPayload, data);
-        }
-        if (info != nullptr)
+        std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+        CacheChange_t* change;
+        WriterProxy * wp = nullptr;
+        if (!this->mp_reader->nextUnreadCache(&change, &wp))
         {
-            info->sampleKind = change->kind;
-            info->sample_identity.writer_guid(change->writerGUID);
-            info->sample_identity.sequence_number(change->sequenceNumber);
-            info->sourceTimestamp = change->sourceTimestamp;
-            if (this->mp_subImpl->getAttributes().qos.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS)
-            {
-                info->ownershipStrength = wp->m_att.ownershipStrength;
-            }
-            if (this->mp_subImpl->getAttributes().topic.topicKind == WITH_KEY &&
-                change->instanceHandle == c_InstanceHandle_Unknown && change->kind == ALIVE)
-            {
-                bool is_key_protected = false;
-#if HAVE_SECURITY
-                is_key_protected = mp_reader->getAttributes().security_attributes().is_key_protected;
-#endif
-                this->mp_subImpl->getType()->getKey(data, &change->instanceHandle, is_key_protected);
-            }
-            info->iHandle = change->instanceHandle;
-            info->related_sample_identity = change->write_params.sample_identity();
+            return false;
         }
-        return true;
+        sample = this->lend_change(change, wp, info, false);
     }
-    return false;
+
+    // The sample is deserialized without blocking the reception of new changes.
+    this->deliver_sample(sample, data, info);
+    return true;
 }
 
 
@@ -412,96 +372,259 @@ bool SubscriberHistory::takeNextData(void* data, SampleInfo_t* info)
         return false;
     }
 
-    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
-    CacheChange_t* change;
-    WriterProxy * wp;
-    if (this->mp_reader->nextUntakenCache(&change, &wp))
+    LentSample sample;
     {
-        if (!change->isRead)
+        std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+        CacheChange_t* change;
+        WriterProxy * wp = nullptr;
+        if (!this->mp_reader->nextUntakenCache(&change, &wp))
         {
-            this->decreaseUnreadCount();
-        }
-        change->isRead = true;
-        logInfo(SUBSCRIBER, this->mp_reader->getGuid().entityId << ": taking seqNum" << change->sequenceNumber <<
-            " from writer: " << change->writerGUID);
-        if (change->kind == ALIVE)
-        {
-            this->mp_subImpl->getType()->deserialize(&change->serializedPayload, data);
+            return false;
         }
-        if (info != nullptr)
+        sample = this->lend_change(change, wp, info, true);
+    }
+
+    // The sample is deserialized without blocking the reception of new changes.
+    this->deliver_sample(sample, data, info);
+    return true;
+}
+
+size_t SubscriberHistory::readData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& infos,
+        size_t max_samples)
+{
+    return get_data(next_data, infos, max_samples, nullptr, false);
+}
+
+size_t SubscriberHistory::takeData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& infos,
+        size_t max_samples)
+{
+    return get_data(next_data, infos, max_samples, nullptr, true);
+}
+
+size_t SubscriberHistory::readInstanceData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& infos,
+        size_t max_samples, const InstanceHandle_t& handle)
+{
+    return get_data(next_data, infos, max_samples, &handle, false);
+}
+
+size_t SubscriberHistory::takeInstanceData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& infos,
+        size_t max_samples, const InstanceHandle_t& handle)
+{
+    return get_data(next_data, infos, max_samples, &handle, true);
+}
+
+size_t SubscriberHistory::get_data(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& infos,
+        size_t max_samples, const InstanceHandle_t* handle, bool take)
+{
+    if (mp_reader == nullptr || mp_mutex == nullptr)
+    {
+        logError(RTPS_HISTORY, "You need to create a Reader with this History before using it");
+        return 0;
+    }
+
+    if (handle != nullptr && mp_subImpl->getAttributes().topic.getTopicKind() == NO_KEY)
+    {
+        logWarning(SUBSCRIBER, "Instances are only kept for topics with key");
+        return 0;
+    }
+
+    size_t first_info = infos.size();
+    std::vector<LentSample> samples;
+    {
+        std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+        if (handle == nullptr)
         {
-            info->sampleKind = change->kind;
-            info->sample_identity.writer_guid(change->writerGUID);
-            info->sample_identity.sequence_number(change->sequenceNumber);
-            info->sourceTimestamp = change->sourceTimestamp;
-            if (this->mp_subImpl->getAttributes().qos.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS)
+            CacheChange_t* change;
+            WriterProxy * wp = nullptr;
+            while (samples.size() < max_samples &&
+                    (take ? this->mp_reader->nextUntakenCache(&change, &wp) :
+                     this->mp_reader->nextUnreadCache(&change, &wp)))
             {
-                info->ownershipStrength = wp->m_att.ownershipStrength;
+                infos.emplace_back();
+                samples.push_back(this->lend_change(change, wp, &infos.back(), take));
             }
-            if (this->mp_subImpl->getAttributes().topic.topicKind == WITH_KEY &&
-                change->instanceHandle == c_InstanceHandle_Unknown && change->kind == ALIVE)
-            {
-                bool is_key_protected = false;
+        }
+        else
+        {
+            get_instance_samples(infos, max_samples, *handle, take, samples);
+        }
+    }
+
+    // The samples are deserialized without blocking the reception of new changes.
+    for (size_t index = 0; index < samples.size(); ++index)
+    {
+        this->deliver_sample(samples[index], next_data(), &infos[first_info + index]);
+    }
+    return samples.size();
+}
+
+void SubscriberHistory::get_instance_samples(std::vector<SampleInfo_t>& infos, size_t max_samples,
+        const InstanceHandle_t& handle, bool take, std::vector<LentSample>& samples)
+{
+    t_m_Inst_Caches::iterator vit = m_keyedChanges.find(handle);
+    if (vit == m_keyedChanges.end())
+    {
+        return;
+    }
+
+    // Changes of the instance come from several writers, so an unavailable change does not end the search.
+    size_t index = 0;
+    while (samples.size() < max_samples && index < vit->second.size())
+    {
+        CacheChange_t* change = vit->second[index];
+        WriterProxy * wp = nullptr;
+        if ((!take && change->isRead) || !this->mp_reader->isChangeAvailable(change, &wp))
+        {
+            ++index;
+            continue;
+        }
+
+        infos.emplace_back();
+        // A taken change is erased from the instance, so the next one takes its position.
+        samples.push_back(this->lend_change(change, wp, &infos.back(), take, &vit));
+        if (!take)
+        {
+            ++index;
+        }
+    }
+}
+
+SubscriberHistory::LentSample SubscriberHistory::lend_change(CacheChange_t* change, WriterProxy* wp,
+        SampleInfo_t* info, bool take, t_m_Inst_Caches::iterator* vit)
+{
+    if (!change->isRead)
+    {
+        this->decreaseUnreadCount();
+    }
+    change->isRead = true;
+    logInfo(SUBSCRIBER, this->mp_reader->getGuid().entityId << (take ? ": taking seqNum" : ": reading seqNum") <<
+        change->sequenceNumber << " from writer: " << change->writerGUID);
+
+    if (info != nullptr)
+    {
+        this->fill_sample_info(change, wp, info);
+    }
+
+    LentSample sample;
+    sample.is_alive = change->kind == ALIVE;
+    sample.needs_key = this->mp_subImpl->getAttributes().topic.topicKind == WITH_KEY &&
+        change->instanceHandle == c_InstanceHandle_Unknown && sample.is_alive;
+    // The change stays valid until the loan is returned, even if it is taken.
+    sample.change = this->loan_change(change);
+    if (take)
+    {
+        this->remove_change_sub(change, vit);
+    }
+    return sample;
+}
+
+void SubscriberHistory::deliver_sample(const LentSample& sample, void* data, SampleInfo_t* info)
+{
+    if (sample.is_alive)
+    {
+        // Nobody else uses a lent payload, as the change is already read or taken.
+        this->mp_subImpl->getType()->deserialize(const_cast<SerializedPayload_t*>(&sample.change->serializedPayload),
+                data);
+    }
+    if (sample.needs_key && info != nullptr)
+    {
+        bool is_key_protected = false;
 #if HAVE_SECURITY
-                is_key_protected = mp_reader->getAttributes().security_attributes().is_key_protected;
+        is_key_protected = mp_reader->getAttributes().security_attributes().is_key_protected;
 #endif
-                this->mp_subImpl->getType()->getKey(data, &change->instanceHandle, is_key_protected);
-            }
-            info->iHandle = change->instanceHandle;
-            info->related_sample_identity = change->write_params.sample_identity();
-        }
-        this->remove_change_sub(change);
+        this->mp_subImpl->getType()->getKey(data, &info->iHandle, is_key_protected);
+    }
+    this->return_loan(sample.change);
+}
+
+void SubscriberHistory::fill_sample_info(CacheChange_t* change, WriterProxy* wp, SampleInfo_t* info)
+{
+    info->sampleKind = change->kind;
+    info->sample_identity.writer_guid(change->writerGUID);
+    info->sample_identity.sequence_number(change->sequenceNumber);
+    info->sourceTimestamp = change->sourceTimestamp;
+    if (this->mp_subImpl->getAttributes().qos.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS && wp != nullptr)
+    {
+        info->ownershipStrength = wp->m_att.ownershipStrength;
+    }
+    info->iHandle = change->instanceHandle;
+    info->related_sample_identity = change->write_params.sample_identity();
+}
+
+bool SubscriberHistory::readNextLoan(const CacheChange_t** lent_change, SampleInfo_t* info)
+{
+    if (mp_reader == nullptr || mp_mutex == nullptr)
+    {
+        logError(RTPS_HISTORY, "You need to create a Reader with this History before using it");
+        return false;
+    }
+
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    CacheChange_t* change;
+    WriterProxy * wp = nullptr;
+    if (this->mp_reader->nextUnreadCache(&change, &wp))
+    {
+        *lent_change = this->lend_change(change, wp, info, false).change;
         return true;
     }
+    return false;
+}
 
+bool SubscriberHistory::takeNextLoan(const CacheChange_t** lent_change, SampleInfo_t* info)
+{
+    if (mp_reader == nullptr || mp_mutex == nullptr)
+    {
+        logError(RTPS_HISTORY, "You need to create a Reader with this History before using it");
+        return false;
+    }
+
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    CacheChange_t* change;
+    WriterProxy * wp = nullptr;
+    if (this->mp_reader->nextUntakenCache(&change, &wp))
+    {
+        *lent_change = this->lend_change(change, wp, info, true).change;
+        return true;
+    }
     return false;
 }
 
-bool SubscriberHistory::find_Key(CacheChange_t* a_change, t_v_Inst_Caches::iterator* vit_out)
+bool SubscriberHistory::find_Key(CacheChange_t* a_change, t_m_Inst_Caches::iterator* vit_out)
 {
-    t_v_Inst_Caches::iterator vit;
-    bool found = false;
-    for (vit = m_keyedChanges.begin(); vit != m_keyedChanges.end(); ++vit)
+    t_m_Inst_Caches::iterator vit = m_keyedChanges.find(a_change->instanceHandle);
+    if (vit != m_keyedChanges.end())
     {
-        if (a_change->instanceHandle == vit->first)
-        {
-            *vit_out = vit;
-            return true;
-        }
+        *vit_out = vit;
+        return true;
     }
-    if (!found)
+
+    if ((int)m_keyedChanges.size() >= m_resourceLimitsQos.max_instances)
     {
-        if ((int)m_keyedChanges.size() < m_resourceLimitsQos.max_instances)
+        // An instance without changes is replaced by the new one.
+        for (vit = m_keyedChanges.begin(); vit != m_keyedChanges.end(); ++vit)
         {
-            t_p_I_Change newpair;
-            newpair.first = a_change->instanceHandle;
-            m_keyedChanges.push_back(newpair);
-            *vit_out = m_keyedChanges.end() - 1;
-            return true;
-        }
-        else
-        {
-            for (vit = m_keyedChanges.begin(); vit != m_keyedChanges.end(); ++vit)
+            if (vit->second.empty())
             {
-                if (vit->second.size() == 0)
-                {
-                    m_keyedChanges.erase(vit);
-                    t_p_I_Change newpair;
-                    newpair.first = a_change->instanceHandle;
-                    m_keyedChanges.push_back(newpair);
-                    *vit_out = m_keyedChanges.end() - 1;
-                    return true;
-                }
+                break;
             }
-            logWarning(SUBSCRIBER, "History has reached the maximum number of instances");
         }
 
+        if (vit == m_keyedChanges.end())
+        {
+            logWarning(SUBSCRIBER, "History has reached the maximum number of instances");
+            return false;
+        }
+        m_keyedChanges.erase(vit);
     }
-    return false;
+
+    // With KEEP_LAST the ring of the instance never has to grow.
+    size_t capacity = m_historyQos.kind == KEEP_LAST_HISTORY_QOS ? (size_t)m_historyQos.depth : 0;
+    *vit_out = m_keyedChanges.emplace(a_change->instanceHandle, InstanceChanges(capacity)).first;
+    return true;
 }
 
 
-bool SubscriberHistory::remove_change_sub(CacheChange_t* change, t_v_Inst_Caches::iterator* vit_in)
+bool SubscriberHistory::remove_change_sub(CacheChange_t* change, t_m_Inst_Caches::iterator* vit_in)
 {
     if (mp_reader == nullptr || mp_mutex == nullptr)
     {
@@ -521,29 +644,24 @@ bool SubscriberHistory::remove_change_sub(CacheChange_t* change, t_v_Inst_Caches
     }
     else
     {
-        t_v_Inst_Caches::iterator vit;
+        t_m_Inst_Caches::iterator vit;
         if (vit_in != nullptr)
         {
             vit = *vit_in;
-        }
-        else if (this->find_Key(change, &vit))
-        {
-
         }
         else
         {
-            return false;
+            vit = m_keyedChanges.find(change->instanceHandle);
         }
-        for (auto chit = vit->second.begin(); chit != vit->second.end(); ++chit)
+
+        if (vit != m_keyedChanges.end())
         {
-            if ((*chit)->sequenceNumber == change->sequenceNumber && (*chit)->writerGUID == change->writerGUID)
+            size_t index = vit->second.find(change);
+            if (index < vit->second.size() && remove_change(change))
             {
-                if (remove_change(change))
-                {
-                    vit->second.erase(chit);
-                    m_isHistoryFull = false;
-                    return true;
-                }
+                vit->second.erase(index);
+                m_isHistoryFull = false;
+                return true;
             }
         }
         logError(SUBSCRIBER, "Change not found, something is wrong");
@@ -43,7 +43,7 @@ SubscriberImpl::SubscriberImpl(ParticipantImpl* p,TopicDataType* ptype,
     mp_type(ptype),
     m_att(att),
 #pragma warning (disable : 4355 )
-    m_history(this,ptype->m_typeSize  + 3/*Possible alignment*/, att.topic.historyQos, att.topic.resourceLimitsQos,att.historyMemoryPolicy),
+    m_history(this,ptype->m_typeSize  + 3/*Possible alignment*/, att.topic.historyQos, att.topic.resourceLimitsQos,att.historyMemoryPolicy, att.historyPayloadArena),
     mp_listener(listen),
     m_readerListener(this),
     mp_userSubscriber(nullptr),
@@ -88,6 +88,45 @@ bool SubscriberImpl::takeNextData(void* data,SampleInfo_t* info) {
     return this->m_history.takeNextData(data,info);
 }
 
+size_t SubscriberImpl::readData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& infos,
+        size_t max_samples)
+{
+    return this->m_history.readData(next_data, infos, max_samples);
+}
+
+size_t SubscriberImpl::takeData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& infos,
+        size_t max_samples)
+{
+    return this->m_history.takeData(next_data, infos, max_samples);
+}
+
+size_t SubscriberImpl::readInstanceData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& infos,
+        size_t max_samples, const InstanceHandle_t& handle)
+{
+    return this->m_history.readInstanceData(next_data, infos, max_samples, handle);
+}
+
+size_t SubscriberImpl::takeInstanceData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& infos,
+        size_t max_samples, const InstanceHandle_t& handle)
+{
+    return this->m_history.takeInstanceData(next_data, infos, max_samples, handle);
+}
+
+bool SubscriberImpl::readNextLoan(const CacheChange_t** change, SampleInfo_t* info)
+{
+    return this->m_history.readNextLoan(change, info);
+}
+
+bool SubscriberImpl::takeNextLoan(const CacheChange_t** change, SampleInfo_t* info)
+{
+    return this->m_history.takeNextLoan(change, info);
+}
+
+bool SubscriberImpl::returnLoan(const CacheChange_t* change)
+{
+    return this->m_history.return_loan(change);
+}
+
 
 
 const GUID_t& SubscriberImpl::getGuid(){
@@ -75,6 +75,17 @@ public:
 	bool readNextData(void* data,SampleInfo_t* info);
 	bool takeNextData(void* data,SampleInfo_t* info);
 
+	size_t readData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& infos, size_t max_samples);
+	size_t takeData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& infos, size_t max_samples);
+	size_t readInstanceData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& infos,
+	        size_t max_samples, const rtps::InstanceHandle_t& handle);
+	size_t takeInstanceData(const std::function<void*()>& next_data, std::vector<SampleInfo_t>& infos,
+	        size_t max_samples, const rtps::InstanceHandle_t& handle);
+
+	bool readNextLoan(const rtps::CacheChange_t** change, SampleInfo_t* info);
+	bool takeNextLoan(const rtps::CacheChange_t** change, SampleInfo_t* info);
+	bool returnLoan(const rtps::CacheChange_t* change);
+
 	///@}
 	
 	/**
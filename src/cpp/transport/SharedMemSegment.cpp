@@ -0,0 +1,593 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "SharedMemSegment.h"
+
+#include <fastrtps/transport/TransportReceiverInterface.h>
+#include <fastrtps/log/Log.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <thread>
+
+#if !defined(_WIN32) && !defined(__APPLE__) && !defined(__ANDROID__)
+#define SHARED_MEM_SEGMENTS_SUPPORTED 1
+#include <cerrno>
+#include <fcntl.h>
+#include <semaphore.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+static const uint32_t s_segmentMagic = 0x32485352; // "RSH2"
+static const size_t s_cacheLineSize = 64;
+//! Set on the sequence of a cell while its producer copies the message.
+static const uint64_t s_cellBeingWritten = 1ULL << 63;
+//! Time the consumer waits for a reserved cell to be published before taking its producer for dead.
+static const std::chrono::milliseconds s_abandonedCellTimeout(1000);
+
+static size_t align_to_cache_line(size_t size)
+{
+    return (size + s_cacheLineSize - 1) & ~(s_cacheLineSize - 1);
+}
+
+struct SharedMemCellHeader
+{
+    std::atomic<uint64_t> sequence;
+    uint32_t length;
+    uint32_t source_id;
+};
+
+#ifdef SHARED_MEM_SEGMENTS_SUPPORTED
+
+struct SharedMemSegmentHeader
+{
+    //! Written last by the owner, once the rest of the segment is initialized.
+    std::atomic<uint32_t> magic;
+    uint32_t cell_count;
+    uint32_t cell_size;
+    uint32_t cell_stride;
+    std::atomic<uint32_t> closed;
+    //! Posted once per published message.
+    sem_t messages;
+    alignas(64) std::atomic<uint64_t> enqueue_pos;
+    alignas(64) uint64_t dequeue_pos;
+};
+
+static size_t segment_size(uint32_t cell_count, uint32_t cell_stride)
+{
+    return align_to_cache_line(sizeof(SharedMemSegmentHeader)) + static_cast<size_t>(cell_count) * cell_stride;
+}
+
+/*!
+ * Checks whether an existing segment belongs to a live process. The owner holds an exclusive lock on the shared
+ * memory object for as long as it lives, which the kernel drops when the process dies. Unlike process ids, the
+ * lock works across PID namespaces and cannot be mistaken for another process reusing the id.
+ */
+static bool is_owner_alive(const std::string& name)
+{
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    bool alive = flock(fd, LOCK_SH | LOCK_NB) != 0 && errno == EWOULDBLOCK;
+    if (alive)
+    {
+        // Locked, but the owner may be already closing it.
+        struct stat info;
+        if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(SharedMemSegmentHeader))
+        {
+            void* address = mmap(nullptr, sizeof(SharedMemSegmentHeader), PROT_READ, MAP_SHARED, fd, 0);
+            if (address != MAP_FAILED)
+            {
+                SharedMemSegmentHeader* header = static_cast<SharedMemSegmentHeader*>(address);
+                alive = header->magic.load(std::memory_order_acquire) != s_segmentMagic ||
+                    header->closed.load(std::memory_order_acquire) == 0;
+                munmap(address, sizeof(SharedMemSegmentHeader));
+            }
+        }
+    }
+
+    ::close(fd);
+    return alive;
+}
+
+//! Whether the shared memory object with the given name is the one open in fd.
+static bool is_same_object(const std::string& name, int fd)
+{
+    int named_fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (named_fd < 0)
+    {
+        return false;
+    }
+
+    struct stat named;
+    struct stat opened;
+    bool same = fstat(named_fd, &named) == 0 && fstat(fd, &opened) == 0 &&
+        named.st_dev == opened.st_dev && named.st_ino == opened.st_ino;
+    ::close(named_fd);
+    return same;
+}
+
+//! 64 bit FNV-1a hash, continuing a previous one.
+static uint64_t fnv1a(const std::string& data, uint64_t hash = 14695981039346656037ULL)
+{
+    for (char c : data)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static std::string read_first_line(const char* path)
+{
+    std::string line;
+    std::ifstream file(path);
+    std::getline(file, line);
+    return line;
+}
+
+static void write_uint64(octet* destination, uint64_t value)
+{
+    for (int i = 7; i >= 0; --i)
+    {
+        destination[i] = static_cast<octet>(value);
+        value >>= 8;
+    }
+}
+
+bool SharedMemSegment::is_supported()
+{
+    std::atomic<uint64_t> probe(0);
+    return probe.is_lock_free();
+}
+
+bool SharedMemSegment::host_id(octet* id)
+{
+    // Different on every boot, so cloned machines do not share it.
+    std::string machine = read_first_line("/proc/sys/kernel/random/boot_id");
+    if (machine.empty())
+    {
+        machine = read_first_line("/etc/machine-id");
+    }
+
+    // Containers usually share the boot of the host but not its shared memory objects.
+    char ipc_namespace[64];
+    ssize_t length = readlink("/proc/self/ns/ipc", ipc_namespace, sizeof(ipc_namespace));
+    struct stat shm_mount;
+
+    if (machine.empty() || length <= 0 || stat("/dev/shm", &shm_mount) != 0)
+    {
+        return false;
+    }
+
+    uint64_t space = fnv1a(std::string(ipc_namespace, static_cast<size_t>(length)));
+    space = fnv1a(std::to_string(shm_mount.st_dev) + ":" + std::to_string(shm_mount.st_ino), space);
+
+    write_uint64(id, fnv1a(machine));
+    write_uint64(id + 8, space);
+    return true;
+}
+
+SharedMemSegment* SharedMemSegment::create(const std::string& name, uint32_t cell_count, uint32_t cell_size,
+        uint32_t mode)
+{
+    if (cell_count == 0 || cell_size == 0)
+    {
+        return nullptr;
+    }
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, static_cast<mode_t>(mode));
+    if (fd < 0 && errno == EEXIST)
+    {
+        if (is_owner_alive(name))
+        {
+            return nullptr;
+        }
+
+        // Left behind by a process that did not close it.
+        shm_unlink(name.c_str());
+        fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, static_cast<mode_t>(mode));
+    }
+
+    if (fd < 0)
+    {
+        logInfo(RTPS_MSG_IN, "Cannot create shared memory segment " << name << ": " << strerror(errno));
+        return nullptr;
+    }
+
+    // Kept until the segment is destroyed, telling other processes the owner is alive. Another process may have
+    // found the object unlocked and removed it before the lock was taken.
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0 || !is_same_object(name, fd))
+    {
+        logInfo(RTPS_MSG_IN, "Cannot lock shared memory segment " << name);
+        ::close(fd);
+        return nullptr;
+    }
+
+    // shm_open applies the umask, which would make a configured mode less permissive than requested.
+    fchmod(fd, static_cast<mode_t>(mode));
+
+    uint32_t cell_stride = static_cast<uint32_t>(align_to_cache_line(sizeof(SharedMemCellHeader) + cell_size));
+    size_t size = segment_size(cell_count, cell_stride);
+    void* address = MAP_FAILED;
+
+    if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+    {
+        address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+
+    if (address == MAP_FAILED)
+    {
+        logInfo(RTPS_MSG_IN, "Cannot map shared memory segment " << name << ": " << strerror(errno));
+        shm_unlink(name.c_str());
+        ::close(fd);
+        return nullptr;
+    }
+
+    SharedMemSegmentHeader* header = new (address) SharedMemSegmentHeader();
+    header->cell_count = cell_count;
+    header->cell_size = cell_size;
+    header->cell_stride = cell_stride;
+    header->closed.store(0, std::memory_order_relaxed);
+    header->enqueue_pos.store(0, std::memory_order_relaxed);
+    header->dequeue_pos = 0;
+
+    if (sem_init(&header->messages, 1, 0) != 0)
+    {
+        munmap(address, size);
+        shm_unlink(name.c_str());
+        ::close(fd);
+        return nullptr;
+    }
+
+    SharedMemSegment* segment = new SharedMemSegment(name, address, size, fd);
+    for (uint64_t position = 0; position < cell_count; ++position)
+    {
+        SharedMemCellHeader* cell = new (segment->cell(position)) SharedMemCellHeader();
+        cell->sequence.store(position, std::memory_order_relaxed);
+    }
+
+    header->magic.store(s_segmentMagic, std::memory_order_release);
+    return segment;
+}
+
+SharedMemSegment* SharedMemSegment::open(const std::string& name)
+{
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SharedMemSegmentHeader))
+    {
+        ::close(fd);
+        return nullptr;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (address == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    SharedMemSegmentHeader* header = static_cast<SharedMemSegmentHeader*>(address);
+    if (header->magic.load(std::memory_order_acquire) != s_segmentMagic ||
+            header->closed.load(std::memory_order_acquire) != 0 ||
+            segment_size(header->cell_count, header->cell_stride) > size)
+    {
+        munmap(address, size);
+        return nullptr;
+    }
+
+    return new SharedMemSegment(name, address, size, -1);
+}
+
+SharedMemSegment::SharedMemSegment(const std::string& name, void* address, size_t size, int lock_fd)
+    : name_(name)
+    , address_(address)
+    , size_(size)
+    , owner_(lock_fd >= 0)
+    , lock_fd_(lock_fd)
+    , header_(static_cast<SharedMemSegmentHeader*>(address))
+{
+}
+
+SharedMemSegment::~SharedMemSegment()
+{
+    if (owner_)
+    {
+        close();
+        shm_unlink(name_.c_str());
+    }
+
+    munmap(address_, size_);
+
+    if (lock_fd_ >= 0)
+    {
+        ::close(lock_fd_);
+    }
+}
+
+octet* SharedMemSegment::cell(uint64_t position) const
+{
+    return static_cast<octet*>(address_) + align_to_cache_line(sizeof(SharedMemSegmentHeader)) +
+        static_cast<size_t>(position % header_->cell_count) * header_->cell_stride;
+}
+
+bool SharedMemSegment::push(const octet* data, uint32_t size, uint32_t source_id)
+{
+    NetworkBuffer buffer(data, size);
+    return push(&buffer, 1, size, source_id);
+}
+
+bool SharedMemSegment::push(const NetworkBuffer* buffers, size_t bufferCount, uint32_t size, uint32_t source_id)
+{
+    if (size > header_->cell_size)
+    {
+        return false;
+    }
+
+    SharedMemCellHeader* cell_header = nullptr;
+    uint64_t position = header_->enqueue_pos.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        cell_header = reinterpret_cast<SharedMemCellHeader*>(cell(position));
+        uint64_t sequence = cell_header->sequence.load(std::memory_order_acquire);
+        int64_t difference = static_cast<int64_t>((sequence & ~s_cellBeingWritten) - position);
+
+        if (difference == 0 && (sequence & s_cellBeingWritten) == 0)
+        {
+            if (header_->enqueue_pos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The consumer has not released this cell yet.
+            return false;
+        }
+        else
+        {
+            position = header_->enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Fails if the consumer gave up on the cell, which only happens after s_abandonedCellTimeout.
+    uint64_t reserved = position;
+    if (!cell_header->sequence.compare_exchange_strong(reserved, position | s_cellBeingWritten,
+            std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    octet* cell_data = reinterpret_cast<octet*>(cell_header + 1);
+    for (size_t i = 0; i < bufferCount; ++i)
+    {
+        memcpy(cell_data, buffers[i].buffer, buffers[i].size);
+        cell_data += buffers[i].size;
+    }
+    cell_header->length = size;
+    cell_header->source_id = source_id;
+
+    uint64_t writing = position | s_cellBeingWritten;
+    if (!cell_header->sequence.compare_exchange_strong(writing, position + 1, std::memory_order_release))
+    {
+        return false;
+    }
+
+    sem_post(&header_->messages);
+    return true;
+}
+
+bool SharedMemSegment::wait_message(const octet*& data, uint32_t& size, uint32_t& source_id)
+{
+    while (sem_wait(&header_->messages) != 0)
+    {
+        if (errno != EINTR)
+        {
+            return false;
+        }
+    }
+
+    // The post may come from a producer ahead of the one that reserved the head cell. That one may have died
+    // before publishing, so cells left unpublished for too long are skipped. Their producers never posted.
+    for (;;)
+    {
+        uint64_t position = header_->dequeue_pos;
+        SharedMemCellHeader* cell_header = reinterpret_cast<SharedMemCellHeader*>(cell(position));
+        auto deadline = std::chrono::steady_clock::now() + s_abandonedCellTimeout;
+        uint64_t sequence = cell_header->sequence.load(std::memory_order_acquire);
+        uint32_t spins = 0;
+
+        while (sequence != position + 1 && std::chrono::steady_clock::now() < deadline)
+        {
+            if (is_closed())
+            {
+                return false;
+            }
+
+            if (++spins < 1000)
+            {
+                std::this_thread::yield();
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            sequence = cell_header->sequence.load(std::memory_order_acquire);
+        }
+
+        if (is_closed())
+        {
+            return false;
+        }
+
+        if (sequence == position + 1)
+        {
+            data = reinterpret_cast<const octet*>(cell_header + 1);
+            size = cell_header->length;
+            source_id = cell_header->source_id;
+            return true;
+        }
+
+        // Gives the cell back to the producers, unless its producer publishes it meanwhile.
+        if (cell_header->sequence.compare_exchange_strong(sequence, position + header_->cell_count,
+                std::memory_order_acq_rel))
+        {
+            logWarning(RTPS_MSG_IN, "Skipping shared memory cell abandoned by its producer");
+            header_->dequeue_pos = position + 1;
+        }
+    }
+}
+
+void SharedMemSegment::release_message()
+{
+    uint64_t position = header_->dequeue_pos;
+    SharedMemCellHeader* cell_header = reinterpret_cast<SharedMemCellHeader*>(cell(position));
+    cell_header->sequence.store(position + header_->cell_count, std::memory_order_release);
+    header_->dequeue_pos = position + 1;
+}
+
+void SharedMemSegment::close()
+{
+    if (header_->closed.exchange(1, std::memory_order_acq_rel) == 0)
+    {
+        sem_post(&header_->messages);
+    }
+}
+
+bool SharedMemSegment::is_closed() const
+{
+    return header_->closed.load(std::memory_order_acquire) != 0;
+}
+
+#else
+
+struct SharedMemSegmentHeader
+{
+};
+
+bool SharedMemSegment::is_supported()
+{
+    return false;
+}
+
+bool SharedMemSegment::host_id(octet*)
+{
+    return false;
+}
+
+SharedMemSegment* SharedMemSegment::create(const std::string&, uint32_t, uint32_t, uint32_t)
+{
+    return nullptr;
+}
+
+SharedMemSegment* SharedMemSegment::open(const std::string&)
+{
+    return nullptr;
+}
+
+SharedMemSegment::SharedMemSegment(const std::string& name, void* address, size_t size, int lock_fd)
+    : name_(name)
+    , address_(address)
+    , size_(size)
+    , owner_(lock_fd >= 0)
+    , lock_fd_(lock_fd)
+    , header_(static_cast<SharedMemSegmentHeader*>(address))
+{
+}
+
+SharedMemSegment::~SharedMemSegment()
+{
+}
+
+octet* SharedMemSegment::cell(uint64_t) const
+{
+    return nullptr;
+}
+
+bool SharedMemSegment::push(const octet*, uint32_t, uint32_t)
+{
+    return false;
+}
+
+bool SharedMemSegment::push(const NetworkBuffer*, size_t, uint32_t, uint32_t)
+{
+    return false;
+}
+
+bool SharedMemSegment::wait_message(const octet*&, uint32_t&, uint32_t&)
+{
+    return false;
+}
+
+void SharedMemSegment::release_message()
+{
+}
+
+void SharedMemSegment::close()
+{
+}
+
+bool SharedMemSegment::is_closed() const
+{
+    return true;
+}
+
+#endif // SHARED_MEM_SEGMENTS_SUPPORTED
+
+SharedMemChannelResource::SharedMemChannelResource(SharedMemSegment* segment, TransportReceiverInterface* receiver)
+    : ChannelResource(0)
+    , segment_(segment)
+    , mMsgReceiver(receiver)
+{
+}
+
+SharedMemChannelResource::~SharedMemChannelResource()
+{
+    // The listening thread must be joined before the segment is unmapped.
+    Disable();
+    Clear();
+}
+
+void SharedMemChannelResource::Disable()
+{
+    ChannelResource::Disable();
+    segment_->close();
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
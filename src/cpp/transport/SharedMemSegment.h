@@ -0,0 +1,159 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef SHARED_MEM_SEGMENT_H
+#define SHARED_MEM_SEGMENT_H
+
+#include <fastrtps/transport/ChannelResource.h>
+#include <fastrtps/rtps/common/Types.h>
+#include <fastrtps/rtps/common/NetworkBuffer.h>
+
+#include <memory>
+#include <string>
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+class TransportReceiverInterface;
+struct SharedMemSegmentHeader;
+
+/**
+ * Shared memory object holding a bounded ring of message cells.
+ * Producers reserve cells through a compare-and-swap on the enqueue position, so several processes can
+ * write concurrently without locks. The owner of the segment is the only consumer. It is woken up
+ * through a process-shared semaphore posted once per published message.
+ */
+class SharedMemSegment
+{
+public:
+
+    //! Size of the identifier filled by host_id().
+    static const size_t host_id_size = 16;
+
+    //! Whether shared memory segments can be used on this platform.
+    static bool is_supported();
+
+    /**
+     * Identifies the processes that can open the segments created by this one: those running on the same boot
+     * of the same machine, sharing the shared memory mount and the IPC namespace.
+     * @param id Buffer of host_id_size octets.
+     * @return false if the identifier cannot be determined, in which case segments must not be used.
+     */
+    static bool host_id(octet* id);
+
+    /**
+     * Creates the segment and becomes its owner. A stale segment left by a dead process is replaced.
+     * @param mode Permissions of the shared memory object, as given to shm_open.
+     * @return nullptr if the segment could not be created or is owned by a live process.
+     */
+    static SharedMemSegment* create(const std::string& name, uint32_t cell_count, uint32_t cell_size,
+            uint32_t mode);
+
+    /**
+     * Maps a segment owned by another participant, in order to write on it.
+     * @return nullptr if the segment does not exist or is not initialized yet.
+     */
+    static SharedMemSegment* open(const std::string& name);
+
+    //! Unmaps the segment. The owner also removes the shared memory object.
+    ~SharedMemSegment();
+
+    /**
+     * Copies a message into the next free cell and wakes up the consumer.
+     * @return false if the message does not fit in a cell or the ring is full.
+     */
+    bool push(const octet* data, uint32_t size, uint32_t source_id);
+
+    /**
+     * Copies a message made of several buffers into the next free cell and wakes up the consumer.
+     * @param size Sum of the sizes of all the buffers.
+     * @return false if the message does not fit in a cell or the ring is full.
+     */
+    bool push(const NetworkBuffer* buffers, size_t bufferCount, uint32_t size, uint32_t source_id);
+
+    /**
+     * Blocks until the message at the head of the ring is published or the segment is closed.
+     * The returned data stays valid until release_message() is called.
+     * @return false if the segment was closed, or if waiting failed, in which case errno tells why.
+     */
+    bool wait_message(const octet*& data, uint32_t& size, uint32_t& source_id);
+
+    //! Gives the cell at the head of the ring back to the producers.
+    void release_message();
+
+    //! Marks the segment as closed and wakes up the consumer.
+    void close();
+
+    //! Whether the owner has closed the segment. Producers must map it again.
+    bool is_closed() const;
+
+private:
+
+    /**
+     * @param lock_fd Descriptor of the shared memory object, locked to tell other processes the owner is alive.
+     * Only given to the owner, which closes it on destruction. -1 for other processes.
+     */
+    SharedMemSegment(const std::string& name, void* address, size_t size, int lock_fd);
+
+    SharedMemSegment(const SharedMemSegment&) = delete;
+    SharedMemSegment& operator=(const SharedMemSegment&) = delete;
+
+    octet* cell(uint64_t position) const;
+
+    std::string name_;
+    void* address_;
+    size_t size_;
+    bool owner_;
+    int lock_fd_;
+    SharedMemSegmentHeader* header_;
+};
+
+/**
+ * Input channel of the shared memory transport. It owns the segment and the thread listening on it.
+ */
+class SharedMemChannelResource : public ChannelResource
+{
+public:
+
+    SharedMemChannelResource(SharedMemSegment* segment, TransportReceiverInterface* receiver);
+    virtual ~SharedMemChannelResource();
+
+    //! Stops listening. The thread is woken up by closing the segment.
+    virtual void Disable() override;
+
+    inline SharedMemSegment* GetSegment()
+    {
+        return segment_.get();
+    }
+
+    inline TransportReceiverInterface* GetMessageReceiver()
+    {
+        return mMsgReceiver;
+    }
+
+private:
+
+    std::unique_ptr<SharedMemSegment> segment_;
+    TransportReceiverInterface* mMsgReceiver;
+    SharedMemChannelResource(const SharedMemChannelResource&) = delete;
+    SharedMemChannelResource& operator=(const SharedMemChannelResource&) = delete;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // SHARED_MEM_SEGMENT_H
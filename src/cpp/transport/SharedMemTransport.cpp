@@ -0,0 +1,494 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <fastrtps/transport/SharedMemTransport.h>
+#include <fastrtps/transport/TransportReceiverInterface.h>
+#include <fastrtps/log/Log.h>
+#include "SharedMemSegment.h"
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+SharedMemTransportDescriptor::SharedMemTransportDescriptor()
+    : TransportDescriptorInterface(s_maximumMessageSize, s_maximumInitialPeersRange)
+    , ring_cell_count(s_defaultSharedMemRingCells)
+    , segment_name_prefix("fastrtps")
+    , segment_permissions(s_defaultSharedMemSegmentPermissions)
+{
+}
+
+SharedMemTransportDescriptor::SharedMemTransportDescriptor(const SharedMemTransportDescriptor& t)
+    : TransportDescriptorInterface(t)
+    , ring_cell_count(t.ring_cell_count)
+    , segment_name_prefix(t.segment_name_prefix)
+    , segment_permissions(t.segment_permissions)
+{
+}
+
+TransportInterface* SharedMemTransportDescriptor::create_transport() const
+{
+    return new SharedMemTransport(*this);
+}
+
+SharedMemTransport::SharedMemTransport(const SharedMemTransportDescriptor& descriptor)
+    : mConfiguration_(descriptor)
+    , mHostIdValid(false)
+    , mOutputChannelOpen(false)
+{
+    memset(mHostId, 0x00, sizeof(mHostId));
+    mHostIdValid = SharedMemSegment::host_id(mHostId);
+}
+
+SharedMemTransport::~SharedMemTransport()
+{
+    std::map<uint32_t, SharedMemChannelResource*> channels;
+    {
+        std::unique_lock<std::recursive_mutex> scopedLock(mInputMapMutex);
+        channels.swap(mInputChannels);
+    }
+
+    for (auto& channel : channels)
+    {
+        delete channel.second;
+    }
+
+    std::unique_lock<std::mutex> scopedLock(mOutputMapMutex);
+    mOutputSegments.clear();
+}
+
+bool SharedMemTransport::init()
+{
+    if (!SharedMemSegment::is_supported())
+    {
+        logError(RTPS_MSG_OUT, "Shared memory transport is not supported on this platform");
+        return false;
+    }
+
+    // A wrong identifier would make other hosts look local, so the transport is not used without one.
+    if (!mHostIdValid)
+    {
+        logError(RTPS_MSG_OUT, "Shared memory transport cannot identify the host");
+        return false;
+    }
+
+    if (mConfiguration_.maxMessageSize == 0 || mConfiguration_.maxMessageSize > s_maximumMessageSize)
+    {
+        logError(RTPS_MSG_OUT, "maxMessageSize should be between 1 and " << s_maximumMessageSize);
+        return false;
+    }
+
+    if (mConfiguration_.ring_cell_count == 0)
+    {
+        logError(RTPS_MSG_OUT, "ring_cell_count cannot be zero");
+        return false;
+    }
+
+    return true;
+}
+
+void SharedMemTransport::FillLocalLocator(Locator_t& locator) const
+{
+    locator.kind = LOCATOR_KIND_SHM;
+    memcpy(locator.address, mHostId, sizeof(mHostId));
+}
+
+std::string SharedMemTransport::SegmentName(uint32_t port) const
+{
+    return "/" + mConfiguration_.segment_name_prefix + "_" + std::to_string(port);
+}
+
+bool SharedMemTransport::IsOutputChannelOpen(const Locator_t& locator) const
+{
+    if (!IsLocatorSupported(locator))
+    {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> scopedLock(mOutputMapMutex);
+    return mOutputChannelOpen;
+}
+
+bool SharedMemTransport::IsInputChannelOpen(const Locator_t& locator) const
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mInputMapMutex);
+    return IsLocatorSupported(locator) && (mInputChannels.find(locator.port) != mInputChannels.end());
+}
+
+bool SharedMemTransport::IsLocatorSupported(const Locator_t& locator) const
+{
+    return locator.kind == LOCATOR_KIND_SHM;
+}
+
+bool SharedMemTransport::IsLocatorAllowed(const Locator_t& locator) const
+{
+    // Locators without address are filled with the local one on normalization.
+    return IsLocatorSupported(locator) && (!IsAddressDefined(locator) || is_local_locator(locator));
+}
+
+bool SharedMemTransport::is_local_locator(const Locator_t& locator) const
+{
+    return IsLocatorSupported(locator) && mHostIdValid && memcmp(locator.address, mHostId, sizeof(mHostId)) == 0;
+}
+
+Locator_t SharedMemTransport::RemoteToMainLocal(const Locator_t& remote) const
+{
+    if (!IsLocatorSupported(remote))
+    {
+        return false;
+    }
+
+    Locator_t mainLocal(remote);
+    FillLocalLocator(mainLocal);
+    return mainLocal;
+}
+
+bool SharedMemTransport::OpenOutputChannel(const Locator_t& locator)
+{
+    if (!IsLocatorSupported(locator))
+    {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> scopedLock(mOutputMapMutex);
+    if (mOutputChannelOpen)
+    {
+        return false;
+    }
+
+    mOutputChannelOpen = true;
+    return true;
+}
+
+bool SharedMemTransport::OpenExtraOutputChannel(const Locator_t&)
+{
+    return false;
+}
+
+bool SharedMemTransport::OpenInputChannel(const Locator_t& locator, TransportReceiverInterface* receiver,
+        uint32_t)
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mInputMapMutex);
+    if (!IsLocatorAllowed(locator) || IsInputChannelOpen(locator))
+    {
+        return false;
+    }
+
+    // Cells are sized after our own configuration, as senders check against theirs.
+    SharedMemSegment* segment = SharedMemSegment::create(SegmentName(locator.port),
+        mConfiguration_.ring_cell_count, mConfiguration_.maxMessageSize, mConfiguration_.segment_permissions);
+    if (segment == nullptr)
+    {
+        logInfo(RTPS_MSG_IN, "SharedMemTransport: cannot create segment for port " << locator.port);
+        return false;
+    }
+
+    SharedMemChannelResource* pChannelResource = new SharedMemChannelResource(segment, receiver);
+    pChannelResource->SetThread(new std::thread(&SharedMemTransport::performListenOperation, this,
+        pChannelResource, locator));
+    mInputChannels[locator.port] = pChannelResource;
+
+    logInfo(RTPS_MSG_IN, "SharedMemTransport: listening on segment " << SegmentName(locator.port));
+    return true;
+}
+
+bool SharedMemTransport::CloseOutputChannel(const Locator_t& locator)
+{
+    if (!IsLocatorSupported(locator))
+    {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> scopedLock(mOutputMapMutex);
+    if (!mOutputChannelOpen)
+    {
+        return false;
+    }
+
+    mOutputSegments.clear();
+    mOutputChannelOpen = false;
+    return true;
+}
+
+bool SharedMemTransport::CloseInputChannel(const Locator_t& locator)
+{
+    SharedMemChannelResource* pChannelResource = nullptr;
+    {
+        std::unique_lock<std::recursive_mutex> scopedLock(mInputMapMutex);
+        auto it = mInputChannels.find(locator.port);
+        if (!IsLocatorSupported(locator) || it == mInputChannels.end())
+        {
+            return false;
+        }
+
+        pChannelResource = it->second;
+        mInputChannels.erase(it);
+    }
+
+    // Stops the listening thread and removes the segment.
+    delete pChannelResource;
+    return true;
+}
+
+bool SharedMemTransport::DoInputLocatorsMatch(const Locator_t& left, const Locator_t& right) const
+{
+    return IsLocatorSupported(left) && IsLocatorSupported(right) && left.port == right.port;
+}
+
+bool SharedMemTransport::DoOutputLocatorsMatch(const Locator_t& left, const Locator_t& right) const
+{
+    return IsLocatorSupported(left) && IsLocatorSupported(right);
+}
+
+std::shared_ptr<SharedMemSegment> SharedMemTransport::GetOutputSegment(uint32_t port)
+{
+    std::unique_lock<std::mutex> scopedLock(mOutputMapMutex);
+    if (!mOutputChannelOpen)
+    {
+        return nullptr;
+    }
+
+    auto it = mOutputSegments.find(port);
+    if (it != mOutputSegments.end())
+    {
+        if (!it->second->is_closed())
+        {
+            return it->second;
+        }
+
+        // The listener has gone. Its port may have been taken by another one.
+        mOutputSegments.erase(it);
+    }
+
+    std::shared_ptr<SharedMemSegment> segment(SharedMemSegment::open(SegmentName(port)));
+    if (segment)
+    {
+        mOutputSegments[port] = segment;
+    }
+
+    return segment;
+}
+
+bool SharedMemTransport::Send(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator,
+        const Locator_t& remoteLocator)
+{
+    NetworkBuffer buffer(sendBuffer, sendBufferSize);
+    return SendBuffers(&buffer, 1, sendBufferSize, localLocator, remoteLocator);
+}
+
+bool SharedMemTransport::Send(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes,
+        const Locator_t& localLocator, const Locator_t& remoteLocator)
+{
+    return SendBuffers(buffers.data(), buffers.size(), totalBytes, localLocator, remoteLocator);
+}
+
+bool SharedMemTransport::SendBuffers(const NetworkBuffer* buffers, size_t bufferCount, uint32_t totalBytes,
+        const Locator_t& localLocator, const Locator_t& remoteLocator)
+{
+    if (!IsOutputChannelOpen(localLocator) || !is_local_locator(remoteLocator) ||
+            totalBytes > mConfiguration_.maxMessageSize)
+    {
+        return false;
+    }
+
+    std::shared_ptr<SharedMemSegment> segment = GetOutputSegment(remoteLocator.port);
+    if (!segment)
+    {
+        logInfo(RTPS_MSG_OUT, "SharedMemTransport: nobody listening on port " << remoteLocator.port);
+        return false;
+    }
+
+    if (!segment->push(buffers, bufferCount, totalBytes, static_cast<uint32_t>(getpid())))
+    {
+        logInfo(RTPS_MSG_OUT, "SharedMemTransport: message dropped, segment for port " << remoteLocator.port <<
+            " is full");
+        return false;
+    }
+
+    return true;
+}
+
+bool SharedMemTransport::Send(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator,
+        const Locator_t& remoteLocator, ChannelResource*)
+{
+    return Send(sendBuffer, sendBufferSize, localLocator, remoteLocator);
+}
+
+void SharedMemTransport::performListenOperation(SharedMemChannelResource* pChannelResource,
+        Locator_t input_locator)
+{
+    SharedMemSegment* segment = pChannelResource->GetSegment();
+    Locator_t remoteLocator;
+    FillLocalLocator(remoteLocator);
+
+    const octet* data = nullptr;
+    uint32_t size = 0;
+    uint32_t source_id = 0;
+
+    while (pChannelResource->IsAlive())
+    {
+        if (!segment->wait_message(data, size, source_id))
+        {
+            // Closing the segment is the way Disable() wakes this thread up. Anything else cannot be recovered.
+            if (!segment->is_closed())
+            {
+                logError(RTPS_MSG_IN, "SharedMemTransport: stopped listening on port " << input_locator.port <<
+                    ", cannot wait for messages: " << strerror(errno));
+            }
+            break;
+        }
+
+        // The sender is identified by its process id.
+        remoteLocator.port = source_id;
+
+        TransportReceiverInterface* receiver = pChannelResource->GetMessageReceiver();
+        if (receiver != nullptr)
+        {
+            receiver->OnDataReceived(data, size, input_locator, remoteLocator);
+        }
+        else
+        {
+            logWarning(RTPS_MSG_IN, "Received Message, but no receiver attached");
+        }
+
+        segment->release_message();
+    }
+}
+
+LocatorList_t SharedMemTransport::NormalizeLocator(const Locator_t& locator)
+{
+    LocatorList_t list;
+    Locator_t normalized(locator);
+
+    if (!IsAddressDefined(locator))
+    {
+        FillLocalLocator(normalized);
+    }
+
+    list.push_back(normalized);
+    return list;
+}
+
+LocatorList_t SharedMemTransport::ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists)
+{
+    LocatorList_t result;
+
+    for (const LocatorList_t& locatorList : locatorLists)
+    {
+        for (const Locator_t& locator : locatorList)
+        {
+            result.push_back(locator);
+        }
+    }
+
+    return result;
+}
+
+void SharedMemTransport::AddDefaultOutputLocator(LocatorList_t &defaultList)
+{
+    Locator_t locator;
+    FillLocalLocator(locator);
+    defaultList.push_back(locator);
+}
+
+bool SharedMemTransport::getDefaultMetatrafficMulticastLocators(LocatorList_t&, uint32_t) const
+{
+    // Multicast is left to the network transports.
+    return false;
+}
+
+bool SharedMemTransport::getDefaultMetatrafficUnicastLocators(LocatorList_t &locators,
+        uint32_t metatraffic_unicast_port) const
+{
+    Locator_t locator;
+    FillLocalLocator(locator);
+    locator.port = metatraffic_unicast_port;
+    locators.push_back(locator);
+    return true;
+}
+
+bool SharedMemTransport::getDefaultUnicastLocators(LocatorList_t &locators, uint32_t unicast_port) const
+{
+    Locator_t locator;
+    FillLocalLocator(locator);
+    fillUnicastLocator(locator, unicast_port);
+    locators.push_back(locator);
+    return true;
+}
+
+bool SharedMemTransport::fillMetatrafficMulticastLocator(Locator_t &locator,
+        uint32_t metatraffic_multicast_port) const
+{
+    if (locator.port == 0)
+    {
+        locator.port = metatraffic_multicast_port;
+    }
+    return true;
+}
+
+bool SharedMemTransport::fillMetatrafficUnicastLocator(Locator_t &locator, uint32_t metatraffic_unicast_port) const
+{
+    if (locator.port == 0)
+    {
+        locator.port = metatraffic_unicast_port;
+    }
+    return true;
+}
+
+bool SharedMemTransport::configureInitialPeerLocator(Locator_t &locator, const PortParameters &port_params,
+        uint32_t domainId, LocatorList_t& list) const
+{
+    if (locator.port == 0)
+    {
+        for (uint32_t i = 0; i < mConfiguration_.maxInitialPeersRange; ++i)
+        {
+            Locator_t auxloc(locator);
+            auxloc.port = port_params.getUnicastPort(domainId, i);
+
+            list.push_back(auxloc);
+        }
+    }
+    else
+    {
+        list.push_back(locator);
+    }
+
+    return true;
+}
+
+bool SharedMemTransport::fillUnicastLocator(Locator_t &locator, uint32_t well_known_port) const
+{
+    if (locator.port == 0)
+    {
+        locator.port = well_known_port;
+    }
+    return true;
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
@@ -0,0 +1,282 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SocketReactor.h"
+
+#include <fastrtps/log/Log.h>
+
+#include <cstring>
+
+#if defined(__linux__)
+#define SOCKET_REACTOR_SUPPORTED 1
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+//! Id of the events of the wakeup descriptor.
+static const uint64_t s_wakeupId = 0;
+
+//! Events taken by each call to epoll_wait. Kept small, so ready descriptors are spread among the threads.
+static const int s_maxEventsPerWait = 4;
+
+static std::mutex s_instanceMutex;
+static std::weak_ptr<SocketReactor> s_instance;
+
+bool SocketReactor::is_supported()
+{
+#ifdef SOCKET_REACTOR_SUPPORTED
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::shared_ptr<SocketReactor> SocketReactor::get_instance(uint32_t thread_count)
+{
+    if (!is_supported())
+    {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(s_instanceMutex);
+    std::shared_ptr<SocketReactor> instance = s_instance.lock();
+
+    if (!instance)
+    {
+        instance.reset(new SocketReactor(thread_count));
+        if (instance->threads_.empty())
+        {
+            return nullptr;
+        }
+        s_instance = instance;
+    }
+    else if (instance->thread_count() != thread_count)
+    {
+        logInfo(RTPS_MSG_IN, "Socket reactor already running with " << instance->thread_count() << " threads");
+    }
+
+    return instance;
+}
+
+SocketReactor::SocketReactor(uint32_t thread_count)
+    : epoll_descriptor_(-1)
+    , wakeup_descriptor_(-1)
+    , running_(true)
+    , next_id_(s_wakeupId + 1)
+{
+#ifdef SOCKET_REACTOR_SUPPORTED
+    epoll_descriptor_ = epoll_create1(EPOLL_CLOEXEC);
+    wakeup_descriptor_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+    if (epoll_descriptor_ < 0 || wakeup_descriptor_ < 0)
+    {
+        logError(RTPS_MSG_IN, "Cannot create socket reactor: " << strerror(errno));
+        return;
+    }
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u64 = s_wakeupId;
+    if (epoll_ctl(epoll_descriptor_, EPOLL_CTL_ADD, wakeup_descriptor_, &event) != 0)
+    {
+        logError(RTPS_MSG_IN, "Cannot create socket reactor: " << strerror(errno));
+        return;
+    }
+
+    if (thread_count == 0)
+    {
+        thread_count = 1;
+    }
+
+    for (uint32_t i = 0; i < thread_count; ++i)
+    {
+        threads_.emplace_back(&SocketReactor::run, this);
+    }
+#else
+    (void)thread_count;
+#endif
+}
+
+SocketReactor::~SocketReactor()
+{
+    running_ = false;
+
+#ifdef SOCKET_REACTOR_SUPPORTED
+    if (wakeup_descriptor_ >= 0)
+    {
+        // Never read, so it wakes up every thread.
+        uint64_t value = 1;
+        ssize_t written = write(wakeup_descriptor_, &value, sizeof(value));
+        (void)written;
+    }
+#endif
+
+    for (std::thread& thread : threads_)
+    {
+        if (thread.get_id() == std::this_thread::get_id())
+        {
+            // Last reference released from a handler.
+            thread.detach();
+        }
+        else
+        {
+            thread.join();
+        }
+    }
+
+#ifdef SOCKET_REACTOR_SUPPORTED
+    if (wakeup_descriptor_ >= 0)
+    {
+        close(wakeup_descriptor_);
+    }
+
+    if (epoll_descriptor_ >= 0)
+    {
+        close(epoll_descriptor_);
+    }
+#endif
+}
+
+bool SocketReactor::add(int descriptor, std::function<void()> on_readable)
+{
+#ifdef SOCKET_REACTOR_SUPPORTED
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    uint64_t id = next_id_++;
+    Registration& registration = registrations_[id];
+    registration.descriptor = descriptor;
+    registration.on_readable = std::move(on_readable);
+    registration.running = false;
+    registration.removed = false;
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.u64 = id;
+    if (epoll_ctl(epoll_descriptor_, EPOLL_CTL_ADD, descriptor, &event) != 0)
+    {
+        logWarning(RTPS_MSG_IN, "Cannot add descriptor to the socket reactor: " << strerror(errno));
+        registrations_.erase(id);
+        return false;
+    }
+
+    ids_by_descriptor_[descriptor] = id;
+    return true;
+#else
+    (void)descriptor;
+    (void)on_readable;
+    return false;
+#endif
+}
+
+void SocketReactor::remove(int descriptor)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto id_it = ids_by_descriptor_.find(descriptor);
+    if (id_it == ids_by_descriptor_.end())
+    {
+        return;
+    }
+
+    auto registration_it = registrations_.find(id_it->second);
+    ids_by_descriptor_.erase(id_it);
+
+#ifdef SOCKET_REACTOR_SUPPORTED
+    epoll_ctl(epoll_descriptor_, EPOLL_CTL_DEL, descriptor, nullptr);
+#endif
+
+    Registration& registration = registration_it->second;
+    registration.removed = true;
+    handler_finished_.wait(lock, [&registration]() { return !registration.running; });
+    registrations_.erase(registration_it);
+}
+
+void SocketReactor::run()
+{
+#ifdef SOCKET_REACTOR_SUPPORTED
+    struct epoll_event events[s_maxEventsPerWait];
+
+    while (running_)
+    {
+        int count = epoll_wait(epoll_descriptor_, events, s_maxEventsPerWait, -1);
+        if (count < 0)
+        {
+            if (errno != EINTR)
+            {
+                logWarning(RTPS_MSG_IN, "Error waiting on the socket reactor: " << strerror(errno));
+            }
+            continue;
+        }
+
+        for (int i = 0; i < count && running_; ++i)
+        {
+            if (events[i].data.u64 != s_wakeupId)
+            {
+                dispatch(events[i].data.u64);
+            }
+        }
+    }
+#endif
+}
+
+void SocketReactor::dispatch(uint64_t id)
+{
+    std::function<void()>* on_readable = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = registrations_.find(id);
+        if (it == registrations_.end() || it->second.removed)
+        {
+            return;
+        }
+
+        // The registration is not erased while its handler runs.
+        it->second.running = true;
+        on_readable = &it->second.on_readable;
+    }
+
+    (*on_readable)();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Registration& registration = registrations_.at(id);
+    registration.running = false;
+
+#ifdef SOCKET_REACTOR_SUPPORTED
+    if (!registration.removed)
+    {
+        struct epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN | EPOLLONESHOT;
+        event.data.u64 = id;
+        if (epoll_ctl(epoll_descriptor_, EPOLL_CTL_MOD, registration.descriptor, &event) != 0)
+        {
+            logWarning(RTPS_MSG_IN, "Cannot rearm descriptor on the socket reactor: " << strerror(errno));
+        }
+    }
+#endif
+
+    handler_finished_.notify_all();
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
@@ -0,0 +1,121 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOCKET_REACTOR_H
+#define SOCKET_REACTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+/**
+ * Small pool of threads waiting on a single epoll set, which call a handler each time one of the
+ * registered descriptors becomes readable.
+ * Descriptors are armed one-shot, so a handler never runs concurrently with itself, and it is rearmed
+ * once the handler returns. Handlers should read until the descriptor would block, or a bounded amount
+ * of data, and return.
+ * A single reactor is shared by all the transports of the process that ask for one.
+ */
+class SocketReactor
+{
+public:
+
+    //! Whether reactors are available on this platform.
+    static bool is_supported();
+
+    /**
+     * Returns the reactor of the process, starting it with the given number of threads if it is not running.
+     * It is stopped when the last reference is released.
+     * @return nullptr if reactors are not supported, or the reactor could not be started.
+     */
+    static std::shared_ptr<SocketReactor> get_instance(uint32_t thread_count);
+
+    ~SocketReactor();
+
+    /**
+     * Starts watching a descriptor.
+     * @param descriptor Descriptor to watch. It should be in non-blocking mode.
+     * @param on_readable Handler called from one of the threads of the pool when there is data to read.
+     * @return false if the descriptor could not be added to the set.
+     */
+    bool add(int descriptor, std::function<void()> on_readable);
+
+    /**
+     * Stops watching a descriptor. When it returns, its handler is not running and will not be called again.
+     * It must not be called from the handler itself.
+     */
+    void remove(int descriptor);
+
+    uint32_t thread_count() const
+    {
+        return static_cast<uint32_t>(threads_.size());
+    }
+
+private:
+
+    struct Registration
+    {
+        int descriptor;
+        std::function<void()> on_readable;
+        bool running;
+        bool removed;
+    };
+
+    explicit SocketReactor(uint32_t thread_count);
+
+    SocketReactor(const SocketReactor&) = delete;
+    SocketReactor& operator=(const SocketReactor&) = delete;
+
+    //! Loop of each thread of the pool.
+    void run();
+
+    //! Calls the handler of a registration and rearms its descriptor.
+    void dispatch(uint64_t id);
+
+    int epoll_descriptor_;
+
+    //! Descriptor written to stop the threads.
+    int wakeup_descriptor_;
+
+    std::atomic<bool> running_;
+
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+
+    std::condition_variable handler_finished_;
+
+    //! Registrations by id. Events carry the id, so late events of a removed descriptor are ignored.
+    std::map<uint64_t, Registration> registrations_;
+
+    //! Id of the active registration of each descriptor.
+    std::map<int, uint64_t> ids_by_descriptor_;
+
+    uint64_t next_id_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // SOCKET_REACTOR_H
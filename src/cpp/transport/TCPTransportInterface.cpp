@@ -245,6 +245,19 @@ void TCPTransportInterface::CalculateCRC(TCPHeader &header, const octet *data, u
     header.crc = crc;
 }
 
+void TCPTransportInterface::CalculateCRC(TCPHeader &header, const NetworkBuffer* buffers, size_t bufferCount) const
+{
+    uint32_t crc(0);
+    for (size_t i = 0; i < bufferCount; ++i)
+    {
+        for (uint32_t j = 0; j < buffers[i].size; ++j)
+        {
+            crc = RTCPMessageManager::addToCRC(crc, buffers[i].buffer[j]);
+        }
+    }
+    header.crc = crc;
+}
+
 
 bool TCPTransportInterface::CreateAcceptorSocket(const Locator_t& locator)
 {
@@ -322,6 +335,14 @@ void TCPTransportInterface::FillTCPHeader(TCPHeader& header, const octet* sendBu
     CalculateCRC(header, sendBuffer, sendBufferSize);
 }
 
+void TCPTransportInterface::FillTCPHeader(TCPHeader& header, const NetworkBuffer* buffers, size_t bufferCount,
+        uint32_t totalBytes, uint16_t logicalPort) const
+{
+    header.length = totalBytes + static_cast<uint32_t>(TCPHeader::getSize());
+    header.logicalPort = logicalPort;
+    CalculateCRC(header, buffers, bufferCount);
+}
+
 
 bool TCPTransportInterface::IsOutputChannelBound(const Locator_t& locator) const
 {
@@ -884,15 +905,16 @@ bool TCPTransportInterface::Receive(TCPChannelResource *pChannelResource, octet*
     return success;
 }
 
-size_t TCPTransportInterface::Send(TCPChannelResource *pChannelResource, const octet *data,
-    size_t size, eSocketErrorCodes &errorCode) const
+template<typename ConstBufferSequence>
+size_t TCPTransportInterface::SendBuffers(TCPChannelResource *pChannelResource, const ConstBufferSequence& buffers,
+    eSocketErrorCodes &errorCode) const
 {
     size_t bytesSent = 0;
     try
     {
         asio::error_code ec;
         std::unique_lock<std::recursive_mutex> scopedLock(pChannelResource->GetWriteMutex());
-        bytesSent = pChannelResource->getSocket()->send(asio::buffer(data, size), 0, ec);
+        bytesSent = pChannelResource->getSocket()->send(buffers, 0, ec);
         errorCode = eSocketErrorCodes::eNoError;
     }
     catch (const asio::error_code& error)
@@ -923,57 +945,81 @@ size_t TCPTransportInterface::Send(TCPChannelResource *pChannelResource, const o
     return bytesSent;
 }
 
+size_t TCPTransportInterface::Send(TCPChannelResource *pChannelResource, const octet *data,
+    size_t size, eSocketErrorCodes &errorCode) const
+{
+    return SendBuffers(pChannelResource, asio::buffer(data, size), errorCode);
+}
+
 size_t TCPTransportInterface::Send(TCPChannelResource *pChannelResource, const octet *data, size_t size) const
 {
     eSocketErrorCodes error;
     return Send(pChannelResource, data, size, error);
 }
 
-
-bool TCPTransportInterface::Send(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator,
-    const Locator_t& remoteLocator)
+TCPChannelResource* TCPTransportInterface::GetOutputChannelResource(const Locator_t& remoteLocator,
+    uint32_t sendBufferSize)
 {
     /*
     logInfo(RTCP, " SEND [RTPS Data] to locator " << IPLocator::getPhysicalPort(remoteLocator) << ":" << \
         IPLocator::getLogicalPort(remoteLocator));
     */
 
-    TCPChannelResource* channelResource = nullptr;
+    std::unique_lock<std::mutex> scopedLock(mSocketsMapMutex);
+    if (!IsOutputChannelConnected(remoteLocator) || sendBufferSize > GetConfiguration()->sendBufferSize)
     {
-        std::unique_lock<std::mutex> scopedLock(mSocketsMapMutex);
-        if (!IsOutputChannelConnected(remoteLocator) || sendBufferSize > GetConfiguration()->sendBufferSize)
-        {
-            logWarning(RTCP, "SEND [RTPS] Failed: Not connect: " << IPLocator::getLogicalPort(remoteLocator) \
-                << " @ IP: " << IPLocator::toIPv4string(remoteLocator));
-            return false;
-        }
+        logWarning(RTCP, "SEND [RTPS] Failed: Not connect: " << IPLocator::getLogicalPort(remoteLocator) \
+            << " @ IP: " << IPLocator::toIPv4string(remoteLocator));
+        return nullptr;
+    }
 
-        auto it = mChannelResources.find(IPLocator::toPhysicalLocator(remoteLocator));
-        if (it == mChannelResources.end())
-        {
-            EnqueueLogicalOutputPort(remoteLocator);
-            logInfo(RTCP, "SEND [RTPS] Failed: Not yet bound: " << IPLocator::getLogicalPort(remoteLocator) \
-                << " @ IP: " << IPLocator::toIPv4string(remoteLocator) << " will be bound.");
-            return false;
-        }
-        else
-        {
-            channelResource = it->second;
-        }
+    auto it = mChannelResources.find(IPLocator::toPhysicalLocator(remoteLocator));
+    if (it == mChannelResources.end())
+    {
+        EnqueueLogicalOutputPort(remoteLocator);
+        logInfo(RTCP, "SEND [RTPS] Failed: Not yet bound: " << IPLocator::getLogicalPort(remoteLocator) \
+            << " @ IP: " << IPLocator::toIPv4string(remoteLocator) << " will be bound.");
+        return nullptr;
     }
 
-    bool result = true;
-    if (channelResource != nullptr)
+    return it->second;
+}
+
+bool TCPTransportInterface::Send(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator,
+    const Locator_t& remoteLocator)
+{
+    TCPChannelResource* channelResource = GetOutputChannelResource(remoteLocator, sendBufferSize);
+    if (channelResource == nullptr)
     {
-        result = result && Send(sendBuffer, sendBufferSize, localLocator, remoteLocator, channelResource);
+        return false;
     }
-    return result;
+
+    return Send(sendBuffer, sendBufferSize, localLocator, remoteLocator, channelResource);
 }
 
 bool TCPTransportInterface::Send(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& /*localLocator*/,
     const Locator_t& remoteLocator, ChannelResource *pChannelResource)
 {
-    TCPChannelResource* tcpChannelResource = dynamic_cast<TCPChannelResource*>(pChannelResource);
+    NetworkBuffer buffer(sendBuffer, sendBufferSize);
+    return SendThroughChannel(&buffer, 1, sendBufferSize, remoteLocator,
+        dynamic_cast<TCPChannelResource*>(pChannelResource));
+}
+
+bool TCPTransportInterface::Send(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes,
+    const Locator_t& /*localLocator*/, const Locator_t& remoteLocator)
+{
+    TCPChannelResource* channelResource = GetOutputChannelResource(remoteLocator, totalBytes);
+    if (channelResource == nullptr)
+    {
+        return false;
+    }
+
+    return SendThroughChannel(buffers.data(), buffers.size(), totalBytes, remoteLocator, channelResource);
+}
+
+bool TCPTransportInterface::SendThroughChannel(const NetworkBuffer* buffers, size_t bufferCount, uint32_t totalBytes,
+    const Locator_t& remoteLocator, TCPChannelResource* tcpChannelResource)
+{
     if (tcpChannelResource != nullptr && tcpChannelResource->IsConnectionEstablished())
     {
         bool success = false;
@@ -991,17 +1037,18 @@ bool TCPTransportInterface::Send(const octet* sendBuffer, uint32_t sendBufferSiz
             if (bConnected && tcpChannelResource->IsLogicalPortOpened(logicalPort))
             {
                 TCPHeader tcp_header;
-                FillTCPHeader(tcp_header, sendBuffer, sendBufferSize, logicalPort);
+                FillTCPHeader(tcp_header, buffers, bufferCount, totalBytes, logicalPort);
 
+                // The header and the message are written at once.
+                std::vector<asio::const_buffer> asioBuffers;
+                asioBuffers.reserve(bufferCount + 1);
+                asioBuffers.push_back(asio::buffer(&tcp_header, TCPHeader::getSize()));
+                for (size_t i = 0; i < bufferCount; ++i)
                 {
-                    std::unique_lock<std::recursive_mutex> sendLock(tcpChannelResource->GetWriteMutex());
-                    success = SendThroughSocket((octet*)&tcp_header, static_cast<uint32_t>(TCPHeader::getSize()), remoteLocator, tcpChannelResource);
-
-                    if (success)
-                    {
-                        success = SendThroughSocket(sendBuffer, sendBufferSize, remoteLocator, tcpChannelResource);
-                    }
+                    asioBuffers.push_back(asio::buffer(buffers[i].buffer, buffers[i].size));
                 }
+
+                success = SendThroughSocket(asioBuffers, tcp_header.length, remoteLocator, tcpChannelResource);
             }
         }
         else
@@ -1020,7 +1067,7 @@ bool TCPTransportInterface::Send(const octet* sendBuffer, uint32_t sendBufferSiz
     }
 }
 
-bool TCPTransportInterface::SendThroughSocket(const octet* sendBuffer, uint32_t sendBufferSize,
+bool TCPTransportInterface::SendThroughSocket(const std::vector<asio::const_buffer>& buffers, uint32_t totalBytes,
     const Locator_t& remoteLocator, TCPChannelResource *socket)
 {
     auto destinationEndpoint = GenerateEndpoint(remoteLocator, IPLocator::getPhysicalPort(remoteLocator));
@@ -1031,21 +1078,22 @@ bool TCPTransportInterface::SendThroughSocket(const octet* sendBuffer, uint32_t
     //logInfo(RTCP, "SOCKET SEND to physical port " << socket->getSocket()->remote_endpoint().port());
 
     eSocketErrorCodes errorCode;
-    bytesSent = Send(socket, sendBuffer, sendBufferSize, errorCode);
+    bytesSent = SendBuffers(socket, buffers, errorCode);
     switch (errorCode)
     {
     case eNoError:
-        //logInfo(RTCP, " Sent [OK]: " << sendBufferSize << " bytes to locator " << IPLocator::getLogicalPort(remoteLocator));
+        //logInfo(RTCP, " Sent [OK]: " << totalBytes << " bytes to locator " << IPLocator::getLogicalPort(remoteLocator));
         break;
     default:
         // Inform that connection has been lost
-        logInfo(RTCP, " Sent [FAILED]: " << sendBufferSize << " bytes to locator " << IPLocator::getLogicalPort(remoteLocator) << " ERROR=" << errorCode);
+        logInfo(RTCP, " Sent [FAILED]: " << totalBytes << " bytes to locator " << IPLocator::getLogicalPort(remoteLocator) << " ERROR=" << errorCode);
         //socket->ConnectionLost();
         CloseTCPSocket(socket);
         break;
     }
 
-    logInfo(RTCP_MSG_OUT, "[SENT] TO " << remoteLocator << " - " << sendBufferSize << " (" << bytesSent << ").");
+    (void)totalBytes;
+    logInfo(RTCP_MSG_OUT, "[SENT] TO " << remoteLocator << " - " << totalBytes << " (" << bytesSent << ").");
     return bytesSent > 0;
 }
 
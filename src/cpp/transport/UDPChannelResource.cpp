@@ -22,14 +22,18 @@ namespace rtps {
 
 UDPChannelResource::UDPChannelResource(eProsimaUDPSocket& socket)
     : mMsgReceiver(nullptr)
+    , mReceiveBuffers(std::make_shared<ReceiveBufferPool>(m_rec_msg.max_size))
+    , mReceiveBuffer(nullptr)
     , socket_(moveSocket(socket))
     , only_multicast_purpose_(false)
 {
 }
 
 UDPChannelResource::UDPChannelResource(eProsimaUDPSocket& socket, uint32_t maxMsgSize)
-    : ChannelResource(maxMsgSize)
+    : ChannelResource(0)
     , mMsgReceiver(nullptr)
+    , mReceiveBuffers(std::make_shared<ReceiveBufferPool>(maxMsgSize))
+    , mReceiveBuffer(nullptr)
     , socket_(moveSocket(socket))
     , only_multicast_purpose_(false)
 {
@@ -37,15 +41,42 @@ UDPChannelResource::UDPChannelResource(eProsimaUDPSocket& socket, uint32_t maxMs
 
 UDPChannelResource::UDPChannelResource(UDPChannelResource&& channelResource)
     : mMsgReceiver(channelResource.mMsgReceiver)
+    , mReceiveBuffers(std::move(channelResource.mReceiveBuffers))
+    , mReceiveBuffer(channelResource.mReceiveBuffer)
     , socket_(moveSocket(channelResource.socket_))
     , only_multicast_purpose_(channelResource.only_multicast_purpose_)
 {
     channelResource.mMsgReceiver = nullptr;
+    channelResource.mReceiveBuffer = nullptr;
 }
 
 UDPChannelResource::~UDPChannelResource()
 {
+    // The receiving thread uses the buffers, so it is joined before they are released. The base destructor would
+    // only join it after the members are destroyed.
+    Clear();
+
     mMsgReceiver = nullptr;
+    if (mReceiveBuffer != nullptr)
+    {
+        mReceiveBuffer->release();
+    }
+}
+
+ReceiveBuffer& UDPChannelResource::GetReceiveBuffer()
+{
+    if (mReceiveBuffer != nullptr && !mReceiveBuffer->unique())
+    {
+        mReceiveBuffer->release();
+        mReceiveBuffer = nullptr;
+    }
+
+    if (mReceiveBuffer == nullptr)
+    {
+        mReceiveBuffer = mReceiveBuffers->acquire();
+    }
+
+    return *mReceiveBuffer;
 }
 
 } // namespace rtps
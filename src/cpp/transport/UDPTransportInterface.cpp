@@ -21,6 +21,17 @@
 #include <fastrtps/log/Log.h>
 #include <fastrtps/utils/Semaphore.h>
 #include <fastrtps/utils/IPLocator.h>
+#include "SocketReactor.h"
+
+#if defined(__linux__)
+#include <sys/file.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#define FASTRTPS_UDP_BATCHED_IO
+#define FASTRTPS_UDP_REUSEPORT_SHARDING
+#endif
 
 using namespace std;
 using namespace asio;
@@ -29,6 +40,51 @@ namespace eprosima{
 namespace fastrtps{
 namespace rtps {
 
+#ifdef FASTRTPS_UDP_REUSEPORT_SHARDING
+/**
+ * Exclusive lock on a file named after a port. Participants of this host hold it while they check that a port is
+ * free and bind the sockets sharing it, so two of them cannot both find it free and end up sharing it.
+ */
+class PortBindingLock
+{
+public:
+
+    explicit PortBindingLock(uint16_t port)
+    {
+        std::string path = "/tmp/fastrtps_udp_port_" + std::to_string(port) + ".lock";
+        fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+        if (fd_ < 0)
+        {
+            logWarning(RTPS_MSG_IN, "Cannot open " << path << ", port " << port << " is bound without locking it: "
+                << strerror(errno));
+            return;
+        }
+
+        // Lets other users lock it too. Fails harmlessly when the file is not ours.
+        fchmod(fd_, 0666);
+        while (flock(fd_, LOCK_EX) != 0 && errno == EINTR)
+        {
+        }
+    }
+
+    //! Closing the file releases the lock.
+    ~PortBindingLock()
+    {
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+        }
+    }
+
+private:
+
+    PortBindingLock(const PortBindingLock&) = delete;
+    PortBindingLock& operator=(const PortBindingLock&) = delete;
+
+    int fd_;
+};
+#endif
+
 struct MultiUniLocatorsLinkage
 {
     MultiUniLocatorsLinkage(LocatorList_t&& m, LocatorList_t&& u)
@@ -44,18 +100,25 @@ struct MultiUniLocatorsLinkage
 UDPTransportDescriptor::UDPTransportDescriptor()
     : SocketTransportDescriptor(s_maximumMessageSize, s_maximumInitialPeersRange)
     , m_output_udp_socket(0)
+    , max_messages_per_batch(1)
+    , reactor_threads(0)
+    , unicast_sockets_per_port(1)
 {
 }
 
 UDPTransportDescriptor::UDPTransportDescriptor(const UDPTransportDescriptor& t)
     : SocketTransportDescriptor(t)
     , m_output_udp_socket(t.m_output_udp_socket)
+    , max_messages_per_batch(t.max_messages_per_batch)
+    , reactor_threads(t.reactor_threads)
+    , unicast_sockets_per_port(t.unicast_sockets_per_port)
 {
 }
 
 UDPTransportInterface::UDPTransportInterface()
 : mSendBufferSize(0)
 , mReceiveBufferSize(0)
+, mUnicastSocketsPerPort(1)
 {
 }
 
@@ -82,11 +145,32 @@ bool UDPTransportInterface::CloseInputChannel(const Locator_t& locator)
 
     }
 
+    // The kernel picks which of the sockets sharing a port gets each datagram, so a close datagram may not reach
+    // the right one. Shutting the socket down wakes its thread instead.
+    bool shared_port = !IPLocator::isMulticast(locator) && mUnicastSocketsPerPort > 1;
+
     for (auto* channelResource : pChannelResources)
     {
-        ReleaseInputChannel(locator, channelResource);
+        if (mReactor)
+        {
+            // No thread to unblock. Once removed, the reactor will not call into the channel again.
+            channelResource->Disable();
+            mReactor->remove(channelResource->getSocket()->native_handle());
+        }
+        else if (shared_port)
+        {
+            channelResource->Disable();
+            asio::error_code ec;
+            channelResource->getSocket()->shutdown(socket_base::shutdown_receive, ec);
+        }
+        else
+        {
+            ReleaseInputChannel(locator, channelResource);
+        }
         channelResource->getSocket()->cancel();
         channelResource->getSocket()->close();
+        // Wait for the receiving thread to leave the channel before destroying it.
+        channelResource->Clear();
         delete channelResource;
     }
 
@@ -174,6 +258,28 @@ bool UDPTransportInterface::init()
         return false;
     }
 
+    if (GetConfiguration()->reactor_threads > 0)
+    {
+        mReactor = SocketReactor::get_instance(GetConfiguration()->reactor_threads);
+        if (!mReactor)
+        {
+            logWarning(RTPS_MSG_IN, "Socket reactor not available. Using a thread per input channel");
+        }
+    }
+
+    mUnicastSocketsPerPort = 1;
+    if (GetConfiguration()->unicast_sockets_per_port > 1)
+    {
+        if (IsReusePortSupported())
+        {
+            mUnicastSocketsPerPort = GetConfiguration()->unicast_sockets_per_port;
+        }
+        else
+        {
+            logWarning(RTPS_MSG_IN, "SO_REUSEPORT not supported. Using a single socket per unicast port");
+        }
+    }
+
     // TODO(Ricardo) Create an event that update this list.
     GetIPs(currentInterfaces);
 
@@ -191,6 +297,35 @@ bool UDPTransportInterface::IsLocatorSupported(const Locator_t& locator) const
     return locator.kind == mTransportKind;
 }
 
+uint32_t UDPTransportInterface::max_concurrent_receptions(const Locator_t& locator) const
+{
+    if (IsLocatorSupported(locator) && !IPLocator::isMulticast(locator))
+    {
+        return mUnicastSocketsPerPort;
+    }
+    return 1;
+}
+
+bool UDPTransportInterface::IsReusePortSupported()
+{
+#ifdef FASTRTPS_UDP_REUSEPORT_SHARDING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void UDPTransportInterface::SetReusePort(eProsimaUDPSocket& socket)
+{
+#ifdef FASTRTPS_UDP_REUSEPORT_SHARDING
+    typedef asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT> reuse_port;
+    getSocketPtr(socket)->set_option(reuse_port(true));
+#else
+    (void)socket;
+    assert(false);
+#endif
+}
+
 bool UDPTransportInterface::IsOutputChannelOpen(const Locator_t& locator) const
 {
     std::unique_lock<std::recursive_mutex> scopedLock(mOutputMapMutex);
@@ -207,12 +342,33 @@ bool UDPTransportInterface::OpenAndBindInputSockets(const Locator_t& locator, Tr
 
     try
     {
+        uint32_t sockets_per_interface = is_multicast ? 1 : mUnicastSocketsPerPort;
+#ifdef FASTRTPS_UDP_REUSEPORT_SHARDING
+        // The plain socket below must be closed before the shared ones can bind. Held until all of them are bound,
+        // so no other participant finds the port free in between.
+        std::unique_ptr<PortBindingLock> port_lock;
+        if (sockets_per_interface > 1)
+        {
+            port_lock.reset(new PortBindingLock(IPLocator::getPhysicalPort(locator)));
+        }
+#endif
         std::vector<std::string> vInterfaces = GetBindingInterfacesList();
         for (std::string sInterface : vInterfaces)
         {
-            UDPChannelResource* pChannelResource; 
-            pChannelResource = CreateInputChannelResource(sInterface, locator, is_multicast, maxMsgSize, receiver);
-            mInputSockets[IPLocator::getPhysicalPort(locator)].push_back(pChannelResource);
+            if (sockets_per_interface > 1)
+            {
+                // Binding with SO_REUSEPORT succeeds even if another participant already shares the port that way.
+                // A plain socket, closed right away, fails in that case and keeps the port exclusive.
+                OpenAndBindInputSocket(sInterface, IPLocator::getPhysicalPort(locator), false, false);
+            }
+
+            for (uint32_t i = 0; i < sockets_per_interface; ++i)
+            {
+                UDPChannelResource* pChannelResource;
+                pChannelResource = CreateInputChannelResource(sInterface, locator, is_multicast, maxMsgSize, receiver,
+                    sockets_per_interface > 1);
+                mInputSockets[IPLocator::getPhysicalPort(locator)].push_back(pChannelResource);
+            }
         }
     }
     catch (asio::system_error const& e)
@@ -220,6 +376,8 @@ bool UDPTransportInterface::OpenAndBindInputSockets(const Locator_t& locator, Tr
         (void)e;
         logInfo(RTPS_MSG_OUT, "UDPTransport Error binding at port: (" << IPLocator::getPhysicalPort(locator) << ")"
             << " with msg: " << e.what());
+        // Releases the sockets already opened for the port, if any.
+        CloseInputChannel(locator);
         mInputSockets.erase(IPLocator::getPhysicalPort(locator));
         return false;
     }
@@ -228,12 +386,26 @@ bool UDPTransportInterface::OpenAndBindInputSockets(const Locator_t& locator, Tr
 }
 
 UDPChannelResource* UDPTransportInterface::CreateInputChannelResource(const std::string& sInterface, const Locator_t& locator, 
-    bool is_multicast, uint32_t maxMsgSize, TransportReceiverInterface* receiver)
+    bool is_multicast, uint32_t maxMsgSize, TransportReceiverInterface* receiver, bool reuse_port)
 {
-    eProsimaUDPSocket unicastSocket = OpenAndBindInputSocket(sInterface, IPLocator::getPhysicalPort(locator), is_multicast);
+    eProsimaUDPSocket unicastSocket = OpenAndBindInputSocket(sInterface, IPLocator::getPhysicalPort(locator), is_multicast,
+        reuse_port);
     UDPChannelResource* pChannelResource = new UDPChannelResource(unicastSocket, maxMsgSize);
     pChannelResource->SetMessageReceiver(receiver);
     pChannelResource->SetInterface(sInterface);
+
+    if (mReactor)
+    {
+        pChannelResource->getSocket()->non_blocking(true);
+        if (!mReactor->add(pChannelResource->getSocket()->native_handle(),
+                [this, pChannelResource, locator]() { performReactorReceive(pChannelResource, locator); }))
+        {
+            delete pChannelResource;
+            throw asio::system_error(asio::error::no_memory);
+        }
+        return pChannelResource;
+    }
+
     std::thread* newThread = new std::thread(&UDPTransportInterface::performListenOperation, this,
         pChannelResource, locator);
     pChannelResource->SetThread(newThread);
@@ -356,20 +528,165 @@ bool UDPTransportInterface::OpenExtraOutputChannel(const Locator_t&)
 
 void UDPTransportInterface::performListenOperation(UDPChannelResource* pChannelResource, Locator_t input_locator)
 {
+#ifdef FASTRTPS_UDP_BATCHED_IO
+    if (GetConfiguration()->max_messages_per_batch > 1)
+    {
+        performBatchedListenOperation(pChannelResource, input_locator);
+        return;
+    }
+#endif
+
     Locator_t remoteLocator;
 
     while (pChannelResource->IsAlive())
     {
         // Blocking receive.
-        auto& msg = pChannelResource->GetMessageBuffer();
-        if (!Receive(pChannelResource, msg.buffer, msg.max_size, msg.length, remoteLocator))
+        ReceiveBuffer& buffer = pChannelResource->GetReceiveBuffer();
+        uint32_t length = 0;
+        if (!Receive(pChannelResource, buffer.data(), buffer.max_size(), length, remoteLocator))
             continue;
 
         // Processes the data through the CDR Message interface.
         auto receiver = pChannelResource->GetMessageReceiver();
         if (receiver != nullptr)
         {
-            receiver->OnDataReceived(msg.buffer, msg.length, input_locator, remoteLocator);
+            receiver->OnDataReceived(buffer, length, input_locator, remoteLocator);
+        }
+        else
+        {
+            logWarning(RTPS_MSG_IN, "Received Message, but no receiver attached");
+        }
+    }
+}
+
+#ifdef FASTRTPS_UDP_BATCHED_IO
+void UDPTransportInterface::performBatchedListenOperation(UDPChannelResource* pChannelResource,
+    Locator_t input_locator)
+{
+    const uint32_t batch_size = GetConfiguration()->max_messages_per_batch;
+    const std::shared_ptr<ReceiveBufferPool>& pool = pChannelResource->GetReceiveBufferPool();
+
+    // Receive slots, refilled by each recvmmsg call once the previous batch has been processed.
+    // Slots whose buffer is still referenced by received payloads take a new one from the pool.
+    std::vector<ReceiveBuffer*> buffers(batch_size, nullptr);
+    std::vector<ip::udp::endpoint> senders(batch_size);
+    std::vector<struct iovec> iovecs(batch_size);
+    std::vector<struct mmsghdr> headers(batch_size);
+
+    for (uint32_t i = 0; i < batch_size; ++i)
+    {
+        memset(&headers[i], 0, sizeof(struct mmsghdr));
+        headers[i].msg_hdr.msg_iov = &iovecs[i];
+        headers[i].msg_hdr.msg_iovlen = 1;
+        headers[i].msg_hdr.msg_name = senders[i].data();
+    }
+
+    Locator_t remoteLocator;
+
+    while (pChannelResource->IsAlive())
+    {
+        for (uint32_t i = 0; i < batch_size; ++i)
+        {
+            if (buffers[i] != nullptr && !buffers[i]->unique())
+            {
+                buffers[i]->release();
+                buffers[i] = nullptr;
+            }
+            if (buffers[i] == nullptr)
+            {
+                buffers[i] = pool->acquire();
+                iovecs[i].iov_base = buffers[i]->data();
+                iovecs[i].iov_len = buffers[i]->max_size();
+            }
+            headers[i].msg_hdr.msg_namelen = static_cast<socklen_t>(senders[i].capacity());
+        }
+
+        // Blocks until the first datagram arrives, then takes whatever else is already queued.
+        int received = recvmmsg(pChannelResource->getSocket()->native_handle(), headers.data(), batch_size,
+            MSG_WAITFORONE, nullptr);
+        if (received < 0)
+        {
+            if (errno != EINTR)
+            {
+                logWarning(RTPS_MSG_IN, "Error receiving data: " << strerror(errno));
+            }
+            continue;
+        }
+
+        for (int i = 0; i < received; ++i)
+        {
+            const octet* receiveBuffer = buffers[i]->data();
+            uint32_t receiveBufferSize = headers[i].msg_len;
+
+            if (receiveBufferSize == 0 ||
+                    (receiveBufferSize == 13 && memcmp(receiveBuffer, "EPRORTPSCLOSE", 13) == 0))
+            {
+                continue;
+            }
+
+            senders[i].resize(headers[i].msg_hdr.msg_namelen);
+            EndpointToLocator(senders[i], remoteLocator);
+
+            // Processes the data through the CDR Message interface.
+            auto receiver = pChannelResource->GetMessageReceiver();
+            if (receiver != nullptr)
+            {
+                receiver->OnDataReceived(*buffers[i], receiveBufferSize, input_locator, remoteLocator);
+            }
+            else
+            {
+                logWarning(RTPS_MSG_IN, "Received Message, but no receiver attached");
+            }
+        }
+    }
+
+    for (ReceiveBuffer* buffer : buffers)
+    {
+        if (buffer != nullptr)
+        {
+            buffer->release();
+        }
+    }
+}
+#endif
+
+void UDPTransportInterface::performReactorReceive(UDPChannelResource* pChannelResource,
+    const Locator_t& input_locator)
+{
+    // Bounds the time a busy channel keeps a thread of the reactor.
+    static const uint32_t s_maxDatagramsPerWakeup = 64;
+
+    ip::udp::endpoint senderEndpoint;
+    Locator_t remoteLocator;
+
+    for (uint32_t i = 0; i < s_maxDatagramsPerWakeup && pChannelResource->IsAlive(); ++i)
+    {
+        ReceiveBuffer& buffer = pChannelResource->GetReceiveBuffer();
+        asio::error_code ec;
+        size_t bytes = pChannelResource->getSocket()->receive_from(asio::buffer(buffer.data(), buffer.max_size()),
+            senderEndpoint, 0, ec);
+        if (ec)
+        {
+            if (ec != asio::error::would_block && ec != asio::error::try_again)
+            {
+                logWarning(RTPS_MSG_IN, "Error receiving data: " << ec.message());
+            }
+            return;
+        }
+
+        uint32_t length = static_cast<uint32_t>(bytes);
+        if (length == 0 || (length == 13 && memcmp(buffer.data(), "EPRORTPSCLOSE", 13) == 0))
+        {
+            continue;
+        }
+
+        EndpointToLocator(senderEndpoint, remoteLocator);
+
+        // Processes the data through the CDR Message interface.
+        auto receiver = pChannelResource->GetMessageReceiver();
+        if (receiver != nullptr)
+        {
+            receiver->OnDataReceived(buffer, length, input_locator, remoteLocator);
         }
         else
         {
@@ -474,7 +791,8 @@ Locator_t UDPTransportInterface::RemoteToMainLocal(const Locator_t& remote) cons
 bool UDPTransportInterface::Send(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator, const Locator_t& remoteLocator)
 {
     std::unique_lock<std::recursive_mutex> scopedLock(mOutputMapMutex);
-    if (!IsOutputChannelOpen(localLocator) || sendBufferSize > GetConfiguration()->sendBufferSize)
+    if (!IsOutputChannelOpen(localLocator) || !IsLocatorSupported(remoteLocator) ||
+            sendBufferSize > GetConfiguration()->sendBufferSize)
         return false;
 
     bool success = false;
@@ -495,7 +813,125 @@ bool UDPTransportInterface::Send(const octet* sendBuffer, uint32_t sendBufferSiz
     return SendThroughSocket(sendBuffer, sendBufferSize, remoteLocator, getRefFromPtr(udpSocket->getSocket()));
 }
 
-bool UDPTransportInterface::SendThroughSocket(const octet* sendBuffer, uint32_t sendBufferSize,
+bool UDPTransportInterface::Send(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes,
+    const Locator_t& localLocator, const Locator_t& remoteLocator)
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mOutputMapMutex);
+    if (!IsOutputChannelOpen(localLocator) || !IsLocatorSupported(remoteLocator) ||
+            totalBytes > GetConfiguration()->sendBufferSize)
+        return false;
+
+    std::vector<asio::const_buffer> asioBuffers;
+    asioBuffers.reserve(buffers.size());
+    for (const NetworkBuffer& buffer : buffers)
+    {
+        asioBuffers.push_back(asio::buffer(buffer.buffer, buffer.size));
+    }
+
+    bool success = false;
+    bool is_multicast_remote_address = IPLocator::isMulticast(remoteLocator);
+
+    for (auto& socket : mOutputSockets)
+    {
+        if (is_multicast_remote_address || !socket->only_multicast_purpose())
+            success |= SendBuffersThroughSocket(asioBuffers, remoteLocator, getRefFromPtr(socket->getSocket()));
+    }
+
+    return success;
+}
+
+bool UDPTransportInterface::SendToLocators(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes,
+    const Locator_t& localLocator, const LocatorList_t& remoteLocators)
+{
+#ifdef FASTRTPS_UDP_BATCHED_IO
+    if (GetConfiguration()->max_messages_per_batch > 1 && remoteLocators.size() > 1)
+    {
+        std::unique_lock<std::recursive_mutex> scopedLock(mOutputMapMutex);
+        if (!IsOutputChannelOpen(localLocator) || totalBytes > GetConfiguration()->sendBufferSize)
+            return false;
+
+        bool success = false;
+
+        for (auto& socket : mOutputSockets)
+        {
+            success |= SendBatchThroughSocket(buffers, totalBytes, remoteLocators,
+                socket->only_multicast_purpose(), getRefFromPtr(socket->getSocket()));
+        }
+
+        return success;
+    }
+#endif
+
+    return TransportInterface::SendToLocators(buffers, totalBytes, localLocator, remoteLocators);
+}
+
+#ifdef FASTRTPS_UDP_BATCHED_IO
+bool UDPTransportInterface::SendBatchThroughSocket(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes,
+    const LocatorList_t& remoteLocators, bool only_multicast, eProsimaUDPSocketRef socket)
+{
+    std::vector<ip::udp::endpoint> destinations;
+    destinations.reserve(remoteLocators.size());
+
+    for (const Locator_t& remoteLocator : remoteLocators)
+    {
+        if (IsLocatorSupported(remoteLocator) && (!only_multicast || IPLocator::isMulticast(remoteLocator)))
+        {
+            destinations.push_back(GenerateEndpoint(remoteLocator, IPLocator::getPhysicalPort(remoteLocator)));
+        }
+    }
+
+    if (destinations.empty())
+    {
+        return false;
+    }
+
+    // All datagrams share the same slices.
+    std::vector<struct iovec> iov(buffers.size());
+    for (size_t i = 0; i < buffers.size(); ++i)
+    {
+        iov[i].iov_base = const_cast<octet*>(buffers[i].buffer);
+        iov[i].iov_len = buffers[i].size;
+    }
+
+    std::vector<struct mmsghdr> headers(std::min<size_t>(GetConfiguration()->max_messages_per_batch,
+        destinations.size()));
+    size_t next = 0;
+    bool success = false;
+
+    while (next < destinations.size())
+    {
+        size_t count = std::min(headers.size(), destinations.size() - next);
+        for (size_t i = 0; i < count; ++i)
+        {
+            memset(&headers[i], 0, sizeof(struct mmsghdr));
+            headers[i].msg_hdr.msg_name = destinations[next + i].data();
+            headers[i].msg_hdr.msg_namelen = static_cast<socklen_t>(destinations[next + i].size());
+            headers[i].msg_hdr.msg_iov = iov.data();
+            headers[i].msg_hdr.msg_iovlen = iov.size();
+        }
+
+        int sent = sendmmsg(getSocketPtr(socket)->native_handle(), headers.data(), static_cast<unsigned int>(count), 0);
+        if (sent <= 0)
+        {
+            // The first datagram of the batch failed. Skip its destination and go on with the rest.
+            logWarning(RTPS_MSG_OUT, "Error sending to " << destinations[next] << ": " << strerror(errno));
+            ++next;
+            continue;
+        }
+
+        success = true;
+        next += static_cast<size_t>(sent);
+    }
+
+    (void)totalBytes;
+    logInfo(RTPS_MSG_OUT, "UDPTransport: " << totalBytes << " bytes TO " << destinations.size()
+        << " endpoints FROM " << getSocketPtr(socket)->local_endpoint());
+    return success;
+}
+#endif
+
+template<typename ConstBufferSequence>
+bool UDPTransportInterface::SendBuffersThroughSocket(const ConstBufferSequence& buffers,
     const Locator_t& remoteLocator, eProsimaUDPSocketRef socket)
 {
     auto destinationEndpoint = GenerateEndpoint(remoteLocator, IPLocator::getPhysicalPort(remoteLocator));
@@ -504,7 +940,7 @@ bool UDPTransportInterface::SendThroughSocket(const octet* sendBuffer, uint32_t
 
     try
     {
-        bytesSent = getSocketPtr(socket)->send_to(asio::buffer(sendBuffer, sendBufferSize), destinationEndpoint);
+        bytesSent = getSocketPtr(socket)->send_to(buffers, destinationEndpoint);
     }
     catch (const std::exception& error)
     {
@@ -518,6 +954,12 @@ bool UDPTransportInterface::SendThroughSocket(const octet* sendBuffer, uint32_t
     return true;
 }
 
+bool UDPTransportInterface::SendThroughSocket(const octet* sendBuffer, uint32_t sendBufferSize,
+    const Locator_t& remoteLocator, eProsimaUDPSocketRef socket)
+{
+    return SendBuffersThroughSocket(asio::buffer(sendBuffer, sendBufferSize), remoteLocator, socket);
+}
+
 LocatorList_t UDPTransportInterface::ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists)
 {
     LocatorList_t multicastResult, unicastResult;
@@ -241,7 +241,8 @@ void UDPv4Transport::GetIPs(std::vector<IPFinder::info_IP>& locNames, bool retur
     GetIP4s(locNames, return_loopback);
 }
 
-eProsimaUDPSocket UDPv4Transport::OpenAndBindInputSocket(const std::string& sIp, uint16_t port, bool is_multicast)
+eProsimaUDPSocket UDPv4Transport::OpenAndBindInputSocket(const std::string& sIp, uint16_t port, bool is_multicast,
+    bool reuse_port)
 {
     eProsimaUDPSocket socket = createUDPSocket(mService);
     getSocketPtr(socket)->open(GenerateProtocol());
@@ -255,6 +256,11 @@ eProsimaUDPSocket UDPv4Transport::OpenAndBindInputSocket(const std::string& sIp,
         getSocketPtr(socket)->set_option(ip::udp::socket::reuse_address(true));
     }
 
+    if (reuse_port)
+    {
+        SetReusePort(socket);
+    }
+
     getSocketPtr(socket)->bind(GenerateEndpoint(sIp, port));
     return socket;
 }
@@ -300,7 +306,8 @@ bool UDPv4Transport::OpenInputChannel(const Locator_t& locator, TransportReceive
                 {
                     // Bind to multicast address
                     UDPChannelResource* pChannelResource;
-                    pChannelResource = CreateInputChannelResource(locatorAddressStr, locator, true, maxMsgSize, receiver);
+                    pChannelResource = CreateInputChannelResource(locatorAddressStr, locator, true, maxMsgSize, receiver,
+                        false);
                     mInputSockets[IPLocator::getPhysicalPort(locator)].push_back(pChannelResource);
 
                     // Join group on all whitelisted interfaces
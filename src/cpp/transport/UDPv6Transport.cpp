@@ -242,7 +242,8 @@ void UDPv6Transport::GetIPs(std::vector<IPFinder::info_IP>& locNames, bool retur
     GetIP6s(locNames, return_loopback);
 }
 
-eProsimaUDPSocket UDPv6Transport::OpenAndBindInputSocket(const std::string& sIp, uint16_t port, bool is_multicast)
+eProsimaUDPSocket UDPv6Transport::OpenAndBindInputSocket(const std::string& sIp, uint16_t port, bool is_multicast,
+    bool reuse_port)
 {
     eProsimaUDPSocket socket = createUDPSocket(mService);
     getSocketPtr(socket)->open(GenerateProtocol());
@@ -256,6 +257,11 @@ eProsimaUDPSocket UDPv6Transport::OpenAndBindInputSocket(const std::string& sIp,
         getSocketPtr(socket)->set_option(ip::udp::socket::reuse_address(true));
     }
 
+    if (reuse_port)
+    {
+        SetReusePort(socket);
+    }
+
     getSocketPtr(socket)->bind(GenerateEndpoint(sIp, port));
 
     return socket;
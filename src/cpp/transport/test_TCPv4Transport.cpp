@@ -176,6 +176,12 @@ void test_TCPv4Transport::CalculateCRC(TCPHeader &header, const octet *data, uin
     }
 }
 
+bool test_TCPv4Transport::Send(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes,
+        const Locator_t& localLocator, const Locator_t& remoteLocator)
+{
+    return TransportInterface::Send(buffers, totalBytes, localLocator, remoteLocator);
+}
+
 static bool ReadSubmessageHeader(CDRMessage_t& msg, SubmessageHeader_t& smh)
 {
     if(msg.length - msg.pos < 4)
@@ -91,6 +91,18 @@ bool test_UDPv4Transport::Send(const octet* sendBuffer, uint32_t sendBufferSize,
     }
 }
 
+bool test_UDPv4Transport::Send(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes,
+        const Locator_t& localLocator, const Locator_t& remoteLocator)
+{
+    return TransportInterface::Send(buffers, totalBytes, localLocator, remoteLocator);
+}
+
+bool test_UDPv4Transport::SendToLocators(const std::vector<NetworkBuffer>& buffers, uint32_t totalBytes,
+        const Locator_t& localLocator, const LocatorList_t& remoteLocators)
+{
+    return TransportInterface::SendToLocators(buffers, totalBytes, localLocator, remoteLocators);
+}
+
 static bool ReadSubmessageHeader(CDRMessage_t& msg, SubmessageHeader_t& smh)
 {
     if(msg.length - msg.pos < 4)
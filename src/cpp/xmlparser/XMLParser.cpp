@@ -216,6 +216,9 @@ XMLP_ret XMLParser::parseXMLTransportData(tinyxml2::XMLElement* p_root)
     </xs:sequence>
     <xs:element name="wan_addr" type="stringType"/>
     <xs:element name="output_port" type="uint16Type"/>
+    <xs:element name="max_messages_per_batch" type="uint32Type"/>
+    <xs:element name="reactor_threads" type="uint32Type"/>
+    <xs:element name="unicast_sockets_per_port" type="uint32Type"/>
     <xs:element name="keep_alive_frequency_ms" type="uint32Type"/>
     <xs:element name="keep_alive_timeout_ms" type="uint32Type"/>
     <xs:element name="max_logical_port" type="uint16Type"/>
@@ -267,6 +270,24 @@ XMLP_ret XMLParser::parseXMLTransportData(tinyxml2::XMLElement* p_root)
                     return XMLP_ret::XML_ERROR;
                 pUDPv4Desc->m_output_udp_socket = static_cast<uint16_t>(iSocket);
             }
+            // Batched I/O
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(UDP_MAX_MESSAGES_PER_BATCH)))
+            {
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &pUDPv4Desc->max_messages_per_batch, 0))
+                    return XMLP_ret::XML_ERROR;
+            }
+            // Receive reactor
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(UDP_REACTOR_THREADS)))
+            {
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &pUDPv4Desc->reactor_threads, 0))
+                    return XMLP_ret::XML_ERROR;
+            }
+            // Receive sharding
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(UDP_UNICAST_SOCKETS_PER_PORT)))
+            {
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &pUDPv4Desc->unicast_sockets_per_port, 0))
+                    return XMLP_ret::XML_ERROR;
+            }
         }
         else if (sType == UDPv6)
         {
@@ -282,6 +303,24 @@ XMLP_ret XMLParser::parseXMLTransportData(tinyxml2::XMLElement* p_root)
                     return XMLP_ret::XML_ERROR;
                 pUDPv6Desc->m_output_udp_socket = static_cast<uint16_t>(iSocket);
             }
+            // Batched I/O
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(UDP_MAX_MESSAGES_PER_BATCH)))
+            {
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &pUDPv6Desc->max_messages_per_batch, 0))
+                    return XMLP_ret::XML_ERROR;
+            }
+            // Receive reactor
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(UDP_REACTOR_THREADS)))
+            {
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &pUDPv6Desc->reactor_threads, 0))
+                    return XMLP_ret::XML_ERROR;
+            }
+            // Receive sharding
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(UDP_UNICAST_SOCKETS_PER_PORT)))
+            {
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &pUDPv6Desc->unicast_sockets_per_port, 0))
+                    return XMLP_ret::XML_ERROR;
+            }
         }
         else if (sType == TCPv4)
         {
@@ -1553,6 +1592,7 @@ XMLP_ret XMLParser::fillDataNode(tinyxml2::XMLElement* p_profile, DataNode<Parti
         <xs:element name="throughputController" type="throughputControllerType"/>
         <xs:element name="userTransports" type="stringListType"/>
         <xs:element name="useBuiltinTransports" type="boolType"/>
+        <xs:element name="intraprocessDelivery" type="boolType"/>
         <xs:element name="propertiesPolicy" type="propertyPolicyType"/>
         <xs:element name="name" type="stringType"/>
       </xs:all>
@@ -1644,6 +1684,12 @@ XMLP_ret XMLParser::fillDataNode(tinyxml2::XMLElement* p_profile, DataNode<Parti
         if (XMLP_ret::XML_OK != getXMLBool(p_aux, &participant_node.get()->rtps.useBuiltinTransports, ident))
             return XMLP_ret::XML_ERROR;
     }
+    // intraprocessDelivery - boolType
+    if (nullptr != (p_aux = p_element->FirstChildElement(INTRAPROCESS_DELIVERY)))
+    {
+        if (XMLP_ret::XML_OK != getXMLBool(p_aux, &participant_node.get()->rtps.intraprocess_delivery, ident))
+            return XMLP_ret::XML_ERROR;
+    }
     // propertiesPolicy
     if (nullptr != (p_aux = p_element->FirstChildElement(PROPERTIES_POLICY)))
     {
@@ -34,6 +34,9 @@ const char* TYPES = "types";
 const char* TRANSPORT_DESCRIPTOR = "transport_descriptor";
 const char* TRANSPORT_ID = "transport_id";
 const char* UDP_OUTPUT_PORT = "output_port";
+const char* UDP_MAX_MESSAGES_PER_BATCH = "max_messages_per_batch";
+const char* UDP_REACTOR_THREADS = "reactor_threads";
+const char* UDP_UNICAST_SOCKETS_PER_PORT = "unicast_sockets_per_port";
 const char* TCP_WAN_ADDR = "wan_addr";
 const char* RECEIVE_BUFFER_SIZE = "receiveBufferSize";
 const char* SEND_BUFFER_SIZE = "sendBufferSize";
@@ -71,6 +74,7 @@ const char* PART_ID = "participantID";
 const char* THROUGHPUT_CONT = "throughputController";
 const char* USER_TRANS = "userTransports";
 const char* USE_BUILTIN_TRANS = "useBuiltinTransports";
+const char* INTRAPROCESS_DELIVERY = "intraprocessDelivery";
 const char* PROPERTIES_POLICY = "propertiesPolicy";
 const char* NAME = "name";
 
@@ -25,6 +25,7 @@
 #include "PubSubReader.hpp"
 #include "PubSubWriter.hpp"
 #include "PubSubWriterReader.hpp"
+#include "PubSubRepublisher.hpp"
 
 #include <fastrtps/rtps/RTPSDomain.h>
 #include <fastrtps/rtps/writer/WriterListener.h>
@@ -745,6 +746,128 @@ BLACKBOXTEST(BlackBox, AsyncPubSubAsReliableHelloworld)
     reader.block_for_all();
 }
 
+BLACKBOXTEST(BlackBox, PubSubAsReliableHelloworldIntraprocess)
+{
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    reader.history_depth(100).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).
+        intraprocess_delivery(true).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    // User data never reaches the network: drop all of it to check it is handed to the reader directly.
+    auto testTransport = std::make_shared<test_UDPv4TransportDescriptor>();
+    testTransport->dropDataMessagesPercentage = 100;
+    writer.disable_builtin_transport();
+    writer.add_user_transport_to_pparams(testTransport);
+
+    writer.history_depth(100).
+        intraprocess_delivery(true).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Because its volatile the durability
+    // Wait for discovery.
+    writer.wait_discovery();
+    reader.wait_discovery();
+
+    auto data = default_helloworld_data_generator();
+
+    reader.startReception(data);
+
+    // Send data
+    writer.send(data);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+    // Block reader until reception finished or timeout.
+    reader.block_for_all();
+}
+
+BLACKBOXTEST(BlackBox, PubSubAsReliableTransientLocalIntraprocess)
+{
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    auto testTransport = std::make_shared<test_UDPv4TransportDescriptor>();
+    testTransport->dropDataMessagesPercentage = 100;
+    writer.disable_builtin_transport();
+    writer.add_user_transport_to_pparams(testTransport);
+
+    writer.history_depth(100).
+        durability_kind(eprosima::fastrtps::TRANSIENT_LOCAL_DURABILITY_QOS).
+        intraprocess_delivery(true).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    auto data = default_helloworld_data_generator();
+    auto expected_data(data);
+
+    // Send data before the reader exists.
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+
+    reader.history_depth(100).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).
+        durability_kind(eprosima::fastrtps::TRANSIENT_LOCAL_DURABILITY_QOS).
+        intraprocess_delivery(true).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    reader.startReception(expected_data);
+
+    // Wait for discovery.
+    writer.wait_discovery();
+    reader.wait_discovery();
+
+    // Block reader until reception finished or timeout.
+    reader.block_for_all();
+}
+
+// Listeners writing with another writer while a sample is delivered to them must not deadlock, even when the
+// samples of both writers are delivered from different threads at the same time.
+BLACKBOXTEST(BlackBox, PubSubAsReliableCrossRepublishingIntraprocess)
+{
+    const uint16_t index_limit = 99;
+    const size_t chains = 20;
+
+    PubSubRepublisher<HelloWorldType> ping(TEST_TOPIC_NAME "_ping", TEST_TOPIC_NAME "_pong", index_limit);
+    PubSubRepublisher<HelloWorldType> pong(TEST_TOPIC_NAME "_pong", TEST_TOPIC_NAME "_ping", index_limit);
+
+    ping.init();
+    ASSERT_TRUE(ping.isInitialized());
+    pong.init();
+    ASSERT_TRUE(pong.isInitialized());
+
+    ping.wait_discovery();
+    pong.wait_discovery();
+
+    // Each chain bounces index_limit + 1 times, half of them received by each republisher.
+    std::thread pong_thread([&pong, chains]()
+    {
+        HelloWorld hello;
+        hello.message("HelloWorld");
+        for(size_t i = 0; i < chains; ++i)
+        {
+            ASSERT_TRUE(pong.send(hello));
+        }
+    });
+
+    HelloWorld hello;
+    hello.message("HelloWorld");
+    for(size_t i = 0; i < chains; ++i)
+    {
+        ASSERT_TRUE(ping.send(hello));
+    }
+
+    pong_thread.join();
+
+    size_t expected = chains * (index_limit + 1);
+    ASSERT_TRUE(ping.block_for_received(expected, std::chrono::seconds(30)));
+    ASSERT_TRUE(pong.block_for_received(expected, std::chrono::seconds(30)));
+}
+
 BLACKBOXTEST(BlackBox, ReqRepAsReliableHelloworld)
 {
     ReqRepAsReliableHelloWorldRequester requester;
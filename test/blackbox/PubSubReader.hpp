@@ -378,6 +378,12 @@ class PubSubReader
             return *this;
         }
 
+        PubSubReader& intraprocess_delivery(bool enabled)
+        {
+            participant_attr_.rtps.intraprocess_delivery = enabled;
+            return *this;
+        }
+
         PubSubReader& resource_limits_allocated_samples(const int32_t initial)
         {
             subscriber_attr_.topic.resourceLimitsQos.allocated_samples = initial;
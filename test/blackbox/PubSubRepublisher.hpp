@@ -0,0 +1,254 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PubSubRepublisher.hpp
+ *
+ */
+
+#ifndef _TEST_BLACKBOX_PUBSUBREPUBLISHER_HPP_
+#define _TEST_BLACKBOX_PUBSUBREPUBLISHER_HPP_
+
+#include <fastrtps/fastrtps_fwd.h>
+#include <fastrtps/Domain.h>
+#include <fastrtps/participant/Participant.h>
+#include <fastrtps/attributes/ParticipantAttributes.h>
+#include <fastrtps/publisher/Publisher.h>
+#include <fastrtps/publisher/PublisherListener.h>
+#include <fastrtps/attributes/PublisherAttributes.h>
+#include <fastrtps/subscriber/Subscriber.h>
+#include <fastrtps/subscriber/SubscriberListener.h>
+#include <fastrtps/attributes/SubscriberAttributes.h>
+#include <fastrtps/subscriber/SampleInfo.h>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <asio.hpp>
+#include <gtest/gtest.h>
+
+/**
+ * Publishes on one topic and subscribes to another one, writing back from the subscriber listener each received
+ * sample with its index increased, until the index reaches a limit.
+ * Two republishers with their topics swapped keep writing to each other from their listeners.
+ */
+template<class TypeSupport>
+class PubSubRepublisher
+{
+    class PubListener : public eprosima::fastrtps::PublisherListener
+    {
+        public:
+
+            PubListener(PubSubRepublisher& republisher) : republisher_(republisher) {}
+
+            ~PubListener() {}
+
+            void onPublicationMatched(eprosima::fastrtps::Publisher* /*pub*/, eprosima::fastrtps::rtps::MatchingInfo& info)
+            {
+                if (info.status == eprosima::fastrtps::rtps::MATCHED_MATCHING)
+                    republisher_.matched();
+            }
+
+        private:
+
+            PubListener& operator=(const PubListener&) = delete;
+
+            PubSubRepublisher& republisher_;
+    } pub_listener_;
+
+    class SubListener : public eprosima::fastrtps::SubscriberListener
+    {
+        public:
+
+            SubListener(PubSubRepublisher& republisher) : republisher_(republisher) {}
+
+            ~SubListener() {}
+
+            void onNewDataMessage(eprosima::fastrtps::Subscriber* sub)
+            {
+                ASSERT_NE(sub, nullptr);
+
+                type data;
+                eprosima::fastrtps::SampleInfo_t info;
+                while(sub->takeNextData((void*)&data, &info))
+                {
+                    if(info.sampleKind == eprosima::fastrtps::rtps::ALIVE)
+                    {
+                        republisher_.republish(data);
+                    }
+                }
+            }
+
+            void onSubscriptionMatched(eprosima::fastrtps::Subscriber* /*sub*/, eprosima::fastrtps::rtps::MatchingInfo& info)
+            {
+                if (info.status == eprosima::fastrtps::rtps::MATCHED_MATCHING)
+                    republisher_.matched();
+            }
+
+        private:
+
+            SubListener& operator=(const SubListener&) = delete;
+
+            PubSubRepublisher& republisher_;
+    } sub_listener_;
+
+    public:
+
+    typedef TypeSupport type_support;
+    typedef typename type_support::type type;
+
+    PubSubRepublisher(const std::string& publish_topic_name, const std::string& subscribe_topic_name,
+            uint16_t index_limit) : pub_listener_(*this), sub_listener_(*this), participant_(nullptr),
+    publisher_(nullptr), subscriber_(nullptr), initialized_(false), matched_(0), received_(0),
+    index_limit_(index_limit)
+    {
+        publisher_attr_.topic.topicDataType = type_.getName();
+        subscriber_attr_.topic.topicDataType = type_.getName();
+        // Generate topic names
+        std::ostringstream pt;
+        pt << publish_topic_name << "_" << asio::ip::host_name() << "_" << GET_PID();
+        publisher_attr_.topic.topicName = pt.str();
+        std::ostringstream st;
+        st << subscribe_topic_name << "_" << asio::ip::host_name() << "_" << GET_PID();
+        subscriber_attr_.topic.topicName = st.str();
+
+        publisher_attr_.qos.m_reliability.kind = eprosima::fastrtps::RELIABLE_RELIABILITY_QOS;
+        subscriber_attr_.qos.m_reliability.kind = eprosima::fastrtps::RELIABLE_RELIABILITY_QOS;
+        publisher_attr_.topic.historyQos.depth = 1000;
+        subscriber_attr_.topic.historyQos.depth = 1000;
+
+        // Samples are only exchanged between endpoints of this process.
+        participant_attr_.rtps.intraprocess_delivery = true;
+
+        // By default, heartbeat period and nack response delay are 100 milliseconds.
+        publisher_attr_.times.heartbeatPeriod.seconds = 0;
+        publisher_attr_.times.heartbeatPeriod.fraction = 4294967 * 100;
+        publisher_attr_.times.nackResponseDelay.seconds = 0;
+        publisher_attr_.times.nackResponseDelay.fraction = 4294967 * 100;
+    }
+
+    ~PubSubRepublisher()
+    {
+        if(participant_ != nullptr)
+            eprosima::fastrtps::Domain::removeParticipant(participant_);
+    }
+
+    void init()
+    {
+        //Create participant
+        participant_attr_.rtps.builtin.domainId = (uint32_t)GET_PID() % 230;
+        participant_ = eprosima::fastrtps::Domain::createParticipant(participant_attr_);
+
+        if(participant_ != nullptr)
+        {
+            // Register type
+            eprosima::fastrtps::Domain::registerType(participant_, &type_);
+
+            //Create publisher
+            publisher_ = eprosima::fastrtps::Domain::createPublisher(participant_, publisher_attr_, &pub_listener_);
+
+            if(publisher_ != nullptr)
+            {
+                //Create subscriber
+                subscriber_ = eprosima::fastrtps::Domain::createSubscriber(participant_, subscriber_attr_, &sub_listener_);
+
+                if(subscriber_ != nullptr)
+                {
+                    initialized_ = true;
+                    return;
+                }
+            }
+
+            eprosima::fastrtps::Domain::removeParticipant(participant_);
+            participant_ = nullptr;
+        }
+    }
+
+    bool isInitialized() const { return initialized_; }
+
+    //! Writes a sample which starts bouncing between the republishers.
+    bool send(const type& data)
+    {
+        return publisher_->write((void*)&data);
+    }
+
+    void wait_discovery()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        std::cout << "Republisher is waiting discovery..." << std::endl;
+
+        cv_.wait(lock, [this]() { return matched_ >= 2; });
+
+        std::cout << "Republisher discovery finished..." << std::endl;
+    }
+
+    /**
+     * Blocks until a number of samples is received.
+     * @return False if they were not received before the timeout.
+     */
+    bool block_for_received(size_t count, const std::chrono::seconds& timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, timeout, [this, count]() { return received_ >= count; });
+    }
+
+    size_t received()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return received_;
+    }
+
+    private:
+
+    void republish(type& data)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ++received_;
+            cv_.notify_all();
+        }
+
+        if(data.index() < index_limit_)
+        {
+            data.index(static_cast<uint16_t>(data.index() + 1));
+            ASSERT_TRUE(publisher_->write((void*)&data));
+        }
+    }
+
+    void matched()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ++matched_;
+        cv_.notify_all();
+    }
+
+    PubSubRepublisher& operator=(const PubSubRepublisher&)= delete;
+
+    eprosima::fastrtps::Participant* participant_;
+    eprosima::fastrtps::ParticipantAttributes participant_attr_;
+    eprosima::fastrtps::Publisher* publisher_;
+    eprosima::fastrtps::PublisherAttributes publisher_attr_;
+    eprosima::fastrtps::Subscriber* subscriber_;
+    eprosima::fastrtps::SubscriberAttributes subscriber_attr_;
+    bool initialized_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    unsigned int matched_;
+    size_t received_;
+    uint16_t index_limit_;
+    type_support type_;
+};
+
+#endif // _TEST_BLACKBOX_PUBSUBREPUBLISHER_HPP_
@@ -410,6 +410,12 @@ class PubSubWriter
         return *this;
     }
 
+    PubSubWriter& intraprocess_delivery(bool enabled)
+    {
+        participant_attr_.rtps.intraprocess_delivery = enabled;
+        return *this;
+    }
+
     PubSubWriter& durability_kind(const eprosima::fastrtps::DurabilityQosPolicyKind kind)
     {
         publisher_attr_.qos.m_durability.kind = kind;
@@ -19,15 +19,42 @@
 #ifndef _RTPS_ENDPOINT_H_
 #define _RTPS_ENDPOINT_H_
 
+#include <fastrtps/rtps/common/Guid.h>
+#include <fastrtps/rtps/attributes/EndpointAttributes.h>
+
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+class RTPSParticipantImpl;
+
 class Endpoint
 {
+    friend class RTPSParticipantImpl;
+
     public:
 
         virtual ~Endpoint() = default;
+
+        const GUID_t& getGuid() const { return m_guid; }
+
+        EndpointAttributes& getAttributes() { return m_att; }
+
+#if HAVE_SECURITY
+        bool supports_rtps_protection() { return supports_rtps_protection_; }
+#endif
+
+    protected:
+
+        GUID_t m_guid;
+
+        EndpointAttributes m_att;
+
+    private:
+
+#if HAVE_SECURITY
+        bool supports_rtps_protection_ = true;
+#endif
 };
 
 } // namespace rtps
@@ -15,6 +15,10 @@
 #ifndef _RTPS_READER_TIMEDEVENT_HEARTBEATRESPONSEDELAY_H_
 #define _RTPS_READER_TIMEDEVENT_HEARTBEATRESPONSEDELAY_H_
 
+#include <fastrtps/rtps/common/Locator.h>
+
+#include <gmock/gmock.h>
+
 namespace eprosima
 {
     namespace fastrtps
@@ -23,14 +27,21 @@ namespace eprosima
         {
             // Forward declarations
             class WriterProxy;
+            class RTPSMessageGroup;
 
             class HeartbeatResponseDelay
             {
                 public:
 
-                    HeartbeatResponseDelay(WriterProxy* /*wp*/,double /*interval*/)
+                    HeartbeatResponseDelay(WriterProxy* wp,double /*interval*/) : mp_WP(wp)
                     {
                     }
+
+                    MOCK_METHOD1(add_messages, void(RTPSMessageGroup&));
+
+                    WriterProxy* mp_WP;
+
+                    LocatorList_t m_destination_locators;
             };
         } // namespace rtps
     } // namespace fastrtps
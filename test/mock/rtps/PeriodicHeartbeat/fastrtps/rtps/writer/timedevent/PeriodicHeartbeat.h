@@ -0,0 +1,50 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PeriodicHeartbeat.h
+ */
+
+#ifndef _RTPS_WRITER_TIMEDEVENT_PERIODICHEARTBEAT_H_
+#define _RTPS_WRITER_TIMEDEVENT_PERIODICHEARTBEAT_H_
+
+#include <fastrtps/rtps/common/Locator.h>
+
+#include <gmock/gmock.h>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+class StatefulWriter;
+class RTPSMessageGroup;
+
+class PeriodicHeartbeat
+{
+    public:
+
+        PeriodicHeartbeat(StatefulWriter* writer, double /*interval*/) : mp_SFW(writer) {}
+
+        MOCK_METHOD1(add_messages, void(RTPSMessageGroup&));
+
+        MOCK_CONST_METHOD0(destination_locators, LocatorList_t());
+
+        StatefulWriter* mp_SFW;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // _RTPS_WRITER_TIMEDEVENT_PERIODICHEARTBEAT_H_
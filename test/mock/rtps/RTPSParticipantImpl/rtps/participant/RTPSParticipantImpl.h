@@ -24,6 +24,8 @@
 #include <fastrtps/rtps/builtin/data/WriterProxyData.h>
 #include <fastrtps/rtps/builtin/data/ReaderProxyData.h>
 
+#include <fastrtps/rtps/Endpoint.h>
+#include <fastrtps/rtps/common/NetworkBuffer.h>
 #include <fastrtps/rtps/attributes/RTPSParticipantAttributes.h>
 #include <fastrtps/rtps/attributes/ReaderAttributes.h>
 #include <fastrtps/rtps/writer/RTPSWriter.h>
@@ -42,7 +44,6 @@ namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
-class Endpoint;
 class RTPSParticipant;
 class WriterHistory;
 class ReaderHistory;
@@ -50,6 +51,12 @@ class WriterListener;
 class ReaderListener;
 struct EntityId_t;
 
+#if HAVE_SECURITY
+namespace security {
+class SecurityManager;
+}
+#endif
+
 class MockParticipantListener : public RTPSParticipantListener
 {
     public:
@@ -61,12 +68,14 @@ class MockParticipantListener : public RTPSParticipantListener
 
         MOCK_METHOD2(onParticipantDiscovery, void (RTPSParticipant*, const ParticipantDiscoveryInfo&));
 
+#if HAVE_SECURITY
         void onParticipantAuthentication(RTPSParticipant* participant, ParticipantAuthenticationInfo&& info) override
         {
             onParticipantAuthentication(participant, info);
         }
 
         MOCK_METHOD2(onParticipantAuthentication, void (RTPSParticipant*, const ParticipantAuthenticationInfo&));
+#endif
 };
 
 class RTPSParticipantImpl
@@ -84,6 +93,8 @@ class RTPSParticipantImpl
 
 #if HAVE_SECURITY
         MOCK_CONST_METHOD0(security_attributes, const security::ParticipantSecurityAttributes&());
+
+        MOCK_METHOD0(security_manager, security::SecurityManager&());
 		
         MOCK_METHOD2(pairing_remote_reader_with_local_writer_after_security, bool(const GUID_t&, const ReaderProxyData&));
 
@@ -131,7 +142,17 @@ class RTPSParticipantImpl
 
         ResourceEvent& getEventResource() { return events_; }
 
-        void set_endpoint_rtps_protection_supports(Endpoint* /*endpoint*/, bool /*support*/) {}
+        void set_endpoint_rtps_protection_supports(Endpoint* endpoint, bool support)
+        {
+#if HAVE_SECURITY
+            endpoint->supports_rtps_protection_ = support;
+#else
+            (void)endpoint;
+            (void)support;
+#endif
+        }
+
+        MOCK_METHOD4(sendSync, void(const std::vector<NetworkBuffer>&, uint32_t, Endpoint*, const LocatorList_t&));
 
         void ResourceSemaphoreWait() {}
         void ResourceSemaphorePost() {}
@@ -31,6 +31,9 @@ namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+struct CacheChange_t;
+class WriterProxy;
+
 class RTPSReader : public Endpoint
 {
     public:
@@ -45,6 +48,13 @@ class RTPSReader : public Endpoint
 
         MOCK_CONST_METHOD0(getGuid, const GUID_t&());
 
+        MOCK_METHOD2(change_removed_by_history_mock, bool(CacheChange_t*, WriterProxy*));
+
+        bool change_removed_by_history(CacheChange_t* change, WriterProxy* prox = nullptr)
+        {
+            return change_removed_by_history_mock(change, prox);
+        }
+
         ReaderHistory* getHistory()
         {
             getHistory_mock();
@@ -47,6 +47,12 @@ class RTPSWriter : public Endpoint
 			
 		MOCK_METHOD1(set_separate_sending, void(bool));
 
+        MOCK_CONST_METHOD0(getGuid, const GUID_t&());
+
+        MOCK_METHOD1(unsent_change_added_to_history, void(CacheChange_t*));
+
+        MOCK_METHOD1(change_removed_by_history, bool(CacheChange_t*));
+
         WriterHistory* history_;
 };
 
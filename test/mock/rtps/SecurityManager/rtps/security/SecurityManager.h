@@ -0,0 +1,56 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SecurityManager.h
+ */
+
+#ifndef _RTPS_SECURITY_SECURITYMANAGER_H_
+#define _RTPS_SECURITY_SECURITYMANAGER_H_
+
+#include <fastrtps/rtps/common/CDRMessage_t.h>
+#include <fastrtps/rtps/common/Guid.h>
+#include <fastrtps/rtps/common/SerializedPayload.h>
+
+#include <vector>
+#include <gmock/gmock.h>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+namespace security {
+
+class SecurityManager
+{
+    public:
+
+        MOCK_METHOD3(encode_rtps_message, bool(const CDRMessage_t&, CDRMessage_t&,
+                    const std::vector<GuidPrefix_t>&));
+
+        MOCK_METHOD4(encode_writer_submessage, bool(const CDRMessage_t&, CDRMessage_t&, const GUID_t&,
+                    const std::vector<GUID_t>&));
+
+        MOCK_METHOD4(encode_reader_submessage, bool(const CDRMessage_t&, CDRMessage_t&, const GUID_t&,
+                    const std::vector<GUID_t>&));
+
+        MOCK_METHOD3(encode_serialized_payload, bool(const SerializedPayload_t&, SerializedPayload_t&,
+                    const GUID_t&));
+};
+
+} // namespace security
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // _RTPS_SECURITY_SECURITYMANAGER_H_
@@ -0,0 +1,128 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * Measures the reserve/release throughput of CacheChangePool as the number of threads sharing a pool grows.
+ * Each thread reserves a small batch of changes and releases them, as a writer or the receiving thread does.
+ *
+ * Usage: CacheChangePoolBenchmark [max_threads] [operations_per_thread]
+ */
+
+#include <fastrtps/rtps/history/CacheChangePool.h>
+#include <fastrtps/rtps/common/CacheChange.h>
+#include <fastrtps/log/Log.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+static const uint32_t s_batchSize = 8;
+static const uint32_t s_payloadSize = 256;
+
+static const char* policy_name(MemoryManagementPolicy_t policy)
+{
+    switch (policy)
+    {
+        case PREALLOCATED_MEMORY_MODE:
+            return "PREALLOCATED";
+        case PREALLOCATED_WITH_REALLOC_MEMORY_MODE:
+            return "PREALLOCATED_WITH_REALLOC";
+        case DYNAMIC_RESERVE_MEMORY_MODE:
+            return "DYNAMIC_RESERVE";
+    }
+    return "";
+}
+
+//! Returns the reserve/release pairs per second done by all the threads.
+static double run(MemoryManagementPolicy_t policy, uint32_t thread_count, uint32_t operations_per_thread)
+{
+    CacheChangePool pool(static_cast<int32_t>(thread_count * s_batchSize), s_payloadSize, 0, policy);
+    uint32_t batches = operations_per_thread / s_batchSize;
+
+    auto worker = [&]()
+    {
+        CacheChange_t* changes[s_batchSize];
+        for (uint32_t batch = 0; batch < batches; ++batch)
+        {
+            for (uint32_t i = 0; i < s_batchSize; ++i)
+            {
+                if (!pool.reserve_Cache(&changes[i], s_payloadSize))
+                {
+                    std::cerr << "Cannot reserve a change" << std::endl;
+                    std::abort();
+                }
+            }
+            for (uint32_t i = 0; i < s_batchSize; ++i)
+            {
+                pool.release_Cache(changes[i]);
+            }
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back(worker);
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(thread_count) * batches * s_batchSize / elapsed.count();
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t max_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    uint32_t operations_per_thread = 1000000;
+
+    if (argc > 1)
+    {
+        max_threads = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+    if (argc > 2)
+    {
+        operations_per_thread = static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10));
+    }
+
+    Log::SetVerbosity(Log::Error);
+
+    std::cout << std::left << std::setw(28) << "Policy" << std::setw(10) << "Threads"
+        << "Reserve/release pairs per second" << std::endl;
+
+    for (MemoryManagementPolicy_t policy : { PREALLOCATED_MEMORY_MODE, PREALLOCATED_WITH_REALLOC_MEMORY_MODE,
+            DYNAMIC_RESERVE_MEMORY_MODE })
+    {
+        for (uint32_t threads = 1; threads <= max_threads; threads *= 2)
+        {
+            double rate = run(policy, threads, operations_per_thread);
+            std::cout << std::left << std::setw(28) << policy_name(policy) << std::setw(10) << threads
+                << std::fixed << std::setprecision(0) << rate << std::endl;
+        }
+    }
+
+    Log::KillThread();
+    return 0;
+}
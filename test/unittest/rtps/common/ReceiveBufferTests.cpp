@@ -0,0 +1,77 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/common/ReceiveBuffer.h>
+#include <fastrtps/rtps/common/SerializedPayload.h>
+
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastrtps::rtps;
+
+static const uint32_t buffer_size = 1024;
+
+//! Payload spanning the whole buffer, as received.
+static void fill_received_payload(SerializedPayload_t& received, ReceiveBuffer* buffer)
+{
+    received.loan(buffer, buffer->data(), buffer_size);
+}
+
+TEST(ReceiveBufferPool, released_buffers_are_reused)
+{
+    std::shared_ptr<ReceiveBufferPool> pool = std::make_shared<ReceiveBufferPool>(buffer_size);
+
+    ReceiveBuffer* buffer = pool->acquire();
+    ASSERT_EQ(1u, pool->buffers_in_use());
+    buffer->release();
+    ASSERT_EQ(0u, pool->buffers_in_use());
+
+    ASSERT_EQ(buffer, pool->acquire());
+    buffer->release();
+}
+
+TEST(ReceiveBufferPool, payloads_are_copied_once_loan_budget_is_reached)
+{
+    // Given a budget of two buffers
+    std::shared_ptr<ReceiveBufferPool> pool = std::make_shared<ReceiveBufferPool>(buffer_size, 2 * buffer_size);
+    std::vector<std::unique_ptr<SerializedPayload_t>> kept;
+
+    // When payloads keep the buffers they are received in
+    for (int i = 0; i < 3; ++i)
+    {
+        ReceiveBuffer* buffer = pool->acquire();
+        SerializedPayload_t received;
+        fill_received_payload(received, buffer);
+        buffer->release();
+
+        kept.emplace_back(new SerializedPayload_t(buffer_size));
+        ASSERT_TRUE(kept.back()->copy_or_loan(&received));
+    }
+
+    // Then the ones over the budget are copied
+    ASSERT_NE(nullptr, kept[0]->loaned_buffer);
+    ASSERT_NE(nullptr, kept[1]->loaned_buffer);
+    ASSERT_EQ(nullptr, kept[2]->loaned_buffer);
+    ASSERT_EQ(2u, pool->buffers_in_use());
+
+    kept.clear();
+    ASSERT_EQ(0u, pool->buffers_in_use());
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -15,6 +15,7 @@
 #include <fastrtps/rtps/common/SequenceNumber.h>
 
 #include <climits>
+#include <vector>
 #include <gtest/gtest.h>
 
 using namespace eprosima::fastrtps::rtps;
@@ -493,6 +494,93 @@ TEST(SequenceNumberSet, GetMaxSeqNumOperation)
     ASSERT_EQ(set.get_maxSeqNum(), expected_seq);
 }
 
+/*!
+ * @fn TEST(SequenceNumberSet, BitmapLimits)
+ * @brief This test checks the set holds the 256 sequence numbers after its base allowed by the bitmap.
+ */
+TEST(SequenceNumberSet, BitmapLimits)
+{
+    SequenceNumberSet_t set;
+
+    set.base = SequenceNumber_t(0, 100);
+
+    ASSERT_TRUE(set.isSetEmpty());
+    ASSERT_EQ(set.get_num_bits(), 0u);
+    ASSERT_FALSE(set.add(SequenceNumber_t(0, 99)));
+    ASSERT_TRUE(set.add(SequenceNumber_t(0, 355)));
+    ASSERT_FALSE(set.add(SequenceNumber_t(0, 356)));
+    ASSERT_FALSE(set.add(SequenceNumber_t(1, 100)));
+
+    ASSERT_FALSE(set.isSetEmpty());
+    ASSERT_EQ(set.get_num_bits(), 256u);
+    ASSERT_EQ(set.get_maxSeqNum(), SequenceNumber_t(0, 355));
+    ASSERT_TRUE(set.is_set(SequenceNumber_t(0, 355)));
+    ASSERT_FALSE(set.is_set(SequenceNumber_t(0, 100)));
+    ASSERT_EQ(set.get_bitmap()[7], 1u);
+}
+
+/*!
+ * @fn TEST(SequenceNumberSet, IterateOperation)
+ * @brief This test checks the sequence numbers of the set are iterated in increasing order.
+ */
+TEST(SequenceNumberSet, IterateOperation)
+{
+    SequenceNumberSet_t set;
+
+    set.base = SequenceNumber_t(10, UINT32_MAX - 1);
+
+    std::vector<SequenceNumber_t> expected;
+    expected.push_back(SequenceNumber_t(10, UINT32_MAX - 1));
+    expected.push_back(SequenceNumber_t(10, UINT32_MAX));
+    expected.push_back(SequenceNumber_t(11, 29));
+    expected.push_back(SequenceNumber_t(11, 30));
+    expected.push_back(SequenceNumber_t(11, 200));
+
+    for(auto it = expected.rbegin(); it != expected.rend(); ++it)
+    {
+        ASSERT_TRUE(set.add(*it));
+    }
+    ASSERT_TRUE(set.add(SequenceNumber_t(11, 30)));
+
+    ASSERT_EQ(set.get_size(), expected.size());
+    ASSERT_EQ(set.get_set(), expected);
+
+    std::vector<SequenceNumber_t> iterated(set.get_begin(), set.get_end());
+    ASSERT_EQ(iterated, expected);
+}
+
+/*!
+ * @fn TEST(SequenceNumberSet, SetBitmapOperation)
+ * @brief This test checks a set is rebuilt from its wire bitmap.
+ */
+TEST(SequenceNumberSet, SetBitmapOperation)
+{
+    SequenceNumberSet_t set;
+
+    set.base = SequenceNumber_t(0, 1);
+    ASSERT_TRUE(set.add(SequenceNumber_t(0, 1)));
+    ASSERT_TRUE(set.add(SequenceNumber_t(0, 33)));
+    ASSERT_TRUE(set.add(SequenceNumber_t(0, 70)));
+
+    SequenceNumberSet_t copy;
+    copy.base = set.base;
+    ASSERT_TRUE(copy.set_bitmap(set.get_num_bits(), set.get_bitmap()));
+    ASSERT_EQ(copy.get_num_bits(), 70u);
+    ASSERT_EQ(copy.get_set(), set.get_set());
+
+    // Bits after the number of bits are not part of the set.
+    uint32_t bitmap[SequenceNumberSet_t::c_words] = { 0xFFFFFFFFu, 0xFFFFFFFFu };
+    ASSERT_TRUE(copy.set_bitmap(40, bitmap));
+    ASSERT_EQ(copy.get_size(), 40u);
+    ASSERT_EQ(copy.get_maxSeqNum(), SequenceNumber_t(0, 40));
+
+    ASSERT_TRUE(copy.set_bitmap(0, bitmap));
+    ASSERT_TRUE(copy.isSetEmpty());
+    ASSERT_TRUE(copy.get_begin() == copy.get_end());
+
+    ASSERT_FALSE(copy.set_bitmap(257, bitmap));
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,166 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/history/CacheChangePool.h>
+#include <fastrtps/rtps/common/CacheChange.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+
+class CacheChangePoolTests : public ::testing::TestWithParam<MemoryManagementPolicy_t>
+{
+};
+
+TEST_P(CacheChangePoolTests, reserve_and_release)
+{
+    CacheChangePool pool(10, 128, 0, GetParam());
+
+    std::vector<CacheChange_t*> changes;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        CacheChange_t* change = nullptr;
+        ASSERT_TRUE(pool.reserve_Cache(&change, 64));
+        ASSERT_NE(change, nullptr);
+        EXPECT_GE(change->serializedPayload.max_size, 64u);
+        changes.push_back(change);
+    }
+
+    // Every change is handed out once.
+    std::set<CacheChange_t*> unique_changes(changes.begin(), changes.end());
+    EXPECT_EQ(unique_changes.size(), changes.size());
+
+    for (CacheChange_t* change : changes)
+    {
+        pool.release_Cache(change);
+    }
+
+    if (GetParam() == DYNAMIC_RESERVE_MEMORY_MODE)
+    {
+        EXPECT_EQ(pool.get_allCachesSize(), 0u);
+    }
+    else
+    {
+        EXPECT_EQ(pool.get_freeCachesSize(), pool.get_allCachesSize());
+    }
+}
+
+TEST_P(CacheChangePoolTests, maximum_size_is_respected)
+{
+    CacheChangePool pool(2, 128, 5, GetParam());
+
+    // The pool keeps one change more than asked for, as the constructor has always done.
+    std::vector<CacheChange_t*> changes;
+    CacheChange_t* change = nullptr;
+    while (pool.reserve_Cache(&change, 64))
+    {
+        changes.push_back(change);
+        ASSERT_LE(changes.size(), 6u);
+    }
+    EXPECT_EQ(changes.size(), 6u);
+
+    pool.release_Cache(changes.back());
+    changes.pop_back();
+    EXPECT_TRUE(pool.reserve_Cache(&change, 64));
+    changes.push_back(change);
+
+    for (CacheChange_t* reserved : changes)
+    {
+        pool.release_Cache(reserved);
+    }
+}
+
+TEST_P(CacheChangePoolTests, foreign_changes_are_not_released)
+{
+    CacheChangePool pool(10, 128, 0, GetParam());
+    CacheChangePool other_pool(10, 128, 0, GetParam());
+
+    CacheChange_t* change = nullptr;
+    ASSERT_TRUE(other_pool.reserve_Cache(&change, 64));
+    size_t free_changes = pool.get_freeCachesSize();
+    pool.release_Cache(change);
+    EXPECT_EQ(pool.get_freeCachesSize(), free_changes);
+
+    CacheChange_t unpooled;
+    pool.release_Cache(&unpooled);
+    EXPECT_EQ(pool.get_freeCachesSize(), free_changes);
+
+    other_pool.release_Cache(change);
+}
+
+TEST_P(CacheChangePoolTests, concurrent_reserve_and_release)
+{
+    const uint32_t thread_count = 8;
+    const uint32_t changes_per_thread = 16;
+    const uint32_t iterations = 2000;
+
+    CacheChangePool pool(4, 128, 0, GetParam());
+
+    auto worker = [&](uint32_t id)
+    {
+        std::vector<CacheChange_t*> changes;
+        for (uint32_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            for (uint32_t i = 0; i < changes_per_thread; ++i)
+            {
+                CacheChange_t* change = nullptr;
+                ASSERT_TRUE(pool.reserve_Cache(&change, 64));
+                // Would be overwritten by another thread holding the same change.
+                change->sequenceNumber = SequenceNumber_t(static_cast<int32_t>(id), i);
+                changes.push_back(change);
+            }
+            for (uint32_t i = 0; i < changes_per_thread; ++i)
+            {
+                ASSERT_EQ(changes[i]->sequenceNumber, SequenceNumber_t(static_cast<int32_t>(id), i));
+                pool.release_Cache(changes[i]);
+            }
+            changes.clear();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t id = 0; id < thread_count; ++id)
+    {
+        threads.emplace_back(worker, id);
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    if (GetParam() == DYNAMIC_RESERVE_MEMORY_MODE)
+    {
+        EXPECT_EQ(pool.get_allCachesSize(), 0u);
+    }
+    else
+    {
+        EXPECT_LE(pool.get_allCachesSize(), thread_count * changes_per_thread + 5);
+        EXPECT_EQ(pool.get_freeCachesSize(), pool.get_allCachesSize());
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(CacheChangePoolTests, CacheChangePoolTests,
+        ::testing::Values(PREALLOCATED_MEMORY_MODE, PREALLOCATED_WITH_REALLOC_MEMORY_MODE,
+            DYNAMIC_RESERVE_MEMORY_MODE));
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
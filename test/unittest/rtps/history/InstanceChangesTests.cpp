@@ -0,0 +1,152 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/history/InstanceChanges.h>
+#include <fastrtps/rtps/common/InstanceHandle.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+
+class InstanceChangesTests : public ::testing::Test
+{
+    protected:
+
+        CacheChange_t* change(uint32_t sequence_number)
+        {
+            changes.emplace_back(new CacheChange_t());
+            changes.back()->sequenceNumber = SequenceNumber_t(0, sequence_number);
+            return changes.back().get();
+        }
+
+        static std::vector<uint32_t> sequence_numbers(const InstanceChanges& instance)
+        {
+            std::vector<uint32_t> result;
+            for(size_t index = 0; index < instance.size(); ++index)
+            {
+                result.push_back(instance[index]->sequenceNumber.low);
+            }
+            return result;
+        }
+
+        std::vector<std::unique_ptr<CacheChange_t>> changes;
+};
+
+TEST_F(InstanceChangesTests, keep_last_ring)
+{
+    const uint32_t depth = 3;
+    InstanceChanges instance(depth);
+
+    for(uint32_t sequence_number = 1; sequence_number <= 10; ++sequence_number)
+    {
+        if(instance.size() == depth)
+        {
+            EXPECT_EQ(instance.front()->sequenceNumber, SequenceNumber_t(0, sequence_number - depth));
+            instance.pop_front();
+        }
+        instance.push_back(change(sequence_number));
+        EXPECT_EQ(instance.back()->sequenceNumber, SequenceNumber_t(0, sequence_number));
+    }
+
+    std::vector<uint32_t> expected = { 8, 9, 10 };
+    EXPECT_EQ(sequence_numbers(instance), expected);
+}
+
+TEST_F(InstanceChangesTests, grows_keeping_order)
+{
+    InstanceChanges instance;
+
+    for(uint32_t sequence_number = 1; sequence_number <= 6; ++sequence_number)
+    {
+        instance.push_back(change(sequence_number));
+    }
+    instance.pop_front();
+    instance.pop_front();
+    for(uint32_t sequence_number = 7; sequence_number <= 20; ++sequence_number)
+    {
+        instance.push_back(change(sequence_number));
+    }
+
+    std::vector<uint32_t> expected;
+    for(uint32_t sequence_number = 3; sequence_number <= 20; ++sequence_number)
+    {
+        expected.push_back(sequence_number);
+    }
+    EXPECT_EQ(sequence_numbers(instance), expected);
+}
+
+TEST_F(InstanceChangesTests, insert_ordered_and_erase)
+{
+    InstanceChanges instance(4);
+    CacheChange_t* c5 = change(5);
+
+    instance.insert_ordered(change(2));
+    instance.insert_ordered(c5);
+    instance.insert_ordered(change(3));
+    instance.insert_ordered(change(1));
+    instance.insert_ordered(change(7));
+    instance.insert_ordered(change(4));
+
+    std::vector<uint32_t> expected = { 1, 2, 3, 4, 5, 7 };
+    EXPECT_EQ(sequence_numbers(instance), expected);
+
+    size_t index = instance.find(c5);
+    ASSERT_EQ(index, 4u);
+    instance.erase(index);
+    instance.erase(1);
+    instance.erase(0);
+    expected = { 3, 4, 7 };
+    EXPECT_EQ(sequence_numbers(instance), expected);
+    EXPECT_EQ(instance.find(c5), instance.size());
+
+    instance.erase(2);
+    instance.erase(0);
+    instance.erase(0);
+    EXPECT_TRUE(instance.empty());
+}
+
+TEST(InstanceHandleHashTests, indexes_instances)
+{
+    std::unordered_map<InstanceHandle_t, uint32_t, InstanceHandleHash> instances;
+
+    // Keys shorter than a handle only fill its first bytes.
+    for(uint32_t key = 0; key < 50000; ++key)
+    {
+        InstanceHandle_t handle;
+        handle.value[0] = static_cast<octet>(key >> 24);
+        handle.value[1] = static_cast<octet>(key >> 16);
+        handle.value[2] = static_cast<octet>(key >> 8);
+        handle.value[3] = static_cast<octet>(key);
+        instances[handle] = key;
+    }
+    ASSERT_EQ(instances.size(), 50000u);
+
+    size_t longest_bucket = 0;
+    for(size_t bucket = 0; bucket < instances.bucket_count(); ++bucket)
+    {
+        longest_bucket = std::max(longest_bucket, instances.bucket_size(bucket));
+    }
+    EXPECT_LT(longest_bucket, 16u);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
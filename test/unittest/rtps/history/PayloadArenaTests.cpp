@@ -0,0 +1,225 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/history/PayloadArena.h>
+#include <fastrtps/rtps/history/CacheChangePool.h>
+#include <fastrtps/rtps/common/CacheChange.h>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+
+TEST(PayloadArenaTests, sizes_are_rounded_to_power_of_two)
+{
+    PayloadArena arena;
+    uint32_t capacity = 0;
+
+    octet* data = arena.allocate(1, capacity);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(capacity, 64u);
+    arena.deallocate(data);
+
+    data = arena.allocate(100, capacity);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(capacity, 128u);
+    arena.deallocate(data);
+
+    data = arena.allocate(65536, capacity);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(capacity, 65536u);
+    memset(data, 0xAA, capacity);
+    arena.deallocate(data);
+}
+
+TEST(PayloadArenaTests, blocks_are_reused)
+{
+    PayloadArena arena;
+    uint32_t capacity = 0;
+
+    octet* first = arena.allocate(200, capacity);
+    ASSERT_NE(first, nullptr);
+    arena.deallocate(first);
+
+    // A payload of a similar size takes the same block.
+    octet* second = arena.allocate(250, capacity);
+    EXPECT_EQ(second, first);
+    arena.deallocate(second);
+}
+
+TEST(PayloadArenaTests, blocks_do_not_overlap)
+{
+    PayloadArena arena;
+    std::vector<octet*> blocks;
+    std::set<octet*> unique_blocks;
+
+    for (uint32_t i = 0; i < 2000; ++i)
+    {
+        uint32_t capacity = 0;
+        octet* data = arena.allocate(64 + (i % 3) * 200, capacity);
+        ASSERT_NE(data, nullptr);
+        memset(data, static_cast<int>(i % 256), capacity);
+        blocks.push_back(data);
+        unique_blocks.insert(data);
+    }
+    EXPECT_EQ(unique_blocks.size(), blocks.size());
+
+    for (uint32_t i = 0; i < blocks.size(); ++i)
+    {
+        EXPECT_EQ(blocks[i][0], static_cast<octet>(i % 256));
+        arena.deallocate(blocks[i]);
+    }
+}
+
+TEST(PayloadArenaTests, idle_slabs_are_returned)
+{
+    PayloadArena arena;
+    std::vector<octet*> blocks;
+
+    // Several slabs of the same class.
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        uint32_t capacity = 0;
+        blocks.push_back(arena.allocate(4096, capacity));
+        ASSERT_NE(blocks.back(), nullptr);
+    }
+    uint64_t reserved = arena.reserved_memory();
+    EXPECT_GE(reserved, 100u * 4096u);
+
+    for (octet* data : blocks)
+    {
+        arena.deallocate(data);
+    }
+
+    // Only one idle slab is kept.
+    EXPECT_GT(arena.reserved_memory(), 0u);
+    EXPECT_LT(arena.reserved_memory(), 2u * 4096u * 16u);
+
+    arena.trim();
+    EXPECT_EQ(arena.reserved_memory(), 0u);
+}
+
+TEST(PayloadArenaTests, budget_is_respected)
+{
+    const uint64_t budget = 1024 * 1024;
+    PayloadArena arena(budget);
+    std::vector<octet*> blocks;
+
+    uint32_t capacity = 0;
+    octet* data = nullptr;
+    while ((data = arena.allocate(100000, capacity)) != nullptr)
+    {
+        blocks.push_back(data);
+        ASSERT_LE(arena.reserved_memory(), budget);
+    }
+    EXPECT_FALSE(blocks.empty());
+    EXPECT_LE(arena.reserved_memory(), budget);
+
+    // Memory freed by other classes can be used again.
+    arena.deallocate(blocks.back());
+    blocks.pop_back();
+    arena.trim();
+    data = arena.allocate(1000, capacity);
+    EXPECT_NE(data, nullptr);
+    blocks.push_back(data);
+
+    for (octet* block : blocks)
+    {
+        arena.deallocate(block);
+    }
+}
+
+TEST(PayloadArenaTests, concurrent_allocate_and_deallocate)
+{
+    const uint32_t thread_count = 8;
+    const uint32_t iterations = 2000;
+    PayloadArena arena;
+
+    auto worker = [&](uint32_t id)
+    {
+        std::vector<octet*> blocks;
+        for (uint32_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            for (uint32_t i = 0; i < 8; ++i)
+            {
+                uint32_t capacity = 0;
+                octet* data = arena.allocate(64u << ((id + i) % 6), capacity);
+                ASSERT_NE(data, nullptr);
+                // Would be overwritten by another thread holding the same block.
+                memset(data, static_cast<int>(id), capacity);
+                blocks.push_back(data);
+            }
+            for (octet* data : blocks)
+            {
+                ASSERT_EQ(data[0], static_cast<octet>(id));
+                arena.deallocate(data);
+            }
+            blocks.clear();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t id = 0; id < thread_count; ++id)
+    {
+        threads.emplace_back(worker, id);
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    arena.trim();
+    EXPECT_EQ(arena.reserved_memory(), 0u);
+}
+
+TEST(PayloadArenaTests, pools_share_an_arena)
+{
+    std::shared_ptr<PayloadArena> arena = std::make_shared<PayloadArena>(512 * 1024);
+    CacheChangePool pool(10, 128, 0, DYNAMIC_RESERVE_MEMORY_MODE, arena);
+    CacheChangePool other_pool(10, 128, 0, DYNAMIC_RESERVE_MEMORY_MODE, arena);
+    EXPECT_EQ(pool.getPayloadArena(), arena.get());
+
+    CacheChange_t* change = nullptr;
+    ASSERT_TRUE(pool.reserve_Cache(&change, 100000));
+    EXPECT_GE(change->serializedPayload.max_size, 100000u);
+
+    // The payload grows inside the arena.
+    change->serializedPayload.length = 4;
+    memset(change->serializedPayload.data, 0x55, 4);
+    change->serializedPayload.reserve(150000);
+    EXPECT_EQ(change->serializedPayload.data[3], 0x55);
+
+    // The budget is spent by the first pool.
+    CacheChange_t* other_change = nullptr;
+    EXPECT_FALSE(other_pool.reserve_Cache(&other_change, 200000));
+    EXPECT_EQ(other_pool.get_allCachesSize(), 0u);
+
+    pool.release_Cache(change);
+    arena->trim();
+    EXPECT_EQ(arena->reserved_memory(), 0u);
+
+    ASSERT_TRUE(other_pool.reserve_Cache(&other_change, 200000));
+    other_pool.release_Cache(other_change);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,260 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/history/ReaderHistory.h>
+#include <fastrtps/rtps/reader/RTPSReader.h>
+#include <fastrtps/rtps/common/CacheChange.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+using ::testing::_;
+using ::testing::Return;
+
+class MockReader : public RTPSReader
+{
+    public:
+
+        bool matched_writer_add(RemoteWriterAttributes&) override { return true; }
+
+        bool matched_writer_remove(RemoteWriterAttributes&) override { return true; }
+};
+
+class TestReaderHistory : public ReaderHistory
+{
+    public:
+
+        TestReaderHistory()
+            : ReaderHistory(HistoryAttributes(PREALLOCATED_MEMORY_MODE, 64, 10, 0))
+        {
+        }
+
+        //! Links the history to the reader, as the constructor of a reader does.
+        void attach(RTPSReader* reader, std::recursive_mutex* mutex)
+        {
+            mp_reader = reader;
+            mp_mutex = mutex;
+        }
+};
+
+class ReaderHistoryTests : public ::testing::Test
+{
+    protected:
+
+        void SetUp() override
+        {
+            history.attach(&reader, &mutex);
+            ON_CALL(reader, change_removed_by_history_mock(_, _)).WillByDefault(Return(true));
+            EXPECT_CALL(reader, change_removed_by_history_mock(_, _)).Times(::testing::AnyNumber());
+
+            writer_a.guidPrefix.value[0] = 1;
+            writer_a.entityId = c_EntityId_SPDPWriter;
+            writer_b.guidPrefix.value[0] = 2;
+            writer_b.entityId = c_EntityId_SPDPWriter;
+        }
+
+        CacheChange_t* add(const GUID_t& writer, int32_t sequence_number)
+        {
+            CacheChange_t* change = nullptr;
+            EXPECT_TRUE(history.reserve_Cache(&change, 0));
+            change->writerGUID = writer;
+            change->sequenceNumber = SequenceNumber_t(0, static_cast<uint32_t>(sequence_number));
+            EXPECT_TRUE(history.add_change(change));
+            return change;
+        }
+
+        std::vector<CacheChange_t*> changes()
+        {
+            return std::vector<CacheChange_t*>(history.changesBegin(), history.changesEnd());
+        }
+
+        std::recursive_mutex mutex;
+        MockReader reader;
+        TestReaderHistory history;
+        GUID_t writer_a;
+        GUID_t writer_b;
+};
+
+TEST_F(ReaderHistoryTests, changes_are_ordered_by_sequence_number)
+{
+    CacheChange_t* a1 = add(writer_a, 1);
+    CacheChange_t* a3 = add(writer_a, 3);
+    CacheChange_t* b2 = add(writer_b, 2);
+    CacheChange_t* a2 = add(writer_a, 2);
+    CacheChange_t* b1 = add(writer_b, 1);
+    CacheChange_t* b5 = add(writer_b, 5);
+
+    // Changes with the same sequence number keep the order they were added in.
+    std::vector<CacheChange_t*> expected = { a1, b1, b2, a2, a3, b5 };
+    EXPECT_EQ(changes(), expected);
+
+    CacheChange_t* min_change = nullptr;
+    ASSERT_TRUE(history.get_min_change_from(&min_change, writer_b));
+    EXPECT_EQ(min_change, b1);
+    ASSERT_TRUE(history.get_min_change_from(&min_change, writer_a));
+    EXPECT_EQ(min_change, a1);
+}
+
+TEST_F(ReaderHistoryTests, remove_keeps_order)
+{
+    CacheChange_t* a1 = add(writer_a, 1);
+    CacheChange_t* b1 = add(writer_b, 1);
+    CacheChange_t* a2 = add(writer_a, 2);
+    CacheChange_t* b3 = add(writer_b, 3);
+
+    EXPECT_TRUE(history.remove_change(a1));
+    std::vector<CacheChange_t*> expected = { b1, a2, b3 };
+    EXPECT_EQ(changes(), expected);
+
+    CacheChange_t* min_change = nullptr;
+    ASSERT_TRUE(history.get_min_change_from(&min_change, writer_a));
+    EXPECT_EQ(min_change, a2);
+
+    EXPECT_TRUE(history.remove_change(a2));
+    EXPECT_FALSE(history.get_min_change_from(&min_change, writer_a));
+    EXPECT_EQ(min_change, nullptr);
+
+    expected = { b1, b3 };
+    EXPECT_EQ(changes(), expected);
+}
+
+TEST_F(ReaderHistoryTests, remove_changes_with_guid)
+{
+    add(writer_a, 1);
+    CacheChange_t* b1 = add(writer_b, 1);
+    add(writer_a, 2);
+    CacheChange_t* b2 = add(writer_b, 2);
+    add(writer_a, 4);
+
+    EXPECT_TRUE(history.remove_changes_with_guid(writer_a));
+    std::vector<CacheChange_t*> expected = { b1, b2 };
+    EXPECT_EQ(changes(), expected);
+
+    EXPECT_TRUE(history.remove_all_changes());
+    EXPECT_TRUE(changes().empty());
+}
+
+TEST_F(ReaderHistoryTests, first_unread_change)
+{
+    CacheChange_t* a1 = add(writer_a, 1);
+    CacheChange_t* a2 = add(writer_a, 2);
+    CacheChange_t* b2 = add(writer_b, 2);
+    CacheChange_t* a3 = add(writer_a, 3);
+
+    CacheChange_t* unread = nullptr;
+    ASSERT_TRUE(history.get_first_unread(&unread));
+    EXPECT_EQ(unread, a1);
+
+    a1->isRead = true;
+    a2->isRead = true;
+    ASSERT_TRUE(history.get_first_unread_from(&unread, writer_a));
+    EXPECT_EQ(unread, a3);
+    ASSERT_TRUE(history.get_first_unread(&unread));
+    EXPECT_EQ(unread, b2);
+
+    // A change arriving out of order before the read ones is the first unread again.
+    CacheChange_t* a0 = add(writer_a, 0);
+    ASSERT_TRUE(history.get_first_unread_from(&unread, writer_a));
+    EXPECT_EQ(unread, a0);
+    a0->isRead = true;
+
+    // Removing read changes keeps the position of the first unread one.
+    EXPECT_TRUE(history.remove_change(a1));
+    EXPECT_TRUE(history.remove_change(a0));
+    ASSERT_TRUE(history.get_first_unread_from(&unread, writer_a));
+    EXPECT_EQ(unread, a3);
+
+    a3->isRead = true;
+    b2->isRead = true;
+    EXPECT_FALSE(history.get_first_unread_from(&unread, writer_a));
+    EXPECT_FALSE(history.get_first_unread(&unread));
+    EXPECT_EQ(unread, nullptr);
+
+    std::vector<CacheChange_t*> expected = { a2, b2, a3 };
+    EXPECT_EQ(changes(), expected);
+}
+
+TEST_F(ReaderHistoryTests, take_in_order)
+{
+    for(int32_t sequence_number = 1; sequence_number <= 1000; ++sequence_number)
+    {
+        add(writer_a, sequence_number);
+        add(writer_b, sequence_number);
+    }
+
+    // Changes are taken as a subscriber does, removing the first unread one.
+    for(int32_t sequence_number = 1; sequence_number <= 1000; ++sequence_number)
+    {
+        for(const GUID_t& writer : { writer_a, writer_b })
+        {
+            CacheChange_t* unread = nullptr;
+            ASSERT_TRUE(history.get_first_unread(&unread));
+            EXPECT_EQ(unread->writerGUID, writer);
+            EXPECT_EQ(unread->sequenceNumber, SequenceNumber_t(0, static_cast<uint32_t>(sequence_number)));
+            unread->isRead = true;
+            ASSERT_TRUE(history.remove_change(unread));
+        }
+    }
+
+    EXPECT_EQ(history.getHistorySize(), 0u);
+    EXPECT_TRUE(changes().empty());
+}
+
+TEST_F(ReaderHistoryTests, loaned_change_stays_in_pool)
+{
+    CacheChange_t* a1 = add(writer_a, 1);
+    CacheChange_t* a2 = add(writer_a, 2);
+
+    // A change lent and returned while in the history stays there.
+    const CacheChange_t* lent = history.loan_change(a2);
+    EXPECT_EQ(lent, a2);
+    EXPECT_TRUE(history.return_loan(lent));
+    EXPECT_EQ(history.getHistorySize(), 2u);
+
+    // A change removed while lent is not reused until its last loan is returned.
+    lent = history.loan_change(a1);
+    EXPECT_EQ(history.loan_change(a1), lent);
+    ASSERT_TRUE(history.remove_change(a1));
+    EXPECT_EQ(history.getHistorySize(), 1u);
+
+    CacheChange_t* change = nullptr;
+    ASSERT_TRUE(history.reserve_Cache(&change, 0));
+    EXPECT_NE(change, a1);
+    history.release_Cache(change);
+
+    EXPECT_TRUE(history.return_loan(lent));
+    ASSERT_TRUE(history.reserve_Cache(&change, 0));
+    EXPECT_NE(change, a1);
+    history.release_Cache(change);
+
+    EXPECT_TRUE(history.return_loan(lent));
+    EXPECT_FALSE(history.return_loan(lent));
+    ASSERT_TRUE(history.reserve_Cache(&change, 0));
+    EXPECT_EQ(change, a1);
+    history.release_Cache(change);
+
+    // Changes not reserved from the history cannot be returned.
+    CacheChange_t foreign;
+    EXPECT_FALSE(history.return_loan(&foreign));
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
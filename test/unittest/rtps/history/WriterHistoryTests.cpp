@@ -0,0 +1,246 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/history/WriterHistory.h>
+#include <fastrtps/rtps/writer/RTPSWriter.h>
+#include <fastrtps/rtps/common/CacheChange.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+using ::testing::_;
+using ::testing::Return;
+using ::testing::ReturnRef;
+
+class MockWriter : public RTPSWriter
+{
+    public:
+
+        bool matched_reader_add(RemoteReaderAttributes&) override { return true; }
+
+        bool matched_reader_remove(RemoteReaderAttributes&) override { return true; }
+};
+
+class TestWriterHistory : public WriterHistory
+{
+    public:
+
+        TestWriterHistory()
+            : WriterHistory(HistoryAttributes(PREALLOCATED_MEMORY_MODE, 64, 10, 0))
+        {
+        }
+
+        //! Links the history to the writer, as the constructor of a writer does.
+        void attach(RTPSWriter* writer, std::recursive_mutex* mutex)
+        {
+            mp_writer = writer;
+            mp_mutex = mutex;
+        }
+};
+
+class WriterHistoryTests : public ::testing::Test
+{
+    protected:
+
+        void SetUp() override
+        {
+            guid.guidPrefix.value[0] = 1;
+            guid.entityId = c_EntityId_SPDPWriter;
+
+            history.attach(&writer, &mutex);
+            ON_CALL(writer, getGuid()).WillByDefault(ReturnRef(guid));
+            ON_CALL(writer, change_removed_by_history(_)).WillByDefault(Return(true));
+            EXPECT_CALL(writer, getGuid()).Times(::testing::AnyNumber());
+            EXPECT_CALL(writer, change_removed_by_history(_)).Times(::testing::AnyNumber());
+            EXPECT_CALL(writer, unsent_change_added_to_history(_)).Times(::testing::AnyNumber());
+        }
+
+        void add(uint32_t count)
+        {
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                CacheChange_t* change = nullptr;
+                ASSERT_TRUE(history.reserve_Cache(&change, 0));
+                change->writerGUID = guid;
+                ASSERT_TRUE(history.add_change(change));
+            }
+        }
+
+        std::vector<uint64_t> sequence_numbers()
+        {
+            std::vector<uint64_t> result;
+            for(auto it = history.changesBegin(); it != history.changesEnd(); ++it)
+            {
+                result.push_back((*it)->sequenceNumber.to64long());
+            }
+            return result;
+        }
+
+        CacheChange_t* get(uint64_t sequence_number)
+        {
+            CacheChange_t* change = nullptr;
+            SequenceNumber_t seq(static_cast<int32_t>(sequence_number >> 32), static_cast<uint32_t>(sequence_number));
+            return history.get_change(seq, guid, &change) ? change : nullptr;
+        }
+
+        GUID_t guid;
+        std::recursive_mutex mutex;
+        MockWriter writer;
+        TestWriterHistory history;
+};
+
+TEST_F(WriterHistoryTests, remove_min_change)
+{
+    add(100);
+    size_t size = 100;
+    ASSERT_EQ(history.getHistorySize(), size);
+
+    for(uint64_t sequence_number = 1; sequence_number <= 100; ++sequence_number)
+    {
+        CacheChange_t* min_change = nullptr;
+        ASSERT_TRUE(history.get_min_change(&min_change));
+        EXPECT_EQ(min_change->sequenceNumber.to64long(), sequence_number);
+        EXPECT_EQ(get(sequence_number), min_change);
+        ASSERT_TRUE(history.remove_min_change());
+        EXPECT_EQ(get(sequence_number), nullptr);
+        EXPECT_EQ(history.getHistorySize(), --size);
+
+        // The history keeps being appended to while the oldest changes are removed.
+        if(sequence_number % 2 == 0)
+        {
+            add(1);
+            ++size;
+        }
+    }
+
+    std::vector<uint64_t> expected;
+    for(uint64_t sequence_number = 101; sequence_number <= 150; ++sequence_number)
+    {
+        expected.push_back(sequence_number);
+    }
+    EXPECT_EQ(sequence_numbers(), expected);
+}
+
+TEST_F(WriterHistoryTests, remove_any_change)
+{
+    add(10);
+
+    EXPECT_TRUE(history.remove_change(SequenceNumber_t(0, 3)));
+    EXPECT_TRUE(history.remove_change(get(8)));
+    CacheChange_t* reused = history.remove_change_and_reuse(SequenceNumber_t(0, 5));
+    ASSERT_NE(reused, nullptr);
+    EXPECT_EQ(reused->sequenceNumber, SequenceNumber_t(0, 5));
+    history.release_Cache(reused);
+    EXPECT_FALSE(history.remove_change(SequenceNumber_t(0, 5)));
+    EXPECT_FALSE(history.remove_change(SequenceNumber_t(0, 11)));
+
+    std::vector<uint64_t> expected = { 1, 2, 4, 6, 7, 9, 10 };
+    EXPECT_EQ(sequence_numbers(), expected);
+    for(uint64_t sequence_number : expected)
+    {
+        ASSERT_NE(get(sequence_number), nullptr);
+        EXPECT_EQ(get(sequence_number)->sequenceNumber.to64long(), sequence_number);
+    }
+    EXPECT_EQ(get(3), nullptr);
+    EXPECT_EQ(get(0), nullptr);
+
+    CacheChange_t* max_change = nullptr;
+    ASSERT_TRUE(history.get_max_change(&max_change));
+    EXPECT_EQ(max_change->sequenceNumber, SequenceNumber_t(0, 10));
+
+    EXPECT_TRUE(history.remove_all_changes());
+    EXPECT_EQ(history.getHistorySize(), 0u);
+    EXPECT_TRUE(history.changesBegin() == history.changesEnd());
+}
+
+TEST_F(WriterHistoryTests, matches_ordered_list)
+{
+    std::vector<uint64_t> expected;
+    uint64_t next = 1;
+    srand(7);
+
+    for(uint32_t iteration = 0; iteration < 2000; ++iteration)
+    {
+        uint32_t count = static_cast<uint32_t>(rand() % 4);
+        add(count);
+        for(uint32_t i = 0; i < count; ++i)
+        {
+            expected.push_back(next++);
+        }
+
+        if(!expected.empty() && rand() % 2 == 0)
+        {
+            // Mostly the oldest change, as when changes are acknowledged.
+            size_t position = rand() % 3 == 0 ? static_cast<size_t>(rand()) % expected.size() : 0;
+            uint64_t sequence_number = expected[position];
+            ASSERT_TRUE(history.remove_change(get(sequence_number)));
+            expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(position));
+        }
+
+        ASSERT_EQ(sequence_numbers(), expected);
+        ASSERT_EQ(history.getHistorySize(), expected.size());
+    }
+
+    for(uint64_t sequence_number : expected)
+    {
+        ASSERT_NE(get(sequence_number), nullptr);
+    }
+}
+
+TEST_F(WriterHistoryTests, lent_change_is_returned_once)
+{
+    CacheChange_t* change = nullptr;
+    ASSERT_TRUE(history.reserve_Cache(&change, 0));
+
+    history.loan_change(change);
+    EXPECT_TRUE(history.return_loan(change));
+    EXPECT_FALSE(history.return_loan(change));
+    history.release_Cache(change);
+
+    // Changes not reserved from the history cannot be returned.
+    CacheChange_t foreign;
+    EXPECT_FALSE(history.return_loan(&foreign));
+}
+
+TEST_F(WriterHistoryTests, removed_change_is_released_when_returned)
+{
+    add(1);
+    CacheChange_t* lent = get(1);
+    ASSERT_NE(lent, nullptr);
+    history.loan_change(lent);
+    ASSERT_TRUE(history.remove_change(lent));
+    EXPECT_EQ(get(1), nullptr);
+
+    // The change stays out of the pool while it is lent.
+    CacheChange_t* change = nullptr;
+    ASSERT_TRUE(history.reserve_Cache(&change, 0));
+    EXPECT_NE(change, lent);
+    history.release_Cache(change);
+
+    EXPECT_TRUE(history.return_loan(lent));
+    ASSERT_TRUE(history.reserve_Cache(&change, 0));
+    EXPECT_EQ(change, lent);
+    history.release_Cache(change);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -295,6 +295,84 @@ TEST_F(NetworkTests, A_Sender_Resource_will_always_send_through_its_original_out
    ASSERT_EQ(messageSent.destination, destinationLocator);
 }
 
+TEST_F(NetworkTests, ShrinkLocatorLists_keeps_other_locators_as_fallback_of_local_shared_memory_locators)
+{
+   // Given
+   HELPER_RegisterTransportWithKindAndChannels(LOCATOR_KIND_UDPv4, 10);
+   HELPER_RegisterTransportWithKindAndChannels(LOCATOR_KIND_SHM, 10);
+   MockTransport::mockTransportInstances.back()->mockLocatorsAreLocal = true;
+
+   Locator_t sharedMemoryLocator;
+   sharedMemoryLocator.kind = LOCATOR_KIND_SHM;
+   sharedMemoryLocator.port = 7410;
+   Locator_t networkLocator;
+   networkLocator.kind = LOCATOR_KIND_UDPv4;
+   networkLocator.port = 7410;
+   networkLocator.address[15] = 1;
+   Locator_t otherNetworkLocator(networkLocator);
+   otherNetworkLocator.port = 7420;
+
+   LocatorList_t localEndpoint;
+   localEndpoint.push_back(sharedMemoryLocator);
+   localEndpoint.push_back(networkLocator);
+   LocatorList_t remoteEndpoint;
+   remoteEndpoint.push_back(otherNetworkLocator);
+
+   // When
+   LocatorList_t shrinked = networkFactoryUnderTest.ShrinkLocatorLists({localEndpoint, remoteEndpoint});
+
+   // Then
+   ASSERT_EQ(2u, shrinked.size());
+   ASSERT_TRUE(shrinked.contains(sharedMemoryLocator));
+   ASSERT_TRUE(shrinked.contains(otherNetworkLocator));
+
+   LocatorList_t fallback;
+   ASSERT_TRUE(networkFactoryUnderTest.GetFallbackLocators(sharedMemoryLocator, fallback));
+   ASSERT_EQ(1u, fallback.size());
+   ASSERT_EQ(networkLocator, *fallback.begin());
+   ASSERT_FALSE(networkFactoryUnderTest.GetFallbackLocators(otherNetworkLocator, fallback));
+}
+
+TEST_F(NetworkTests, fallback_locators_are_replaced_on_rediscovery_and_removed_with_their_endpoints)
+{
+   // Given
+   HELPER_RegisterTransportWithKindAndChannels(LOCATOR_KIND_UDPv4, 10);
+   HELPER_RegisterTransportWithKindAndChannels(LOCATOR_KIND_SHM, 10);
+   MockTransport::mockTransportInstances.back()->mockLocatorsAreLocal = true;
+
+   Locator_t sharedMemoryLocator;
+   sharedMemoryLocator.kind = LOCATOR_KIND_SHM;
+   sharedMemoryLocator.port = 7410;
+   Locator_t networkLocator;
+   networkLocator.kind = LOCATOR_KIND_UDPv4;
+   networkLocator.port = 7410;
+   networkLocator.address[15] = 1;
+   Locator_t newNetworkLocator(networkLocator);
+   newNetworkLocator.port = 7411;
+
+   LocatorList_t endpoint;
+   endpoint.push_back(sharedMemoryLocator);
+   endpoint.push_back(networkLocator);
+   LocatorList_t rediscoveredEndpoint;
+   rediscoveredEndpoint.push_back(sharedMemoryLocator);
+   rediscoveredEndpoint.push_back(newNetworkLocator);
+
+   // When
+   networkFactoryUnderTest.ShrinkLocatorLists({endpoint});
+   networkFactoryUnderTest.ShrinkLocatorLists({rediscoveredEndpoint});
+
+   // Then
+   LocatorList_t fallback;
+   ASSERT_TRUE(networkFactoryUnderTest.GetFallbackLocators(sharedMemoryLocator, fallback));
+   ASSERT_EQ(1u, fallback.size());
+   ASSERT_EQ(newNetworkLocator, *fallback.begin());
+
+   networkFactoryUnderTest.RemoveFallbackLocators(rediscoveredEndpoint);
+   fallback.clear();
+   ASSERT_FALSE(networkFactoryUnderTest.GetFallbackLocators(sharedMemoryLocator, fallback));
+   ASSERT_EQ(0u, fallback.size());
+}
+
 /*
 TEST_F(NetworkTests, A_Receiver_Resource_will_always_receive_through_its_original_inbound_locator_and_from_the_specified_remote_locator)
 {
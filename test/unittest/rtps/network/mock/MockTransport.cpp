@@ -29,14 +29,16 @@ std::vector<MockTransport*> MockTransport::mockTransportInstances;
 
 MockTransport::MockTransport(const MockTransportDescriptor& descriptor):
     mockSupportedKind(descriptor.supportedKind),
-    mockMaximumChannels(descriptor.maximumChannels)
+    mockMaximumChannels(descriptor.maximumChannels),
+    mockLocatorsAreLocal(false)
 {
     mockTransportInstances.push_back(this);
 }
 
 MockTransport::MockTransport():
    mockSupportedKind(DefaultKind),
-   mockMaximumChannels(DefaultMaxChannels)
+   mockMaximumChannels(DefaultMaxChannels),
+   mockLocatorsAreLocal(false)
 {
    mockTransportInstances.push_back(this);
 }
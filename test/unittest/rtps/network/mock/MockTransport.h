@@ -69,7 +69,7 @@ class MockTransport: public TransportInterface
 
         virtual LocatorList_t ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists) override;
 
-        virtual bool is_local_locator(const Locator_t&) const override { return false; }
+        virtual bool is_local_locator(const Locator_t&) const override { return mockLocatorsAreLocal; }
 
         virtual TransportDescriptorInterface* get_configuration() override { return nullptr; };
         virtual void AddDefaultOutputLocator(LocatorList_t &) override {};
@@ -111,6 +111,7 @@ class MockTransport: public TransportInterface
 
         const static int DefaultMaxChannels = 10;
         int mockMaximumChannels;
+        bool mockLocatorsAreLocal;
 
         //Helper persistent handles
         static std::vector<MockTransport*> mockTransportInstances;
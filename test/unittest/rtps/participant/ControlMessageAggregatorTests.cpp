@@ -0,0 +1,288 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/participant/ControlMessageAggregator.h>
+#include <rtps/participant/RTPSParticipantImpl.h>
+#include <fastrtps/rtps/writer/StatefulWriter.h>
+#include <fastrtps/rtps/writer/timedevent/PeriodicHeartbeat.h>
+#include <fastrtps/rtps/reader/StatefulReader.h>
+#include <fastrtps/rtps/reader/WriterProxy.h>
+#include <fastrtps/rtps/reader/timedevent/HeartbeatResponseDelay.h>
+#if HAVE_SECURITY
+#include <rtps/security/SecurityManager.h>
+#endif
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <future>
+#include <memory>
+
+using namespace eprosima::fastrtps::rtps;
+using ::testing::_;
+using ::testing::Eq;
+using ::testing::Invoke;
+using ::testing::InSequence;
+using ::testing::NiceMock;
+using ::testing::ReturnRef;
+
+// Events never fire by themselves during the tests, which call event() directly.
+static const double c_LongWindow = 60000;
+
+static GUID_t participant_guid()
+{
+    GuidPrefix_t prefix;
+    prefix.value[0] = 1;
+    return GUID_t(prefix, c_EntityId_RTPSParticipant);
+}
+
+static GUID_t remote_guid(uint32_t entity)
+{
+    GuidPrefix_t prefix;
+    prefix.value[0] = 2;
+    return GUID_t(prefix, entity);
+}
+
+static LocatorList_t locators(uint32_t port)
+{
+    LocatorList_t list;
+    list.push_back(Locator_t(port));
+    return list;
+}
+
+class ControlMessageAggregatorTests : public ::testing::Test
+{
+    protected:
+
+        ControlMessageAggregatorTests()
+            : participant_guid_(participant_guid())
+            , writer_a_(&participant_)
+            , writer_b_(&participant_)
+            , writer_proxy_(writer_attributes_, &reader_)
+            , heartbeat_a_(&writer_a_, 0)
+            , heartbeat_b_(&writer_b_, 0)
+            , response_(&writer_proxy_, 0)
+            , messages_(65536, participant_guid_.guidPrefix)
+        {
+            ON_CALL(participant_, getGuid()).WillByDefault(ReturnRef(participant_guid_));
+#if HAVE_SECURITY
+            ON_CALL(participant_, security_attributes()).WillByDefault(ReturnRef(security_attributes_));
+            ON_CALL(participant_, security_manager()).WillByDefault(ReturnRef(security_manager_));
+#endif
+
+            aggregator_.reset(new ControlMessageAggregator(&participant_, c_LongWindow));
+        }
+
+        //! Expects a heartbeat event to add the heartbeat of its writer when it is sent.
+        void expect_heartbeat(PeriodicHeartbeat& heartbeat, StatefulWriter& writer, const LocatorList_t& destination)
+        {
+            EXPECT_CALL(heartbeat, destination_locators()).WillRepeatedly(::testing::Return(destination));
+            EXPECT_CALL(heartbeat, add_messages(_)).WillOnce(Invoke([this, &writer, destination](
+                            RTPSMessageGroup& group)
+                        {
+                            add_heartbeat(group, writer, destination);
+                        }));
+        }
+
+        //! Expects the heartbeat response to add an ACKNACK of the reader when it is sent.
+        void expect_response(const LocatorList_t& destination)
+        {
+            response_.m_destination_locators = destination;
+            EXPECT_CALL(response_, add_messages(_)).WillOnce(Invoke([this, destination](RTPSMessageGroup& group)
+                        {
+                            group.set_endpoint(&reader_);
+                            std::vector<GUID_t> remote_writers{remote_guid(1)};
+                            SequenceNumberSet_t set;
+                            set.base = SequenceNumber_t(0, 1);
+                            group.add_acknack(remote_writers, set, 1, false, destination);
+                        }));
+        }
+
+        void add_heartbeat(RTPSMessageGroup& group, StatefulWriter& writer, const LocatorList_t& destination)
+        {
+            group.set_endpoint(&writer);
+            std::vector<GUID_t> remote_readers{remote_guid(4)};
+            group.add_heartbeat(remote_readers, SequenceNumber_t(0, 1), SequenceNumber_t(0, 1), 1, false, false,
+                    destination);
+        }
+
+        GUID_t participant_guid_;
+#if HAVE_SECURITY
+        security::ParticipantSecurityAttributes security_attributes_;
+        NiceMock<security::SecurityManager> security_manager_;
+#endif
+        NiceMock<RTPSParticipantImpl> participant_;
+        StatefulWriter writer_a_;
+        StatefulWriter writer_b_;
+        StatefulReader reader_;
+        RemoteWriterAttributes writer_attributes_;
+        WriterProxy writer_proxy_;
+        PeriodicHeartbeat heartbeat_a_;
+        PeriodicHeartbeat heartbeat_b_;
+        HeartbeatResponseDelay response_;
+        RTPSMessageGroup_t messages_;
+        std::unique_ptr<ControlMessageAggregator> aggregator_;
+};
+
+TEST_F(ControlMessageAggregatorTests, events_to_same_locators_share_datagram)
+{
+    ControlMessageAggregator aggregator(&participant_, 10);
+    std::promise<void> sent;
+
+    expect_heartbeat(heartbeat_a_, writer_a_, locators(7400));
+    expect_heartbeat(heartbeat_b_, writer_b_, locators(7400));
+    expect_response(locators(7400));
+    EXPECT_CALL(participant_, sendSync(_, _, _, Eq(locators(7400)))).WillOnce(Invoke(
+                [&sent](const std::vector<NetworkBuffer>&, uint32_t, Endpoint*, const LocatorList_t&)
+                {
+                    sent.set_value();
+                }));
+
+    aggregator.add_heartbeat(&heartbeat_a_);
+    aggregator.add_heartbeat_response(&response_);
+    aggregator.add_heartbeat(&heartbeat_b_);
+    // Already pending, so it is not sent twice.
+    aggregator.add_heartbeat(&heartbeat_a_);
+
+    ASSERT_EQ(std::future_status::ready, sent.get_future().wait_for(std::chrono::seconds(5)));
+}
+
+TEST_F(ControlMessageAggregatorTests, events_to_different_locators_are_split)
+{
+    expect_heartbeat(heartbeat_a_, writer_a_, locators(7400));
+    expect_response(locators(7410));
+    expect_heartbeat(heartbeat_b_, writer_b_, locators(7400));
+
+    {
+        // Events to the same locators are sent together even when added apart.
+        InSequence sequence;
+        EXPECT_CALL(participant_, sendSync(_, _, _, Eq(locators(7400)))).Times(1);
+        EXPECT_CALL(participant_, sendSync(_, _, &reader_, Eq(locators(7410)))).Times(1);
+    }
+
+    aggregator_->add_heartbeat(&heartbeat_a_);
+    aggregator_->add_heartbeat_response(&response_);
+    aggregator_->add_heartbeat(&heartbeat_b_);
+    aggregator_->event(TimedEvent::EVENT_SUCCESS);
+
+    // Nothing is left to send.
+    aggregator_->event(TimedEvent::EVENT_SUCCESS);
+}
+
+TEST_F(ControlMessageAggregatorTests, removed_events_are_not_sent)
+{
+    EXPECT_CALL(heartbeat_a_, add_messages(_)).Times(0);
+    EXPECT_CALL(response_, add_messages(_)).Times(0);
+    expect_heartbeat(heartbeat_b_, writer_b_, locators(7400));
+    EXPECT_CALL(participant_, sendSync(_, _, &writer_b_, Eq(locators(7400)))).Times(1);
+
+    aggregator_->add_heartbeat(&heartbeat_a_);
+    aggregator_->add_heartbeat_response(&response_);
+    aggregator_->add_heartbeat(&heartbeat_b_);
+    aggregator_->remove_heartbeat(&heartbeat_a_);
+    aggregator_->remove_heartbeat_response(&response_);
+    aggregator_->event(TimedEvent::EVENT_SUCCESS);
+}
+
+TEST_F(ControlMessageAggregatorTests, remove_waits_for_send_in_progress)
+{
+    std::future<void> heartbeat_removal;
+    std::future<void> response_removal;
+
+    EXPECT_CALL(heartbeat_a_, destination_locators()).WillRepeatedly(::testing::Return(locators(7400)));
+    EXPECT_CALL(heartbeat_a_, add_messages(_)).WillOnce(Invoke([&](RTPSMessageGroup& group)
+                {
+                    heartbeat_removal = std::async(std::launch::async, [this]()
+                            {
+                                aggregator_->remove_heartbeat(&heartbeat_a_);
+                            });
+                    response_removal = std::async(std::launch::async, [this]()
+                            {
+                                aggregator_->remove_heartbeat_response(&response_);
+                            });
+
+                    // The events cannot be destroyed while they are being sent.
+                    EXPECT_EQ(std::future_status::timeout,
+                            heartbeat_removal.wait_for(std::chrono::milliseconds(50)));
+                    EXPECT_EQ(std::future_status::timeout,
+                            response_removal.wait_for(std::chrono::milliseconds(50)));
+
+                    add_heartbeat(group, writer_a_, locators(7400));
+                }));
+    expect_response(locators(7400));
+    EXPECT_CALL(participant_, sendSync(_, _, _, Eq(locators(7400)))).Times(1);
+
+    aggregator_->add_heartbeat(&heartbeat_a_);
+    aggregator_->add_heartbeat_response(&response_);
+    aggregator_->event(TimedEvent::EVENT_SUCCESS);
+
+    ASSERT_TRUE(heartbeat_removal.valid());
+    ASSERT_TRUE(response_removal.valid());
+    ASSERT_EQ(std::future_status::ready, heartbeat_removal.wait_for(std::chrono::seconds(5)));
+    ASSERT_EQ(std::future_status::ready, response_removal.wait_for(std::chrono::seconds(5)));
+}
+
+TEST_F(ControlMessageAggregatorTests, set_endpoint_keeps_message)
+{
+    EXPECT_CALL(participant_, sendSync(_, _, &writer_b_, Eq(locators(7400)))).Times(1);
+
+    RTPSMessageGroup group(&participant_, &writer_a_, RTPSMessageGroup::WRITER, messages_);
+    add_heartbeat(group, writer_a_, locators(7400));
+    add_heartbeat(group, writer_b_, locators(7400));
+}
+
+#if HAVE_SECURITY
+TEST_F(ControlMessageAggregatorTests, set_endpoint_keeps_message_with_same_rtps_protection)
+{
+    security_attributes_.is_rtps_protected = true;
+    participant_.set_endpoint_rtps_protection_supports(&writer_a_, false);
+    participant_.set_endpoint_rtps_protection_supports(&writer_b_, false);
+
+    EXPECT_CALL(security_manager_, encode_rtps_message(_, _, _)).Times(0);
+    EXPECT_CALL(participant_, sendSync(_, _, &writer_b_, Eq(locators(7400)))).Times(1);
+
+    RTPSMessageGroup group(&participant_, &writer_a_, RTPSMessageGroup::WRITER, messages_);
+    add_heartbeat(group, writer_a_, locators(7400));
+    add_heartbeat(group, writer_b_, locators(7400));
+}
+
+TEST_F(ControlMessageAggregatorTests, set_endpoint_flushes_when_rtps_protection_differs)
+{
+    security_attributes_.is_rtps_protected = true;
+    participant_.set_endpoint_rtps_protection_supports(&writer_a_, false);
+    participant_.set_endpoint_rtps_protection_supports(&writer_b_, true);
+
+    RTPSMessageGroup group(&participant_, &writer_a_, RTPSMessageGroup::WRITER, messages_);
+    add_heartbeat(group, writer_a_, locators(7400));
+
+    // The unprotected heartbeat is sent as is before switching to the protected writer.
+    EXPECT_CALL(security_manager_, encode_rtps_message(_, _, _)).Times(0);
+    EXPECT_CALL(participant_, sendSync(_, _, &writer_a_, Eq(locators(7400)))).Times(1);
+    group.set_endpoint(&writer_b_);
+    ::testing::Mock::VerifyAndClearExpectations(&participant_);
+    ::testing::Mock::VerifyAndClearExpectations(&security_manager_);
+
+    // Only the protected heartbeat is encoded.
+    EXPECT_CALL(security_manager_, encode_rtps_message(_, _, _)).WillOnce(::testing::Return(true));
+    EXPECT_CALL(participant_, sendSync(_, _, &writer_b_, Eq(locators(7400)))).Times(1);
+    add_heartbeat(group, writer_b_, locators(7400));
+}
+#endif
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
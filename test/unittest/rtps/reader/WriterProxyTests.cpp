@@ -40,25 +40,25 @@ namespace eprosima
 
                 // Update MISSING changes util sequence number 3.
                 wproxy.missing_changes_update(SequenceNumber_t(0, 3));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 0));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 0));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 3u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 1))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 2))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 3))->getStatus(), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 1)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 2)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 3)), ChangeFromWriterStatus_t::MISSING);
 
                 // Add two UNKNOWN with sequence numberes 4 and 5.
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0,4)));
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0,5)));
+                wproxy.m_changesFromW.extend_to(SequenceNumber_t(0,4), ChangeFromWriterStatus_t::UNKNOWN);
+                wproxy.m_changesFromW.extend_to(SequenceNumber_t(0,5), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Update MISSING changes util sequence number 5.
                 wproxy.missing_changes_update(SequenceNumber_t(0,5));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 0));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 0));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 5u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 1))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 2))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 3))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 1)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 2)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 3)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::MISSING);
 
                 // Set all as received.
                 wproxy.received_change_set(SequenceNumber_t(0, 1));
@@ -66,40 +66,40 @@ namespace eprosima
                 wproxy.received_change_set(SequenceNumber_t(0, 3));
                 wproxy.received_change_set(SequenceNumber_t(0, 4));
                 wproxy.received_change_set(SequenceNumber_t(0, 5));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 5));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 5));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 0u);
 
                 // Try to update MISSING changes util sequence number 4.
                 wproxy.missing_changes_update(SequenceNumber_t(0, 4));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 5));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 5));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 0u);
 
                 // Add three UNKNOWN changes with sequence number 6, 7 and 9.
                 // Add one RECEIVED change with sequence number 8.
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0, 6)));
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0, 7)));
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0, 8)));
+                wproxy.m_changesFromW.extend_to(SequenceNumber_t(0, 6), ChangeFromWriterStatus_t::UNKNOWN);
+                wproxy.m_changesFromW.extend_to(SequenceNumber_t(0, 7), ChangeFromWriterStatus_t::UNKNOWN);
+                wproxy.m_changesFromW.extend_to(SequenceNumber_t(0, 8), ChangeFromWriterStatus_t::UNKNOWN);
                 wproxy.received_change_set(SequenceNumber_t(0, 8));
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0, 9)));
+                wproxy.m_changesFromW.extend_to(SequenceNumber_t(0, 9), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Update MISSING changes util sequence number 8.
                 wproxy.missing_changes_update(SequenceNumber_t(0, 8));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 5));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 5));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 4u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 7))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 9))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 6)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 7)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 8)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 9)), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Update MISSING changes util sequence number 10.
                 wproxy.missing_changes_update(SequenceNumber_t(0, 10));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 5));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 5));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 5u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 7))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 9))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 10))->getStatus(), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 6)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 7)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 8)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 9)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 10)), ChangeFromWriterStatus_t::MISSING);
             }
 
             TEST(WriterProxyTests, LostChangesUpdate)
@@ -110,43 +110,41 @@ namespace eprosima
 
                 // Update LOST changes util sequence number 3.
                 wproxy.lost_changes_update(SequenceNumber_t(0, 3));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 2));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 2));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 0u);
 
                 // Add two UNKNOWN with sequence numberes 3 and 4.
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0,3)));
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0,4)));
+                wproxy.m_changesFromW.extend_to(SequenceNumber_t(0,3), ChangeFromWriterStatus_t::UNKNOWN);
+                wproxy.m_changesFromW.extend_to(SequenceNumber_t(0,4), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Update LOST changes util sequence number 5.
                 wproxy.lost_changes_update(SequenceNumber_t(0, 5));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 4));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 4));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 0u);
 
                 // Try to update LOST changes util sequence number 4.
                 wproxy.lost_changes_update(SequenceNumber_t(0, 3));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 4));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 4));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 0u);
 
                 // Add two UNKNOWN changes with sequence number 5 and 8.
                 // Add one MISSING change with sequence number 6.
                 // Add one RECEIVED change with sequence number 7.
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0, 5)));
-                ChangeFromWriter_t missing_aux_change_from_w(SequenceNumber_t(0, 6));
-                missing_aux_change_from_w.setStatus(ChangeFromWriterStatus_t::MISSING);
-                wproxy.m_changesFromW.insert(missing_aux_change_from_w);
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0, 7)));
+                wproxy.m_changesFromW.extend_to(SequenceNumber_t(0, 5), ChangeFromWriterStatus_t::UNKNOWN);
+                wproxy.m_changesFromW.extend_to(SequenceNumber_t(0, 6), ChangeFromWriterStatus_t::MISSING);
+                wproxy.m_changesFromW.extend_to(SequenceNumber_t(0, 7), ChangeFromWriterStatus_t::UNKNOWN);
                 wproxy.received_change_set(SequenceNumber_t(0, 7));
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0, 8)));
+                wproxy.m_changesFromW.extend_to(SequenceNumber_t(0, 8), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Update LOST changes util sequence number 8.
                 wproxy.lost_changes_update(SequenceNumber_t(0, 8));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 7));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 7));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 1u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 8)), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Update LOST changes util sequence number 10.
                 wproxy.lost_changes_update(SequenceNumber_t(0, 10));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 9));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 9));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 0u);
             }
 
@@ -158,77 +156,77 @@ namespace eprosima
 
                 // Set received change with sequence number 3.
                 wproxy.received_change_set(SequenceNumber_t(0, 3));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 0));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 0));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 3u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 1))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 2))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 3))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 1)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 2)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 3)), ChangeFromWriterStatus_t::RECEIVED);
 
                 // Add two UNKNOWN with sequence numberes 4 and 5.
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0,4)));
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0,5)));
+                wproxy.m_changesFromW.extend_to(SequenceNumber_t(0,4), ChangeFromWriterStatus_t::UNKNOWN);
+                wproxy.m_changesFromW.extend_to(SequenceNumber_t(0,5), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Set received change with sequence number 2
                 wproxy.received_change_set(SequenceNumber_t(0, 2));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 0));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 0));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 5u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 1))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 2))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 3))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 1)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 2)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 3)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Set received change with sequence number 1
                 wproxy.received_change_set(SequenceNumber_t(0, 1));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 3));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 3));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 2u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Try to update LOST changes util sequence number 3.
                 wproxy.received_change_set(SequenceNumber_t(0, 3));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 3));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 3));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 2u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Add received change with sequence number 6
                 wproxy.received_change_set(SequenceNumber_t(0, 6));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 3));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 3));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 3u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 6)), ChangeFromWriterStatus_t::RECEIVED);
 
                 // Add received change with sequence number 8
                 wproxy.received_change_set(SequenceNumber_t(0, 8));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 3));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 3));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 5u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 7))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 6)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 7)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 8)), ChangeFromWriterStatus_t::RECEIVED);
 
                 // Add received change with sequence number 4
                 wproxy.received_change_set(SequenceNumber_t(0, 4));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 4));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 4));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 4u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 7))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 6)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 7)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 8)), ChangeFromWriterStatus_t::RECEIVED);
 
                 // Add received change with sequence number 5
                 wproxy.received_change_set(SequenceNumber_t(0, 5));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 6));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 6));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 2u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 7))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 7)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 8)), ChangeFromWriterStatus_t::RECEIVED);
 
                 // Add received change with sequence number 7
                 wproxy.received_change_set(SequenceNumber_t(0, 7));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 8));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 8));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 0u);
             }
 
@@ -240,89 +238,138 @@ namespace eprosima
 
                 // Set irrelevant change with sequence number 3.
                 wproxy.irrelevant_change_set(SequenceNumber_t(0, 3));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 0));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 0));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 3u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 1))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 2))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 3))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 3))->isRelevant(), false);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 1)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 2)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 3)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.is_relevant(SequenceNumber_t(0, 3)), false);
 
                 // Add two UNKNOWN with sequence numberes 4 and 5.
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0,4)));
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0,5)));
+                wproxy.m_changesFromW.extend_to(SequenceNumber_t(0,4), ChangeFromWriterStatus_t::UNKNOWN);
+                wproxy.m_changesFromW.extend_to(SequenceNumber_t(0,5), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Set irrelevant change with sequence number 2
                 wproxy.irrelevant_change_set(SequenceNumber_t(0, 2));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 0));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 0));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 5u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 1))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 2))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 2))->isRelevant(), false);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 3))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 3))->isRelevant(), false);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 1)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 2)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.is_relevant(SequenceNumber_t(0, 2)), false);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 3)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.is_relevant(SequenceNumber_t(0, 3)), false);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Set irrelevant change with sequence number 1
                 wproxy.irrelevant_change_set(SequenceNumber_t(0, 1));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 3));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 3));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 2u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Try to update LOST changes util sequence number 3.
                 wproxy.irrelevant_change_set(SequenceNumber_t(0, 3));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 3));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 3));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 2u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Add irrelevant change with sequence number 6
                 wproxy.irrelevant_change_set(SequenceNumber_t(0, 6));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 3));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 3));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 3u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->isRelevant(), false);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 6)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.is_relevant(SequenceNumber_t(0, 6)), false);
 
                 // Add irrelevant change with sequence number 8
                 wproxy.irrelevant_change_set(SequenceNumber_t(0, 8));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 3));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 3));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 5u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->isRelevant(), false);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 7))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->isRelevant(), false);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 6)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.is_relevant(SequenceNumber_t(0, 6)), false);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 7)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 8)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.is_relevant(SequenceNumber_t(0, 8)), false);
 
                 // Add irrelevant change with sequence number 4
                 wproxy.irrelevant_change_set(SequenceNumber_t(0, 4));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 4));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 4));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 4u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->isRelevant(), false);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 7))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->isRelevant(), false);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 6)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.is_relevant(SequenceNumber_t(0, 6)), false);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 7)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 8)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.is_relevant(SequenceNumber_t(0, 8)), false);
 
                 // Add irrelevant change with sequence number 5
                 wproxy.irrelevant_change_set(SequenceNumber_t(0, 5));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 6));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 6));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 2u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 7))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->isRelevant(), false);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 7)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.m_changesFromW.status(SequenceNumber_t(0, 8)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.m_changesFromW.is_relevant(SequenceNumber_t(0, 8)), false);
 
                 // Add irrelevant change with sequence number 7
                 wproxy.irrelevant_change_set(SequenceNumber_t(0, 7));
-                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 8));
+                ASSERT_EQ(wproxy.m_changesFromW.low_mark(), SequenceNumber_t(0, 8));
                 ASSERT_EQ(wproxy.m_changesFromW.size(), 0u);
             }
 
+            TEST(WriterProxyTests, MissingChangesSet)
+            {
+                RemoteWriterAttributes wattr;
+                StatefulReader readerMock;
+                WriterProxy wproxy(wattr, &readerMock);
+
+                // Heartbeat announcing changes 1 to 300.
+                wproxy.missing_changes_update(SequenceNumber_t(0, 300));
+                ASSERT_TRUE(wproxy.areThereMissing());
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 300u);
+
+                // Only the changes fitting in the bitmap are requested.
+                SequenceNumberSet_t missing;
+                ASSERT_TRUE(wproxy.missing_changes(missing));
+                ASSERT_EQ(missing.base, SequenceNumber_t(0, 1));
+                ASSERT_EQ(missing.get_size(), 256u);
+
+                for(uint32_t seq_num = 1; seq_num <= 200; ++seq_num)
+                {
+                    ASSERT_TRUE(wproxy.received_change_set(SequenceNumber_t(0, seq_num)));
+                }
+                ASSERT_TRUE(wproxy.received_change_set(SequenceNumber_t(0, 260)));
+                ASSERT_FALSE(wproxy.received_change_set(SequenceNumber_t(0, 260)));
+                ASSERT_EQ(wproxy.available_changes_max(), SequenceNumber_t(0, 200));
+                ASSERT_EQ(wproxy.unknown_missing_changes_up_to(SequenceNumber_t(0, 270)), 68u);
+                ASSERT_TRUE(wproxy.change_was_received(SequenceNumber_t(0, 260)));
+                ASSERT_FALSE(wproxy.change_was_received(SequenceNumber_t(0, 261)));
+
+                missing = SequenceNumberSet_t();
+                ASSERT_TRUE(wproxy.missing_changes(missing));
+                ASSERT_EQ(missing.base, SequenceNumber_t(0, 201));
+                ASSERT_EQ(missing.get_size(), 99u);
+                ASSERT_EQ(*missing.get_begin(), SequenceNumber_t(0, 201));
+
+                // Changes after the ones the writer no longer has are received in order.
+                wproxy.lost_changes_update(SequenceNumber_t(0, 280));
+                ASSERT_EQ(wproxy.available_changes_max(), SequenceNumber_t(0, 279));
+                for(uint32_t seq_num = 280; seq_num <= 300; ++seq_num)
+                {
+                    ASSERT_TRUE(wproxy.received_change_set(SequenceNumber_t(0, seq_num)));
+                }
+                ASSERT_EQ(wproxy.available_changes_max(), SequenceNumber_t(0, 300));
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 0u);
+                ASSERT_FALSE(wproxy.areThereMissing());
+                missing = SequenceNumberSet_t();
+                ASSERT_FALSE(wproxy.missing_changes(missing));
+                ASSERT_EQ(missing.base, SequenceNumber_t(0, 301));
+            }
+
         } // namespace rtps
     } // namespace fastrtps
 } // namespace eprosima
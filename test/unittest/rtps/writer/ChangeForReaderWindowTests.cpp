@@ -0,0 +1,138 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/writer/ChangeForReaderWindow.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+
+static ChangeForReader_t change_for_reader(uint32_t sequence_number, ChangeForReaderStatus_t status = UNSENT)
+{
+    ChangeForReader_t change(SequenceNumber_t(0, sequence_number));
+    change.setStatus(status);
+    return change;
+}
+
+static std::vector<uint32_t> sequence_numbers(ChangeForReaderWindow& window, ChangeForReaderStatus_t status)
+{
+    std::vector<ChangeForReader_t*> changes;
+    window.get_changes(status, changes);
+    std::vector<uint32_t> result;
+    for(const ChangeForReader_t* change : changes)
+    {
+        result.push_back(change->getSequenceNumber().low);
+    }
+    return result;
+}
+
+TEST(ChangeForReaderWindowTests, tracks_status_by_sequence_number)
+{
+    ChangeForReaderWindow window;
+
+    // Sequence number 4 was not sent to this reader.
+    for(uint32_t sequence_number : { 1, 2, 3, 5, 6 })
+    {
+        ASSERT_TRUE(window.push_back(change_for_reader(sequence_number)));
+    }
+    EXPECT_FALSE(window.push_back(change_for_reader(6)));
+    EXPECT_EQ(window.size(), 5u);
+    EXPECT_EQ(window.find(SequenceNumber_t(0, 4)), nullptr);
+
+    EXPECT_TRUE(window.set_status(SequenceNumber_t(0, 2), UNDERWAY));
+    EXPECT_TRUE(window.set_status(SequenceNumber_t(0, 5), UNDERWAY));
+    EXPECT_FALSE(window.set_status(SequenceNumber_t(0, 4), UNDERWAY));
+    EXPECT_EQ(window.find(SequenceNumber_t(0, 5))->getStatus(), UNDERWAY);
+
+    std::vector<uint32_t> expected = { 1, 3, 6 };
+    EXPECT_EQ(sequence_numbers(window, UNSENT), expected);
+    EXPECT_FALSE(window.has_changes(UNACKNOWLEDGED));
+
+    EXPECT_EQ(window.convert_status(UNDERWAY, UNACKNOWLEDGED), 2u);
+    expected = { 2, 5 };
+    EXPECT_EQ(sequence_numbers(window, UNACKNOWLEDGED), expected);
+    EXPECT_EQ(window.find(SequenceNumber_t(0, 2))->getStatus(), UNACKNOWLEDGED);
+    EXPECT_FALSE(window.has_changes(UNDERWAY));
+}
+
+TEST(ChangeForReaderWindowTests, removes_acknowledged_changes)
+{
+    ChangeForReaderWindow window;
+    for(uint32_t sequence_number = 1; sequence_number <= 200; ++sequence_number)
+    {
+        window.push_back(change_for_reader(sequence_number, UNACKNOWLEDGED));
+    }
+
+    // A change acknowledged out of order waits for the previous ones.
+    window.set_status(SequenceNumber_t(0, 2), ACKNOWLEDGED);
+    EXPECT_EQ(window.remove_acknowledged_front(), c_SequenceNumber_Unknown);
+    window.set_status(SequenceNumber_t(0, 1), ACKNOWLEDGED);
+    EXPECT_EQ(window.remove_acknowledged_front(), SequenceNumber_t(0, 2));
+    EXPECT_EQ(window.front()->getSequenceNumber(), SequenceNumber_t(0, 3));
+
+    EXPECT_EQ(window.remove_until(SequenceNumber_t(0, 150)), 147u);
+    EXPECT_EQ(window.size(), 51u);
+    EXPECT_EQ(window.front()->getSequenceNumber(), SequenceNumber_t(0, 150));
+    EXPECT_EQ(window.find(SequenceNumber_t(0, 149)), nullptr);
+    EXPECT_EQ(sequence_numbers(window, UNACKNOWLEDGED).size(), 51u);
+
+    // Adding changes reclaims the removed slots, keeping the state of the remaining ones.
+    for(uint32_t sequence_number = 201; sequence_number <= 400; ++sequence_number)
+    {
+        window.push_back(change_for_reader(sequence_number));
+    }
+    EXPECT_EQ(window.size(), 251u);
+    EXPECT_EQ(window.front()->getSequenceNumber(), SequenceNumber_t(0, 150));
+    EXPECT_EQ(sequence_numbers(window, UNACKNOWLEDGED).size(), 51u);
+    EXPECT_EQ(sequence_numbers(window, UNSENT).size(), 200u);
+
+    EXPECT_EQ(window.remove_until(SequenceNumber_t(0, 1000)), 251u);
+    EXPECT_TRUE(window.empty());
+    EXPECT_EQ(window.front(), nullptr);
+    EXPECT_TRUE(window.push_back(change_for_reader(401)));
+    EXPECT_EQ(window.front()->getSequenceNumber(), SequenceNumber_t(0, 401));
+}
+
+TEST(ChangeForReaderWindowTests, prepends_older_changes)
+{
+    ChangeForReaderWindow window;
+    window.push_back(change_for_reader(10));
+    window.push_back(change_for_reader(11));
+
+    ChangeForReaderWindow overlapping;
+    overlapping.push_back(change_for_reader(10));
+    EXPECT_FALSE(window.prepend(overlapping));
+
+    ChangeForReaderWindow older;
+    for(uint32_t sequence_number = 5; sequence_number <= 9; ++sequence_number)
+    {
+        older.push_back(change_for_reader(sequence_number, UNACKNOWLEDGED));
+    }
+    ASSERT_TRUE(window.prepend(older));
+    EXPECT_TRUE(older.empty());
+
+    EXPECT_EQ(window.size(), 7u);
+    EXPECT_EQ(window.front()->getSequenceNumber(), SequenceNumber_t(0, 5));
+    std::vector<uint32_t> expected = { 10, 11 };
+    EXPECT_EQ(sequence_numbers(window, UNSENT), expected);
+    EXPECT_EQ(window.last_sequence_number(), SequenceNumber_t(0, 11));
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
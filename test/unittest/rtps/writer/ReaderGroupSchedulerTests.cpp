@@ -0,0 +1,105 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/writer/ReaderGroupScheduler.h>
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastrtps::rtps;
+
+// The scheduler never dereferences the readers, so any distinct addresses identify them.
+static char reader_storage[8];
+
+static ReaderProxy* reader(size_t index)
+{
+    return reinterpret_cast<ReaderProxy*>(&reader_storage[index]);
+}
+
+static GUID_t guid(uint32_t entity)
+{
+    return GUID_t(GuidPrefix_t(), entity);
+}
+
+static LocatorList_t locators(uint32_t port)
+{
+    LocatorList_t list;
+    list.push_back(Locator_t(port));
+    list.push_back(Locator_t(port + 1));
+    return list;
+}
+
+TEST(ReaderGroupSchedulerTests, GroupsReadersByLocators)
+{
+    ReaderGroupScheduler scheduler;
+
+    ASSERT_TRUE(scheduler.add_reader(reader(0), guid(1), locators(7400), false));
+    ASSERT_TRUE(scheduler.add_reader(reader(1), guid(2), locators(7410), false));
+    ASSERT_TRUE(scheduler.add_reader(reader(2), guid(3), locators(7400), true));
+    ASSERT_FALSE(scheduler.add_reader(reader(2), guid(3), locators(7410), false));
+
+    // Locators in a different order are the same destination.
+    LocatorList_t reversed;
+    reversed.push_back(Locator_t(7411));
+    reversed.push_back(Locator_t(7410));
+    ASSERT_TRUE(scheduler.add_reader(reader(3), guid(4), reversed, false));
+
+    ASSERT_EQ(scheduler.size(), 4u);
+    ASSERT_EQ(scheduler.groups().size(), 2u);
+    ASSERT_TRUE(scheduler.expects_inline_qos());
+
+    const ReaderGroupScheduler::Group& first = scheduler.groups()[scheduler.group_of(reader(0))];
+    ASSERT_EQ(scheduler.group_of(reader(2)), scheduler.group_of(reader(0)));
+    ASSERT_EQ(first.readers.size(), 2u);
+    ASSERT_EQ(first.guids[1], guid(3));
+    ASSERT_TRUE(first.expects_inline_qos());
+
+    const ReaderGroupScheduler::Group& second = scheduler.groups()[scheduler.group_of(reader(1))];
+    ASSERT_EQ(scheduler.group_of(reader(3)), scheduler.group_of(reader(1)));
+    ASSERT_FALSE(second.expects_inline_qos());
+
+    ASSERT_EQ(scheduler.group_of(reader(4)), scheduler.groups().size());
+}
+
+TEST(ReaderGroupSchedulerTests, RemoveReaders)
+{
+    ReaderGroupScheduler scheduler;
+
+    ASSERT_TRUE(scheduler.add_reader(reader(0), guid(1), locators(7400), true));
+    ASSERT_TRUE(scheduler.add_reader(reader(1), guid(2), locators(7410), false));
+    ASSERT_TRUE(scheduler.add_reader(reader(2), guid(3), locators(7410), false));
+
+    ASSERT_TRUE(scheduler.remove_reader(reader(0)));
+    ASSERT_FALSE(scheduler.remove_reader(reader(0)));
+    ASSERT_FALSE(scheduler.expects_inline_qos());
+
+    // The remaining group takes the position of the removed one.
+    ASSERT_EQ(scheduler.groups().size(), 1u);
+    ASSERT_EQ(scheduler.group_of(reader(1)), 0u);
+    ASSERT_EQ(scheduler.group_of(reader(2)), 0u);
+
+    ASSERT_TRUE(scheduler.remove_reader(reader(1)));
+    ASSERT_EQ(scheduler.groups().size(), 1u);
+    ASSERT_EQ(scheduler.groups()[0].readers.size(), 1u);
+    ASSERT_EQ(scheduler.groups()[0].guids[0], guid(3));
+
+    ASSERT_TRUE(scheduler.remove_reader(reader(2)));
+    ASSERT_EQ(scheduler.size(), 0u);
+    ASSERT_TRUE(scheduler.groups().empty());
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
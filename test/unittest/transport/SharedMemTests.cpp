@@ -0,0 +1,308 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <fastrtps/utils/Semaphore.h>
+#include <fastrtps/transport/SharedMemTransport.h>
+#include <fastrtps/log/Log.h>
+#include <gtest/gtest.h>
+#include <thread>
+#include <memory>
+#include <cstring>
+#include <vector>
+#include <MockReceiverResource.h>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+#if defined(_WIN32)
+#define GET_PID _getpid
+#else
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define GET_PID getpid
+#endif
+
+static uint16_t g_default_port = 0;
+
+uint16_t get_port()
+{
+    uint16_t port = static_cast<uint16_t>(GET_PID());
+
+    if(4000 > port)
+    {
+        port += 4000;
+    }
+
+    return port;
+}
+
+class SharedMemTests: public ::testing::Test
+{
+    public:
+        SharedMemTests()
+        {
+            HELPER_SetDescriptorDefaults();
+        }
+
+        void HELPER_SetDescriptorDefaults();
+
+        SharedMemTransportDescriptor descriptor;
+};
+
+TEST_F(SharedMemTests, locators_with_kind_16_supported)
+{
+    // Given
+    SharedMemTransport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t supportedLocator;
+    supportedLocator.kind = LOCATOR_KIND_SHM;
+    Locator_t unsupportedLocator;
+    unsupportedLocator.kind = LOCATOR_KIND_UDPv4;
+
+    // Then
+    ASSERT_TRUE(transportUnderTest.IsLocatorSupported(supportedLocator));
+    ASSERT_FALSE(transportUnderTest.IsLocatorSupported(unsupportedLocator));
+}
+
+TEST_F(SharedMemTests, only_local_locators_are_allowed)
+{
+    // Given
+    SharedMemTransport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    LocatorList_t defaultLocators;
+    transportUnderTest.getDefaultUnicastLocators(defaultLocators, g_default_port);
+    ASSERT_EQ(defaultLocators.size(), 1u);
+    Locator_t localLocator = *defaultLocators.begin();
+
+    Locator_t remoteLocator(localLocator);
+    remoteLocator.address[15] ^= 0xFF;
+
+    // Then
+    ASSERT_TRUE(transportUnderTest.is_local_locator(localLocator));
+    ASSERT_TRUE(transportUnderTest.IsLocatorAllowed(localLocator));
+    ASSERT_FALSE(transportUnderTest.is_local_locator(remoteLocator));
+    ASSERT_FALSE(transportUnderTest.IsLocatorAllowed(remoteLocator));
+
+    // The whole address identifies the host.
+    Locator_t otherHostLocator(localLocator);
+    otherHostLocator.address[0] ^= 0xFF;
+    ASSERT_FALSE(transportUnderTest.is_local_locator(otherHostLocator));
+}
+
+#if !defined(_WIN32) && !defined(__APPLE__) && !defined(__ANDROID__)
+TEST_F(SharedMemTests, opening_and_closing_input_channel)
+{
+    // Given
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    Locator_t inputLocator;
+    inputLocator.kind = LOCATOR_KIND_SHM;
+    inputLocator.port = g_default_port;
+
+    // Then
+    ASSERT_FALSE (transportUnderTest.IsInputChannelOpen(inputLocator));
+    ASSERT_TRUE  (transportUnderTest.OpenInputChannel(inputLocator, nullptr, descriptor.maxMessageSize));
+    ASSERT_TRUE  (transportUnderTest.IsInputChannelOpen(inputLocator));
+    ASSERT_TRUE  (transportUnderTest.CloseInputChannel(inputLocator));
+    ASSERT_FALSE (transportUnderTest.IsInputChannelOpen(inputLocator));
+    ASSERT_FALSE (transportUnderTest.CloseInputChannel(inputLocator));
+}
+
+TEST_F(SharedMemTests, port_owned_by_another_transport_cannot_be_opened)
+{
+    // Given
+    SharedMemTransport owner(descriptor);
+    ASSERT_TRUE(owner.init());
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    Locator_t inputLocator;
+    inputLocator.kind = LOCATOR_KIND_SHM;
+    inputLocator.port = g_default_port + 1;
+
+    // Then
+    ASSERT_TRUE  (owner.OpenInputChannel(inputLocator, nullptr, descriptor.maxMessageSize));
+    ASSERT_FALSE (transportUnderTest.OpenInputChannel(inputLocator, nullptr, descriptor.maxMessageSize));
+    ASSERT_TRUE  (owner.CloseInputChannel(inputLocator));
+    ASSERT_TRUE  (transportUnderTest.OpenInputChannel(inputLocator, nullptr, descriptor.maxMessageSize));
+    ASSERT_TRUE  (transportUnderTest.CloseInputChannel(inputLocator));
+}
+
+#if !defined(_WIN32)
+TEST_F(SharedMemTests, port_left_by_dead_process_can_be_opened)
+{
+    Locator_t inputLocator;
+    inputLocator.kind = LOCATOR_KIND_SHM;
+    inputLocator.port = g_default_port + 6;
+
+    // Given a segment whose owner exits without closing it
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0)
+    {
+        SharedMemTransport owner(descriptor);
+        bool opened = owner.init() && owner.OpenInputChannel(inputLocator, nullptr, descriptor.maxMessageSize);
+        _exit(opened ? 0 : 1);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    // Then
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+    ASSERT_TRUE(transportUnderTest.OpenInputChannel(inputLocator, nullptr, descriptor.maxMessageSize));
+    ASSERT_TRUE(transportUnderTest.CloseInputChannel(inputLocator));
+}
+#endif
+
+TEST_F(SharedMemTests, segments_are_created_with_configured_permissions)
+{
+    Locator_t inputLocator;
+    inputLocator.kind = LOCATOR_KIND_SHM;
+    inputLocator.port = g_default_port + 5;
+    std::string segmentPath = "/dev/shm/" + descriptor.segment_name_prefix + "_" + std::to_string(inputLocator.port);
+    struct stat info;
+
+    {
+        SharedMemTransport transportUnderTest(descriptor);
+        ASSERT_TRUE(transportUnderTest.init());
+        ASSERT_TRUE(transportUnderTest.OpenInputChannel(inputLocator, nullptr, descriptor.maxMessageSize));
+        ASSERT_EQ(stat(segmentPath.c_str(), &info), 0);
+        EXPECT_EQ(info.st_mode & 0777, 0600u);
+        ASSERT_TRUE(transportUnderTest.CloseInputChannel(inputLocator));
+    }
+
+    descriptor.segment_permissions = 0660;
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+    ASSERT_TRUE(transportUnderTest.OpenInputChannel(inputLocator, nullptr, descriptor.maxMessageSize));
+    ASSERT_EQ(stat(segmentPath.c_str(), &info), 0);
+    EXPECT_EQ(info.st_mode & 0777, 0660u);
+    ASSERT_TRUE(transportUnderTest.CloseInputChannel(inputLocator));
+}
+
+TEST_F(SharedMemTests, send_and_receive_between_ports)
+{
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    LocatorList_t inputLocators;
+    transportUnderTest.getDefaultUnicastLocators(inputLocators, g_default_port + 2);
+    Locator_t inputLocator = *inputLocators.begin();
+
+    LocatorList_t outputLocators;
+    transportUnderTest.AddDefaultOutputLocator(outputLocators);
+    Locator_t outputChannelLocator = *outputLocators.begin();
+
+    MockReceiverResource receiver(transportUnderTest, inputLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(outputChannelLocator));
+    ASSERT_TRUE(transportUnderTest.IsInputChannelOpen(inputLocator));
+    octet message[5] = { 'H','e','l','l','o' };
+
+    Semaphore sem;
+    std::function<void()> recCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message,msg_recv->data,5), 0);
+        sem.post();
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    EXPECT_TRUE(transportUnderTest.Send(message, 5, outputChannelLocator, inputLocator));
+    sem.wait();
+    ASSERT_TRUE(transportUnderTest.CloseOutputChannel(outputChannelLocator));
+}
+
+TEST_F(SharedMemTests, send_fails_when_ring_is_full)
+{
+    descriptor.ring_cell_count = 2;
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    LocatorList_t inputLocators;
+    transportUnderTest.getDefaultUnicastLocators(inputLocators, g_default_port + 3);
+    Locator_t inputLocator = *inputLocators.begin();
+
+    LocatorList_t outputLocators;
+    transportUnderTest.AddDefaultOutputLocator(outputLocators);
+    Locator_t outputChannelLocator = *outputLocators.begin();
+
+    MockReceiverResource receiver(transportUnderTest, inputLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+
+    // Keeps the listening thread busy with the first message.
+    Semaphore received;
+    Semaphore release;
+    msg_recv->setCallback([&]()
+    {
+        received.post();
+        release.wait();
+    });
+
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(outputChannelLocator));
+    octet message[5] = { 'H','e','l','l','o' };
+
+    EXPECT_TRUE(transportUnderTest.Send(message, 5, outputChannelLocator, inputLocator));
+    received.wait();
+    EXPECT_TRUE(transportUnderTest.Send(message, 5, outputChannelLocator, inputLocator));
+    EXPECT_FALSE(transportUnderTest.Send(message, 5, outputChannelLocator, inputLocator));
+
+    release.post();
+    received.wait();
+    release.post();
+    ASSERT_TRUE(transportUnderTest.CloseOutputChannel(outputChannelLocator));
+}
+#endif
+
+TEST_F(SharedMemTests, send_to_oversized_message_fails)
+{
+    SharedMemTransport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    LocatorList_t outputLocators;
+    transportUnderTest.AddDefaultOutputLocator(outputLocators);
+    Locator_t outputChannelLocator = *outputLocators.begin();
+    Locator_t destinationLocator(outputChannelLocator);
+    destinationLocator.port = g_default_port + 4;
+
+    transportUnderTest.OpenOutputChannel(outputChannelLocator);
+    std::vector<octet> message(descriptor.maxMessageSize + 1, 'a');
+
+    ASSERT_FALSE(transportUnderTest.Send(message.data(), static_cast<uint32_t>(message.size()),
+        outputChannelLocator, destinationLocator));
+}
+
+void SharedMemTests::HELPER_SetDescriptorDefaults()
+{
+    descriptor.maxMessageSize = 5;
+    descriptor.ring_cell_count = 4;
+    descriptor.segment_name_prefix = "fastrtps_test";
+}
+
+int main(int argc, char **argv)
+{
+    Log::SetVerbosity(Log::Warning);
+    g_default_port = get_port();
+
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
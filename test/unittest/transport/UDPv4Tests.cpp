@@ -213,8 +213,301 @@ TEST_F(UDPv4Tests, send_to_loopback)
     sem.wait();
     ASSERT_TRUE(transportUnderTest.CloseOutputChannel(outputChannelLocator));
 }
+
+TEST_F(UDPv4Tests, send_and_receive_gathered_buffers)
+{
+    UDPv4Transport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t multicastLocator;
+    multicastLocator.port = g_default_port;
+    multicastLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(multicastLocator, 239, 255, 0, 1);
+
+    Locator_t outputChannelLocator;
+    outputChannelLocator.port = g_default_port + 1;
+    outputChannelLocator.kind = LOCATOR_KIND_UDPv4;
+
+    MockReceiverResource receiver(transportUnderTest, multicastLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(outputChannelLocator));
+    ASSERT_TRUE(transportUnderTest.IsInputChannelOpen(multicastLocator));
+    octet header[2] = { 'H','e' };
+    octet payload[3] = { 'l','l','o' };
+    octet message[5] = { 'H','e','l','l','o' };
+
+    Semaphore sem;
+    std::function<void()> recCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message,msg_recv->data,5), 0);
+        sem.post();
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    std::vector<NetworkBuffer> buffers;
+    buffers.emplace_back(header, 2);
+    buffers.emplace_back(payload, 3);
+
+    auto sendThreadFunction = [&]()
+    {
+        EXPECT_TRUE(transportUnderTest.Send(buffers, 5, outputChannelLocator, multicastLocator));
+    };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    senderThread->join();
+    sem.wait();
+    ASSERT_TRUE(transportUnderTest.CloseOutputChannel(outputChannelLocator));
+}
+
+TEST_F(UDPv4Tests, send_and_receive_batched_to_several_locators)
+{
+    descriptor.max_messages_per_batch = 8;
+    UDPv4Transport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t firstLocator;
+    firstLocator.port = g_default_port;
+    firstLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(firstLocator, 239, 255, 0, 1);
+
+    Locator_t secondLocator;
+    secondLocator.port = g_default_port + 2;
+    secondLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(secondLocator, 239, 255, 0, 1);
+
+    Locator_t outputChannelLocator;
+    outputChannelLocator.port = g_default_port + 1;
+    outputChannelLocator.kind = LOCATOR_KIND_UDPv4;
+
+    MockReceiverResource firstReceiver(transportUnderTest, firstLocator);
+    MockMessageReceiver *first_msg_recv = dynamic_cast<MockMessageReceiver*>(firstReceiver.CreateMessageReceiver());
+    MockReceiverResource secondReceiver(transportUnderTest, secondLocator);
+    MockMessageReceiver *second_msg_recv = dynamic_cast<MockMessageReceiver*>(secondReceiver.CreateMessageReceiver());
+
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(outputChannelLocator));
+    ASSERT_TRUE(transportUnderTest.IsInputChannelOpen(firstLocator));
+    ASSERT_TRUE(transportUnderTest.IsInputChannelOpen(secondLocator));
+    octet message[5] = { 'H','e','l','l','o' };
+
+    Semaphore sem;
+    std::function<void()> firstCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message,first_msg_recv->data,5), 0);
+        sem.post();
+    };
+    std::function<void()> secondCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message,second_msg_recv->data,5), 0);
+        sem.post();
+    };
+
+    first_msg_recv->setCallback(firstCallback);
+    second_msg_recv->setCallback(secondCallback);
+
+    LocatorList_t destinations;
+    destinations.push_back(firstLocator);
+    destinations.push_back(secondLocator);
+
+    std::vector<NetworkBuffer> buffers;
+    buffers.emplace_back(message, 3);
+    buffers.emplace_back(message + 3, 2);
+
+    auto sendThreadFunction = [&]()
+    {
+        EXPECT_TRUE(transportUnderTest.SendToLocators(buffers, 5, outputChannelLocator, destinations));
+    };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    senderThread->join();
+    sem.wait();
+    sem.wait();
+    ASSERT_TRUE(transportUnderTest.CloseOutputChannel(outputChannelLocator));
+}
+
+TEST_F(UDPv4Tests, send_and_receive_through_reactor)
+{
+    descriptor.reactor_threads = 2;
+    UDPv4Transport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t firstLocator;
+    firstLocator.port = g_default_port;
+    firstLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(firstLocator, 239, 255, 0, 1);
+
+    Locator_t secondLocator;
+    secondLocator.port = g_default_port + 2;
+    secondLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(secondLocator, 239, 255, 0, 1);
+
+    Locator_t outputChannelLocator;
+    outputChannelLocator.port = g_default_port + 1;
+    outputChannelLocator.kind = LOCATOR_KIND_UDPv4;
+
+    MockReceiverResource firstReceiver(transportUnderTest, firstLocator);
+    MockMessageReceiver *first_msg_recv = dynamic_cast<MockMessageReceiver*>(firstReceiver.CreateMessageReceiver());
+    MockReceiverResource secondReceiver(transportUnderTest, secondLocator);
+    MockMessageReceiver *second_msg_recv = dynamic_cast<MockMessageReceiver*>(secondReceiver.CreateMessageReceiver());
+
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(outputChannelLocator));
+    ASSERT_TRUE(transportUnderTest.IsInputChannelOpen(firstLocator));
+    ASSERT_TRUE(transportUnderTest.IsInputChannelOpen(secondLocator));
+    octet message[5] = { 'H','e','l','l','o' };
+
+    Semaphore sem;
+    std::function<void()> firstCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message,first_msg_recv->data,5), 0);
+        sem.post();
+    };
+    std::function<void()> secondCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message,second_msg_recv->data,5), 0);
+        sem.post();
+    };
+
+    first_msg_recv->setCallback(firstCallback);
+    second_msg_recv->setCallback(secondCallback);
+
+    auto sendThreadFunction = [&]()
+    {
+        EXPECT_TRUE(transportUnderTest.Send(message, 5, outputChannelLocator, firstLocator));
+        EXPECT_TRUE(transportUnderTest.Send(message, 5, outputChannelLocator, secondLocator));
+    };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    senderThread->join();
+    sem.wait();
+    sem.wait();
+    ASSERT_TRUE(transportUnderTest.CloseOutputChannel(outputChannelLocator));
+    ASSERT_TRUE(transportUnderTest.CloseInputChannel(firstLocator));
+    ASSERT_FALSE(transportUnderTest.IsInputChannelOpen(firstLocator));
+}
+
+TEST_F(UDPv4Tests, send_and_receive_through_shared_unicast_port)
+{
+    descriptor.unicast_sockets_per_port = 4;
+    UDPv4Transport transportUnderTest(descriptor);
+    transportUnderTest.init();
+    UDPv4Transport otherTransport(descriptor);
+    otherTransport.init();
+
+    Locator_t unicastLocator;
+    unicastLocator.port = g_default_port;
+    unicastLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(unicastLocator, 127, 0, 0, 1);
+
+    Locator_t outputChannelLocator;
+    outputChannelLocator.port = g_default_port + 1;
+    outputChannelLocator.kind = LOCATOR_KIND_UDPv4;
+
+    EXPECT_EQ(transportUnderTest.max_concurrent_receptions(unicastLocator), 4u);
+
+    MockReceiverResource receiver(transportUnderTest, unicastLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+    ASSERT_TRUE(transportUnderTest.IsInputChannelOpen(unicastLocator));
+
+    // The port is not shared with other transports, even if they also use SO_REUSEPORT.
+    MockReceiverResource otherReceiver(otherTransport, unicastLocator);
+    ASSERT_FALSE(otherTransport.IsInputChannelOpen(unicastLocator));
+
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(outputChannelLocator));
+    octet message[5] = { 'H','e','l','l','o' };
+
+    Semaphore sem;
+    std::function<void()> recCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message,msg_recv->data,5), 0);
+        sem.post();
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    auto sendThreadFunction = [&]()
+    {
+        EXPECT_TRUE(transportUnderTest.Send(message, 5, outputChannelLocator, unicastLocator));
+    };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    senderThread->join();
+    sem.wait();
+    ASSERT_TRUE(transportUnderTest.CloseOutputChannel(outputChannelLocator));
+    ASSERT_TRUE(transportUnderTest.CloseInputChannel(unicastLocator));
+}
 #endif
 
+// Keeps a reference to every buffer it receives, as readers do with loaned payloads.
+class BufferKeepingReceiver : public TransportReceiverInterface
+{
+public:
+
+    ~BufferKeepingReceiver()
+    {
+        for (ReceiveBuffer* buffer : buffers)
+        {
+            buffer->release();
+        }
+    }
+
+    void OnDataReceived(const octet*, const uint32_t, const Locator_t&, const Locator_t&) override
+    {
+        ADD_FAILURE() << "Data not received into a pooled buffer";
+        sem.post();
+    }
+
+    void OnDataReceived(ReceiveBuffer& buffer, const uint32_t size, const Locator_t&, const Locator_t&) override
+    {
+        EXPECT_EQ(size, 5u);
+        buffer.acquire();
+        buffers.push_back(&buffer);
+        sem.post();
+    }
+
+    std::vector<ReceiveBuffer*> buffers;
+    Semaphore sem;
+};
+
+TEST_F(UDPv4Tests, referenced_receive_buffers_are_not_reused)
+{
+    UDPv4Transport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t unicastLocator;
+    unicastLocator.port = g_default_port;
+    unicastLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(unicastLocator, 127, 0, 0, 1);
+
+    Locator_t outputChannelLocator;
+    outputChannelLocator.port = g_default_port + 1;
+    outputChannelLocator.kind = LOCATOR_KIND_UDPv4;
+
+    BufferKeepingReceiver receiver;
+    ASSERT_TRUE(transportUnderTest.OpenInputChannel(unicastLocator, &receiver, 0x8FFF));
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(outputChannelLocator));
+
+    octet first[5] = { 'H','e','l','l','o' };
+    octet second[5] = { 'W','o','r','l','d' };
+    EXPECT_TRUE(transportUnderTest.Send(first, 5, outputChannelLocator, unicastLocator));
+    receiver.sem.wait();
+    EXPECT_TRUE(transportUnderTest.Send(second, 5, outputChannelLocator, unicastLocator));
+    receiver.sem.wait();
+
+    ASSERT_TRUE(transportUnderTest.CloseOutputChannel(outputChannelLocator));
+    ASSERT_TRUE(transportUnderTest.CloseInputChannel(unicastLocator));
+
+    // The first message is still there, after the second one was received and the channel closed.
+    ASSERT_EQ(receiver.buffers.size(), 2u);
+    EXPECT_NE(receiver.buffers[0], receiver.buffers[1]);
+    EXPECT_EQ(memcmp(first, receiver.buffers[0]->data(), 5), 0);
+    EXPECT_EQ(memcmp(second, receiver.buffers[1]->data(), 5), 0);
+}
+
 TEST_F(UDPv4Tests, send_is_rejected_if_buffer_size_is_bigger_to_size_specified_in_descriptor)
 {
     // Given
@@ -73,7 +73,7 @@ void MockMessageReceiver::setCallback(std::function<void()> cb)
     this->callback = cb;
 }
 
-void MockMessageReceiver::processCDRMsg(const Locator_t&, CDRMessage_t*msg)
+void MockMessageReceiver::processCDRMsg(const Locator_t&, CDRMessage_t*msg, ReceiveBuffer*)
 {
     data = msg->buffer;
     if (callback != nullptr)
@@ -41,7 +41,7 @@ class MockMessageReceiver : public MessageReceiver
 {
 public:
     MockMessageReceiver() : MessageReceiver(nullptr, nullptr) {}
-    void processCDRMsg(const Locator_t& loc, CDRMessage_t*msg) override;
+    void processCDRMsg(const Locator_t& loc, CDRMessage_t*msg, ReceiveBuffer* buffer = nullptr) override;
     void setCallback(std::function<void()> cb);
     octet* data;
     std::function<void()> callback;